@@ -9,6 +9,8 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "BoxSIMD.h"
+#include "SIMD.h"
 #include "VectorMath.h"
 
 /*! \file Box.h
@@ -32,6 +34,15 @@ namespace freud { namespace box {
      - wrap()
      - unwrap()
 
+    The coordinate transforms wrap(), makeFractional() and makeAbsolute() also have versions templated on the
+ dimensionality of the box (e.g. wrap<true>() for 2D boxes), so that inner loops can dispatch on is2D() once
+ and skip all work on the z component in 2D.
+
+    The versions of these transforms acting on arrays of vectors, computeDistances() and
+ computeAllDistances() use the vectorized kernels of BoxSIMD.h when the CPU supports them (see
+ util::getSIMDLevel()). The kernels give the same results as the scalar code, up to rounding if the scalar
+ code is compiled with fused multiply-adds.
+
     A Box can represent either a two or three dimensional box. By default, a Box is 3D, but can be set as 2D
  with the method set2D(), or via an optional boolean argument to the constructor. is2D() queries if a Box is
  2D or not. 2D boxes have a "volume" of Lx * Ly, and Lz is set to 0. To keep programming simple, all inputs
@@ -212,13 +223,29 @@ public:
      */
     vec3<float> makeAbsolute(const vec3<float>& f) const
     {
+        return m_2d ? makeAbsolute<true>(f) : makeAbsolute<false>(f);
+    }
+
+    //! Convert fractional coordinates into absolute coordinates for a box of known dimensionality
+    /*! The template parameter must match is2D(). Callers that transform
+     *  many vectors should dispatch on is2D() once and use this version, so
+     *  that no z component work is done for 2D boxes.
+     *
+     *  \param f Fractional coordinates between 0 and 1 within
+     *         parallelepipedal box
+     *  \return A vector inside the box corresponding to f
+     */
+    template<bool is2D> vec3<float> makeAbsolute(const vec3<float>& f) const
+    {
+        if (is2D)
+        {
+            vec3<float> v(m_lo.x + f.x * m_L.x, m_lo.y + f.y * m_L.y, 0.0f);
+            v.x += m_xy * v.y;
+            return v;
+        }
         vec3<float> v = m_lo + f * m_L;
         v.x += m_xy * v.y + m_xz * v.z;
         v.y += m_yz * v.z;
-        if (m_2d)
-        {
-            v.z = 0.0f;
-        }
         return v;
     }
 
@@ -229,12 +256,16 @@ public:
      */
     void makeAbsolute(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = makeAbsolute(vecs[i]);
-            }
-        });
+        if (m_2d)
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::makeAbsolute,
+                         [this](const vec3<float>& v) { return makeAbsolute<true>(v); });
+        }
+        else
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::makeAbsolute,
+                         [this](const vec3<float>& v) { return makeAbsolute<false>(v); });
+        }
     }
 
     //! Compute the position of the particle in box relative coordinates
@@ -246,29 +277,48 @@ public:
      *  either direction, it will go larger than 1 or less than 0
      *  keeping the same scaling.
      */
+    vec3<float> makeFractional(const vec3<float>& v,
+                               const vec3<float>& ghost_width = vec3<float>(0.0, 0.0, 0.0)) const
+    {
+        return m_2d ? makeFractional<true>(v, ghost_width) : makeFractional<false>(v, ghost_width);
+    }
+
+    //! Compute the position of the particle in box relative coordinates for a box of known dimensionality
+    /*! The template parameter must match is2D(); see makeAbsolute<is2D>.
+     *
+     *  \param p point
+     *  \returns alpha
+     */
+    template<bool is2D>
     vec3<float> makeFractional(const vec3<float>& v,
                                const vec3<float>& ghost_width = vec3<float>(0.0, 0.0, 0.0)) const
     {
         vec3<float> delta = v - m_lo;
         delta.x -= (m_xz - m_yz * m_xy) * v.z + m_xy * v.y;
         delta.y -= m_yz * v.z;
-        delta = (delta + ghost_width) / (m_L + 2.0f * ghost_width);
-
-        if (m_2d)
+        if (is2D)
         {
+            delta.x = (delta.x + ghost_width.x) / (m_L.x + 2.0f * ghost_width.x);
+            delta.y = (delta.y + ghost_width.y) / (m_L.y + 2.0f * ghost_width.y);
             delta.z = 0.0f;
+            return delta;
         }
+        delta = (delta + ghost_width) / (m_L + 2.0f * ghost_width);
         return delta;
     }
 
     void makeFractional(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = makeFractional(vecs[i]);
-            }
-        });
+        if (m_2d)
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::makeFractional,
+                         [this](const vec3<float>& v) { return makeFractional<true>(v); });
+        }
+        else
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::makeFractional,
+                         [this](const vec3<float>& v) { return makeFractional<false>(v); });
+        }
     }
 
     //! Get the periodic image vectors belongs to
@@ -294,6 +344,17 @@ public:
      *  \returns Wrapped vector
      */
     vec3<float> wrap(const vec3<float>& v) const
+    {
+        return m_2d ? wrap<true>(v) : wrap<false>(v);
+    }
+
+    //! Wrap a vector back into the box for a box of known dimensionality
+    /*! The template parameter must match is2D(); see makeAbsolute<is2D>.
+     *
+     *  \param v Vector to wrap, updated to the minimum image obeying the periodic settings
+     *  \returns Wrapped vector
+     */
+    template<bool is2D> vec3<float> wrap(const vec3<float>& v) const
     {
         // Return quickly if the box is aperiodic
         if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
@@ -301,7 +362,7 @@ public:
             return v;
         }
 
-        vec3<float> v_frac = makeFractional(v);
+        vec3<float> v_frac = makeFractional<is2D>(v);
         if (m_periodic.x)
         {
             v_frac.x = util::modulusPositive(v_frac.x, 1.0f);
@@ -310,11 +371,62 @@ public:
         {
             v_frac.y = util::modulusPositive(v_frac.y, 1.0f);
         }
-        if (m_periodic.z)
+        if (!is2D && m_periodic.z)
         {
             v_frac.z = util::modulusPositive(v_frac.z, 1.0f);
         }
-        return makeAbsolute(v_frac);
+        return makeAbsolute<is2D>(v_frac);
+    }
+
+    //! Wrap a vector back into the box and find the image it was moved to
+    /*! The wrapped vector is the same as that returned by wrap(v).
+     *
+     *  \param v Vector to wrap
+     *  \param image Set to the multiples of the lattice vectors added to v to wrap it
+     *  \returns Wrapped vector
+     */
+    vec3<float> wrap(const vec3<float>& v, vec3<int>& image) const
+    {
+        return m_2d ? wrap<true>(v, image) : wrap<false>(v, image);
+    }
+
+    //! Wrap a vector back into the box and find its image for a box of known dimensionality
+    /*! The template parameter must match is2D(); see makeAbsolute<is2D>.
+     *
+     *  \param v Vector to wrap
+     *  \param image Set to the multiples of the lattice vectors added to v to wrap it
+     *  \returns Wrapped vector
+     */
+    template<bool is2D> vec3<float> wrap(const vec3<float>& v, vec3<int>& image) const
+    {
+        image = vec3<int>(0, 0, 0);
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            return v;
+        }
+
+        // The image is read off the wrapped coordinates rather than taken
+        // from floor(), which can differ by one at the faces of the box.
+        vec3<float> v_frac = makeFractional<is2D>(v);
+        if (m_periodic.x)
+        {
+            const float wrapped = util::modulusPositive(v_frac.x, 1.0f);
+            image.x = static_cast<int>(std::round(wrapped - v_frac.x));
+            v_frac.x = wrapped;
+        }
+        if (m_periodic.y)
+        {
+            const float wrapped = util::modulusPositive(v_frac.y, 1.0f);
+            image.y = static_cast<int>(std::round(wrapped - v_frac.y));
+            v_frac.y = wrapped;
+        }
+        if (!is2D && m_periodic.z)
+        {
+            const float wrapped = util::modulusPositive(v_frac.z, 1.0f);
+            image.z = static_cast<int>(std::round(wrapped - v_frac.z));
+            v_frac.z = wrapped;
+        }
+        return makeAbsolute<is2D>(v_frac);
     }
 
     //! Wrap vectors back into the box in place
@@ -323,12 +435,37 @@ public:
      */
     void wrap(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = wrap(vecs[i]);
-            }
-        });
+        if (m_2d)
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::wrap,
+                         [this](const vec3<float>& v) { return wrap<true>(v); });
+        }
+        else
+        {
+            applyInPlace(vecs, Nvecs, BoxTransform::wrap,
+                         [this](const vec3<float>& v) { return wrap<false>(v); });
+        }
+    }
+
+    //! Wrap vectors back into the box in place, serially and with a given SIMD level
+    /*! This version is intended for callers that wrap many small batches of
+     *  vectors inside their own parallel loops, and resolve the SIMD level
+     *  once per compute with util::getSIMDLevel().
+     *
+     *  \param vecs Vectors to wrap, updated to the minimum image obeying the periodic settings
+     *  \param Nvecs Number of vectors
+     *  \param simd_level SIMD level of the kernels to use
+     */
+    void wrap(vec3<float>* vecs, unsigned int Nvecs, util::SIMDLevel simd_level) const
+    {
+        if (transformVectorsSIMD(simd_level, getSIMDParameters(), BoxTransform::wrap, vecs, Nvecs))
+        {
+            return;
+        }
+        for (unsigned int i = 0; i < Nvecs; ++i)
+        {
+            vecs[i] = wrap(vecs[i]);
+        }
     }
 
     //! Unwrap given positions to their absolute location in place
@@ -420,7 +557,14 @@ public:
         {
             throw std::invalid_argument("The number of query points and points must match.");
         }
+        const util::SIMDLevel simd_level = util::getSIMDLevel();
+        const BoxSIMDParameters params = getSIMDParameters();
         util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+            if (computeDistancesSIMD(simd_level, params, query_points + begin, false, points + begin,
+                                     end - begin, distances + begin))
+            {
+                return;
+            }
             for (size_t i = begin; i < end; ++i)
             {
                 distances[i] = computeDistance(query_points[i], points[i]);
@@ -439,10 +583,17 @@ public:
     void computeAllDistances(const vec3<float>* query_points, const unsigned int n_query_points,
                              const vec3<float>* points, const unsigned int n_points, float* distances) const
     {
+        const util::SIMDLevel simd_level = util::getSIMDLevel();
+        const BoxSIMDParameters params = getSIMDParameters();
         util::forLoopWrapper2D(
             0, n_query_points, 0, n_points, [&](size_t begin_n, size_t end_n, size_t begin_m, size_t end_m) {
                 for (size_t i = begin_n; i < end_n; ++i)
                 {
+                    if (computeDistancesSIMD(simd_level, params, query_points + i, true, points + begin_m,
+                                             end_m - begin_m, distances + i * n_points + begin_m))
+                    {
+                        continue;
+                    }
                     for (size_t j = begin_m; j < end_m; ++j)
                     {
                         distances[i * n_points + j] = computeDistance(query_points[i], points[j]);
@@ -567,6 +718,41 @@ public:
     }
 
 private:
+    //! Get the parameters of the box used by the vectorized kernels
+    BoxSIMDParameters getSIMDParameters() const
+    {
+        BoxSIMDParameters params;
+        params.lo = m_lo;
+        params.L = m_L;
+        params.xy = m_xy;
+        params.xz = m_xz;
+        params.yz = m_yz;
+        params.periodic = m_periodic;
+        params.is2D = m_2d;
+        return params;
+    }
+
+    //! Apply a coordinate transform to each of the vectors, in parallel
+    /*! Each chunk of vectors is transformed with the vectorized kernel of the
+     *  transform if one is available, and with func otherwise.
+     */
+    template<typename Func>
+    void applyInPlace(vec3<float>* vecs, unsigned int Nvecs, BoxTransform transform, const Func& func) const
+    {
+        const util::SIMDLevel simd_level = util::getSIMDLevel();
+        const BoxSIMDParameters params = getSIMDParameters();
+        util::forLoopWrapper(0, Nvecs, [=, &func, &params](size_t begin, size_t end) {
+            if (transformVectorsSIMD(simd_level, params, transform, vecs + begin, end - begin))
+            {
+                return;
+            }
+            for (size_t i = begin; i < end; ++i)
+            {
+                vecs[i] = func(vecs[i]);
+            }
+        });
+    }
+
     vec3<float> m_lo;      //!< Minimum coords in the box
     vec3<float> m_hi;      //!< Maximum coords in the box
     vec3<float> m_L;       //!< L precomputed (used to avoid subtractions in boundary conditions)
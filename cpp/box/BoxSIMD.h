@@ -0,0 +1,398 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOX_SIMD_H
+#define BOX_SIMD_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "SIMD.h"
+#include "VectorMath.h"
+
+#ifdef FREUD_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+/*! \file BoxSIMD.h
+    \brief Vectorized kernels for the coordinate transforms and distances of boxes.
+*/
+
+namespace freud { namespace box {
+
+//! Coordinate transforms of a Box with vectorized kernels.
+enum class BoxTransform
+{
+    wrap,           //!< Box::wrap
+    makeFractional, //!< Box::makeFractional
+    makeAbsolute    //!< Box::makeAbsolute
+};
+
+//! Parameters of a Box used by the vectorized kernels.
+struct BoxSIMDParameters
+{
+    vec3<float> lo;        //!< Minimum coordinates of the box
+    vec3<float> L;         //!< Box lengths
+    float xy;              //!< xy tilt factor
+    float xz;              //!< xz tilt factor
+    float yz;              //!< yz tilt factor
+    vec3<bool> periodic;   //!< Periodicity in each direction
+    bool is2D;             //!< Whether the box is 2D
+};
+
+/* The kernels below perform exactly the floating point operations of the
+ * scalar transforms in Box.h, in the same order, so that all SIMD levels give
+ * identical results. Fused multiply-adds would change the rounding, so the
+ * AVX2 kernels are compiled without FMA and the AVX-512 kernels use the
+ * explicitly rounded intrinsics, which compilers do not contract. The scalar
+ * code may still be contracted when the baseline build flags enable FMA (e.g.
+ * -march=native), in which case the results only agree up to rounding.
+ */
+#ifdef FREUD_SIMD_DISPATCH
+
+//! AVX2 version of util::modulusPositive(a, 1), exact for all finite values.
+FREUD_TARGET_AVX2 inline __m256 modulusPositiveAVX2(__m256 a)
+{
+    const __m256 remainder = _mm256_sub_ps(a, _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    const __m256 shifted = _mm256_add_ps(remainder, _mm256_set1_ps(1.0f));
+    return _mm256_sub_ps(shifted, _mm256_round_ps(shifted, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+//! Apply a coordinate transform to 8 vectors stored as separate x, y and z components.
+FREUD_TARGET_AVX2 inline void transformAVX2(const BoxSIMDParameters& box, BoxTransform transform, __m256& x,
+                                            __m256& y, __m256& z)
+{
+    if (transform == BoxTransform::wrap && !box.periodic.x && !box.periodic.y && !box.periodic.z)
+    {
+        return;
+    }
+
+    if (transform != BoxTransform::makeAbsolute)
+    {
+        const __m256 v_y = y;
+        const __m256 v_z = z;
+        __m256 delta_x = _mm256_sub_ps(x, _mm256_set1_ps(box.lo.x));
+        __m256 delta_y = _mm256_sub_ps(y, _mm256_set1_ps(box.lo.y));
+        const __m256 delta_z = _mm256_sub_ps(z, _mm256_set1_ps(box.lo.z));
+        const __m256 tilt_xz = _mm256_sub_ps(_mm256_set1_ps(box.xz),
+                                             _mm256_mul_ps(_mm256_set1_ps(box.yz), _mm256_set1_ps(box.xy)));
+        delta_x = _mm256_sub_ps(delta_x, _mm256_add_ps(_mm256_mul_ps(tilt_xz, v_z),
+                                                       _mm256_mul_ps(_mm256_set1_ps(box.xy), v_y)));
+        delta_y = _mm256_sub_ps(delta_y, _mm256_mul_ps(_mm256_set1_ps(box.yz), v_z));
+        x = _mm256_div_ps(delta_x, _mm256_set1_ps(box.L.x));
+        y = _mm256_div_ps(delta_y, _mm256_set1_ps(box.L.y));
+        z = box.is2D ? _mm256_setzero_ps() : _mm256_div_ps(delta_z, _mm256_set1_ps(box.L.z));
+    }
+
+    if (transform == BoxTransform::makeFractional)
+    {
+        return;
+    }
+
+    if (transform == BoxTransform::wrap)
+    {
+        if (box.periodic.x)
+        {
+            x = modulusPositiveAVX2(x);
+        }
+        if (box.periodic.y)
+        {
+            y = modulusPositiveAVX2(y);
+        }
+        if (!box.is2D && box.periodic.z)
+        {
+            z = modulusPositiveAVX2(z);
+        }
+    }
+
+    x = _mm256_add_ps(_mm256_set1_ps(box.lo.x), _mm256_mul_ps(x, _mm256_set1_ps(box.L.x)));
+    y = _mm256_add_ps(_mm256_set1_ps(box.lo.y), _mm256_mul_ps(y, _mm256_set1_ps(box.L.y)));
+    if (box.is2D)
+    {
+        z = _mm256_setzero_ps();
+        x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(box.xy), y));
+        return;
+    }
+    z = _mm256_add_ps(_mm256_set1_ps(box.lo.z), _mm256_mul_ps(z, _mm256_set1_ps(box.L.z)));
+    x = _mm256_add_ps(x, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(box.xy), y),
+                                       _mm256_mul_ps(_mm256_set1_ps(box.xz), z)));
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(box.yz), z));
+}
+
+//! Multiply two AVX-512 vectors without allowing contraction into fused multiply-adds.
+FREUD_TARGET_AVX512 inline __m512 mulAVX512(__m512 a, __m512 b)
+{
+    return _mm512_mul_round_ps(a, b, _MM_FROUND_CUR_DIRECTION);
+}
+
+//! Add two AVX-512 vectors without allowing contraction into fused multiply-adds.
+FREUD_TARGET_AVX512 inline __m512 addAVX512(__m512 a, __m512 b)
+{
+    return _mm512_add_round_ps(a, b, _MM_FROUND_CUR_DIRECTION);
+}
+
+//! Subtract two AVX-512 vectors without allowing contraction into fused multiply-adds.
+FREUD_TARGET_AVX512 inline __m512 subAVX512(__m512 a, __m512 b)
+{
+    return _mm512_sub_round_ps(a, b, _MM_FROUND_CUR_DIRECTION);
+}
+
+//! AVX-512 version of util::modulusPositive(a, 1), exact for all finite values.
+FREUD_TARGET_AVX512 inline __m512 modulusPositiveAVX512(__m512 a)
+{
+    const __m512 remainder = subAVX512(a, _mm512_roundscale_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    const __m512 shifted = addAVX512(remainder, _mm512_set1_ps(1.0f));
+    return subAVX512(shifted, _mm512_roundscale_ps(shifted, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+//! Apply a coordinate transform to 16 vectors stored as separate x, y and z components.
+FREUD_TARGET_AVX512 inline void transformAVX512(const BoxSIMDParameters& box, BoxTransform transform,
+                                                __m512& x, __m512& y, __m512& z)
+{
+    if (transform == BoxTransform::wrap && !box.periodic.x && !box.periodic.y && !box.periodic.z)
+    {
+        return;
+    }
+
+    if (transform != BoxTransform::makeAbsolute)
+    {
+        const __m512 v_y = y;
+        const __m512 v_z = z;
+        __m512 delta_x = subAVX512(x, _mm512_set1_ps(box.lo.x));
+        __m512 delta_y = subAVX512(y, _mm512_set1_ps(box.lo.y));
+        const __m512 delta_z = subAVX512(z, _mm512_set1_ps(box.lo.z));
+        const __m512 tilt_xz
+            = subAVX512(_mm512_set1_ps(box.xz), mulAVX512(_mm512_set1_ps(box.yz), _mm512_set1_ps(box.xy)));
+        delta_x = subAVX512(delta_x,
+                            addAVX512(mulAVX512(tilt_xz, v_z), mulAVX512(_mm512_set1_ps(box.xy), v_y)));
+        delta_y = subAVX512(delta_y, mulAVX512(_mm512_set1_ps(box.yz), v_z));
+        x = _mm512_div_round_ps(delta_x, _mm512_set1_ps(box.L.x), _MM_FROUND_CUR_DIRECTION);
+        y = _mm512_div_round_ps(delta_y, _mm512_set1_ps(box.L.y), _MM_FROUND_CUR_DIRECTION);
+        z = box.is2D ? _mm512_setzero_ps()
+                     : _mm512_div_round_ps(delta_z, _mm512_set1_ps(box.L.z), _MM_FROUND_CUR_DIRECTION);
+    }
+
+    if (transform == BoxTransform::makeFractional)
+    {
+        return;
+    }
+
+    if (transform == BoxTransform::wrap)
+    {
+        if (box.periodic.x)
+        {
+            x = modulusPositiveAVX512(x);
+        }
+        if (box.periodic.y)
+        {
+            y = modulusPositiveAVX512(y);
+        }
+        if (!box.is2D && box.periodic.z)
+        {
+            z = modulusPositiveAVX512(z);
+        }
+    }
+
+    x = addAVX512(_mm512_set1_ps(box.lo.x), mulAVX512(x, _mm512_set1_ps(box.L.x)));
+    y = addAVX512(_mm512_set1_ps(box.lo.y), mulAVX512(y, _mm512_set1_ps(box.L.y)));
+    if (box.is2D)
+    {
+        z = _mm512_setzero_ps();
+        x = addAVX512(x, mulAVX512(_mm512_set1_ps(box.xy), y));
+        return;
+    }
+    z = addAVX512(_mm512_set1_ps(box.lo.z), mulAVX512(z, _mm512_set1_ps(box.L.z)));
+    x = addAVX512(x, addAVX512(mulAVX512(_mm512_set1_ps(box.xy), y), mulAVX512(_mm512_set1_ps(box.xz), z)));
+    y = addAVX512(y, mulAVX512(_mm512_set1_ps(box.yz), z));
+}
+
+//! Apply a coordinate transform to an array of vectors with AVX2.
+FREUD_TARGET_AVX2 inline void transformVectorsAVX2(const BoxSIMDParameters& box, BoxTransform transform,
+                                                   vec3<float>* vecs, size_t n)
+{
+    alignas(32) float x[8];
+    alignas(32) float y[8];
+    alignas(32) float z[8];
+    for (size_t first = 0; first < n; first += 8)
+    {
+        const size_t count = std::min(size_t(8), n - first);
+        for (size_t k = 0; k < 8; ++k)
+        {
+            const vec3<float> v = (k < count) ? vecs[first + k] : vec3<float>(0, 0, 0);
+            x[k] = v.x;
+            y[k] = v.y;
+            z[k] = v.z;
+        }
+        __m256 x_v = _mm256_load_ps(x);
+        __m256 y_v = _mm256_load_ps(y);
+        __m256 z_v = _mm256_load_ps(z);
+        transformAVX2(box, transform, x_v, y_v, z_v);
+        _mm256_store_ps(x, x_v);
+        _mm256_store_ps(y, y_v);
+        _mm256_store_ps(z, z_v);
+        for (size_t k = 0; k < count; ++k)
+        {
+            vecs[first + k] = vec3<float>(x[k], y[k], z[k]);
+        }
+    }
+}
+
+//! Apply a coordinate transform to an array of vectors with AVX-512.
+FREUD_TARGET_AVX512 inline void transformVectorsAVX512(const BoxSIMDParameters& box, BoxTransform transform,
+                                                       vec3<float>* vecs, size_t n)
+{
+    alignas(64) float x[16];
+    alignas(64) float y[16];
+    alignas(64) float z[16];
+    for (size_t first = 0; first < n; first += 16)
+    {
+        const size_t count = std::min(size_t(16), n - first);
+        for (size_t k = 0; k < 16; ++k)
+        {
+            const vec3<float> v = (k < count) ? vecs[first + k] : vec3<float>(0, 0, 0);
+            x[k] = v.x;
+            y[k] = v.y;
+            z[k] = v.z;
+        }
+        __m512 x_v = _mm512_load_ps(x);
+        __m512 y_v = _mm512_load_ps(y);
+        __m512 z_v = _mm512_load_ps(z);
+        transformAVX512(box, transform, x_v, y_v, z_v);
+        _mm512_store_ps(x, x_v);
+        _mm512_store_ps(y, y_v);
+        _mm512_store_ps(z, z_v);
+        for (size_t k = 0; k < count; ++k)
+        {
+            vecs[first + k] = vec3<float>(x[k], y[k], z[k]);
+        }
+    }
+}
+
+//! Compute the wrapped distances from query points to points with AVX2 (see computeDistancesSIMD).
+FREUD_TARGET_AVX2 inline void computeDistancesAVX2(const BoxSIMDParameters& box,
+                                                   const vec3<float>* query_points, bool single_query_point,
+                                                   const vec3<float>* points, size_t n, float* distances)
+{
+    alignas(32) float x[8];
+    alignas(32) float y[8];
+    alignas(32) float z[8];
+    for (size_t first = 0; first < n; first += 8)
+    {
+        const size_t count = std::min(size_t(8), n - first);
+        for (size_t k = 0; k < 8; ++k)
+        {
+            vec3<float> delta(0, 0, 0);
+            if (k < count)
+            {
+                delta = points[first + k] - query_points[single_query_point ? 0 : first + k];
+            }
+            x[k] = delta.x;
+            y[k] = delta.y;
+            z[k] = delta.z;
+        }
+        __m256 x_v = _mm256_load_ps(x);
+        __m256 y_v = _mm256_load_ps(y);
+        __m256 z_v = _mm256_load_ps(z);
+        transformAVX2(box, BoxTransform::wrap, x_v, y_v, z_v);
+        const __m256 r_sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_v, x_v), _mm256_mul_ps(y_v, y_v)),
+                                          _mm256_mul_ps(z_v, z_v));
+        _mm256_store_ps(x, _mm256_sqrt_ps(r_sq));
+        std::copy(x, x + count, distances + first);
+    }
+}
+
+//! Compute the wrapped distances from query points to points with AVX-512 (see computeDistancesSIMD).
+FREUD_TARGET_AVX512 inline void computeDistancesAVX512(const BoxSIMDParameters& box,
+                                                       const vec3<float>* query_points,
+                                                       bool single_query_point, const vec3<float>* points,
+                                                       size_t n, float* distances)
+{
+    alignas(64) float x[16];
+    alignas(64) float y[16];
+    alignas(64) float z[16];
+    for (size_t first = 0; first < n; first += 16)
+    {
+        const size_t count = std::min(size_t(16), n - first);
+        for (size_t k = 0; k < 16; ++k)
+        {
+            vec3<float> delta(0, 0, 0);
+            if (k < count)
+            {
+                delta = points[first + k] - query_points[single_query_point ? 0 : first + k];
+            }
+            x[k] = delta.x;
+            y[k] = delta.y;
+            z[k] = delta.z;
+        }
+        __m512 x_v = _mm512_load_ps(x);
+        __m512 y_v = _mm512_load_ps(y);
+        __m512 z_v = _mm512_load_ps(z);
+        transformAVX512(box, BoxTransform::wrap, x_v, y_v, z_v);
+        const __m512 r_sq
+            = addAVX512(addAVX512(mulAVX512(x_v, x_v), mulAVX512(y_v, y_v)), mulAVX512(z_v, z_v));
+        _mm512_store_ps(x, _mm512_sqrt_round_ps(r_sq, _MM_FROUND_CUR_DIRECTION));
+        std::copy(x, x + count, distances + first);
+    }
+}
+
+#endif // FREUD_SIMD_DISPATCH
+
+//! Apply a coordinate transform to an array of vectors with the kernels of a SIMD level.
+/*! \param simd_level The SIMD level to use.
+ *  \param box Parameters of the box.
+ *  \param transform The transform to apply.
+ *  \param vecs The vectors to transform in place.
+ *  \param n The number of vectors.
+ *
+ *  \return Whether a kernel was available for the SIMD level. If not, the
+ *          vectors are unchanged and the caller must use the scalar transform.
+ */
+inline bool transformVectorsSIMD(util::SIMDLevel simd_level, const BoxSIMDParameters& box,
+                                 BoxTransform transform, vec3<float>* vecs, size_t n)
+{
+#ifdef FREUD_SIMD_DISPATCH
+    switch (simd_level)
+    {
+    case util::SIMDLevel::avx512:
+        transformVectorsAVX512(box, transform, vecs, n);
+        return true;
+    case util::SIMDLevel::avx2:
+        transformVectorsAVX2(box, transform, vecs, n);
+        return true;
+    default:
+        break;
+    }
+#endif
+    return false;
+}
+
+//! Compute the wrapped distances from query points to points with the kernels of a SIMD level.
+/*! Computes distances[i] = |wrap(points[i] - query_points[i])|, or
+ *  |wrap(points[i] - query_points[0])| if single_query_point is true.
+ *
+ *  \return Whether a kernel was available for the SIMD level. If not, the
+ *          distances are not written and the caller must compute them.
+ */
+inline bool computeDistancesSIMD(util::SIMDLevel simd_level, const BoxSIMDParameters& box,
+                                 const vec3<float>* query_points, bool single_query_point,
+                                 const vec3<float>* points, size_t n, float* distances)
+{
+#ifdef FREUD_SIMD_DISPATCH
+    switch (simd_level)
+    {
+    case util::SIMDLevel::avx512:
+        computeDistancesAVX512(box, query_points, single_query_point, points, n, distances);
+        return true;
+    case util::SIMDLevel::avx2:
+        computeDistancesAVX2(box, query_points, single_query_point, points, n, distances);
+        return true;
+    default:
+        break;
+    }
+#endif
+    return false;
+}
+
+}; }; // end namespace freud::box
+
+#endif // BOX_SIMD_H
@@ -2,7 +2,9 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <array>
 #include <numeric>
+#include <tbb/spin_mutex.h>
 
 #include "Cluster.h"
 #include "NeighborBond.h"
@@ -12,22 +14,246 @@
 //! Finds clusters using a network of neighbors.
 namespace freud { namespace cluster {
 
+namespace {
+
+//! Disjoint sets of points that track the periodic image of each point relative to its set.
+/*! This is a weighted union-find: each point stores the periodic image it
+ *  occupies relative to its parent, so that following the path to the root
+ *  gives its image relative to the root of its set. Uniting two points that
+ *  are already in the same set closes a loop of bonds, and the net image
+ *  vector around the loop is a lattice vector along which the set wraps
+ *  through the periodic boundaries. Each root keeps a basis of the lattice
+ *  spanned by these loops.
+ */
+class PeriodicDisjointSets
+{
+public:
+    //! Constructor
+    /*! \param size Number of points, each initially in its own set.
+     */
+    explicit PeriodicDisjointSets(unsigned int size)
+        : m_parent(size), m_rank(size, 0), m_image(size, vec3<int>(0, 0, 0)), m_num_loops(size, 0),
+          m_loops(size)
+    {
+        std::iota(m_parent.begin(), m_parent.end(), 0);
+    }
+
+    //! Find the root of a point's set, updating the point's image to be relative to the root.
+    unsigned int find(unsigned int id)
+    {
+        unsigned int root = id;
+        while (m_parent[root] != root)
+        {
+            root = m_parent[root];
+        }
+
+        // Compress the path, accumulating the images from the root down.
+        m_path.clear();
+        for (unsigned int node = id; m_parent[node] != root && node != root; node = m_parent[node])
+        {
+            m_path.push_back(node);
+        }
+        for (auto node = m_path.rbegin(); node != m_path.rend(); ++node)
+        {
+            m_image[*node] += m_image[m_parent[*node]];
+            m_parent[*node] = root;
+        }
+        return root;
+    }
+
+    //! Get the image of a point relative to the root of its set, which find must have been called on.
+    const vec3<int>& image(unsigned int id) const
+    {
+        return m_image[id];
+    }
+
+    //! Unite the sets of two points bonded across the given periodic image.
+    /*! \param id1 The first point.
+     *  \param id2 The second point.
+     *  \param bond_image The image of the second point's copy bonded to the first point.
+     */
+    void unite(unsigned int id1, unsigned int id2, const vec3<int>& bond_image)
+    {
+        const unsigned int root1 = find(id1);
+        const unsigned int root2 = find(id2);
+
+        // The image of root2 relative to root1 that places the copy of id2 next to id1.
+        const vec3<int> offset = m_image[id1] + bond_image - m_image[id2];
+        if (root1 == root2)
+        {
+            addLoop(root1, offset);
+            return;
+        }
+
+        unsigned int parent = root1;
+        unsigned int child = root2;
+        vec3<int> child_image = offset;
+        if (m_rank[root1] < m_rank[root2])
+        {
+            std::swap(parent, child);
+            child_image = -offset;
+        }
+        m_parent[child] = parent;
+        m_image[child] = child_image;
+        if (m_rank[parent] == m_rank[child])
+        {
+            ++m_rank[parent];
+        }
+        // Loops of the child set are unchanged by the shift of its origin.
+        for (unsigned int loop = 0; loop < m_num_loops[child]; ++loop)
+        {
+            addLoop(parent, m_loops[child][loop]);
+        }
+    }
+
+    //! Get the number of independent lattice vectors that the set of a root wraps along.
+    unsigned int rank(unsigned int root) const
+    {
+        return m_num_loops[root];
+    }
+
+    //! Get whether the set of a root wraps through the periodic boundaries along each box vector.
+    vec3<bool> wrapping(unsigned int root) const
+    {
+        vec3<bool> result(false, false, false);
+        for (unsigned int loop = 0; loop < m_num_loops[root]; ++loop)
+        {
+            const vec3<int>& v = m_loops[root][loop];
+            result.x = result.x || v.x != 0;
+            result.y = result.y || v.y != 0;
+            result.z = result.z || v.z != 0;
+        }
+        return result;
+    }
+
+private:
+    //! Add a loop vector to the lattice basis of a root, if it is linearly independent of the basis.
+    void addLoop(unsigned int root, const vec3<int>& v)
+    {
+        std::array<vec3<int>, 3>& loops = m_loops[root];
+        const unsigned int num_loops = m_num_loops[root];
+        bool independent;
+        if (num_loops == 0)
+        {
+            independent = v.x != 0 || v.y != 0 || v.z != 0;
+        }
+        else if (num_loops == 1)
+        {
+            const vec3<long long> c = cross(toLong(loops[0]), toLong(v));
+            independent = c.x != 0 || c.y != 0 || c.z != 0;
+        }
+        else if (num_loops == 2)
+        {
+            independent = dot(cross(toLong(loops[0]), toLong(loops[1])), toLong(v)) != 0;
+        }
+        else
+        {
+            independent = false;
+        }
+        if (independent)
+        {
+            loops[num_loops] = v;
+            ++m_num_loops[root];
+        }
+    }
+
+    static vec3<long long> toLong(const vec3<int>& v)
+    {
+        return vec3<long long>(v.x, v.y, v.z);
+    }
+
+    std::vector<unsigned int> m_parent;            //!< Parent of each point.
+    std::vector<unsigned int> m_rank;              //!< Upper bound of the height of each root's tree.
+    std::vector<vec3<int>> m_image;                //!< Image of each point relative to its parent.
+    std::vector<unsigned int> m_num_loops;         //!< Number of independent loops of each root.
+    std::vector<std::array<vec3<int>, 3>> m_loops; //!< Independent loop vectors of each root.
+    std::vector<unsigned int> m_path;              //!< Scratch space for path compression.
+};
+
+}; // end anonymous namespace
+
 void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
                       freud::locality::QueryArgs qargs, const unsigned int* keys)
 {
     const unsigned int num_points = nq->getNPoints();
     m_cluster_idx.prepare(num_points);
-    DisjointSets dj(num_points);
 
-    freud::locality::loopOverNeighbors(
-        nq, nq->getPoints(), num_points, qargs, nlist,
-        [&dj](const freud::locality::NeighborBond& neighbor_bond) {
-            // Merge the two sets using the disjoint set
-            if (!dj.same(neighbor_bond.point_idx, neighbor_bond.query_point_idx))
+    // The root of the set of each point, and the wrapping of the set of each root.
+    std::vector<unsigned int> roots(num_points);
+    std::vector<vec3<bool>> root_wrapping;
+    std::vector<unsigned int> root_rank;
+    if (m_detect_wrapping)
+    {
+        PeriodicDisjointSets dj(num_points);
+
+        // Each bond joins a query point to the periodic image of a point that
+        // the query found it through. NeighborLists do not record the images
+        // of their bonds, so their bonds join the minimum images of the points.
+        // The bonds are found in parallel, but the union-find tracking images
+        // is serial, so batches of bonds are merged one at a time. Distances
+        // are not used, so the query is not asked to compute their square roots.
+        if (nlist != NULL)
+        {
+            const box::Box& box = nq->getBox();
+            freud::locality::loopOverNeighbors(
+                nq, nq->getPoints(), num_points, qargs, nlist,
+                [&](const freud::locality::NeighborBond& neighbor_bond) {
+                    vec3<int> bond_image;
+                    box.wrap((*nq)[neighbor_bond.point_idx] - (*nq)[neighbor_bond.query_point_idx],
+                             bond_image);
+                    dj.unite(neighbor_bond.query_point_idx, neighbor_bond.point_idx, bond_image);
+                },
+                false);
+        }
+        else
+        {
+            tbb::spin_mutex mutex;
+            nq->queryBonds(
+                nq->getPoints(), num_points, qargs,
+                [&](const std::vector<freud::locality::NeighborBond>& bonds) {
+                    tbb::spin_mutex::scoped_lock lock(mutex);
+                    for (const freud::locality::NeighborBond& neighbor_bond : bonds)
+                    {
+                        dj.unite(neighbor_bond.query_point_idx, neighbor_bond.point_idx,
+                                 neighbor_bond.image);
+                    }
+                },
+                true, true);
+        }
+
+        root_wrapping.resize(num_points);
+        root_rank.resize(num_points);
+        for (unsigned int i = 0; i < num_points; i++)
+        {
+            roots[i] = dj.find(i);
+            if (roots[i] == i)
             {
-                dj.unite(neighbor_bond.point_idx, neighbor_bond.query_point_idx);
+                root_wrapping[i] = dj.wrapping(i);
+                root_rank[i] = dj.rank(i);
             }
-        });
+        }
+    }
+    else
+    {
+        DisjointSets dj(num_points);
+
+        // Distances are not used, so the query is not asked to compute their square roots.
+        freud::locality::loopOverNeighbors(
+            nq, nq->getPoints(), num_points, qargs, nlist,
+            [&dj](const freud::locality::NeighborBond& neighbor_bond) {
+                // Merge the two sets using the disjoint set
+                if (!dj.same(neighbor_bond.point_idx, neighbor_bond.query_point_idx))
+                {
+                    dj.unite(neighbor_bond.point_idx, neighbor_bond.query_point_idx);
+                }
+            },
+            true, true);
+
+        for (unsigned int i = 0; i < num_points; i++)
+        {
+            roots[i] = dj.find(i);
+        }
+    }
 
     // Done looping over points. All clusters are now determined.
     // Next, we renumber clusters from zero to num_clusters-1.
@@ -42,7 +268,7 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
     m_num_clusters = 0;
     for (size_t i = 0; i < num_points; i++)
     {
-        size_t s = dj.find(i);
+        size_t s = roots[i];
 
         // Label this cluster if we haven't seen it yet.
         if (cluster_label[s] == num_points)
@@ -71,6 +297,24 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
     // Clear the cluster keys
     m_cluster_keys = std::vector<std::vector<unsigned int>>(m_num_clusters, std::vector<unsigned int>());
 
+    // Record the periodic wrapping of each cluster from the loops found by its root.
+    if (m_detect_wrapping)
+    {
+        m_cluster_wrapping.prepare({m_num_clusters, 3});
+        m_cluster_wrapping_rank.prepare(m_num_clusters);
+        for (size_t i = 0; i < num_points; i++)
+        {
+            if (roots[i] == i)
+            {
+                const size_t cluster_idx = cluster_reindex[cluster_label[i]];
+                m_cluster_wrapping(cluster_idx, 0) = root_wrapping[i].x;
+                m_cluster_wrapping(cluster_idx, 1) = root_wrapping[i].y;
+                m_cluster_wrapping(cluster_idx, 2) = root_wrapping[i].z;
+                m_cluster_wrapping_rank[cluster_idx] = root_rank[i];
+            }
+        }
+    }
+
     /* Loop over all points, set their cluster ids and add them to a list of
      * sets. Each set contains all the keys that are part of that cluster. If
      * no keys are provided, the keys use point ids. Get the computed list
@@ -78,7 +322,7 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
      */
     for (size_t i = 0; i < num_points; i++)
     {
-        size_t s = dj.find(i);
+        size_t s = roots[i];
         size_t cluster_idx = cluster_reindex[cluster_label[s]];
         m_cluster_idx[i] = cluster_idx;
         unsigned int key = i;
@@ -36,17 +36,37 @@ namespace freud { namespace cluster {
  *  cluster_keys, as a list of lists. If keys are not provided, every point is
  *  assigned a key corresponding to its index, and cluster_keys contains the
  *  point ids present in each cluster.
+ *
+ *  While clustering, the periodic image of each point relative to the root
+ *  of its cluster is tracked through the union-find. A bond between two
+ *  points of the same cluster whose images disagree closes a loop that winds
+ *  through the periodic boundaries, so the cluster is infinite along the net
+ *  image vector of the loop. The box vectors along which each cluster wraps
+ *  and the rank of the lattice spanned by its loops are found in the same
+ *  pass, without replicating the system. Tracking images makes the union-find
+ *  serial, so it is only done when wrapping detection is requested; otherwise
+ *  the bonds are merged concurrently by a lock-free union-find. The image of each bond is the one
+ *  reported by the neighbor query, while the bonds of a NeighborList, which
+ *  does not record images, join the minimum images of their points.
  */
 class Cluster
 {
 public:
     //! Constructor
-    Cluster() {}
+    /*! \param detect_wrapping Whether to find the clusters that wrap through the periodic boundaries.
+     */
+    explicit Cluster(bool detect_wrapping = false) : m_detect_wrapping(detect_wrapping) {}
 
     //! Compute the point clusters.
     void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
                  freud::locality::QueryArgs qargs, const unsigned int* keys = NULL);
 
+    //! Get whether clusters that wrap through the periodic boundaries are found.
+    bool getDetectWrapping() const
+    {
+        return m_detect_wrapping;
+    }
+
     //! Get the total number of clusters.
     unsigned int getNumClusters() const
     {
@@ -65,10 +85,25 @@ public:
         return m_cluster_keys;
     }
 
+    //! Get whether each cluster wraps through the periodic boundaries along each box vector.
+    const util::ManagedArray<bool>& getClusterWrapping() const
+    {
+        return m_cluster_wrapping;
+    }
+
+    //! Get the number of independent lattice vectors along which each cluster wraps.
+    const util::ManagedArray<unsigned int>& getClusterWrappingRank() const
+    {
+        return m_cluster_wrapping_rank;
+    }
+
 private:
-    unsigned int m_num_clusters;                           //!< Number of clusters found
-    util::ManagedArray<unsigned int> m_cluster_idx;        //!< Cluster index for each point
-    std::vector<std::vector<unsigned int>> m_cluster_keys; //!< List of keys in each cluster
+    bool m_detect_wrapping;                                   //!< Whether to find wrapping clusters
+    unsigned int m_num_clusters;                              //!< Number of clusters found
+    util::ManagedArray<unsigned int> m_cluster_idx;           //!< Cluster index for each point
+    std::vector<std::vector<unsigned int>> m_cluster_keys;    //!< List of keys in each cluster
+    util::ManagedArray<bool> m_cluster_wrapping;              //!< Box vectors each cluster wraps along
+    util::ManagedArray<unsigned int> m_cluster_wrapping_rank; //!< Rank of the lattice of each cluster's loops
 
     // Returns inverse permutation of cluster indices, sorted from largest to
     // smallest. Adapted from
@@ -5,6 +5,7 @@
 
 #include "ClusterProperties.h"
 #include "NeighborComputeFunctional.h"
+#include "diagonalize.h"
 
 /*! \file ClusterProperties.cc
     \brief Routines for computing properties of point clusters.
@@ -16,9 +17,10 @@ namespace freud { namespace cluster {
     \param cluster_idx Index of which cluster each point belongs to
 
     compute loops over all points in the given array and determines the center
-    of mass of the cluster as well as the gyration tensor. These can be
-    accessed after the call to compute with getClusterCenters() and
-    getClusterGyrations().
+    of mass of the cluster as well as the gyration tensor and its
+    eigen-decomposition. These can be accessed after the call to compute with
+    getClusterCenters(), getClusterGyrations(),
+    getClusterGyrationEigenvalues() and getClusterGyrationEigenvectors().
 */
 
 void ClusterProperties::compute(const freud::locality::NeighborQuery* nq, const unsigned int* cluster_idx)
@@ -87,6 +89,10 @@ void ClusterProperties::compute(const freud::locality::NeighborQuery* nq, const
         m_cluster_gyrations(c, 2, 1) /= s;
         m_cluster_gyrations(c, 2, 2) /= s;
     }
+
+    // The principal moments and axes of all clusters are found in one batch.
+    util::diagonalize33SymmetricMatrices(m_cluster_gyrations, m_cluster_gyration_eigenvalues,
+                                         m_cluster_gyration_eigenvectors);
 }
 
 }; }; // end namespace freud::cluster
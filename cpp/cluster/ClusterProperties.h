@@ -19,11 +19,13 @@ namespace freud { namespace cluster {
     cluster:
      - Center of mass
      - Gyration tensor
+     - Principal moments and axes of the gyration tensor
 
     m_cluster_centers stores the computed center of mass for each cluster,
     properly handling periodic boundary conditions.
     m_cluster_gyrations stores a 3x3 gyration tensor for each cluster. The
-    tensors are symmetric.
+    tensors are symmetric, and their eigenvalues and eigenvectors are stored
+    in m_cluster_gyration_eigenvalues and m_cluster_gyration_eigenvectors.
 */
 class ClusterProperties
 {
@@ -46,6 +48,18 @@ public:
         return m_cluster_gyrations;
     }
 
+    //! Get a reference to the last computed eigenvalues of the cluster gyration tensors
+    const util::ManagedArray<float>& getClusterGyrationEigenvalues() const
+    {
+        return m_cluster_gyration_eigenvalues;
+    }
+
+    //! Get a reference to the last computed eigenvectors of the cluster gyration tensors
+    const util::ManagedArray<float>& getClusterGyrationEigenvectors() const
+    {
+        return m_cluster_gyration_eigenvectors;
+    }
+
     //! Get a reference to the last computed cluster size
     const util::ManagedArray<unsigned int>& getClusterSizes() const
     {
@@ -57,6 +71,10 @@ private:
         m_cluster_centers; //!< Center of mass computed for each cluster (length: m_num_clusters)
     util::ManagedArray<float>
         m_cluster_gyrations; //!< Gyration tensor computed for each cluster (m_num_clusters x 3 x 3 array)
+    util::ManagedArray<float>
+        m_cluster_gyration_eigenvalues; //!< Gyration tensor eigenvalues (m_num_clusters x 3 array)
+    util::ManagedArray<float>
+        m_cluster_gyration_eigenvectors; //!< Gyration tensor eigenvectors (m_num_clusters x 3 x 3 array)
     util::ManagedArray<unsigned int> m_cluster_sizes; //!< Size per cluster
 };
 
@@ -0,0 +1,376 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+
+#include "NeighborComputeFunctional.h"
+#include "RingStatistics.h"
+#include "utils.h"
+
+/*! \file RingStatistics.cc
+    \brief Routines for counting shortest-path rings of a network of neighbors.
+*/
+
+namespace freud { namespace cluster {
+
+namespace {
+
+//! Get a new stamp for a visitation buffer, clearing the buffer when the stamps run out.
+inline unsigned int nextStamp(std::vector<unsigned int>& stamps, unsigned int& stamp)
+{
+    if (++stamp == 0)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+    }
+    return stamp;
+}
+
+//! Finds the shortest-path rings of a network, with buffers reused for all searches of one thread.
+class RingSearch
+{
+public:
+    //! Constructor
+    /*! \param segments First neighbor of each point in neighbors.
+     *  \param counts Number of neighbors of each point.
+     *  \param neighbors Neighbors of all points.
+     *  \param n_points Number of points.
+     *  \param max_ring_size Largest number of points of the rings to find.
+     */
+    RingSearch(const unsigned int* segments, const unsigned int* counts, const unsigned int* neighbors,
+               unsigned int n_points, unsigned int max_ring_size)
+        : m_segments(segments), m_counts(counts), m_neighbors(neighbors), m_max_ring_size(max_ring_size),
+          m_visit_stamps(n_points, 0), m_distances(n_points, 0), m_visit_stamp(0), m_root_stamp(0),
+          m_search_stamps(n_points, 0), m_search_distances(n_points, 0), m_search_stamp(0),
+          m_ring_stamps(n_points, 0), m_ring_positions(n_points, 0), m_ring_stamp(0)
+    {}
+
+    //! Find the rings whose smallest point is root.
+    void findRings(unsigned int root)
+    {
+        // Breadth-first search among the points not smaller than the root.
+        // The points are queued in order of their distance from the root.
+        m_root_stamp = nextStamp(m_visit_stamps, m_visit_stamp);
+        const unsigned int max_depth = m_max_ring_size / 2;
+        m_queue.clear();
+        m_queue.push_back(root);
+        m_visit_stamps[root] = m_root_stamp;
+        m_distances[root] = 0;
+        for (size_t head = 0; head < m_queue.size(); ++head)
+        {
+            const unsigned int v = m_queue[head];
+            if (m_distances[v] == max_depth)
+            {
+                continue;
+            }
+            const unsigned int* v_neighbors_end = m_neighbors + m_segments[v] + m_counts[v];
+            for (const unsigned int* w = m_neighbors + m_segments[v]; w != v_neighbors_end; ++w)
+            {
+                if (*w > root && m_visit_stamps[*w] != m_root_stamp)
+                {
+                    m_visit_stamps[*w] = m_root_stamp;
+                    m_distances[*w] = m_distances[v] + 1;
+                    m_queue.push_back(*w);
+                }
+            }
+        }
+
+        for (size_t head = 1; head < m_queue.size(); ++head)
+        {
+            const unsigned int v = m_queue[head];
+            const unsigned int depth = m_distances[v];
+            bool found_paths = false;
+
+            // Rings with an even number of points are closed by two shortest
+            // paths from the root to v that share no other points.
+            if (depth >= 2 && 2 * depth <= m_max_ring_size)
+            {
+                findPaths(v, m_paths);
+                found_paths = true;
+                const size_t num_paths = m_paths.size() / (depth + 1);
+                for (size_t a = 0; a < num_paths; ++a)
+                {
+                    for (size_t b = a + 1; b < num_paths; ++b)
+                    {
+                        addRing(&m_paths[a * (depth + 1)], &m_paths[b * (depth + 1)], depth, depth - 1);
+                    }
+                }
+            }
+
+            // Rings with an odd number of points are closed by two shortest
+            // paths from the root to the ends of a bond between v and a larger
+            // point u at the same distance from the root.
+            if (2 * depth + 1 <= m_max_ring_size)
+            {
+                const unsigned int* v_neighbors_end = m_neighbors + m_segments[v] + m_counts[v];
+                for (const unsigned int* u = m_neighbors + m_segments[v]; u != v_neighbors_end; ++u)
+                {
+                    if (*u <= v || m_visit_stamps[*u] != m_root_stamp || m_distances[*u] != depth)
+                    {
+                        continue;
+                    }
+                    if (!found_paths)
+                    {
+                        findPaths(v, m_paths);
+                        found_paths = true;
+                    }
+                    findPaths(*u, m_other_paths);
+                    const size_t num_paths = m_paths.size() / (depth + 1);
+                    const size_t num_other_paths = m_other_paths.size() / (depth + 1);
+                    for (size_t a = 0; a < num_paths; ++a)
+                    {
+                        for (size_t b = 0; b < num_other_paths; ++b)
+                        {
+                            addRing(&m_paths[a * (depth + 1)], &m_other_paths[b * (depth + 1)], depth,
+                                    depth);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> ring_sizes;  //!< Number of points of each ring found.
+    std::vector<unsigned int> ring_points; //!< Points of all rings found.
+
+private:
+    //! Store all shortest paths from the root to a point of the last search.
+    /*! Each path is stored as the depth + 1 points at distances 0 to depth
+     *  from the root.
+     */
+    void findPaths(unsigned int target, std::vector<unsigned int>& paths)
+    {
+        paths.clear();
+        m_path.resize(m_distances[target] + 1);
+        extendPath(target, paths);
+    }
+
+    //! Prepend a point to the current path, and continue it with each neighbor closer to the root.
+    void extendPath(unsigned int v, std::vector<unsigned int>& paths)
+    {
+        const unsigned int distance = m_distances[v];
+        m_path[distance] = v;
+        if (distance == 0)
+        {
+            paths.insert(paths.end(), m_path.begin(), m_path.end());
+            return;
+        }
+        const unsigned int* v_neighbors_end = m_neighbors + m_segments[v] + m_counts[v];
+        for (const unsigned int* w = m_neighbors + m_segments[v]; w != v_neighbors_end; ++w)
+        {
+            if (m_visit_stamps[*w] == m_root_stamp && m_distances[*w] == distance - 1)
+            {
+                extendPath(*w, paths);
+            }
+        }
+    }
+
+    //! Join two shortest paths from the root into a ring, and keep it if it is a shortest-path ring.
+    /*! \param path Points of the first path, at distances 0 to depth from the root.
+     *  \param other_path Points of the second path, at distances 0 to depth from the root.
+     *  \param depth Length of the first path.
+     *  \param other_depth Length of the second path without its shared end, if any.
+     */
+    void addRing(const unsigned int* path, const unsigned int* other_path, unsigned int depth,
+                 unsigned int other_depth)
+    {
+        // Points of shortest paths at the same distance from the root can
+        // only coincide if they are at the same position of both paths.
+        for (unsigned int k = 1; k <= other_depth; ++k)
+        {
+            if (path[k] == other_path[k])
+            {
+                return;
+            }
+        }
+
+        m_ring.assign(path, path + depth + 1);
+        for (unsigned int k = other_depth; k >= 1; --k)
+        {
+            m_ring.push_back(other_path[k]);
+        }
+        if (isShortestPathRing())
+        {
+            ring_sizes.push_back(static_cast<unsigned int>(m_ring.size()));
+            ring_points.insert(ring_points.end(), m_ring.begin(), m_ring.end());
+        }
+    }
+
+    //! Check that no two points of the current ring are closer on the network than along the ring.
+    bool isShortestPathRing()
+    {
+        const unsigned int ring_size = static_cast<unsigned int>(m_ring.size());
+        // Any shortcut is shorter than the largest distance along the ring.
+        const unsigned int max_depth = ring_size / 2 - 1;
+        if (max_depth == 0)
+        {
+            return true;
+        }
+
+        const unsigned int ring_stamp = nextStamp(m_ring_stamps, m_ring_stamp);
+        for (unsigned int k = 0; k < ring_size; ++k)
+        {
+            m_ring_stamps[m_ring[k]] = ring_stamp;
+            m_ring_positions[m_ring[k]] = k;
+        }
+
+        // A shortcut between two points is found from either of them, so the
+        // last point need not be searched from.
+        for (unsigned int i = 0; i + 1 < ring_size; ++i)
+        {
+            const unsigned int search_stamp = nextStamp(m_search_stamps, m_search_stamp);
+            m_search_queue.clear();
+            m_search_queue.push_back(m_ring[i]);
+            m_search_stamps[m_ring[i]] = search_stamp;
+            m_search_distances[m_ring[i]] = 0;
+            for (size_t head = 0; head < m_search_queue.size(); ++head)
+            {
+                const unsigned int v = m_search_queue[head];
+                const unsigned int distance = m_search_distances[v] + 1;
+                if (distance > max_depth)
+                {
+                    continue;
+                }
+                const unsigned int* v_neighbors_end = m_neighbors + m_segments[v] + m_counts[v];
+                for (const unsigned int* w = m_neighbors + m_segments[v]; w != v_neighbors_end; ++w)
+                {
+                    if (m_search_stamps[*w] == search_stamp)
+                    {
+                        continue;
+                    }
+                    m_search_stamps[*w] = search_stamp;
+                    m_search_distances[*w] = distance;
+                    m_search_queue.push_back(*w);
+                    if (m_ring_stamps[*w] == ring_stamp)
+                    {
+                        const unsigned int j = m_ring_positions[*w];
+                        const unsigned int separation = (i < j) ? j - i : i - j;
+                        if (distance < std::min(separation, ring_size - separation))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    const unsigned int* m_segments;  //!< First neighbor of each point.
+    const unsigned int* m_counts;    //!< Number of neighbors of each point.
+    const unsigned int* m_neighbors; //!< Neighbors of all points.
+    unsigned int m_max_ring_size;    //!< Largest number of points of the rings to find.
+
+    std::vector<unsigned int> m_visit_stamps; //!< Stamp of the last search from a root reaching each point.
+    std::vector<unsigned int> m_distances;    //!< Distance of each point from the root.
+    std::vector<unsigned int> m_queue;        //!< Points reached from the root in order of distance.
+    unsigned int m_visit_stamp;               //!< Last stamp used for searches from a root.
+    unsigned int m_root_stamp;                //!< Stamp of the current search from a root.
+
+    std::vector<unsigned int> m_search_stamps;    //!< Stamp of the last shortcut search reaching each point.
+    std::vector<unsigned int> m_search_distances; //!< Distance of each point in the shortcut search.
+    std::vector<unsigned int> m_search_queue;     //!< Points reached in the shortcut search.
+    unsigned int m_search_stamp;                  //!< Last stamp used for shortcut searches.
+
+    std::vector<unsigned int> m_ring_stamps;    //!< Stamp of the last ring containing each point.
+    std::vector<unsigned int> m_ring_positions; //!< Position of each point in the current ring.
+    unsigned int m_ring_stamp;                  //!< Last stamp used for rings.
+
+    std::vector<unsigned int> m_path;        //!< Path being extended towards the root.
+    std::vector<unsigned int> m_paths;       //!< Shortest paths from the root to a point.
+    std::vector<unsigned int> m_other_paths; //!< Shortest paths from the root to a second point.
+    std::vector<unsigned int> m_ring;        //!< Points of the current ring in order.
+};
+
+}; // end anonymous namespace
+
+RingStatistics::RingStatistics(unsigned int max_ring_size) : m_max_ring_size(max_ring_size), m_num_rings(0)
+{
+    if (max_ring_size < 3)
+    {
+        throw std::invalid_argument("RingStatistics requires max_ring_size to be at least 3.");
+    }
+}
+
+void RingStatistics::compute(const locality::NeighborQuery* nq, const locality::NeighborList* nlist,
+                             locality::QueryArgs qargs)
+{
+    const unsigned int n_points = nq->getNPoints();
+
+    // This function requires a NeighborList object, so we always make one and store it locally.
+    m_nlist = locality::makeDefaultNlist(nq, nlist, nq->getPoints(), n_points, qargs);
+    m_nlist.validate(n_points, n_points);
+
+    // Bonds are undirected, so each bond is stored for both of its points.
+    const unsigned int num_bonds = m_nlist.getNumBonds();
+    const util::ArrayView<unsigned int, 2> bonds = m_nlist.getNeighbors().view<2>();
+    std::vector<unsigned int> segments(n_points + 1, 0);
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        if (bonds(bond, 0) != bonds(bond, 1))
+        {
+            ++segments[bonds(bond, 0) + 1];
+            ++segments[bonds(bond, 1) + 1];
+        }
+    }
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        segments[i + 1] += segments[i];
+    }
+    std::vector<unsigned int> neighbors(segments[n_points]);
+    std::vector<unsigned int> counts(n_points, 0);
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        const unsigned int i = bonds(bond, 0);
+        const unsigned int j = bonds(bond, 1);
+        if (i != j)
+        {
+            neighbors[segments[i] + counts[i]++] = j;
+            neighbors[segments[j] + counts[j]++] = i;
+        }
+    }
+
+    // Remove the bonds that appear in both directions in the neighbor list.
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto segment_begin = neighbors.begin() + segments[i];
+            const auto segment_end = segment_begin + counts[i];
+            std::sort(segment_begin, segment_end);
+            counts[i] = static_cast<unsigned int>(std::unique(segment_begin, segment_end) - segment_begin);
+        }
+    });
+
+    tbb::enumerable_thread_specific<RingSearch> searches([&]() {
+        return RingSearch(segments.data(), counts.data(), neighbors.data(), n_points, m_max_ring_size);
+    });
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        RingSearch& search = searches.local();
+        for (size_t i = begin; i < end; ++i)
+        {
+            search.findRings(i);
+        }
+    });
+
+    m_num_rings = 0;
+    m_ring_counts.prepare(m_max_ring_size + 1);
+    m_point_ring_counts.prepare({n_points, m_max_ring_size + 1});
+    for (const RingSearch& search : searches)
+    {
+        const unsigned int* ring_points = search.ring_points.data();
+        for (const unsigned int ring_size : search.ring_sizes)
+        {
+            ++m_ring_counts[ring_size];
+            for (unsigned int k = 0; k < ring_size; ++k)
+            {
+                ++m_point_ring_counts(ring_points[k], ring_size);
+            }
+            ring_points += ring_size;
+        }
+        m_num_rings += static_cast<unsigned int>(search.ring_sizes.size());
+    }
+}
+
+}; }; // end namespace freud::cluster
@@ -0,0 +1,93 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef RING_STATISTICS_H
+#define RING_STATISTICS_H
+
+#include <vector>
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file RingStatistics.h
+    \brief Routines for counting shortest-path rings of a network of neighbors.
+*/
+
+namespace freud { namespace cluster {
+
+//! Counts the shortest-path rings of a network of neighbors.
+/*! The network is the undirected graph whose edges are the bonds of the
+ *  neighbor list. A ring is a closed path that visits no point twice, and it
+ *  is a shortest-path ring (Franzblau, Phys. Rev. B 44, 1991) if the shortest
+ *  path on the network between any two of its points runs along the ring. For
+ *  example, every ring of a honeycomb lattice is a hexagon, and the
+ *  12-membered paths around pairs of adjacent hexagons are not rings.
+ *
+ *  Rings are enumerated from every point in parallel. A ring is found from
+ *  its smallest point s by a breadth-first search of depth max_ring_size / 2
+ *  among the points not smaller than s: the two halves of a ring with an even
+ *  number of points are shortest paths from s to the opposite point, and the
+ *  two halves of a ring with an odd number of points are shortest paths from s
+ *  to the two ends of the opposite bond. Each candidate ring is then checked
+ *  for shortcuts with bounded breadth-first searches from its points. Since
+ *  every ring is only found from its smallest point, it is counted once. All
+ *  breadth-first searches use visitation buffers allocated once per thread.
+ */
+class RingStatistics
+{
+public:
+    //! Constructor
+    /*! \param max_ring_size The largest number of points of the rings to count.
+     */
+    RingStatistics(unsigned int max_ring_size = 12);
+
+    //! Destructor
+    ~RingStatistics() {}
+
+    //! Count the rings of the network of neighbors.
+    void compute(const locality::NeighborQuery* nq, const locality::NeighborList* nlist,
+                 locality::QueryArgs qargs);
+
+    //! Get the largest number of points of the rings counted.
+    unsigned int getMaxRingSize() const
+    {
+        return m_max_ring_size;
+    }
+
+    //! Get the total number of rings counted.
+    unsigned int getNumRings() const
+    {
+        return m_num_rings;
+    }
+
+    //! Get the number of rings of each size, indexed by the number of points of the ring.
+    const util::ManagedArray<unsigned int>& getRingCounts() const
+    {
+        return m_ring_counts;
+    }
+
+    //! Get the number of rings of each size that each point belongs to.
+    const util::ManagedArray<unsigned int>& getPointRingCounts() const
+    {
+        return m_point_ring_counts;
+    }
+
+    //! Return a pointer to the NeighborList used in the last call to compute.
+    locality::NeighborList* getNList()
+    {
+        return &m_nlist;
+    }
+
+private:
+    unsigned int m_max_ring_size;   //!< Largest number of points of the rings to count.
+    unsigned int m_num_rings;       //!< Total number of rings counted.
+    locality::NeighborList m_nlist; //!< The NeighborList used in the last call to compute.
+
+    util::ManagedArray<unsigned int> m_ring_counts;       //!< Number of rings of each size.
+    util::ManagedArray<unsigned int> m_point_ring_counts; //!< Number of rings of each size per point.
+};
+
+}; }; // end namespace freud::cluster
+
+#endif // RING_STATISTICS_H
@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
 #include "GaussianDensity.h"
 
@@ -79,7 +80,14 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq)
     const float dimensions = m_box.is2D() ? 2.0f : 3.0f;
     const float normalization = std::pow(normalization_base, dimensions);
 
+    // The displacements to the bins of each row are wrapped together, so
+    // that the vectorized wrapping kernels can be used.
+    const util::SIMDLevel simd_level = util::getSIMDLevel();
+
     util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        const util::ArrayView<float, 3> bin_counts = local_bin_counts.local().view<3>();
+        std::vector<vec3<float>> row_deltas;
+        std::vector<unsigned int> row_bins;
         // for each reference point
         for (size_t idx = begin; idx < end; ++idx)
         {
@@ -113,6 +121,8 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq)
                     }
                     const float dy = float((grid_size_y * j + grid_size_y / 2.0f) - point.y - Ly / 2.0f);
 
+                    row_deltas.clear();
+                    row_bins.clear();
                     for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
                     {
                         if (!periodic.x && (i < 0 || i >= int(m_width.x)))
@@ -120,11 +130,21 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq)
                             continue;
                         }
                         const float dx = float((grid_size_x * i + grid_size_x / 2.0f) - point.x - Lx / 2.0f);
+                        row_deltas.emplace_back(dx, dy, dz);
 
-                        // Calculate the distance from the particle to the grid cell
-                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                        // Assure that out of range indices are corrected for storage
+                        // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                        row_bins.push_back((i + m_width.x) % m_width.x);
+                    }
 
-                        const float r_sq = dot(delta, delta);
+                    // Calculate the distances from the particle to the grid cells
+                    m_box.wrap(row_deltas.data(), static_cast<unsigned int>(row_deltas.size()), simd_level);
+
+                    const unsigned int nj = (j + m_width.y) % m_width.y;
+                    const unsigned int nk = (k + m_width.z) % m_width.z;
+                    for (size_t n = 0; n < row_deltas.size(); ++n)
+                    {
+                        const float r_sq = dot(row_deltas[n], row_deltas[n]);
 
                         // Check to see if this distance is within the specified r_max
                         if (r_sq < r_max_sq)
@@ -132,14 +152,8 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq)
                             // Evaluate the gaussian
                             const float gaussian = normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
 
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
-                            const unsigned int nj = (j + m_width.y) % m_width.y;
-                            const unsigned int nk = (k + m_width.z) % m_width.z;
-
                             // Store the gaussian contribution
-                            local_bin_counts.local()(ni, nj, nk) += gaussian;
+                            bin_counts(row_bins[n], nj, nk) += gaussian;
                         }
                     }
                 }
@@ -0,0 +1,196 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "NumberVariance.h"
+#include "ThreadStorage.h"
+#include "utils.h"
+
+/*! \file NumberVariance.cc
+    \brief Routines for computing the variance of the number of points in windows of many sizes.
+*/
+
+namespace freud { namespace density {
+
+namespace {
+
+//! Mix the bits of a 64-bit integer (the finalizer of the splitmix64 generator).
+inline uint64_t mixBits(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+//! Find the grid cell of a coordinate, wrapping it into the box.
+inline unsigned int wrapCell(float fraction, unsigned int width)
+{
+    const int cell = static_cast<int>(std::floor(fraction * width)) % static_cast<int>(width);
+    return static_cast<unsigned int>(cell < 0 ? cell + static_cast<int>(width) : cell);
+}
+
+}; // end anonymous namespace
+
+NumberVariance::NumberVariance(vec3<unsigned int> width, unsigned int num_samples, unsigned int seed)
+    : m_box(), m_width(width), m_num_samples(num_samples), m_seed(seed)
+{
+    if (width.x == 0 || width.y == 0 || width.z == 0)
+    {
+        throw std::invalid_argument("NumberVariance requires at least one grid cell in each dimension.");
+    }
+}
+
+void NumberVariance::compute(const freud::locality::NeighborQuery* nq)
+{
+    m_box = nq->getBox();
+    const bool is2D = m_box.is2D();
+    const unsigned int wx = m_width.x;
+    const unsigned int wy = m_width.y;
+    const unsigned int wz = is2D ? 1 : m_width.z;
+    const unsigned int num_sizes = std::min(wx, is2D ? wy : std::min(wy, wz)) - 1;
+    if (num_sizes == 0)
+    {
+        throw std::invalid_argument(
+            "NumberVariance requires a grid at least two cells wide in each dimension of the box.");
+    }
+
+    // The summed-area table has an extra leading row of zeros in each
+    // dimension, so that table(i, j, k) is the number of points in the cells
+    // [0, i) x [0, j) x [0, k).
+    util::ManagedArray<unsigned int> table({wx + 1, wy + 1, wz + 1});
+    const util::ArrayView<unsigned int, 3> sums = table.view<3>();
+    const unsigned int n_points = nq->getNPoints();
+    for (unsigned int idx = 0; idx < n_points; ++idx)
+    {
+        const vec3<float> fraction = m_box.makeFractional((*nq)[idx]);
+        const unsigned int k = is2D ? 0 : wrapCell(fraction.z, wz);
+        ++sums(wrapCell(fraction.x, wx) + 1, wrapCell(fraction.y, wy) + 1, k + 1);
+    }
+
+    // Accumulate the counts along each dimension in turn, in parallel over the other two.
+    util::forLoopWrapper(0, (wy + 1) * (wz + 1), [&](size_t begin, size_t end) {
+        for (size_t jk = begin; jk < end; ++jk)
+        {
+            for (unsigned int i = 1; i <= wx; ++i)
+            {
+                sums(i, jk / (wz + 1), jk % (wz + 1)) += sums(i - 1, jk / (wz + 1), jk % (wz + 1));
+            }
+        }
+    });
+    util::forLoopWrapper(0, (wx + 1) * (wz + 1), [&](size_t begin, size_t end) {
+        for (size_t ik = begin; ik < end; ++ik)
+        {
+            for (unsigned int j = 1; j <= wy; ++j)
+            {
+                sums(ik / (wz + 1), j, ik % (wz + 1)) += sums(ik / (wz + 1), j - 1, ik % (wz + 1));
+            }
+        }
+    });
+    util::forLoopWrapper(0, (wx + 1) * (wy + 1), [&](size_t begin, size_t end) {
+        for (size_t ij = begin; ij < end; ++ij)
+        {
+            for (unsigned int k = 1; k <= wz; ++k)
+            {
+                sums(ij / (wy + 1), ij % (wy + 1), k) += sums(ij / (wy + 1), ij % (wy + 1), k - 1);
+            }
+        }
+    });
+
+    // The number of points in [0, x) x [0, y) x [0, z) of the periodic grid
+    // for coordinates up to twice the width, split into a whole period and a
+    // remainder along each dimension that exceeds the width.
+    auto periodicSum = [&](unsigned int x, unsigned int y, unsigned int z) {
+        const unsigned int xs[2] = {std::min(x, wx), x > wx ? x - wx : 0};
+        const unsigned int ys[2] = {std::min(y, wy), y > wy ? y - wy : 0};
+        const unsigned int zs[2] = {std::min(z, wz), z > wz ? z - wz : 0};
+        unsigned int sum = 0;
+        for (unsigned int a = 0; a < (x > wx ? 2u : 1u); ++a)
+        {
+            for (unsigned int b = 0; b < (y > wy ? 2u : 1u); ++b)
+            {
+                for (unsigned int c = 0; c < (z > wz ? 2u : 1u); ++c)
+                {
+                    sum += sums(xs[a], ys[b], zs[c]);
+                }
+            }
+        }
+        return sum;
+    };
+
+    // Deviations from the mean number of points in a window are accumulated
+    // so that the variance does not cancel against the squared mean.
+    const size_t num_cells = size_t(wx) * wy * wz;
+    const size_t num_windows = (m_num_samples == 0) ? num_cells : m_num_samples;
+    const float cell_volume = m_box.getVolume() / num_cells;
+    m_window_widths.prepare(num_sizes);
+    m_window_volumes.prepare(num_sizes);
+    std::vector<double> expected_counts(num_sizes);
+    for (unsigned int size = 0; size < num_sizes; ++size)
+    {
+        const unsigned int window_width = size + 1;
+        const unsigned int window_cells = window_width * window_width * (is2D ? 1 : window_width);
+        m_window_widths[size] = window_width;
+        m_window_volumes[size] = cell_volume * window_cells;
+        expected_counts[size] = double(n_points) * window_cells / num_cells;
+    }
+
+    util::ThreadStorage<double> local_deviations(num_sizes);
+    util::ThreadStorage<double> local_squared_deviations(num_sizes);
+    util::forLoopWrapper2D(
+        0, num_sizes, 0, num_windows, [&](size_t begin_size, size_t end_size, size_t begin, size_t end) {
+            util::ManagedArray<double>& deviations = local_deviations.local();
+            util::ManagedArray<double>& squared_deviations = local_squared_deviations.local();
+            for (size_t size = begin_size; size < end_size; ++size)
+            {
+                const unsigned int a = static_cast<unsigned int>(size) + 1;
+                const unsigned int c = is2D ? 1 : a;
+                for (size_t window = begin; window < end; ++window)
+                {
+                    unsigned int i, j, k;
+                    if (m_num_samples == 0)
+                    {
+                        i = static_cast<unsigned int>(window / (size_t(wy) * wz));
+                        j = static_cast<unsigned int>((window / wz) % wy);
+                        k = static_cast<unsigned int>(window % wz);
+                    }
+                    else
+                    {
+                        const uint64_t key = mixBits((uint64_t(m_seed) << 32 | size) ^ mixBits(window));
+                        i = static_cast<unsigned int>(key % wx);
+                        j = static_cast<unsigned int>(mixBits(key) % wy);
+                        k = static_cast<unsigned int>(mixBits(key + 1) % wz);
+                    }
+
+                    // Inclusion-exclusion over the corners of the window.
+                    const unsigned int count = periodicSum(i + a, j + a, k + c) - periodicSum(i, j + a, k + c)
+                        - periodicSum(i + a, j, k + c) - periodicSum(i + a, j + a, k)
+                        + periodicSum(i, j, k + c) + periodicSum(i, j + a, k) + periodicSum(i + a, j, k)
+                        - periodicSum(i, j, k);
+                    const double deviation = count - expected_counts[size];
+                    deviations[size] += deviation;
+                    squared_deviations[size] += deviation * deviation;
+                }
+            }
+        });
+
+    util::ManagedArray<double> deviations(num_sizes);
+    util::ManagedArray<double> squared_deviations(num_sizes);
+    local_deviations.reduceInto(deviations);
+    local_squared_deviations.reduceInto(squared_deviations);
+    m_mean_counts.prepare(num_sizes);
+    m_variances.prepare(num_sizes);
+    for (unsigned int size = 0; size < num_sizes; ++size)
+    {
+        const double mean_deviation = deviations[size] / num_windows;
+        m_mean_counts[size] = static_cast<float>(expected_counts[size] + mean_deviation);
+        m_variances[size]
+            = static_cast<float>(squared_deviations[size] / num_windows - mean_deviation * mean_deviation);
+    }
+}
+
+}; }; // end namespace freud::density
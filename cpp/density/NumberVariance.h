@@ -0,0 +1,109 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef NUMBER_VARIANCE_H
+#define NUMBER_VARIANCE_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file NumberVariance.h
+    \brief Routines for computing the variance of the number of points in windows of many sizes.
+*/
+
+namespace freud { namespace density {
+
+//! Computes the variance of the number of points in windows of many sizes.
+/*! The points are counted on a periodic grid, from which a summed-area table
+    is built once, so that the number of points in any window of whole grid
+    cells is found from a few table lookups regardless of its size. Window k
+    spans k grid cells along each dimension of the box (the x and y
+    dimensions in 2D), for k from 1 to one less than the smallest width of the
+    grid, and windows wrap around the periodic boundaries.
+
+    For each window size, the windows are either placed at every grid cell or
+    at num_samples randomly chosen grid cells. Random positions are derived
+    from the seed, the window size and the sample index, so the samples do
+    not depend on how they are distributed among threads.
+*/
+class NumberVariance
+{
+public:
+    //! Constructor
+    /*! \param width Number of grid cells in each dimension.
+     *  \param num_samples Number of windows of each size to sample, or 0 to place windows at every grid cell.
+     *  \param seed Seed of the random window positions.
+     */
+    NumberVariance(vec3<unsigned int> width, unsigned int num_samples = 0, unsigned int seed = 0);
+
+    //! Destructor
+    ~NumberVariance() {}
+
+    //! Get the simulation box.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+    //! Get the number of grid cells in each dimension.
+    vec3<unsigned int> getWidth() const
+    {
+        return m_width;
+    }
+
+    //! Get the number of windows of each size sampled, or 0 if windows are placed at every grid cell.
+    unsigned int getNumSamples() const
+    {
+        return m_num_samples;
+    }
+
+    //! Get the seed of the random window positions.
+    unsigned int getSeed() const
+    {
+        return m_seed;
+    }
+
+    //! Compute the variance of the number of points in windows of all sizes.
+    void compute(const freud::locality::NeighborQuery* nq);
+
+    //! Get the number of grid cells spanned by each window size along each dimension.
+    const util::ManagedArray<unsigned int>& getWindowWidths() const
+    {
+        return m_window_widths;
+    }
+
+    //! Get the volume (area in 2D) of each window size.
+    const util::ManagedArray<float>& getWindowVolumes() const
+    {
+        return m_window_volumes;
+    }
+
+    //! Get the mean number of points in the windows of each size.
+    const util::ManagedArray<float>& getMeanCounts() const
+    {
+        return m_mean_counts;
+    }
+
+    //! Get the variance of the number of points in the windows of each size.
+    const util::ManagedArray<float>& getVariances() const
+    {
+        return m_variances;
+    }
+
+private:
+    box::Box m_box;             //!< Simulation box containing the points.
+    vec3<unsigned int> m_width; //!< Number of grid cells in each dimension.
+    unsigned int m_num_samples; //!< Number of windows of each size to sample.
+    unsigned int m_seed;        //!< Seed of the random window positions.
+
+    util::ManagedArray<unsigned int> m_window_widths; //!< Grid cells spanned by each window size.
+    util::ManagedArray<float> m_window_volumes;       //!< Volume of each window size.
+    util::ManagedArray<float> m_mean_counts;          //!< Mean number of points in each window size.
+    util::ManagedArray<float> m_variances;            //!< Variance of the number of points per window size.
+};
+
+}; }; // end namespace freud::density
+
+#endif // NUMBER_VARIANCE_H
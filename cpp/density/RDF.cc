@@ -1,9 +1,17 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
 #include <stdexcept>
 
+#include "AABBQuery.h"
 #include "RDF.h"
+#include "ThreadStorage.h"
 
 /*! \file RDF.cc
     \brief Routines for computing radial density functions.
@@ -11,8 +19,8 @@
 
 namespace freud { namespace density {
 
-RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
-    : BondHistogramCompute(), m_normalize(normalize)
+RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize, bool log_bins)
+    : BondHistogramCompute(), m_normalize(normalize), m_n_sampled_query_points(0), m_sampled_frames(0)
 {
     if (bins == 0)
         throw std::invalid_argument("RDF requires a nonzero number of bins.");
@@ -20,12 +28,39 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
         throw std::invalid_argument("RDF requires r_max to be positive.");
     if (r_max <= r_min)
         throw std::invalid_argument("RDF requires that r_max must be greater than r_min.");
+    if (log_bins && r_min <= 0.0f)
+        throw std::invalid_argument("RDF requires r_min to be positive for logarithmic bins.");
+
+    if (log_bins)
+    {
+        setAxis(std::make_shared<util::LogAxis>(bins, r_min, r_max));
+    }
+    else
+    {
+        setAxis(std::make_shared<util::RegularAxis>(bins, r_min, r_max));
+    }
+}
+
+RDF::RDF(const std::vector<float>& bin_edges, bool normalize)
+    : BondHistogramCompute(), m_normalize(normalize), m_n_sampled_query_points(0), m_sampled_frames(0)
+{
+    if (!bin_edges.empty() && bin_edges.front() < 0.0f)
+        throw std::invalid_argument("RDF requires the bin edges to be non-negative.");
+
+    setAxis(std::make_shared<util::IrregularAxis>(bin_edges));
+}
+
+void RDF::setAxis(std::shared_ptr<util::Axis> axis)
+{
+    const size_t bins = axis->size();
 
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
     BHAxes axes;
-    axes.push_back(std::make_shared<util::RegularAxis>(bins, r_min, r_max));
+    axes.push_back(axis);
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_squared_binner = util::SquaredDistanceBinner(*axes[0]);
+    m_relative_error.prepare(bins);
 
     // Precompute the cell volumes to speed up later calculations.
     m_vol_array2D.prepare(bins);
@@ -33,7 +68,7 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
     float volume_prefactor = (float(4.0) / float(3.0)) * M_PI;
     std::vector<float> bin_boundaries = getBinEdges()[0];
 
-    for (unsigned int i = 0; i < bins; i++)
+    for (size_t i = 0; i < bins; i++)
     {
         float r = bin_boundaries[i];
         float nextr = bin_boundaries[i + 1];
@@ -42,6 +77,12 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
     }
 }
 
+void RDF::reset()
+{
+    BondHistogramCompute::reset();
+    m_sampled_frames = 0;
+}
+
 void RDF::reduce()
 {
     m_pcf.prepare(getAxisSizes()[0]);
@@ -55,7 +96,7 @@ void RDF::reduce()
         number_density *= static_cast<float>(m_n_query_points - 1) / (m_n_query_points);
     }
     float np = static_cast<float>(m_n_points);
-    float prefactor = float(1.0) / (np * number_density * m_frame_counter);
+    float prefactor = float(1.0) / (np * number_density * m_sampled_frames);
 
     util::ManagedArray<float> vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
     m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &vol_array](size_t i) {
@@ -64,7 +105,7 @@ void RDF::reduce()
 
     // The accumulation of the cumulative density must be performed in
     // sequence, so it is done after the reduction.
-    prefactor = float(1.0) / (np * m_frame_counter);
+    prefactor = float(1.0) / (np * m_sampled_frames);
     m_N_r[0] = m_histogram[0] * prefactor;
     for (unsigned int i = 1; i < getAxisSizes()[0]; i++)
     {
@@ -76,10 +117,702 @@ void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const
                      unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                      freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
-                          m_local_histograms(neighbor_bond.distance);
-                      });
+    // Bonds are binned from their squared distances, so queries skip the square roots.
+    accumulateGeneral(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [=](const freud::locality::NeighborBond& neighbor_bond) {
+            m_local_histograms.increment(m_squared_binner.bin(neighbor_bond.distance));
+        },
+        true);
+    m_relative_error.prepare(getAxisSizes()[0]);
+    m_n_sampled_query_points = n_query_points;
+    m_sampled_frames += 1;
+}
+
+namespace {
+
+//! Order a range of points so that every prefix alternates between the two halves of the range.
+/*! The halves are ordered the same way recursively, and which of them comes
+ *  first is chosen at random.
+ *
+ *  \param points The range of points.
+ *  \param n_points The number of points in the range.
+ *  \param rng The random number generator.
+ *  \param order Set to the order of the points.
+ *  \param scratch Scratch space for n_points points, separate from order.
+ */
+void alternatingOrder(const unsigned int* points, unsigned int n_points, std::mt19937& rng,
+                      unsigned int* order, unsigned int* scratch)
+{
+    if (n_points == 1)
+    {
+        order[0] = points[0];
+        return;
+    }
+
+    // Each half is ordered into the scratch space, using the output as its scratch space.
+    const unsigned int n_left = n_points / 2;
+    const unsigned int n_right = n_points - n_left;
+    alternatingOrder(points, n_left, rng, scratch, order);
+    alternatingOrder(points + n_left, n_right, rng, scratch + n_left, order + n_left);
+
+    const unsigned int* first = scratch;
+    const unsigned int* second = scratch + n_left;
+    unsigned int n_first = n_left;
+    unsigned int n_second = n_right;
+    if (rng() & 1u)
+    {
+        std::swap(first, second);
+        std::swap(n_first, n_second);
+    }
+    unsigned int i = 0;
+    for (unsigned int point = 0; point < std::max(n_first, n_second); ++point)
+    {
+        if (point < n_first)
+        {
+            order[i++] = first[point];
+        }
+        if (point < n_second)
+        {
+            order[i++] = second[point];
+        }
+    }
+}
+
+//! Order points so that every prefix of the order is a stratified random sample of the points.
+/*! The points are sorted along a Morton curve of their fractional
+ *  coordinates, which splits them hierarchically into spatially compact
+ *  ranges of equal numbers of points, and the order alternates between the
+ *  two halves of every range. A prefix of m points therefore holds, within
+ *  two points, its proportional share of each of the 2^k ranges at level k
+ *  of the hierarchy. In particular, it holds about one random point of each
+ *  of m ranges of N / m neighboring points.
+ */
+std::vector<unsigned int> stratifiedOrder(const box::Box& box, const vec3<float>* points,
+                                          unsigned int n_points, unsigned int seed)
+{
+    // Sort the points by their Morton codes, with ties broken by index.
+    std::vector<uint64_t> keys(n_points);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        const uint64_t code = locality::mortonCode(box.makeFractional(points[i]), box.is2D());
+        keys[i] = (code << 32) | i;
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<unsigned int> sorted_points(n_points);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        sorted_points[i] = static_cast<unsigned int>(keys[i] & 0xffffffff);
+    }
+
+    std::vector<unsigned int> order(n_points);
+    if (n_points > 0)
+    {
+        std::mt19937 rng(seed);
+        std::vector<unsigned int> scratch(n_points);
+        alternatingOrder(sorted_points.data(), n_points, rng, order.data(), scratch.data());
+    }
+    return order;
+}
+
+}; // end anonymous namespace
+
+void RDF::accumulateSubsampled(const freud::locality::NeighborQuery* neighbor_query,
+                               const vec3<float>* query_points, unsigned int n_query_points,
+                               freud::locality::QueryArgs qargs, float max_fraction, float target_error,
+                               unsigned int seed)
+{
+    if (!(max_fraction > 0 && max_fraction <= 1))
+        throw std::invalid_argument("RDF requires the fraction of sampled query points to be in (0, 1].");
+
+    m_box = neighbor_query->getBox();
+    const size_t bins = getAxisSizes()[0];
+    const unsigned int num_groups = NUM_ERROR_GROUPS;
+    const unsigned int initial_sample_size = INITIAL_SAMPLE_SIZE;
+    const double max_sampled_count = std::ceil(max_fraction * double(n_query_points));
+    const unsigned int max_sampled
+        = std::max(1u, std::min(n_query_points, static_cast<unsigned int>(max_sampled_count)));
+    const std::vector<unsigned int> order = stratifiedOrder(m_box, query_points, n_query_points, seed);
+    std::shared_ptr<locality::NeighborQueryIterator> iter
+        = neighbor_query->query(query_points, n_query_points, qargs);
+
+    // Bond counts are kept separately for interleaved groups of the sampled
+    // query points, whose spread gives the error of the combined counts.
+    util::ThreadStorage<unsigned int> local_group_counts({num_groups, bins});
+    util::ManagedArray<unsigned int> group_counts({num_groups, bins});
+    m_relative_error.prepare(bins);
+
+    unsigned int num_sampled = 0;
+    unsigned int next_num_sampled
+        = (target_error > 0) ? std::min(max_sampled, initial_sample_size) : max_sampled;
+    while (true)
+    {
+        util::forLoopWrapper(num_sampled, next_num_sampled, [&](size_t begin, size_t end) {
+            util::ManagedArray<unsigned int>& counts = local_group_counts.local();
+            for (size_t sample = begin; sample < end; ++sample)
+            {
+                // Successive samples alternate between the halves of the
+                // points, so the groups are offset by one every round to
+                // keep each group from sampling a fixed region.
+                const size_t group = (sample + sample / num_groups) % num_groups;
+                std::shared_ptr<locality::NeighborQueryPerPointIterator> it = iter->query(order[sample]);
+                // Iterators that cannot skip the square roots have their distances squared.
+                const bool square_distances = !it->useSquaredDistances();
+                while (!it->end())
+                {
+                    locality::NeighborBond nb = it->next();
+                    if (nb != locality::NeighborQueryIterator::ITERATOR_TERMINATOR)
+                    {
+                        const size_t bin = m_squared_binner.bin(square_distances ? nb.distance * nb.distance
+                                                                                  : nb.distance);
+                        if (bin != util::Axis::OVERFLOW_BIN)
+                        {
+                            ++counts(group, bin);
+                        }
+                    }
+                }
+            }
+        });
+        num_sampled = next_num_sampled;
+        group_counts.reset();
+        local_group_counts.reduceInto(group_counts);
+
+        // Estimate the standard error of the mean count per query point of
+        // each bin from the means of the groups, including the finite
+        // population correction for sampling without replacement.
+        const double sampled_fraction = double(num_sampled) / double(n_query_points);
+        const unsigned int num_nonempty_groups = std::min(num_groups, num_sampled);
+        float max_error = (num_sampled == n_query_points) ? 0 : std::numeric_limits<float>::infinity();
+        bool found_bonds = false;
+        for (size_t bin = 0; bin < bins; ++bin)
+        {
+            unsigned long total = 0;
+            for (unsigned int group = 0; group < num_groups; ++group)
+            {
+                total += group_counts(group, bin);
+            }
+            if (num_sampled == n_query_points)
+            {
+                m_relative_error[bin] = 0;
+                continue;
+            }
+            if (total == 0 || num_nonempty_groups < 2)
+            {
+                m_relative_error[bin] = std::numeric_limits<float>::infinity();
+                continue;
+            }
+            const double mean = double(total) / num_sampled;
+            double variance = 0;
+            const unsigned int num_rounds = num_sampled / num_groups;
+            for (unsigned int group = 0; group < num_groups; ++group)
+            {
+                const unsigned int round_offset = (group + num_groups - num_rounds % num_groups) % num_groups;
+                const unsigned int group_size = num_rounds + (round_offset < num_sampled % num_groups);
+                if (group_size == 0)
+                {
+                    continue;
+                }
+                const double deviation = double(group_counts(group, bin)) / group_size - mean;
+                const double group_weight = double(group_size) / num_sampled;
+                variance += group_weight * group_weight * deviation * deviation;
+            }
+            variance *= double(num_nonempty_groups) / (num_nonempty_groups - 1) * (1 - sampled_fraction);
+            m_relative_error[bin] = static_cast<float>(std::sqrt(variance) / mean);
+            max_error = found_bonds ? std::max(max_error, m_relative_error[bin]) : m_relative_error[bin];
+            found_bonds = true;
+        }
+
+        if (num_sampled == max_sampled || max_error <= target_error)
+        {
+            break;
+        }
+        next_num_sampled = std::min(max_sampled, 2 * num_sampled);
+    }
+
+    for (size_t bin = 0; bin < bins; ++bin)
+    {
+        unsigned int total = 0;
+        for (unsigned int group = 0; group < num_groups; ++group)
+        {
+            total += group_counts(group, bin);
+        }
+        m_local_histograms.increment(bin, total);
+    }
+
+    m_frame_counter++;
+    m_n_points = neighbor_query->getNPoints();
+    m_n_query_points = n_query_points;
+    m_n_sampled_query_points = num_sampled;
+    m_sampled_frames += static_cast<float>(double(num_sampled) / n_query_points);
+    m_reduce = true;
+}
+
+namespace {
+
+//! A binary tree of bounding spheres over points.
+class PairTree
+{
+public:
+    //! A node of the tree, holding a contiguous range of the sorted points.
+    struct Node
+    {
+        vec3<float> center;  //!< Center of the bounding sphere.
+        float radius;        //!< Radius of the bounding sphere.
+        unsigned int begin;  //!< First sorted point of the node.
+        unsigned int end;    //!< One past the last sorted point of the node.
+        unsigned int left;   //!< Index of the first child, or 0 for a leaf.
+        unsigned int right;  //!< Index of the second child, or 0 for a leaf.
+    };
+
+    //! Constructor
+    /*! \param box The box of the points.
+     *  \param points The points to sort into the tree.
+     *  \param n_points The number of points.
+     *  \param leaf_size The maximum number of points of a leaf.
+     *  \param move_into_box Whether to move points outside of the box into it
+     *         by whole lattice vectors, as packets of query points are moved.
+     */
+    PairTree(const box::Box& box, const vec3<float>* points, unsigned int n_points, unsigned int leaf_size,
+             bool move_into_box)
+        : m_positions(n_points), m_indices(n_points), m_leaf_size(leaf_size), m_outside_box(false),
+          m_max_coordinate(0)
+    {
+        const vec3<bool> periodic = box.getPeriodic();
+        const vec3<float> latt_a = vec3<float>(box.getLatticeVector(0));
+        const vec3<float> latt_b = vec3<float>(box.getLatticeVector(1));
+        const vec3<float> latt_c = box.is2D() ? vec3<float>(0, 0, 0) : vec3<float>(box.getLatticeVector(2));
+        for (unsigned int i = 0; i < n_points; ++i)
+        {
+            // Points are kept as the neighbor queries see them, so that their
+            // distances are rounded the same way.
+            vec3<float> position = points[i];
+            if (box.is2D())
+            {
+                position.z = 0;
+            }
+            vec3<float> fractional = box.makeFractional(position);
+            const vec3<float> image(periodic.x ? std::floor(fractional.x) : 0,
+                                    periodic.y ? std::floor(fractional.y) : 0,
+                                    (!box.is2D() && periodic.z) ? std::floor(fractional.z) : 0);
+            if (image.x != 0 || image.y != 0 || image.z != 0)
+            {
+                m_outside_box = true;
+                if (move_into_box)
+                {
+                    position -= image.x * latt_a + image.y * latt_b + image.z * latt_c;
+                    fractional -= image;
+                }
+            }
+            m_positions[i] = position;
+            m_indices[i] = i;
+            if (i == 0)
+            {
+                m_frac_lower = m_frac_upper = fractional;
+            }
+            m_frac_lower = vec3<float>(std::min(m_frac_lower.x, fractional.x),
+                                       std::min(m_frac_lower.y, fractional.y),
+                                       std::min(m_frac_lower.z, fractional.z));
+            m_frac_upper = vec3<float>(std::max(m_frac_upper.x, fractional.x),
+                                       std::max(m_frac_upper.y, fractional.y),
+                                       std::max(m_frac_upper.z, fractional.z));
+            m_max_coordinate = std::max(
+                m_max_coordinate,
+                std::max(std::abs(position.x), std::max(std::abs(position.y), std::abs(position.z))));
+        }
+        m_nodes.reserve(2 * (n_points / leaf_size + 1));
+        build(0, n_points);
+    }
+
+    const std::vector<Node>& getNodes() const
+    {
+        return m_nodes;
+    }
+
+    const std::vector<vec3<float>>& getPositions() const
+    {
+        return m_positions;
+    }
+
+    const std::vector<unsigned int>& getIndices() const
+    {
+        return m_indices;
+    }
+
+    //! Get the lower corner of the fractional coordinates of the points.
+    const vec3<float>& getFractionalLower() const
+    {
+        return m_frac_lower;
+    }
+
+    //! Get the upper corner of the fractional coordinates of the points.
+    const vec3<float>& getFractionalUpper() const
+    {
+        return m_frac_upper;
+    }
+
+    //! Get whether any of the points lies outside of the box.
+    bool isOutsideBox() const
+    {
+        return m_outside_box;
+    }
+
+    //! Get the largest magnitude of the coordinates of the points.
+    float getMaxCoordinate() const
+    {
+        return m_max_coordinate;
+    }
+
+private:
+    //! Build the subtree of a range of points, returning the index of its root.
+    unsigned int build(unsigned int begin, unsigned int end)
+    {
+        vec3<float> lower = m_positions[begin];
+        vec3<float> upper = m_positions[begin];
+        for (unsigned int i = begin + 1; i < end; ++i)
+        {
+            const vec3<float>& position = m_positions[i];
+            lower = vec3<float>(std::min(lower.x, position.x), std::min(lower.y, position.y),
+                                std::min(lower.z, position.z));
+            upper = vec3<float>(std::max(upper.x, position.x), std::max(upper.y, position.y),
+                                std::max(upper.z, position.z));
+        }
+        Node node;
+        node.center = float(0.5) * (lower + upper);
+        float radius_sq = 0;
+        for (unsigned int i = begin; i < end; ++i)
+        {
+            const vec3<float> delta = m_positions[i] - node.center;
+            radius_sq = std::max(radius_sq, dot(delta, delta));
+        }
+        node.radius = std::sqrt(radius_sq);
+        node.begin = begin;
+        node.end = end;
+        node.left = node.right = 0;
+        const unsigned int index = static_cast<unsigned int>(m_nodes.size());
+        m_nodes.push_back(node);
+        if (end - begin <= m_leaf_size)
+        {
+            return index;
+        }
+
+        // Split the points at the median of the longest side of their bounding box.
+        const vec3<float> extent = upper - lower;
+        unsigned int axis = (extent.x >= extent.y) ? 0 : 1;
+        if (extent.z > std::max(extent.x, extent.y))
+        {
+            axis = 2;
+        }
+        const auto coordinate = [axis](const vec3<float>& v) {
+            return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+        };
+        const unsigned int middle = begin + (end - begin) / 2;
+        std::vector<unsigned int> order(end - begin);
+        std::iota(order.begin(), order.end(), begin);
+        std::nth_element(order.begin(), order.begin() + (middle - begin), order.end(),
+                         [&](unsigned int a, unsigned int b) {
+                             return coordinate(m_positions[a]) < coordinate(m_positions[b]);
+                         });
+        std::vector<vec3<float>> positions(end - begin);
+        std::vector<unsigned int> indices(end - begin);
+        for (unsigned int i = 0; i < end - begin; ++i)
+        {
+            positions[i] = m_positions[order[i]];
+            indices[i] = m_indices[order[i]];
+        }
+        std::copy(positions.begin(), positions.end(), m_positions.begin() + begin);
+        std::copy(indices.begin(), indices.end(), m_indices.begin() + begin);
+
+        const unsigned int left = build(begin, middle);
+        const unsigned int right = build(middle, end);
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+        return index;
+    }
+
+    std::vector<Node> m_nodes;            //!< Nodes of the tree, with the root first.
+    std::vector<vec3<float>> m_positions; //!< Positions of the points in tree order.
+    std::vector<unsigned int> m_indices;  //!< Original indices of the points in tree order.
+    unsigned int m_leaf_size;             //!< Maximum number of points of a leaf.
+    vec3<float> m_frac_lower;             //!< Lower corner of the fractional coordinates.
+    vec3<float> m_frac_upper;             //!< Upper corner of the fractional coordinates.
+    bool m_outside_box;                   //!< Whether any of the points lies outside of the box.
+    float m_max_coordinate;               //!< Largest magnitude of the coordinates.
+};
+
+//! Counts the pairs of points of two trees in the bins of a histogram.
+class PairCounter
+{
+public:
+    PairCounter(const PairTree& query_tree, const PairTree& tree, const util::SquaredDistanceBinner& binner,
+                float r_min, float r_max, float length_scale, bool exclude_ii, bool shared)
+        : m_query_tree(query_tree), m_tree(tree), m_binner(binner), m_r_min(r_min), m_r_max(r_max),
+          m_length_scale(length_scale), m_exclude_ii(exclude_ii), m_shared(shared)
+    {}
+
+    //! Count the pairs of a node of the query tree and a node of the tree shifted by an image of the box.
+    void count(unsigned int query_node_index, unsigned int node_index, const vec3<float>& image,
+               util::Histogram<unsigned int>& histogram) const
+    {
+        const PairTree::Node& query_node = m_query_tree.getNodes()[query_node_index];
+        const PairTree::Node& node = m_tree.getNodes()[node_index];
+        const vec3<float> delta = node.center + image - query_node.center;
+        size_t bin;
+        if (!inRange(delta, query_node.radius + node.radius, bin))
+        {
+            return;
+        }
+        if (bin != util::Axis::OVERFLOW_BIN)
+        {
+            // The nodes of a shared tree share the points in the
+            // intersection of their ranges, whose pairs with themselves are excluded.
+            const unsigned int overlap_begin = std::max(query_node.begin, node.begin);
+            const unsigned int overlap_end = std::min(query_node.end, node.end);
+            const unsigned int overlap
+                = (m_exclude_ii && overlap_end > overlap_begin) ? overlap_end - overlap_begin : 0;
+            histogram.increment(bin, (query_node.end - query_node.begin) * (node.end - node.begin) - overlap);
+            return;
+        }
+
+        const bool query_leaf = (query_node.left == 0);
+        if (query_leaf)
+        {
+            // Single query points are far smaller than a node, so each of
+            // them may be counted with larger nodes at once.
+            const std::vector<vec3<float>>& query_positions = m_query_tree.getPositions();
+            for (unsigned int i = query_node.begin; i < query_node.end; ++i)
+            {
+                countPoint(i, query_positions[i] - image, node_index, histogram);
+            }
+        }
+        else if (node.left == 0 || query_node.radius >= node.radius)
+        {
+            count(query_node.left, node_index, image, histogram);
+            count(query_node.right, node_index, image, histogram);
+        }
+        else
+        {
+            count(query_node_index, node.left, image, histogram);
+            count(query_node_index, node.right, image, histogram);
+        }
+    }
+
+private:
+    //! Bound the distances between two bounding spheres.
+    /*! \param delta The vector between the centers of the spheres.
+     *  \param extent The sum of the radii of the spheres.
+     *  \param bin Set to the bin of all distances, or Axis::OVERFLOW_BIN if
+     *         they may fall in several bins or outside of the bins.
+     *  \return Whether any of the distances may fall in a bin.
+     */
+    bool inRange(const vec3<float>& delta, float extent, size_t& bin) const
+    {
+        // The bounds are padded slightly so that rounding in the distances
+        // of the pairs can never move them out of the bounds.
+        const float center_distance = std::sqrt(dot(delta, delta));
+        const float padding = float(1e-5) * (center_distance + extent + m_length_scale);
+        const float min_distance = std::max(float(0), center_distance - extent - padding);
+        const float max_distance = center_distance + extent + padding;
+        bin = util::Axis::OVERFLOW_BIN;
+        if (min_distance >= m_r_max || max_distance < m_r_min)
+        {
+            return false;
+        }
+
+        // When the overlap of two trees is unknown, excluded pairs must be found one at a time.
+        if (min_distance >= m_r_min && max_distance < m_r_max && (m_shared || !m_exclude_ii))
+        {
+            const size_t min_bin = m_binner.bin(min_distance * min_distance);
+            if (min_bin == m_binner.bin(max_distance * max_distance))
+            {
+                bin = min_bin;
+            }
+        }
+        return true;
+    }
+
+    //! Count the pairs of a query point and a node of the tree.
+    /*! \param i The index of the query point in the query tree.
+     *  \param query_image The query point shifted by the opposite of the image of the box.
+     *  \param node_index The node of the tree.
+     *  \param histogram The histogram of the pairs.
+     */
+    void countPoint(unsigned int i, const vec3<float>& query_image, unsigned int node_index,
+                    util::Histogram<unsigned int>& histogram) const
+    {
+        const PairTree::Node& node = m_tree.getNodes()[node_index];
+        size_t bin;
+        if (!inRange(node.center - query_image, node.radius, bin))
+        {
+            return;
+        }
+        if (bin != util::Axis::OVERFLOW_BIN)
+        {
+            const bool overlap = m_exclude_ii && i >= node.begin && i < node.end;
+            histogram.increment(bin, node.end - node.begin - (overlap ? 1 : 0));
+        }
+        else if (node.left != 0)
+        {
+            countPoint(i, query_image, node.left, histogram);
+            countPoint(i, query_image, node.right, histogram);
+        }
+        else
+        {
+            const std::vector<vec3<float>>& positions = m_tree.getPositions();
+            const unsigned int query_index = m_query_tree.getIndices()[i];
+            const std::vector<unsigned int>& indices = m_tree.getIndices();
+            for (unsigned int j = node.begin; j < node.end; ++j)
+            {
+                if (m_exclude_ii && query_index == indices[j])
+                {
+                    continue;
+                }
+                // The query point is shifted like the query points of ball
+                // queries, so the distances are computed in the same order.
+                const vec3<float> r_ij = positions[j] - query_image;
+                histogram.increment(m_binner.bin(dot(r_ij, r_ij)));
+            }
+        }
+    }
+
+    const PairTree& m_query_tree;                //!< Tree of the query points.
+    const PairTree& m_tree;                      //!< Tree of the points.
+    const util::SquaredDistanceBinner& m_binner; //!< Bins pairs from their squared distances.
+    const float m_r_min;                         //!< Lower edge of the first bin.
+    const float m_r_max;                         //!< Upper edge of the last bin.
+    const float m_length_scale;                  //!< Scale of the positions, setting their rounding.
+    const bool m_exclude_ii;                     //!< Whether to skip pairs with the same index.
+    const bool m_shared;                         //!< Whether the two trees are the same tree.
+};
+
+}; // end anonymous namespace
+
+void RDF::accumulateCellPairs(const freud::locality::NeighborQuery* neighbor_query,
+                              const vec3<float>* query_points, unsigned int n_query_points,
+                              freud::locality::QueryArgs qargs)
+{
+    const float r_min = getBounds()[0].first;
+    const float r_max = getBounds()[0].second;
+    const bool ball_query = (qargs.mode == locality::QueryArgs::ball)
+        || (qargs.mode == locality::QueryArgs::none && qargs.r_max != locality::QueryArgs::DEFAULT_R_MAX);
+    if (!ball_query || qargs.num_neighbors != locality::QueryArgs::DEFAULT_NUM_NEIGHBORS)
+        throw std::invalid_argument("RDF can only count pairs of cells for ball queries.");
+    if (qargs.r_max < r_max || qargs.r_min > r_min)
+        throw std::invalid_argument(
+            "RDF can only count pairs of cells for ball queries that cover the bins.");
+
+    const bool exclude_ii = qargs.exclude_ii;
+    m_box = neighbor_query->getBox();
+    const unsigned int n_points = neighbor_query->getNPoints();
+    const unsigned int leaf_size = CELL_PAIR_LEAF_SIZE;
+    const vec3<float>* points = neighbor_query->getPoints();
+
+    // Ball queries of an AABBQuery move query points outside of the box into
+    // it when they are processed in packets, which is done unless there are
+    // too few of them or the points are queried against themselves with a
+    // dual tree traversal. The query points are moved the same way, so the
+    // trees can only be shared when no point is moved.
+    const bool same_points = (query_points == points && n_query_points == n_points);
+    const bool move_query_points = n_query_points >= locality::AABB_PACKET_SIZE
+        && !(same_points && n_query_points >= locality::DUAL_TREE_MIN_QUERY_POINTS);
+    const PairTree tree(m_box, points, n_points, leaf_size, false);
+    const bool shared = same_points && !(move_query_points && tree.isOutsideBox());
+    std::shared_ptr<PairTree> separate_query_tree;
+    if (!shared)
+    {
+        separate_query_tree
+            = std::make_shared<PairTree>(m_box, query_points, n_query_points, leaf_size, move_query_points);
+    }
+    const PairTree& query_tree = shared ? tree : *separate_query_tree;
+
+    // The images along each periodic lattice vector are those that bring the
+    // fractional extents of the two trees within reach of each other. The
+    // half widths are padded slightly so that rounding in the fractional
+    // transform can never discard a pair.
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    const auto image_range = [r_max](bool is_periodic, float distance, float query_lower, float query_upper,
+                                     float lower, float upper, int& min_image, int& max_image) {
+        min_image = max_image = 0;
+        if (is_periodic)
+        {
+            const float width = r_max / distance + float(1e-5);
+            min_image = static_cast<int>(std::ceil(query_lower - upper - width));
+            max_image = static_cast<int>(std::floor(query_upper - lower + width));
+        }
+    };
+    const vec3<float>& query_lower = query_tree.getFractionalLower();
+    const vec3<float>& query_upper = query_tree.getFractionalUpper();
+    const vec3<float>& lower = tree.getFractionalLower();
+    const vec3<float>& upper = tree.getFractionalUpper();
+    int min_i, max_i, min_j, max_j, min_k, max_k;
+    image_range(periodic.x, plane_distance.x, query_lower.x, query_upper.x, lower.x, upper.x, min_i, max_i);
+    image_range(periodic.y, plane_distance.y, query_lower.y, query_upper.y, lower.y, upper.y, min_j, max_j);
+    image_range(periodic.z && !m_box.is2D(), plane_distance.z, query_lower.z, query_upper.z, lower.z, upper.z,
+                min_k, max_k);
+
+    // The image vectors are the negatives of those of the queries, which are
+    // added to the query points instead of the points, and negation is exact.
+    const vec3<float> latt_a = vec3<float>(m_box.getLatticeVector(0));
+    const vec3<float> latt_b = vec3<float>(m_box.getLatticeVector(1));
+    const vec3<float> latt_c = m_box.is2D() ? vec3<float>(0, 0, 0) : vec3<float>(m_box.getLatticeVector(2));
+    std::vector<vec3<float>> images;
+    for (int i = min_i; i <= max_i; ++i)
+    {
+        for (int j = min_j; j <= max_j; ++j)
+        {
+            for (int k = min_k; k <= max_k; ++k)
+            {
+                images.push_back(float(i) * latt_a + float(j) * latt_b + float(k) * latt_c);
+            }
+        }
+    }
+
+    // Subtrees of the query points paired with each image are the units of
+    // parallel work, split until there are enough of them to balance the load.
+    const std::vector<PairTree::Node>& query_nodes = query_tree.getNodes();
+    std::vector<unsigned int> subtrees(1, 0);
+    bool splittable = (query_nodes[0].left != 0);
+    while (splittable && subtrees.size() * images.size() < MIN_CELL_PAIR_TASKS)
+    {
+        std::vector<unsigned int> children;
+        splittable = false;
+        for (const unsigned int node : subtrees)
+        {
+            if (query_nodes[node].left == 0)
+            {
+                children.push_back(node);
+            }
+            else
+            {
+                children.push_back(query_nodes[node].left);
+                children.push_back(query_nodes[node].right);
+                splittable = splittable || query_nodes[query_nodes[node].left].left != 0
+                    || query_nodes[query_nodes[node].right].left != 0;
+            }
+        }
+        subtrees.swap(children);
+    }
+
+    const vec3<float> L = m_box.getL();
+    const float length_scale = std::max(std::max(L.x, std::max(L.y, L.z)),
+                                        std::max(tree.getMaxCoordinate(), query_tree.getMaxCoordinate()));
+    const PairCounter counter(query_tree, tree, m_squared_binner, r_min, r_max, length_scale, exclude_ii,
+                              shared);
+    util::forLoopWrapper(0, subtrees.size() * images.size(), [&](size_t begin, size_t end) {
+        util::Histogram<unsigned int>& histogram = m_local_histograms.local();
+        for (size_t task = begin; task < end; ++task)
+        {
+            counter.count(subtrees[task / images.size()], 0, images[task % images.size()], histogram);
+        }
+    });
+
+    m_frame_counter++;
+    m_n_points = n_points;
+    m_n_query_points = n_query_points;
+    m_reduce = true;
+    m_relative_error.prepare(getAxisSizes()[0]);
+    m_n_sampled_query_points = n_query_points;
+    m_sampled_frames += 1;
 }
 
 }; }; // end namespace freud::density
@@ -17,7 +17,19 @@ class RDF : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    RDF(unsigned int bins, float r_max, float r_min = 0, bool normalize = false);
+    /*! \param bins The number of bins.
+     *  \param r_max The upper edge of the last bin.
+     *  \param r_min The lower edge of the first bin.
+     *  \param normalize Whether to normalize the RDF for the finite number of query points.
+     *  \param log_bins Whether the bins are logarithmically spaced rather than linearly spaced.
+     */
+    RDF(unsigned int bins, float r_max, float r_min = 0, bool normalize = false, bool log_bins = false);
+
+    //! Constructor for arbitrary bins
+    /*! \param bin_edges The strictly increasing edges of the bins.
+     *  \param normalize Whether to normalize the RDF for the finite number of query points.
+     */
+    RDF(const std::vector<float>& bin_edges, bool normalize = false);
 
     //! Destructor
     virtual ~RDF() {};
@@ -31,6 +43,54 @@ public:
                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //! Compute the RDF from a stratified random subset of the query points
+    /*! The query points are ordered so that every prefix of the order is a
+     * stratified sample: the query points are sorted along a Morton curve,
+     * and the order alternates at random between the two halves of every
+     * range of the sorted points, so a prefix of m points holds about one
+     * point of each range of N / m neighboring points. The neighbors of a
+     * growing prefix are accumulated until the relative error of every
+     * nonempty bin is below target_error, or until the fraction max_fraction
+     * of the query points has been processed. The RDF is normalized by the
+     * number of query points actually processed.
+     *
+     * The error of each bin is the standard error of its mean count per
+     * query point, estimated from the spread between interleaved groups of
+     * the sampled query points and corrected for sampling without
+     * replacement, so it vanishes when all query points are processed.
+     *
+     * \param max_fraction The maximum fraction of query points to process.
+     * \param target_error The relative error at which to stop adding query
+     *        points. If not positive, the fraction max_fraction is processed.
+     * \param seed The seed of the random order of the query points.
+     */
+    void accumulateSubsampled(const freud::locality::NeighborQuery* neighbor_query,
+                              const vec3<float>* query_points, unsigned int n_query_points,
+                              freud::locality::QueryArgs qargs, float max_fraction, float target_error,
+                              unsigned int seed);
+
+    //! Compute the RDF by counting the pairs of nodes of spatial trees
+    /*! The points and query points are sorted into binary trees of bounding
+     * spheres, with their positions kept as the ball queries of an AABBQuery
+     * see them so that the distances of pairs are rounded the same way.
+     * Pairs of nodes are visited recursively for every image of the box
+     * within reach of the bins, starting from subtrees of the query points
+     * in parallel. When the bounds
+     * on the distances between two nodes lie in a single bin, all of their
+     * pairs are counted at once. Otherwise the larger node is split, down to
+     * single query points against nodes of the other tree, and the
+     * distances of the pairs of a query point and a leaf are binned one at a
+     * time. The counts are those of a ball query between the edges of the
+     * bins, so the query arguments must be those of a ball query that
+     * covers the bins.
+     */
+    void accumulateCellPairs(const freud::locality::NeighborQuery* neighbor_query,
+                             const vec3<float>* query_points, unsigned int n_query_points,
+                             freud::locality::QueryArgs qargs);
+
+    //! Reset the RDF array to all zeros
+    virtual void reset();
+
     //! Reduce thread-local arrays onto the primary data arrays.
     virtual void reduce();
 
@@ -50,7 +110,27 @@ public:
         return reduceAndReturn(m_N_r);
     }
 
+    //! Get the relative error of each bin of the last accumulation due to subsampling the query points.
+    const util::ManagedArray<float>& getRelativeError() const
+    {
+        return m_relative_error;
+    }
+
+    //! Get the number of query points processed by the last accumulation.
+    unsigned int getNumSampledQueryPoints() const
+    {
+        return m_n_sampled_query_points;
+    }
+
+    static const unsigned int NUM_ERROR_GROUPS = 16;      //!< Groups of query points for error estimates.
+    static const unsigned int INITIAL_SAMPLE_SIZE = 4096; //!< Query points sampled before checking errors.
+    static const unsigned int CELL_PAIR_LEAF_SIZE = 8;    //!< Maximum points per leaf of the pair trees.
+    static const unsigned int MIN_CELL_PAIR_TASKS = 1024; //!< Parallel tasks of pairs of trees.
+
 private:
+    //! Set the axis of the histogram and precompute the volumes of its bins.
+    void setAxis(std::shared_ptr<util::Axis> axis);
+
     bool m_normalize;                //!< Whether to enforce that the RDF should tend to 1 (instead of
                                      //!< num_query_points/num_points).
     util::ManagedArray<float> m_pcf; //!< The computed pair correlation function.
@@ -60,6 +140,10 @@ private:
         m_vol_array2D; //!< Areas of concentric rings corresponding to the histogram bins in 2D.
     util::ManagedArray<float>
         m_vol_array3D; //!< Areas of concentric spherical shells corresponding to the histogram bins in 3D.
+    util::SquaredDistanceBinner m_squared_binner; //!< Bins bonds by distance from their squared distance.
+    util::ManagedArray<float> m_relative_error;   //!< Relative error of each bin due to subsampling.
+    unsigned int m_n_sampled_query_points;        //!< Number of query points processed in the last frame.
+    float m_sampled_frames; //!< Number of frames, weighted by the fraction of query points processed.
 };
 
 }; }; // end namespace freud::density
@@ -74,6 +74,7 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
     const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
     const float r_max_sq = m_r_max * m_r_max;
 
+    const util::ArrayView<unsigned int, 3> voxels = m_voxels_array.view<3>();
     util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
         // for each reference point
         for (size_t idx = begin; idx < end; ++idx)
@@ -127,7 +128,7 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
 
                             // This array value could be written by multiple threads in parallel.
                             // This is only safe because all threads are writing the same value (1).
-                            m_voxels_array(ni, nj, nk) = 1;
+                            voxels(ni, nj, nk) = 1;
                         }
                     }
                 }
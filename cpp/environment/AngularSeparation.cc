@@ -63,6 +63,7 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
 
     const size_t tot_num_neigh = m_nlist.getNumBonds();
     m_angles.prepare(tot_num_neigh);
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
 
     util::forLoopWrapper(0, nq->getNPoints(), [=](size_t begin, size_t end) {
         size_t bond(m_nlist.find_first_index(begin));
@@ -70,9 +71,9 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
         {
             quat<float> q = orientations[i];
 
-            for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            for (; bond < tot_num_neigh && neighbors(bond, 0) == i; ++bond)
             {
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
+                const size_t j(neighbors(bond, 1));
                 quat<float> query_q = query_orientations[j];
 
                 float theta = computeMinSeparationAngle(q, query_q, equiv_orientations, n_equiv_orientations);
@@ -88,6 +89,7 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
                                       unsigned int n_equiv_orientations)
 {
     m_angles.prepare({n_points, n_global});
+    const util::ArrayView<float, 2> angles = m_angles.view<2>();
 
     util::forLoopWrapper(0, n_points, [=](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
@@ -98,7 +100,7 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
                 quat<float> global_q = global_orientations[j];
                 float theta
                     = computeMinSeparationAngle(q, global_q, equiv_orientations, n_equiv_orientations);
-                m_angles(i, j) = theta;
+                angles(i, j) = theta;
             }
         }
     });
@@ -0,0 +1,309 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is part of the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+#include "CommonNeighborAnalysis.h"
+#include "NeighborComputeFunctional.h"
+
+/*! \file CommonNeighborAnalysis.cc
+    \brief Identify crystalline environments with common neighbor analysis.
+*/
+
+namespace freud { namespace environment {
+
+namespace {
+
+//! Count the set bits of a bitset of neighbors.
+inline unsigned int countNeighbors(uint32_t neighbors)
+{
+    return static_cast<unsigned int>(std::bitset<32>(neighbors).count());
+}
+
+//! Count the bonds between a set of common neighbors and in their largest connected cluster.
+/*! \param bonds Bitsets of the neighbors bonded to each neighbor.
+ *  \param common Bitset of the common neighbors.
+ *  \param num_neighbors Number of neighbors.
+ *  \param num_bonds Set to the number of bonds between the common neighbors.
+ *  \param max_chain Set to the number of bonds of the largest connected cluster of bonds.
+ */
+inline void countCommonNeighborBonds(const uint32_t* bonds, uint32_t common, unsigned int num_neighbors,
+                                     unsigned int& num_bonds, unsigned int& max_chain)
+{
+    num_bonds = 0;
+    max_chain = 0;
+    uint32_t remaining = common;
+    while (remaining != 0)
+    {
+        // Grow the cluster of the lowest remaining neighbor until it stops changing.
+        uint32_t cluster = remaining & (~remaining + 1);
+        uint32_t previous_cluster = 0;
+        while (cluster != previous_cluster)
+        {
+            previous_cluster = cluster;
+            for (unsigned int b = 0; b < num_neighbors; ++b)
+            {
+                if (previous_cluster & (uint32_t(1) << b))
+                {
+                    cluster |= bonds[b] & common;
+                }
+            }
+        }
+
+        unsigned int cluster_bonds = 0;
+        for (unsigned int b = 0; b < num_neighbors; ++b)
+        {
+            if (cluster & (uint32_t(1) << b))
+            {
+                cluster_bonds += countNeighbors(bonds[b] & cluster);
+            }
+        }
+        // Every bond was counted from both of its ends.
+        cluster_bonds /= 2;
+        num_bonds += cluster_bonds;
+        max_chain = std::max(max_chain, cluster_bonds);
+        remaining &= ~cluster;
+    }
+}
+
+}; // end anonymous namespace
+
+CommonNeighborAnalysis::CommonNeighborAnalysis(bool adaptive) : m_adaptive(adaptive) {}
+
+CommonNeighborAnalysis::Structure CommonNeighborAnalysis::classify(const uint32_t* bonds,
+                                                                   unsigned int num_neighbors)
+{
+    unsigned int num_421(0), num_422(0), num_444(0), num_555(0), num_666(0);
+    for (unsigned int a = 0; a < num_neighbors; ++a)
+    {
+        const unsigned int num_common = countNeighbors(bonds[a]);
+        unsigned int num_bonds, max_chain;
+        countCommonNeighborBonds(bonds, bonds[a], num_neighbors, num_bonds, max_chain);
+
+        if (num_common == 4 && num_bonds == 2 && max_chain == 1)
+        {
+            ++num_421;
+        }
+        else if (num_common == 4 && num_bonds == 2 && max_chain == 2)
+        {
+            ++num_422;
+        }
+        else if (num_common == 4 && num_bonds == 4 && max_chain == 4)
+        {
+            ++num_444;
+        }
+        else if (num_common == 5 && num_bonds == 5 && max_chain == 5)
+        {
+            ++num_555;
+        }
+        else if (num_common == 6 && num_bonds == 6 && max_chain == 6)
+        {
+            ++num_666;
+        }
+        else
+        {
+            // No structure has bonds with any other signature.
+            return OTHER;
+        }
+    }
+
+    if (num_neighbors == 12)
+    {
+        if (num_421 == 12)
+        {
+            return FCC;
+        }
+        if (num_421 == 6 && num_422 == 6)
+        {
+            return HCP;
+        }
+        if (num_555 == 12)
+        {
+            return ICO;
+        }
+    }
+    else if (num_neighbors == 14 && num_666 == 8 && num_444 == 6)
+    {
+        return BCC;
+    }
+    return OTHER;
+}
+
+CommonNeighborAnalysis::Structure
+CommonNeighborAnalysis::classifyConventional(unsigned int i, const unsigned int* sorted_neighbors,
+                                             const unsigned int* segments, const unsigned int* counts) const
+{
+    const unsigned int num_neighbors = counts[i];
+    if (num_neighbors != 12 && num_neighbors != 14)
+    {
+        return OTHER;
+    }
+
+    // The neighbors of i bonded to each neighbor j are found by merging the
+    // sorted neighbor segments of i and j.
+    const unsigned int* neighbors = sorted_neighbors + segments[i];
+    uint32_t bonds[MAX_NEIGHBORS];
+    for (unsigned int a = 0; a < num_neighbors; ++a)
+    {
+        const unsigned int j = neighbors[a];
+        const unsigned int* j_neighbors = sorted_neighbors + segments[j];
+        const unsigned int* j_neighbors_end = j_neighbors + counts[j];
+        bonds[a] = 0;
+        unsigned int b = 0;
+        while (b < num_neighbors && j_neighbors != j_neighbors_end)
+        {
+            if (neighbors[b] < *j_neighbors)
+            {
+                ++b;
+            }
+            else if (*j_neighbors < neighbors[b])
+            {
+                ++j_neighbors;
+            }
+            else
+            {
+                if (b != a)
+                {
+                    bonds[a] |= uint32_t(1) << b;
+                }
+                ++b;
+                ++j_neighbors;
+            }
+        }
+    }
+    return classify(bonds, num_neighbors);
+}
+
+CommonNeighborAnalysis::Structure CommonNeighborAnalysis::classifyAdaptive(
+    const locality::NeighborQuery* nq, unsigned int i, const unsigned int* neighbors,
+    const unsigned int* segments, const unsigned int* counts,
+    std::vector<NeighborDelta>& deltas) const
+{
+    const unsigned int num_bonds = counts[i];
+    if (num_bonds < 12)
+    {
+        return OTHER;
+    }
+
+    // Sort the nearest neighbors by distance.
+    const box::Box& box = nq->getBox();
+    deltas.resize(num_bonds);
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        const vec3<float> delta = box.wrap((*nq)[neighbors[segments[i] + bond]] - (*nq)[i]);
+        deltas[bond] = std::make_pair(dot(delta, delta), delta);
+    }
+    const unsigned int num_nearest = std::min(num_bonds, static_cast<unsigned int>(MAX_NEIGHBORS));
+    std::partial_sort(deltas.begin(), deltas.begin() + num_nearest, deltas.end(),
+                      [](const NeighborDelta& left, const NeighborDelta& right) {
+                          return left.first < right.first;
+                      });
+
+    const float cutoff_factor = (1 + std::sqrt(2.0f)) / 2;
+    uint32_t bonds[MAX_NEIGHBORS];
+    auto findBonds = [&](unsigned int num_neighbors, float cutoff) {
+        const float cutoff_sq = cutoff * cutoff;
+        for (unsigned int a = 0; a < num_neighbors; ++a)
+        {
+            bonds[a] = 0;
+        }
+        for (unsigned int a = 0; a < num_neighbors; ++a)
+        {
+            for (unsigned int b = a + 1; b < num_neighbors; ++b)
+            {
+                const vec3<float> delta = deltas[b].second - deltas[a].second;
+                if (dot(delta, delta) < cutoff_sq)
+                {
+                    bonds[a] |= uint32_t(1) << b;
+                    bonds[b] |= uint32_t(1) << a;
+                }
+            }
+        }
+    };
+
+    // fcc, hcp and icosahedral environments have 12 nearest neighbors, so the
+    // cutoff lies between the first and second shells.
+    float mean_distance = 0;
+    for (unsigned int a = 0; a < 12; ++a)
+    {
+        mean_distance += std::sqrt(deltas[a].first);
+    }
+    mean_distance /= 12;
+    findBonds(12, cutoff_factor * mean_distance);
+    const Structure structure = classify(bonds, 12);
+    if (structure != OTHER || num_nearest < 14)
+    {
+        return structure;
+    }
+
+    // bcc environments have 8 nearest neighbors and 6 second nearest
+    // neighbors at 2 / sqrt(3) times the distance, and the cutoff lies between
+    // the second and third shells.
+    float first_shell_distance = 0;
+    float second_shell_distance = 0;
+    for (unsigned int a = 0; a < 8; ++a)
+    {
+        first_shell_distance += std::sqrt(deltas[a].first);
+    }
+    for (unsigned int a = 8; a < 14; ++a)
+    {
+        second_shell_distance += std::sqrt(deltas[a].first);
+    }
+    mean_distance = (2 / std::sqrt(3.0f) * first_shell_distance / 8 + second_shell_distance / 6) / 2;
+    findBonds(14, cutoff_factor * mean_distance);
+    return classify(bonds, 14);
+}
+
+void CommonNeighborAnalysis::compute(const locality::NeighborQuery* nq, const locality::NeighborList* nlist,
+                                     locality::QueryArgs qargs)
+{
+    const unsigned int n_points = nq->getNPoints();
+
+    // This function requires a NeighborList object, so we always make one and store it locally.
+    m_nlist = locality::makeDefaultNlist(nq, nlist, nq->getPoints(), n_points, qargs);
+    m_nlist.validate(n_points, n_points);
+
+    const unsigned int num_bonds = m_nlist.getNumBonds();
+    const unsigned int* segments = m_nlist.getSegments().get();
+    const unsigned int* counts = m_nlist.getCounts().get();
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
+
+    // Copy the neighbors of each point into a CSR array, sorted within each
+    // segment for conventional CNA.
+    std::vector<unsigned int> point_neighbors(num_bonds);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const unsigned int segment_end = segments[i] + counts[i];
+            for (unsigned int bond = segments[i]; bond < segment_end; ++bond)
+            {
+                point_neighbors[bond] = neighbors(bond, 1);
+            }
+            if (!m_adaptive)
+            {
+                std::sort(point_neighbors.begin() + segments[i], point_neighbors.begin() + segment_end);
+            }
+        }
+    });
+
+    m_structures.prepare(n_points);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        std::vector<NeighborDelta> deltas;
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_structures[i] = m_adaptive
+                ? classifyAdaptive(nq, i, point_neighbors.data(), segments, counts, deltas)
+                : classifyConventional(i, point_neighbors.data(), segments, counts);
+        }
+    });
+
+    m_structure_counts.prepare(NUM_STRUCTURES);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        ++m_structure_counts[m_structures[i]];
+    }
+}
+
+}; }; // end namespace freud::environment
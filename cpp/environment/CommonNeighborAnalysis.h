@@ -0,0 +1,130 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is part of the freud project, released under the BSD 3-Clause License.
+
+#ifndef COMMON_NEIGHBOR_ANALYSIS_H
+#define COMMON_NEIGHBOR_ANALYSIS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file CommonNeighborAnalysis.h
+    \brief Identify crystalline environments with common neighbor analysis.
+*/
+
+namespace freud { namespace environment {
+
+//! Identify fcc, hcp, bcc and icosahedral environments with common neighbor analysis.
+/*! Every bond between a point and one of its neighbors is characterized by
+ *  the number of neighbors common to both points, the number of bonds between
+ *  these common neighbors, and the number of bonds in the largest connected
+ *  cluster of these bonds. A point is assigned a structure when the
+ *  signatures of all its bonds match those of the structure:
+ *  - fcc: 12 neighbors with signature (4, 2, 1).
+ *  - hcp: 6 neighbors with signature (4, 2, 1) and 6 with signature (4, 2, 2).
+ *  - bcc: 8 neighbors with signature (6, 6, 6) and 6 with signature (4, 4, 4).
+ *  - icosahedral: 12 neighbors with signature (5, 5, 5).
+ *
+ *  In conventional CNA, the neighbors of each point and the bonds between
+ *  them are the bonds of the neighbor list, which should be found with a
+ *  cutoff between the first and second (or for bcc, the second and third)
+ *  neighbor shells. The neighbors of a point and its bonded neighbors are
+ *  compared by intersecting their sorted neighbor segments.
+ *
+ *  In adaptive CNA (Stukowski, Modelling Simul. Mater. Sci. Eng. 20, 2012),
+ *  each point uses its own cutoff derived from the distances of its 12
+ *  nearest neighbors (for fcc, hcp and icosahedral environments) or its 14
+ *  nearest neighbors (for bcc environments), and bonds between its neighbors
+ *  are found from the distances between them. The neighbor list must then
+ *  contain at least the 14 nearest neighbors of each point.
+ *
+ *  Either way, the neighbors of a point are represented by bitsets over its
+ *  (at most MAX_NEIGHBORS) neighbors, so that common neighbors and their bonds
+ *  are found with a few bitwise operations.
+ */
+class CommonNeighborAnalysis
+{
+public:
+    //! Structures identified by common neighbor analysis.
+    enum Structure
+    {
+        OTHER = 0,
+        FCC = 1,
+        HCP = 2,
+        BCC = 3,
+        ICO = 4,
+        NUM_STRUCTURES = 5
+    };
+
+    //! Constructor
+    /*! \param adaptive Whether to use adaptive cutoffs rather than the bonds of the neighbor list.
+     */
+    CommonNeighborAnalysis(bool adaptive = true);
+
+    //! Destructor
+    ~CommonNeighborAnalysis() {}
+
+    //! Identify the structure of the environment of each point.
+    void compute(const locality::NeighborQuery* nq, const locality::NeighborList* nlist,
+                 locality::QueryArgs qargs);
+
+    //! Whether adaptive cutoffs are used.
+    bool isAdaptive() const
+    {
+        return m_adaptive;
+    }
+
+    //! Get the structure identified for each point.
+    const util::ManagedArray<unsigned int>& getStructures() const
+    {
+        return m_structures;
+    }
+
+    //! Get the number of points identified as each structure.
+    const util::ManagedArray<unsigned int>& getStructureCounts() const
+    {
+        return m_structure_counts;
+    }
+
+    //! Return a pointer to the NeighborList used in the last call to compute.
+    locality::NeighborList* getNList()
+    {
+        return &m_nlist;
+    }
+
+    static const unsigned int MAX_NEIGHBORS = 14; //!< Largest number of neighbors of a known structure.
+
+private:
+    //! A neighbor vector and its squared length.
+    typedef std::pair<float, vec3<float>> NeighborDelta;
+
+    //! Identify the structure of the environment of a point.
+    /*! \param bonds Bitsets of the neighbors bonded to each of the num_neighbors neighbors of the point.
+     *  \param num_neighbors The number of neighbors of the point.
+     */
+    static Structure classify(const uint32_t* bonds, unsigned int num_neighbors);
+
+    //! Identify the structure of a point from the conventional CNA bonds of the neighbor list.
+    Structure classifyConventional(unsigned int i, const unsigned int* sorted_neighbors,
+                                   const unsigned int* segments, const unsigned int* counts) const;
+
+    //! Identify the structure of a point with adaptive cutoffs.
+    Structure classifyAdaptive(const locality::NeighborQuery* nq, unsigned int i,
+                               const unsigned int* neighbors, const unsigned int* segments,
+                               const unsigned int* counts, std::vector<NeighborDelta>& deltas) const;
+
+    bool m_adaptive;                //!< Whether to use adaptive cutoffs.
+    locality::NeighborList m_nlist; //!< The NeighborList used in the last call to compute.
+
+    util::ManagedArray<unsigned int> m_structures;       //!< Structure of each point.
+    util::ManagedArray<unsigned int> m_structure_counts; //!< Number of points of each structure.
+};
+
+}; }; // end namespace freud::environment
+
+#endif // COMMON_NEIGHBOR_ANALYSIS_H
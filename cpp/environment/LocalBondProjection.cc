@@ -66,15 +66,18 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
 
     m_local_bond_proj.prepare({tot_num_neigh, n_proj});
     m_local_bond_proj_norm.prepare({tot_num_neigh, n_proj});
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
+    const util::ArrayView<float, 2> local_bond_proj = m_local_bond_proj.view<2>();
+    const util::ArrayView<float, 2> local_bond_proj_norm = m_local_bond_proj_norm.view<2>();
 
     // compute the order parameter
     util::forLoopWrapper(0, n_query_points, [=](size_t begin, size_t end) {
         size_t bond(m_nlist.find_first_index(begin));
         for (size_t i = begin; i < end; ++i)
         {
-            for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            for (; bond < tot_num_neigh && neighbors(bond, 0) == i; ++bond)
             {
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
+                const size_t j(neighbors(bond, 1));
 
                 // compute bond vector between the two particles
                 vec3<float> local_bond(bondVector(locality::NeighborBond(i, j), nq, query_points));
@@ -88,8 +91,8 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
                     vec3<float> proj_vec = proj_vecs[k];
                     float max_proj = computeMaxProjection(proj_vec, local_bond, equiv_orientations,
                                                           n_equiv_orientations);
-                    m_local_bond_proj(bond, k) = max_proj;
-                    m_local_bond_proj_norm(bond, k) = max_proj / local_bond_len;
+                    local_bond_proj(bond, k) = max_proj;
+                    local_bond_proj_norm(bond, k) = max_proj / local_bond_len;
                 }
             }
         }
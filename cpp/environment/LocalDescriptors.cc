@@ -30,6 +30,7 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
         max_num_neighbors = std::numeric_limits<unsigned int>::max();
 
     m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
 
     util::forLoopWrapper(0, nq->getNPoints(), [=](size_t begin, size_t end) {
         fsph::PointSPHEvaluator<float> sph_eval(m_l_max);
@@ -46,10 +47,10 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
                 util::ManagedArray<float> inertiaTensor = util::ManagedArray<float>({3, 3});
 
                 for (size_t bond_copy(bond); bond_copy < m_nlist.getNumBonds()
-                     && m_nlist.getNeighbors()(bond_copy, 0) == i && neighbor_count < max_num_neighbors;
+                     && neighbors(bond_copy, 0) == i && neighbor_count < max_num_neighbors;
                      ++bond_copy, ++neighbor_count)
                 {
-                    const size_t j(m_nlist.getNeighbors()(bond_copy, 1));
+                    const size_t j(neighbors(bond_copy, 1));
                     const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
                     const float r_sq(dot(r_ij, r_ij));
 
@@ -97,12 +98,12 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
             }
 
             neighbor_count = 0;
-            for (; bond < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond, 0) == i
+            for (; bond < m_nlist.getNumBonds() && neighbors(bond, 0) == i
                  && neighbor_count < max_num_neighbors;
                  ++bond, ++neighbor_count)
             {
                 const unsigned int sphCount(bond * getSphWidth());
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
+                const size_t j(neighbors(bond, 1));
                 const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
                 const float r_sq(dot(r_ij, r_ij));
                 const vec3<float> bond_ij(dot(rotation_0, r_ij), dot(rotation_1, r_ij),
@@ -501,10 +501,11 @@ Environment MatchEnv::buildEnv(const freud::locality::NeighborQuery* nq,
     // set the environment index equal to the particle index
     ei.env_ind = env_ind;
 
-    for (; bond < num_bonds && nlist->getNeighbors()(bond, 0) == i; ++bond)
+    const util::ArrayView<const unsigned int, 2> neighbors = nlist->getNeighbors().view<2>();
+    for (; bond < num_bonds && neighbors(bond, 0) == i; ++bond)
     {
         // compute vec{r} between the two particles
-        const size_t j(nlist->getNeighbors()(bond, 1));
+        const size_t j(neighbors(bond, 1));
         if (i != j)
         {
             vec3<float> delta(bondVector(locality::NeighborBond(i, j), nq, nq->getPoints()));
@@ -554,6 +555,7 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, dj.m_max_num_neigh});
 
+    const util::ArrayView<const unsigned int, 2> neighbors = nlist.getNeighbors().view<2>();
     size_t bond(0);
     // loop through points
     for (unsigned int i = 0; i < Np; i++)
@@ -561,9 +563,9 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
         if (global == false)
         {
             // loop over the neighbors
-            for (; bond < nlist.getNumBonds() && nlist.getNeighbors()(bond, 0) == i; ++bond)
+            for (; bond < nlist.getNumBonds() && neighbors(bond, 0) == i; ++bond)
             {
-                const size_t j(nlist.getNeighbors()(bond, 1));
+                const size_t j(neighbors(bond, 1));
                 std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
                     = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
                 rotmat3<float> rotation = mapping.first;
@@ -0,0 +1,209 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is part of the freud project, released under the BSD 3-Clause License.
+
+#include <limits>
+#include <stdexcept>
+
+#include "NeighborComputeFunctional.h"
+#include "NonaffineDisplacement.h"
+#include "utils.h"
+
+/*! \file NonaffineDisplacement.cc
+    \brief Compute the nonaffine displacement of the neighbors of each point between two frames.
+*/
+
+namespace freud { namespace environment {
+
+namespace {
+
+//! Smallest determinant of an invertible matrix relative to the determinant of its mean eigenvalue.
+const double MIN_RELATIVE_DETERMINANT = 1e-6;
+
+//! Invert the leading dim x dim block of a symmetric positive semidefinite matrix.
+/*! \param matrix The matrix to invert.
+ *  \param dim The size of the block to invert, 2 or 3.
+ *  \param inverse Set to the inverse of the block, padded with zeros.
+ *  \return Whether the block is invertible.
+ */
+bool invertBlock(const double (&matrix)[3][3], unsigned int dim, double (&inverse)[3][3])
+{
+    for (unsigned int a = 0; a < 3; ++a)
+    {
+        for (unsigned int b = 0; b < 3; ++b)
+        {
+            inverse[a][b] = 0;
+        }
+    }
+
+    double trace = 0;
+    for (unsigned int a = 0; a < dim; ++a)
+    {
+        trace += matrix[a][a];
+    }
+    const double mean_eigenvalue = trace / dim;
+    const double scale = (dim == 2) ? mean_eigenvalue * mean_eigenvalue
+                                    : mean_eigenvalue * mean_eigenvalue * mean_eigenvalue;
+
+    if (dim == 2)
+    {
+        const double det = matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0];
+        if (!(det > MIN_RELATIVE_DETERMINANT * scale))
+        {
+            return false;
+        }
+        inverse[0][0] = matrix[1][1] / det;
+        inverse[0][1] = -matrix[0][1] / det;
+        inverse[1][0] = -matrix[1][0] / det;
+        inverse[1][1] = matrix[0][0] / det;
+        return true;
+    }
+
+    // The inverse is the transposed matrix of cofactors divided by the determinant.
+    double cofactors[3][3];
+    for (unsigned int a = 0; a < 3; ++a)
+    {
+        for (unsigned int b = 0; b < 3; ++b)
+        {
+            cofactors[a][b] = matrix[(a + 1) % 3][(b + 1) % 3] * matrix[(a + 2) % 3][(b + 2) % 3]
+                - matrix[(a + 1) % 3][(b + 2) % 3] * matrix[(a + 2) % 3][(b + 1) % 3];
+        }
+    }
+    const double det
+        = matrix[0][0] * cofactors[0][0] + matrix[0][1] * cofactors[0][1] + matrix[0][2] * cofactors[0][2];
+    if (!(det > MIN_RELATIVE_DETERMINANT * scale))
+    {
+        return false;
+    }
+    for (unsigned int a = 0; a < 3; ++a)
+    {
+        for (unsigned int b = 0; b < 3; ++b)
+        {
+            inverse[a][b] = cofactors[b][a] / det;
+        }
+    }
+    return true;
+}
+
+}; // end anonymous namespace
+
+void NonaffineDisplacement::compute(const locality::NeighborQuery* reference_nq,
+                                    const locality::NeighborQuery* nq, const locality::NeighborList* nlist,
+                                    locality::QueryArgs qargs)
+{
+    const unsigned int n_points = reference_nq->getNPoints();
+    if (nq->getNPoints() != n_points)
+    {
+        throw std::invalid_argument("The reference and current frames must have the same number of points.");
+    }
+    const box::Box& reference_box = reference_nq->getBox();
+    const box::Box& box = nq->getBox();
+    if (reference_box.is2D() != box.is2D())
+    {
+        throw std::invalid_argument("The reference and current boxes must have the same dimensionality.");
+    }
+
+    // This function requires a NeighborList object, so we always make one and store it locally.
+    m_nlist = locality::makeDefaultNlist(reference_nq, nlist, reference_nq->getPoints(), n_points, qargs);
+    m_nlist.validate(n_points, n_points);
+
+    const unsigned int dim = box.is2D() ? 2 : 3;
+    const unsigned int* segments = m_nlist.getSegments().get();
+    const unsigned int* counts = m_nlist.getCounts().get();
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
+
+    m_d2min.prepare(n_points);
+    m_strain.prepare({n_points, 3, 3});
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const unsigned int segment_end = segments[i] + counts[i];
+            const vec3<float> reference_point = (*reference_nq)[i];
+            const vec3<float> point = (*nq)[i];
+
+            // Correlations X = sum_j d_j d0_j^T and Y = sum_j d0_j d0_j^T of the bonds.
+            double X[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+            double Y[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+            for (unsigned int bond = segments[i]; bond < segment_end; ++bond)
+            {
+                const unsigned int j = neighbors(bond, 1);
+                const vec3<float> reference_delta = reference_box.wrap((*reference_nq)[j] - reference_point);
+                const vec3<float> delta = box.wrap((*nq)[j] - point);
+                const double d0[3] = {reference_delta.x, reference_delta.y, reference_delta.z};
+                const double d[3] = {delta.x, delta.y, delta.z};
+                for (unsigned int a = 0; a < 3; ++a)
+                {
+                    for (unsigned int b = 0; b < 3; ++b)
+                    {
+                        X[a][b] += d[a] * d0[b];
+                        Y[a][b] += d0[a] * d0[b];
+                    }
+                }
+            }
+
+            double Y_inverse[3][3];
+            if (!invertBlock(Y, dim, Y_inverse))
+            {
+                m_d2min[i] = std::numeric_limits<float>::quiet_NaN();
+                for (unsigned int a = 0; a < 3; ++a)
+                {
+                    for (unsigned int b = 0; b < 3; ++b)
+                    {
+                        m_strain(i, a, b) = std::numeric_limits<float>::quiet_NaN();
+                    }
+                }
+                continue;
+            }
+
+            // The best affine transformation J = X Y^{-1}, which is the
+            // identity along z in 2D.
+            double J[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+            if (dim == 2)
+            {
+                J[2][2] = 1;
+            }
+            for (unsigned int a = 0; a < dim; ++a)
+            {
+                for (unsigned int b = 0; b < dim; ++b)
+                {
+                    for (unsigned int c = 0; c < dim; ++c)
+                    {
+                        J[a][b] += X[a][c] * Y_inverse[c][b];
+                    }
+                }
+            }
+
+            // The residual is summed over the bonds rather than expanded in
+            // terms of X and Y, which would cancel catastrophically for
+            // nearly affine displacements.
+            double d2min = 0;
+            for (unsigned int bond = segments[i]; bond < segment_end; ++bond)
+            {
+                const unsigned int j = neighbors(bond, 1);
+                const vec3<float> reference_delta = reference_box.wrap((*reference_nq)[j] - reference_point);
+                const vec3<float> delta = box.wrap((*nq)[j] - point);
+                const double d0[3] = {reference_delta.x, reference_delta.y, reference_delta.z};
+                const double d[3] = {delta.x, delta.y, delta.z};
+                for (unsigned int a = 0; a < dim; ++a)
+                {
+                    double residual = d[a];
+                    for (unsigned int b = 0; b < dim; ++b)
+                    {
+                        residual -= J[a][b] * d0[b];
+                    }
+                    d2min += residual * residual;
+                }
+            }
+
+            m_d2min[i] = static_cast<float>(d2min);
+            for (unsigned int a = 0; a < 3; ++a)
+            {
+                for (unsigned int b = 0; b < 3; ++b)
+                {
+                    m_strain(i, a, b) = static_cast<float>(J[a][b] - (a == b ? 1 : 0));
+                }
+            }
+        }
+    });
+}
+
+}; }; // end namespace freud::environment
@@ -0,0 +1,75 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is part of the freud project, released under the BSD 3-Clause License.
+
+#ifndef NONAFFINE_DISPLACEMENT_H
+#define NONAFFINE_DISPLACEMENT_H
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file NonaffineDisplacement.h
+    \brief Compute the nonaffine displacement of the neighbors of each point between two frames.
+*/
+
+namespace freud { namespace environment {
+
+//! Compute the nonaffine displacement D^2_min of the neighbors of each point between two frames.
+/*! Following Falk and Langer (Phys. Rev. E 57, 1998), the bonds d0_j from
+ *  each point to its neighbors j in a reference frame are mapped to the bonds
+ *  d_j between the same points in a current frame by the affine
+ *  transformation J that minimizes
+ *      D^2 = sum_j |d_j - J d0_j|^2,
+ *  which is J = X Y^{-1} with the correlation matrices X = sum_j d_j d0_j^T
+ *  and Y = sum_j d0_j d0_j^T. The minimum D^2_min measures the nonaffine
+ *  displacement of the neighbors, and the local strain is J - I.
+ *
+ *  The neighbors are found in the reference frame. Bonds are wrapped into
+ *  the reference box in the reference frame and into the current box in the
+ *  current frame. In two dimensions, only the xy block of J is fit and the
+ *  strain has no z components. Points whose reference bonds do not span the
+ *  space have NaN D^2_min and strain.
+ */
+class NonaffineDisplacement
+{
+public:
+    //! Constructor
+    NonaffineDisplacement() {}
+
+    //! Destructor
+    ~NonaffineDisplacement() {}
+
+    //! Compute the nonaffine displacement of the neighbors of each point.
+    /*! \param reference_nq The points in the reference frame, in which neighbors are found.
+     *  \param nq The same points in the current frame.
+     */
+    void compute(const locality::NeighborQuery* reference_nq, const locality::NeighborQuery* nq,
+                 const locality::NeighborList* nlist, locality::QueryArgs qargs);
+
+    //! Get the nonaffine displacement D^2_min of each point.
+    const util::ManagedArray<float>& getD2min() const
+    {
+        return m_d2min;
+    }
+
+    //! Get the local strain tensor J - I of each point.
+    const util::ManagedArray<float>& getStrain() const
+    {
+        return m_strain;
+    }
+
+    //! Return a pointer to the NeighborList used in the last call to compute.
+    locality::NeighborList* getNList()
+    {
+        return &m_nlist;
+    }
+
+private:
+    locality::NeighborList m_nlist;     //!< The NeighborList used in the last call to compute.
+    util::ManagedArray<float> m_d2min;  //!< Nonaffine displacement of each point.
+    util::ManagedArray<float> m_strain; //!< Local strain tensor of each point.
+};
+
+}; }; // end namespace freud::environment
+
+#endif // NONAFFINE_DISPLACEMENT_H
@@ -55,6 +55,8 @@ namespace freud { namespace locality {
 
     - merge()
     - overlap()
+    - overlapMask()
+    - distanceSquared()
     - contains()
 */
 struct CACHE_ALIGN AABB
@@ -278,6 +280,22 @@ struct CACHE_ALIGN AABBSphere
     }
 };
 
+//! Number of spheres in an AABBSpherePacket
+const unsigned int AABB_PACKET_SIZE = 8;
+
+//! Packet of spheres with a common radius
+/*! The sphere positions are stored as a structure of arrays so that a single AABB can be tested against all
+   spheres of the packet at once. Slots beyond the number of spheres in use must still hold finite values (a
+   copy of a valid sphere) and be masked out by the caller.
+*/
+struct CACHE_ALIGN AABBSpherePacket
+{
+    float x[AABB_PACKET_SIZE]; //!< x coordinates of the sphere positions
+    float y[AABB_PACKET_SIZE]; //!< y coordinates of the sphere positions
+    float z[AABB_PACKET_SIZE]; //!< z coordinates of the sphere positions
+    float radius;              //!< Radius of all spheres
+};
+
 //! Check if two AABBs overlap
 /*! \param a First AABB
     \param b Second AABB
@@ -324,6 +342,228 @@ inline bool overlap(const AABB& a, const AABBSphere& b)
 #endif
 }
 
+//! Check which spheres of a packet overlap an AABB
+/*! \tparam is2D Whether the AABB and spheres lie in the z=0 plane, in which case the z components are skipped
+    \param a AABB
+    \param b AABBSpherePacket
+    \returns A bit mask in which bit i is set when the AABB overlaps sphere i of the packet
+*/
+template<bool is2D> inline unsigned int overlapMask(const AABB& a, const AABBSpherePacket& b)
+{
+    unsigned int mask = 0;
+#if defined(__SSE__)
+    static_assert(AABB_PACKET_SIZE % 4 == 0, "The AABB packet size must be a multiple of the SSE width.");
+    const __m128 lower_x = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 lower_y = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 lower_z = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 upper_x = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 upper_y = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 upper_z = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 r2_v = _mm_set1_ps(b.radius * b.radius);
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; i += 4)
+    {
+        const __m128 x_v = _mm_load_ps(&b.x[i]);
+        const __m128 y_v = _mm_load_ps(&b.y[i]);
+        const __m128 dx_v = _mm_sub_ps(_mm_min_ps(_mm_max_ps(x_v, lower_x), upper_x), x_v);
+        const __m128 dy_v = _mm_sub_ps(_mm_min_ps(_mm_max_ps(y_v, lower_y), upper_y), y_v);
+        __m128 dr2_v = _mm_add_ps(_mm_mul_ps(dx_v, dx_v), _mm_mul_ps(dy_v, dy_v));
+        if (!is2D)
+        {
+            const __m128 z_v = _mm_load_ps(&b.z[i]);
+            const __m128 dz_v = _mm_sub_ps(_mm_min_ps(_mm_max_ps(z_v, lower_z), upper_z), z_v);
+            dr2_v = _mm_add_ps(dr2_v, _mm_mul_ps(dz_v, dz_v));
+        }
+        mask |= static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(dr2_v, r2_v))) << i;
+    }
+
+#else
+    const float r2 = b.radius * b.radius;
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; ++i)
+    {
+        const float dx = std::min(std::max(b.x[i], a.lower.x), a.upper.x) - b.x[i];
+        const float dy = std::min(std::max(b.y[i], a.lower.y), a.upper.y) - b.y[i];
+        float dr2 = dx * dx + dy * dy;
+        if (!is2D)
+        {
+            const float dz = std::min(std::max(b.z[i], a.lower.z), a.upper.z) - b.z[i];
+            dr2 += dz * dz;
+        }
+        if (dr2 < r2)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+#endif
+    return mask;
+}
+
+//! Check which spheres of a packet contain an AABB
+/*! The squared distance from each sphere center to the farthest point of the AABB is compared against r_sq
+   rather than the radius of the packet, so that AABBs lying entirely within a minimum distance can be
+   skipped.
+
+    \tparam is2D Whether the AABB and spheres lie in the z=0 plane, in which case the z components are skipped
+    \param a AABB
+    \param b AABBSpherePacket
+    \param r_sq Squared distance to compare against
+    \returns A bit mask in which bit i is set when all points of the AABB are closer than sqrt(r_sq) to the
+   center of sphere i
+*/
+template<bool is2D>
+inline unsigned int insideMask(const AABB& a, const AABBSpherePacket& b, float r_sq)
+{
+    unsigned int mask = 0;
+#if defined(__SSE__)
+    const __m128 lower_x = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 lower_y = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 lower_z = _mm_shuffle_ps(a.lower_v, a.lower_v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 upper_x = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 upper_y = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 upper_z = _mm_shuffle_ps(a.upper_v, a.upper_v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 r2_v = _mm_set1_ps(r_sq);
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; i += 4)
+    {
+        const __m128 x_v = _mm_load_ps(&b.x[i]);
+        const __m128 y_v = _mm_load_ps(&b.y[i]);
+        const __m128 dx_v = _mm_max_ps(_mm_sub_ps(x_v, lower_x), _mm_sub_ps(upper_x, x_v));
+        const __m128 dy_v = _mm_max_ps(_mm_sub_ps(y_v, lower_y), _mm_sub_ps(upper_y, y_v));
+        __m128 dr2_v = _mm_add_ps(_mm_mul_ps(dx_v, dx_v), _mm_mul_ps(dy_v, dy_v));
+        if (!is2D)
+        {
+            const __m128 z_v = _mm_load_ps(&b.z[i]);
+            const __m128 dz_v = _mm_max_ps(_mm_sub_ps(z_v, lower_z), _mm_sub_ps(upper_z, z_v));
+            dr2_v = _mm_add_ps(dr2_v, _mm_mul_ps(dz_v, dz_v));
+        }
+        mask |= static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(dr2_v, r2_v))) << i;
+    }
+
+#else
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; ++i)
+    {
+        const float dx = std::max(b.x[i] - a.lower.x, a.upper.x - b.x[i]);
+        const float dy = std::max(b.y[i] - a.lower.y, a.upper.y - b.y[i]);
+        float dr2 = dx * dx + dy * dy;
+        if (!is2D)
+        {
+            const float dz = std::max(b.z[i] - a.lower.z, a.upper.z - b.z[i]);
+            dr2 += dz * dz;
+        }
+        if (dr2 < r_sq)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+#endif
+    return mask;
+}
+
+//! Compute the squared distances between a point and the centers of the spheres of a packet
+/*! \tparam is2D Whether the point and spheres lie in the z=0 plane, in which case the z components are
+   skipped
+    \param b AABBSpherePacket
+    \param p Point
+    \param r_sq Output array of AABB_PACKET_SIZE squared distances
+    \returns A bit mask in which bit i is set when the point lies strictly within sphere i
+*/
+template<bool is2D>
+inline unsigned int distanceSquared(const AABBSpherePacket& b, const vec3<float>& p, float* r_sq)
+{
+    unsigned int mask = 0;
+#if defined(__SSE__)
+    const __m128 x_v = _mm_set1_ps(p.x);
+    const __m128 y_v = _mm_set1_ps(p.y);
+    const __m128 z_v = _mm_set1_ps(p.z);
+    const __m128 r2_v = _mm_set1_ps(b.radius * b.radius);
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; i += 4)
+    {
+        const __m128 dx_v = _mm_sub_ps(x_v, _mm_load_ps(&b.x[i]));
+        const __m128 dy_v = _mm_sub_ps(y_v, _mm_load_ps(&b.y[i]));
+        __m128 dr2_v = _mm_add_ps(_mm_mul_ps(dx_v, dx_v), _mm_mul_ps(dy_v, dy_v));
+        if (!is2D)
+        {
+            const __m128 dz_v = _mm_sub_ps(z_v, _mm_load_ps(&b.z[i]));
+            dr2_v = _mm_add_ps(dr2_v, _mm_mul_ps(dz_v, dz_v));
+        }
+        _mm_storeu_ps(&r_sq[i], dr2_v);
+        mask |= static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(dr2_v, r2_v))) << i;
+    }
+
+#else
+    const float r2 = b.radius * b.radius;
+    for (unsigned int i = 0; i < AABB_PACKET_SIZE; ++i)
+    {
+        const float dx = p.x - b.x[i];
+        const float dy = p.y - b.y[i];
+        r_sq[i] = dx * dx + dy * dy;
+        if (!is2D)
+        {
+            const float dz = p.z - b.z[i];
+            r_sq[i] += dz * dz;
+        }
+        if (r_sq[i] < r2)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+#endif
+    return mask;
+}
+
+//! Compute the squared distance between the closest points of two AABBs
+/*! \param a First AABB
+    \param b Second AABB
+    \returns The squared minimum distance between a and b, which is zero when they overlap
+*/
+inline float distanceSquared(const AABB& a, const AABB& b)
+{
+#if defined(__SSE__)
+    const __m128 zero_v = _mm_setzero_ps();
+    const __m128 gap_v
+        = _mm_max_ps(_mm_max_ps(_mm_sub_ps(a.lower_v, b.upper_v), _mm_sub_ps(b.lower_v, a.upper_v)), zero_v);
+    __m128 gap2_v = _mm_mul_ps(gap_v, gap_v);
+    __m128 shuf = _mm_shuffle_ps(gap2_v, gap2_v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(gap2_v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+
+#else
+    const vec3<float> gap(std::max(std::max(a.lower.x - b.upper.x, b.lower.x - a.upper.x), 0.0f),
+                          std::max(std::max(a.lower.y - b.upper.y, b.lower.y - a.upper.y), 0.0f),
+                          std::max(std::max(a.lower.z - b.upper.z, b.lower.z - a.upper.z), 0.0f));
+    return dot(gap, gap);
+
+#endif
+}
+
+//! Compute the squared distance between the farthest points of two AABBs
+/*! \param a First AABB
+    \param b Second AABB
+    \returns The squared maximum distance between a point in a and a point in b
+*/
+inline float maxDistanceSquared(const AABB& a, const AABB& b)
+{
+#if defined(__SSE__)
+    const __m128 span_v = _mm_max_ps(_mm_sub_ps(a.upper_v, b.lower_v), _mm_sub_ps(b.upper_v, a.lower_v));
+    __m128 span2_v = _mm_mul_ps(span_v, span_v);
+    __m128 shuf = _mm_shuffle_ps(span2_v, span2_v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(span2_v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+
+#else
+    const vec3<float> span(std::max(a.upper.x - b.lower.x, b.upper.x - a.lower.x),
+                           std::max(a.upper.y - b.lower.y, b.upper.y - a.lower.y),
+                           std::max(a.upper.z - b.lower.z, b.upper.z - a.lower.z));
+    return dot(span, span);
+
+#endif
+}
+
 //! Check if one AABB contains another
 /*! \param a First AABB
     \param b Second AABB
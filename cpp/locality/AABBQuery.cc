@@ -2,14 +2,18 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <tbb/parallel_sort.h>
 
 #include "AABBQuery.h"
 
 namespace freud { namespace locality {
 
-AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-    : NeighborQuery(box, points, n_points)
+AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points, bool wide_tree)
+    : NeighborQuery(box, points, n_points), m_n_changed(0), m_wide_tree(wide_tree)
 {
     // Allocate memory and create image vectors
     setupTree(m_n_points);
@@ -41,6 +45,382 @@ AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_i
     }
 }
 
+void AABBQuery::queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                           const BondBatchFunction& cf, bool parallel, bool squared_distances) const
+{
+    this->validateQueryArgs(args);
+
+    // Packets only pay off for ball queries with enough query points to fill them.
+    if (args.mode != QueryArgs::ball || n_query_points < AABB_PACKET_SIZE)
+    {
+        NeighborQuery::queryBonds(query_points, n_query_points, args, cf, parallel, squared_distances);
+        return;
+    }
+
+    // When the points are queried against themselves, the tree doubles as a
+    // tree over the query points whose leaves make well-shaped packets.
+    // The dimensionality is dispatched once here, so the traversals below
+    // drop the z components entirely for 2D boxes.
+    if (query_points == m_points && n_query_points == m_n_points
+        && n_query_points >= DUAL_TREE_MIN_QUERY_POINTS)
+    {
+        if (m_box.is2D())
+        {
+            queryBondsDualTree<true>(args, cf, parallel, squared_distances);
+        }
+        else
+        {
+            queryBondsDualTree<false>(args, cf, parallel, squared_distances);
+        }
+    }
+    else
+    {
+        if (m_box.is2D())
+        {
+            queryBondsPackets<true>(query_points, n_query_points, args, cf, parallel, squared_distances);
+        }
+        else
+        {
+            queryBondsPackets<false>(query_points, n_query_points, args, cf, parallel, squared_distances);
+        }
+    }
+}
+
+template<bool is2D>
+void AABBQuery::queryPacket(const AABBSpherePacket& packet, const unsigned int* query_point_indices,
+                            const vec3<int>* lane_images, unsigned int packet_size, unsigned int root,
+                            float r_min, bool exclude_ii, std::vector<NeighborBond>& bonds) const
+{
+    const unsigned int active_mask = (1u << packet_size) - 1;
+    const float r_min_sq = r_min * r_min;
+
+    // Stackless traversal of the subtree, entering nodes that any sphere overlaps
+    const unsigned int end_node_idx = root + m_aabb_tree.getNodeSkip(root) + 1;
+    for (unsigned int cur_node_idx = root; cur_node_idx < end_node_idx; ++cur_node_idx)
+    {
+        // Spheres whose r_min shell contains the node cannot find neighbors in it
+        const AABB& node_aabb = m_aabb_tree.getNodeAABB(cur_node_idx);
+        unsigned int mask = overlapMask<is2D>(node_aabb, packet) & active_mask;
+        if (r_min_sq > 0 && mask != 0)
+        {
+            mask &= ~insideMask<is2D>(node_aabb, packet, r_min_sq);
+        }
+        if (mask == 0)
+        {
+            // Skip ahead
+            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+            continue;
+        }
+
+        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+        {
+            for (unsigned int cur_ref_p = 0; cur_ref_p < m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                 ++cur_ref_p)
+            {
+                // Neighbor j
+                const unsigned int j = m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
+                vec3<float> pos_j(m_points[j]);
+                if (is2D)
+                {
+                    pos_j.z = 0;
+                }
+
+                // Only the query points whose sphere overlaps this leaf can have neighbors in it
+                float r_sq[AABB_PACKET_SIZE];
+                const unsigned int within_mask = distanceSquared<is2D>(packet, pos_j, r_sq) & mask;
+                if (within_mask == 0)
+                {
+                    continue;
+                }
+                for (unsigned int lane = 0; lane < packet_size; ++lane)
+                {
+                    if ((within_mask & (1u << lane)) && r_sq[lane] >= r_min_sq
+                        && !(exclude_ii && query_point_indices[lane] == j))
+                    {
+                        bonds.emplace_back(query_point_indices[lane], j, r_sq[lane], lane_images[lane]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<bool is2D>
+void AABBQuery::queryBondsPackets(const vec3<float>* query_points, unsigned int n_query_points,
+                                  const QueryArgs& args, const BondBatchFunction& cf, bool parallel,
+                                  bool squared_distances) const
+{
+    // Sort the query points along a Morton curve of their (wrapped) fractional
+    // coordinates so that consecutive query points are close to each other.
+    // The key holds the Morton code in the high bits and the index in the low bits.
+    std::vector<uint64_t> keys(n_query_points);
+    util::forLoopWrapper(
+        0, n_query_points,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i)
+            {
+                const uint64_t code = mortonCode(m_box.makeFractional<is2D>(query_points[i]), is2D);
+                keys[i] = (code << 32) | i;
+            }
+        },
+        parallel);
+    if (parallel)
+    {
+        tbb::parallel_sort(keys.begin(), keys.end());
+    }
+    else
+    {
+        std::sort(keys.begin(), keys.end());
+    }
+
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> latt_a(m_box.getLatticeVector(0));
+    const vec3<float> latt_b(m_box.getLatticeVector(1));
+    const vec3<float> latt_c(is2D ? vec3<float>(0, 0, 0) : m_box.getLatticeVector(2));
+
+    const unsigned int n_packets = (n_query_points + AABB_PACKET_SIZE - 1) / AABB_PACKET_SIZE;
+    util::forLoopWrapper(
+        0, n_packets,
+        [&](size_t begin, size_t end) {
+            AABBSpherePacket packet;
+            packet.radius = args.r_max;
+            unsigned int query_point_indices[AABB_PACKET_SIZE];
+            vec3<float> positions[AABB_PACKET_SIZE];
+            vec3<int> position_images[AABB_PACKET_SIZE];
+            vec3<int> lane_images[AABB_PACKET_SIZE];
+            std::vector<vec3<float>> image_list;
+            std::vector<vec3<int>> images;
+            std::vector<NeighborBond> bonds;
+
+            for (size_t cur_packet = begin; cur_packet != end; ++cur_packet)
+            {
+                const unsigned int first = cur_packet * AABB_PACKET_SIZE;
+                const unsigned int packet_size = std::min(AABB_PACKET_SIZE, n_query_points - first);
+
+                // Gather the packet and the fractional region it spans
+                vec3<float> frac_lower, frac_upper;
+                for (unsigned int lane = 0; lane < packet_size; ++lane)
+                {
+                    query_point_indices[lane] = static_cast<unsigned int>(keys[first + lane] & 0xffffffff);
+                    positions[lane] = query_points[query_point_indices[lane]];
+                    if (is2D)
+                    {
+                        positions[lane].z = 0;
+                    }
+
+                    // Query points outside of the box are moved into it by
+                    // whole lattice vectors like their sort keys, so that a
+                    // packet spans a compact region. Points inside of the box
+                    // are left untouched. The points found from a moved query
+                    // point are moved along with it.
+                    vec3<float> frac = m_box.makeFractional<is2D>(positions[lane]);
+                    const vec3<float> image(periodic.x ? std::floor(frac.x) : 0,
+                                            periodic.y ? std::floor(frac.y) : 0,
+                                            (!is2D && periodic.z) ? std::floor(frac.z) : 0);
+                    position_images[lane] = vec3<int>(static_cast<int>(image.x), static_cast<int>(image.y),
+                                                      static_cast<int>(image.z));
+                    if (image.x != 0 || image.y != 0 || image.z != 0)
+                    {
+                        positions[lane] -= image.x * latt_a + image.y * latt_b + image.z * latt_c;
+                        frac -= image;
+                    }
+                    if (lane == 0)
+                    {
+                        frac_lower = frac_upper = frac;
+                    }
+                    else
+                    {
+                        frac_lower.x = std::min(frac_lower.x, frac.x);
+                        frac_lower.y = std::min(frac_lower.y, frac.y);
+                        frac_lower.z = std::min(frac_lower.z, frac.z);
+                        frac_upper.x = std::max(frac_upper.x, frac.x);
+                        frac_upper.y = std::max(frac_upper.y, frac.y);
+                        frac_upper.z = std::max(frac_upper.z, frac.z);
+                    }
+                }
+                const unsigned int n_images
+                    = getImageVectors(frac_lower, frac_upper, args.r_max, image_list, images);
+
+                bonds.clear();
+                for (unsigned int cur_image = 0; cur_image < n_images; ++cur_image)
+                {
+                    // Unused lanes repeat the last query point and are masked out
+                    for (unsigned int lane = 0; lane < AABB_PACKET_SIZE; ++lane)
+                    {
+                        const unsigned int source_lane = std::min(lane, packet_size - 1);
+                        const vec3<float> pos_i_image = positions[source_lane] + image_list[cur_image];
+                        packet.x[lane] = pos_i_image.x;
+                        packet.y[lane] = pos_i_image.y;
+                        packet.z[lane] = pos_i_image.z;
+                        lane_images[lane] = position_images[source_lane] + images[cur_image];
+                    }
+                    queryPacket<is2D>(packet, query_point_indices, lane_images, packet_size, 0, args.r_min,
+                                      args.exclude_ii, bonds);
+                }
+                if (!squared_distances)
+                {
+                    sqrtBondDistances(bonds);
+                }
+                cf(bonds);
+            }
+        },
+        parallel);
+}
+
+template<bool is2D>
+void AABBQuery::queryBondsDualTree(const QueryArgs& args, const BondBatchFunction& cf, bool parallel,
+                                   bool squared_distances) const
+{
+    const float r_max_sq = args.r_max * args.r_max;
+    const float r_min_sq = args.r_min * args.r_min;
+
+    // The query points are the points of this object, so the existing tree
+    // serves as the query tree.
+    const AABBTree* query_tree = &m_aabb_tree;
+
+    // Split the query tree into subtrees that are processed independently.
+    // Each query point belongs to exactly one subtree, so all of its bonds
+    // are found by the same task.
+    std::vector<unsigned int> task_roots;
+    for (unsigned int cur_node_idx = 0; cur_node_idx < query_tree->getNumNodes();)
+    {
+        const unsigned int skip = query_tree->getNodeSkip(cur_node_idx);
+        if (skip < DUAL_TREE_TASK_NODES)
+        {
+            task_roots.push_back(cur_node_idx);
+            cur_node_idx += skip + 1;
+        }
+        else
+        {
+            ++cur_node_idx;
+        }
+    }
+
+    // The size of a node, used to decide which tree to descend. The point
+    // tree is only descended while its node is much larger than the query
+    // node: query leaves then traverse the remaining subtree as packets,
+    // which is cheaper than testing many small pairs of nodes.
+    auto node_size = [](const AABB& aabb) {
+        const vec3<float> extent = aabb.getUpper() - aabb.getLower();
+        return extent.x + extent.y + extent.z;
+    };
+
+    util::forLoopWrapper(
+        0, task_roots.size(),
+        [&](size_t begin, size_t end) {
+            AABBSpherePacket packet;
+            packet.radius = args.r_max;
+            unsigned int query_point_indices[AABB_PACKET_SIZE];
+            vec3<int> lane_images[AABB_PACKET_SIZE];
+            std::vector<vec3<float>> image_list;
+            std::vector<vec3<int>> images;
+            std::vector<NeighborBond> bonds;
+            std::vector<std::pair<unsigned int, unsigned int>> node_pairs;
+
+            for (size_t cur_task = begin; cur_task != end; ++cur_task)
+            {
+                const unsigned int task_root = task_roots[cur_task];
+
+                // The fractional region spanned by the subtree is bounded by
+                // the fractional coordinates of the corners of its AABB.
+                const AABB& root_aabb = query_tree->getNodeAABB(task_root);
+                const vec3<float> lower = root_aabb.getLower();
+                const vec3<float> upper = root_aabb.getUpper();
+                vec3<float> frac_lower, frac_upper;
+                for (unsigned int corner = 0; corner < 8; ++corner)
+                {
+                    const vec3<float> frac = m_box.makeFractional<is2D>(
+                        vec3<float>((corner & 1) ? upper.x : lower.x, (corner & 2) ? upper.y : lower.y,
+                                    (corner & 4) ? upper.z : lower.z));
+                    if (corner == 0)
+                    {
+                        frac_lower = frac_upper = frac;
+                    }
+                    else
+                    {
+                        frac_lower.x = std::min(frac_lower.x, frac.x);
+                        frac_lower.y = std::min(frac_lower.y, frac.y);
+                        frac_lower.z = std::min(frac_lower.z, frac.z);
+                        frac_upper.x = std::max(frac_upper.x, frac.x);
+                        frac_upper.y = std::max(frac_upper.y, frac.y);
+                        frac_upper.z = std::max(frac_upper.z, frac.z);
+                    }
+                }
+                const unsigned int n_images
+                    = getImageVectors(frac_lower, frac_upper, args.r_max, image_list, images);
+
+                bonds.clear();
+                for (unsigned int cur_image = 0; cur_image < n_images; ++cur_image)
+                {
+                    const vec3<float>& image = image_list[cur_image];
+                    std::fill(lane_images, lane_images + AABB_PACKET_SIZE, images[cur_image]);
+                    node_pairs.clear();
+                    node_pairs.emplace_back(task_root, 0);
+                    while (!node_pairs.empty())
+                    {
+                        const unsigned int query_node = node_pairs.back().first;
+                        const unsigned int node = node_pairs.back().second;
+                        node_pairs.pop_back();
+
+                        AABB query_aabb = query_tree->getNodeAABB(query_node);
+                        query_aabb.translate(image);
+                        const AABB& node_aabb = m_aabb_tree.getNodeAABB(node);
+                        if (!(distanceSquared(query_aabb, node_aabb) < r_max_sq)
+                            || (r_min_sq > 0 && maxDistanceSquared(query_aabb, node_aabb) < r_min_sq))
+                        {
+                            continue;
+                        }
+
+                        if (query_tree->isNodeLeaf(query_node))
+                        {
+                            // Traverse the subtree of points with packets of the leaf's query points
+                            const unsigned int n_leaf_points = query_tree->getNodeNumParticles(query_node);
+                            for (unsigned int first = 0; first < n_leaf_points; first += AABB_PACKET_SIZE)
+                            {
+                                const unsigned int packet_size
+                                    = std::min(AABB_PACKET_SIZE, n_leaf_points - first);
+                                for (unsigned int lane = 0; lane < AABB_PACKET_SIZE; ++lane)
+                                {
+                                    const unsigned int i = query_tree->getNodeParticleTag(
+                                        query_node, first + std::min(lane, packet_size - 1));
+                                    query_point_indices[lane] = i;
+                                    vec3<float> pos_i(m_points[i]);
+                                    if (is2D)
+                                    {
+                                        pos_i.z = 0;
+                                    }
+                                    const vec3<float> pos_i_image = pos_i + image;
+                                    packet.x[lane] = pos_i_image.x;
+                                    packet.y[lane] = pos_i_image.y;
+                                    packet.z[lane] = pos_i_image.z;
+                                }
+                                queryPacket<is2D>(packet, query_point_indices, lane_images, packet_size,
+                                                  node, args.r_min, args.exclude_ii, bonds);
+                            }
+                        }
+                        else if (m_aabb_tree.isNodeLeaf(node)
+                                 || float(4.0) * node_size(query_aabb) >= node_size(node_aabb))
+                        {
+                            node_pairs.emplace_back(query_tree->getNodeLeft(query_node), node);
+                            node_pairs.emplace_back(query_tree->getNodeRight(query_node), node);
+                        }
+                        else
+                        {
+                            node_pairs.emplace_back(query_node, m_aabb_tree.getNodeLeft(node));
+                            node_pairs.emplace_back(query_node, m_aabb_tree.getNodeRight(node));
+                        }
+                    }
+                }
+                if (!squared_distances)
+                {
+                    sqrtBondDistances(bonds);
+                }
+                cf(bonds);
+            }
+        },
+        parallel);
+}
+
 void AABBQuery::setupTree(unsigned int Np)
 {
     m_aabbs.resize(Np);
@@ -56,41 +436,205 @@ void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
         if (m_box.is2D())
             my_pos.z = 0;
         m_aabbs[i] = AABB(my_pos, i);
+
+        // Track the extent of the points along each lattice vector, which is
+        // used to prune periodic images that cannot contain any neighbors.
+        const vec3<float> frac(m_box.makeFractional(my_pos));
+        if (i == 0)
+        {
+            m_frac_lower = m_frac_upper = frac;
+        }
+        else
+        {
+            m_frac_lower.x = std::min(m_frac_lower.x, frac.x);
+            m_frac_lower.y = std::min(m_frac_lower.y, frac.y);
+            m_frac_lower.z = std::min(m_frac_lower.z, frac.z);
+            m_frac_upper.x = std::max(m_frac_upper.x, frac.x);
+            m_frac_upper.y = std::max(m_frac_upper.y, frac.y);
+            m_frac_upper.z = std::max(m_frac_upper.z, frac.z);
+        }
     }
 
     // Call the tree build routine, one tree per type
     m_aabb_tree.buildTree(m_aabbs.data(), Np);
+    if (m_wide_tree)
+    {
+        m_aabb_wide_tree.buildTree(m_aabb_tree);
+    }
+    m_n_changed = 0;
 }
 
-void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
+bool AABBQuery::rebuildIfStale(unsigned int n_changed)
 {
-    box::Box box = m_neighbor_query->getBox();
-    vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
-    vec3<bool> periodic = box.getPeriodic();
-    if (_check_r_max)
+    // Rebuilding once as many points changed as there are points amortizes
+    // the O(N log N) build over the updates.
+    m_n_changed += n_changed;
+    if (m_n_changed <= m_n_points)
+    {
+        return false;
+    }
+    setupTree(m_n_points);
+    buildTree(m_points, m_n_points);
+    return true;
+}
+
+void AABBQuery::refitLeaves(std::vector<unsigned int>& leaves)
+{
+    std::sort(leaves.begin(), leaves.end());
+    leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+    for (const unsigned int leaf : leaves)
     {
-        if ((periodic.x && nearest_plane_distance.x <= r_max * 2.0)
-            || (periodic.y && nearest_plane_distance.y <= r_max * 2.0)
-            || (!box.is2D() && periodic.z && nearest_plane_distance.z <= r_max * 2.0))
+        // An empty leaf keeps its bounds, which are never entered since it has no points.
+        const unsigned int n_leaf_points = m_aabb_tree.getNodeNumParticles(leaf);
+        if (n_leaf_points == 0)
         {
-            throw std::runtime_error("The AABBQuery r_max is too large for this box.");
+            continue;
+        }
+        vec3<float> lower, upper;
+        for (unsigned int j = 0; j < n_leaf_points; ++j)
+        {
+            vec3<float> pos(m_points[m_aabb_tree.getNodeParticleTag(leaf, j)]);
+            if (m_box.is2D())
+                pos.z = 0;
+            if (j == 0)
+            {
+                lower = upper = pos;
+            }
+            else
+            {
+                lower.x = std::min(lower.x, pos.x);
+                lower.y = std::min(lower.y, pos.y);
+                lower.z = std::min(lower.z, pos.z);
+                upper.x = std::max(upper.x, pos.x);
+                upper.y = std::max(upper.y, pos.y);
+                upper.z = std::max(upper.z, pos.z);
+            }
+        }
+        m_aabb_tree.refit(leaf, AABB(lower, upper));
+        if (m_wide_tree)
+        {
+            m_aabb_wide_tree.refit(m_aabb_tree, leaf);
         }
     }
+}
 
-    // Now compute the image vectors
-    // Each dimension increases by one power of 3
-    unsigned int n_dim_periodic = (unsigned int) (periodic.x + periodic.y + (!box.is2D()) * periodic.z);
-    m_n_images = 1;
-    for (unsigned int dim = 0; dim < n_dim_periodic; ++dim)
+void AABBQuery::growFractionalExtent(const vec3<float>& point)
+{
+    vec3<float> pos(point);
+    if (m_box.is2D())
+        pos.z = 0;
+    const vec3<float> frac(m_box.makeFractional(pos));
+    m_frac_lower.x = std::min(m_frac_lower.x, frac.x);
+    m_frac_lower.y = std::min(m_frac_lower.y, frac.y);
+    m_frac_lower.z = std::min(m_frac_lower.z, frac.z);
+    m_frac_upper.x = std::max(m_frac_upper.x, frac.x);
+    m_frac_upper.y = std::max(m_frac_upper.y, frac.y);
+    m_frac_upper.z = std::max(m_frac_upper.z, frac.z);
+}
+
+void AABBQuery::updatePoints(const vec3<float>* points, const unsigned int* indices, unsigned int n_indices)
+{
+    validatePointIndices(points, m_n_points, indices, n_indices, true);
+    m_points = points;
+    if (rebuildIfStale(n_indices))
     {
-        m_n_images *= 3;
+        return;
     }
 
-    // Reallocate memory if necessary
-    if (m_n_images > m_image_list.size())
+    // Points that leave the bounds of their leaf are moved to the leaf that
+    // grows the least, so that leaves stay compact when points move far.
+    std::vector<unsigned int> leaves;
+    leaves.reserve(2 * n_indices);
+    for (unsigned int k = 0; k < n_indices; ++k)
     {
-        m_image_list.resize(m_n_images);
+        const unsigned int i = indices[k];
+        vec3<float> pos(points[i]);
+        if (m_box.is2D())
+            pos.z = 0;
+        const AABB point_aabb(pos, i);
+        const unsigned int leaf = m_aabb_tree.getParticleNode(i);
+        leaves.push_back(leaf);
+        if (!contains(m_aabb_tree.getNodeAABB(leaf), point_aabb))
+        {
+            m_aabb_tree.remove(i);
+            leaves.push_back(m_aabb_tree.insert(i, point_aabb));
+        }
+        growFractionalExtent(pos);
     }
+    refitLeaves(leaves);
+}
+
+void AABBQuery::insertPoints(const vec3<float>* points, unsigned int n_points)
+{
+    validateInsertedPoints(points, n_points);
+    const unsigned int old_n_points = m_n_points;
+    m_points = points;
+    m_n_points = n_points;
+    if (rebuildIfStale(n_points - old_n_points))
+    {
+        return;
+    }
+
+    for (unsigned int i = old_n_points; i < n_points; ++i)
+    {
+        vec3<float> pos(points[i]);
+        if (m_box.is2D())
+            pos.z = 0;
+        const unsigned int leaf = m_aabb_tree.insert(i, AABB(pos, i));
+        if (leaf == INVALID_NODE)
+        {
+            // All leaves are full
+            setupTree(m_n_points);
+            buildTree(m_points, m_n_points);
+            return;
+        }
+        if (m_wide_tree)
+        {
+            m_aabb_wide_tree.refit(m_aabb_tree, leaf);
+        }
+        growFractionalExtent(pos);
+    }
+}
+
+void AABBQuery::removePoints(const vec3<float>* points, unsigned int n_points, const unsigned int* indices,
+                             unsigned int n_indices)
+{
+    const std::vector<unsigned int> removed = sortRemovedPointIndices(n_points, indices, n_indices);
+
+    // The last point takes the index of each removed point, staying in its leaf.
+    std::vector<unsigned int> leaves;
+    leaves.reserve(n_indices);
+    unsigned int last = m_n_points;
+    for (const unsigned int i : removed)
+    {
+        --last;
+        leaves.push_back(m_aabb_tree.remove(i));
+        if (i != last)
+        {
+            m_aabb_tree.reindex(last, i);
+        }
+    }
+    m_points = points;
+    m_n_points = n_points;
+    if (!rebuildIfStale(n_indices))
+    {
+        refitLeaves(leaves);
+    }
+}
+
+void AABBIterator::updateImageVectors(float r_max)
+{
+    const vec3<float> frac_query = m_aabb_query->getBox().makeFractional(m_query_point);
+    m_n_images = m_aabb_query->getImageVectors(frac_query, frac_query, r_max, m_image_list, m_images);
+}
+
+unsigned int AABBQuery::getImageVectors(const vec3<float>& frac_lower, const vec3<float>& frac_upper,
+                                        float r_max, std::vector<vec3<float>>& image_list,
+                                        std::vector<vec3<int>>& images) const
+{
+    const box::Box& box = m_box;
+    vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
+    vec3<bool> periodic = box.getPeriodic();
 
     vec3<float> latt_a = vec3<float>(box.getLatticeVector(0));
     vec3<float> latt_b = vec3<float>(box.getLatticeVector(1));
@@ -100,104 +644,220 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
         latt_c = vec3<float>(box.getLatticeVector(2));
     }
 
+    // The query sphere spans r_max / d in fractional coordinates along each
+    // lattice vector, where d is the distance between the corresponding box
+    // planes. An image along a lattice vector is only needed if the translated
+    // sphere around some point of the query region overlaps the fractional
+    // extent of the points in the tree. The half widths are padded slightly
+    // so that rounding in the fractional transform can never discard a
+    // neighbor.
+    const float padding = float(1e-5);
+    vec3<float> half_width(r_max / nearest_plane_distance.x + padding,
+                           r_max / nearest_plane_distance.y + padding, 0);
+    if (!box.is2D())
+    {
+        half_width.z = r_max / nearest_plane_distance.z + padding;
+    }
+
+    // Range of image shifts along a lattice vector for which the translated
+    // query region reaches the points. When r_max exceeds half the box, this
+    // includes images beyond the nearest ones, so a point may be found
+    // through several images. The range only covers the images that can reach
+    // the points, so a query point far outside the box does not produce a
+    // range spanning all the images in between.
+    auto image_range = [](bool is_periodic, float query_lower, float query_upper, float width, float lower,
+                          float upper, int& min_image, int& max_image) {
+        min_image = max_image = 0;
+        if (is_periodic)
+        {
+            const float min_shift = std::ceil(lower - query_upper - width);
+            const float max_shift = std::floor(upper - query_lower + width);
+            // Image shifts are exact as floats up to 2^24, and the checks
+            // also reject non-finite coordinates.
+            const float max_exact_shift = float(1 << 24);
+            if (!(min_shift >= -max_exact_shift && max_shift <= max_exact_shift))
+            {
+                throw std::invalid_argument("Query points must lie within 2^24 box lengths of the box.");
+            }
+            min_image = static_cast<int>(min_shift);
+            max_image = static_cast<int>(max_shift);
+        }
+    };
+    int min_i, max_i, min_j, max_j, min_k, max_k;
+    image_range(periodic.x, frac_lower.x, frac_upper.x, half_width.x, m_frac_lower.x, m_frac_upper.x, min_i,
+                max_i);
+    image_range(periodic.y, frac_lower.y, frac_upper.y, half_width.y, m_frac_lower.y, m_frac_upper.y, min_j,
+                max_j);
+    image_range(periodic.z && !box.is2D(), frac_lower.z, frac_upper.z, half_width.z, m_frac_lower.z,
+                m_frac_upper.z, min_k, max_k);
+
+    // Reallocate memory if necessary. The zero image is always searched first,
+    // even when it lies outside the range.
+    auto range_size = [](int min_image, int max_image) {
+        return static_cast<size_t>(std::max(max_image - min_image + 1, 0));
+    };
+    const size_t max_images
+        = range_size(min_i, max_i) * range_size(min_j, max_j) * range_size(min_k, max_k) + 1;
+    if (max_images > std::numeric_limits<unsigned int>::max())
+    {
+        throw std::invalid_argument("The query requires too many periodic images; r_max is too large for "
+                                    "the box.");
+    }
+    if (max_images > image_list.size())
+    {
+        image_list.resize(max_images);
+        images.resize(max_images);
+    }
+
     // There is always at least 1 image, which we put as our first thing to look at
-    m_image_list[0] = vec3<float>(0.0, 0.0, 0.0);
+    image_list[0] = vec3<float>(0.0, 0.0, 0.0);
+    images[0] = vec3<int>(0, 0, 0);
 
     // Iterate over all other combinations of images
     unsigned int n_images = 1;
-    for (int i = -1; i <= 1 && n_images < m_n_images; ++i)
+    for (int i = min_i; i <= max_i; ++i)
     {
-        for (int j = -1; j <= 1 && n_images < m_n_images; ++j)
+        for (int j = min_j; j <= max_j; ++j)
         {
-            for (int k = -1; k <= 1 && n_images < m_n_images; ++k)
+            for (int k = min_k; k <= max_k; ++k)
             {
                 if (!(i == 0 && j == 0 && k == 0))
                 {
-                    // Skip any periodic images if we don't have periodicity
-                    if (i != 0 && !periodic.x)
-                        continue;
-                    if (j != 0 && !periodic.y)
-                        continue;
-                    if (k != 0 && (box.is2D() || !periodic.z))
-                        continue;
-
-                    m_image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
+                    image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
+                    images[n_images] = vec3<int>(-i, -j, -k);
                     ++n_images;
                 }
             }
         }
     }
+
+    return n_images;
 }
 
 NeighborBond AABBQueryBallIterator::next()
+{
+    // Dispatch on the dimensionality once per call rather than once per candidate
+    if (m_neighbor_query->getBox().is2D())
+    {
+        return nextImpl<true>();
+    }
+    return nextImpl<false>();
+}
+
+template<bool is2D> NeighborBond AABBQueryBallIterator::nextImpl()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
     // Read in the position of current point
     vec3<float> pos_i(m_query_point);
-    if (m_neighbor_query->getBox().is2D())
+    if (is2D)
     {
         pos_i.z = 0;
     }
 
     // Loop over image vectors
+    const AABBTree& tree = m_aabb_query->m_aabb_tree;
+    const AABBWideTree& wide_tree = m_aabb_query->m_aabb_wide_tree;
+    const bool use_wide_tree = m_aabb_query->usesWideTree();
     while (cur_image < m_n_images)
     {
         // Make an AABB for the image of this point
         vec3<float> pos_i_image = pos_i + m_image_list[cur_image];
         AABBSphere asphere = AABBSphere(pos_i_image, m_r_max);
 
-        // Stackless traversal of the tree
-        while (cur_node_idx < m_aabb_query->m_aabb_tree.getNumNodes())
+        // Depth first traversal of the wide or binary tree
+        while (true)
         {
-            if (overlap(m_aabb_query->m_aabb_tree.getNodeAABB(cur_node_idx), asphere))
+            if (cur_leaf_idx != INVALID_NODE)
             {
-                if (m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                while (cur_ref_p < tree.getNodeNumParticles(cur_leaf_idx))
                 {
-                    while (cur_ref_p < m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx))
+                    // Neighbor j
+                    const unsigned int j = tree.getNodeParticleTag(cur_leaf_idx, cur_ref_p);
+                    // Increment before possible return.
+                    cur_ref_p++;
+
+                    // Skip ii matches immediately if requested.
+                    if (m_exclude_ii && m_query_point_idx == j)
                     {
-                        // Neighbor j
-                        const unsigned int j
-                            = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
-                        // Increment before possible return.
-                        cur_ref_p++;
-
-                        // Skip ii matches immediately if requested.
-                        if (m_exclude_ii && m_query_point_idx == j)
-                        {
-                            continue;
-                        }
+                        continue;
+                    }
 
-                        // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
-                        if (m_neighbor_query->getBox().is2D())
-                        {
-                            pos_j.z = 0;
-                        }
+                    // Read in the position of j
+                    const vec3<float> pos_j((*m_neighbor_query)[j]);
 
-                        // Compute distance
-                        const vec3<float> r_ij = pos_j - pos_i_image;
-                        const float r_sq = dot(r_ij, r_ij);
+                    // Compute distance. In 2D the z component of the image
+                    // vectors is zero, so it is dropped.
+                    const vec3<float> r_ij = pos_j - pos_i_image;
+                    const float r_sq = is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij);
 
-                        // Check ii exclusion before including the pair.
-                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                        {
-                            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
-                        }
+                    // Check ii exclusion before including the pair.
+                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                    {
+                        return NeighborBond(m_query_point_idx, j,
+                                            m_squared_distances ? r_sq : std::sqrt(r_sq),
+                                            m_images[cur_image]);
                     }
                 }
+                cur_leaf_idx = INVALID_NODE;
             }
-            else
+
+            if (m_node_stack.empty())
+            {
+                break;
+            }
+            const unsigned int cur_node_idx = m_node_stack.back();
+            m_node_stack.pop_back();
+
+            if (!use_wide_tree)
+            {
+                // Search the binary node if the sphere overlaps it, skipping
+                // nodes that lie entirely within r_min
+                const AABB& node_aabb = tree.getNodeAABB(cur_node_idx);
+                if (!overlap(node_aabb, asphere)
+                    || (r_min_sq > 0 && maxDistanceSquared(AABB(pos_i_image, 0.0f), node_aabb) < r_min_sq))
+                {
+                    continue;
+                }
+                if (tree.isNodeLeaf(cur_node_idx))
+                {
+                    cur_leaf_idx = cur_node_idx;
+                    cur_ref_p = 0;
+                }
+                else
+                {
+                    m_node_stack.push_back(tree.getNodeRight(cur_node_idx));
+                    m_node_stack.push_back(tree.getNodeLeft(cur_node_idx));
+                }
+                continue;
+            }
+
+            if (cur_node_idx & WIDE_LEAF_FLAG)
             {
-                // Skip ahead
-                cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(cur_node_idx);
+                cur_leaf_idx = cur_node_idx & ~WIDE_LEAF_FLAG;
+                cur_ref_p = 0;
+                continue;
+            }
+
+            // Test all children of the node at once and search the overlapping
+            // ones, skipping children that lie entirely within r_min
+            const AABBWideNode& node = wide_tree.getNode(cur_node_idx);
+            unsigned int mask = overlapMask<is2D>(node, asphere);
+            if (r_min_sq > 0)
+            {
+                mask &= ~insideMask<is2D>(node, pos_i_image, r_min_sq);
+            }
+            for (unsigned int child = 0; child < node.num_children; ++child)
+            {
+                if (mask & (1u << child))
+                {
+                    m_node_stack.push_back(node.children[child]);
+                }
             }
-            cur_node_idx++;
-            cur_ref_p = 0;
-        } // end stackless search
+        } // end tree search
         cur_image++;
-        cur_node_idx = 0;
+        m_node_stack.push_back(0);
     } // end loop over images
 
     m_finished = true;
@@ -224,17 +884,16 @@ NeighborBond AABBQueryIterator::next()
         // Continually perform ball queries until the termination conditions are met.
         while (true)
         {
-            // Perform a ball query to get neighbors. To ensure that we allow
-            // ball queries to exceed their normal boundaries, we pass false as
-            // the _check_r_max. We also can't depend on the ball query for
-            // r_min filtering because we're querying beyond the normally safe
-            // bounds, so we have to do it in this class.
+            // Perform a ball query to get neighbors. We can't depend on the
+            // ball query for r_min filtering because beyond the normally safe
+            // bounds a point may be found through several images, so we have
+            // to do it in this class.
             m_current_neighbors.clear();
-            m_all_distances.clear();
+            m_nearest_bonds.clear();
             m_query_points_below_r_min.clear();
             std::shared_ptr<NeighborQueryPerPointIterator> ball_it = std::make_shared<AABBQueryBallIterator>(
                 static_cast<const AABBQuery*>(m_neighbor_query), m_query_point, m_query_point_idx,
-                std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false);
+                std::min(m_r_cur, m_r_max), 0, m_exclude_ii);
             while (!ball_it->end())
             {
                 NeighborBond nb = ball_it->next();
@@ -248,10 +907,10 @@ NeighborBond AABBQueryIterator::next()
                     // distance, use the map instead of the vector.
                     if (m_search_extended)
                     {
-                        if (!m_all_distances.count(nb.point_idx)
-                            || m_all_distances[nb.point_idx] > nb.distance)
+                        if (!m_nearest_bonds.count(nb.point_idx)
+                            || m_nearest_bonds[nb.point_idx].distance > nb.distance)
                         {
-                            m_all_distances[nb.point_idx] = nb.distance;
+                            m_nearest_bonds[nb.point_idx] = nb;
                             if (nb.distance < m_r_min)
                             {
                                 m_query_points_below_r_min.insert(nb.point_idx);
@@ -276,18 +935,18 @@ NeighborBond AABBQueryIterator::next()
                 break;
             }
             else if ((m_r_cur >= m_r_max) || (m_r_cur >= max_plane_distance)
-                     || ((m_all_distances.size() - m_query_points_below_r_min.size()) >= m_num_neighbors))
+                     || ((m_nearest_bonds.size() - m_query_points_below_r_min.size()) >= m_num_neighbors))
             {
                 // Once this condition is reached, either we found enough
                 // neighbors beyond the normal min_plane_distance
                 // condition or we conclude that there are not enough
                 // neighbors left in the system.
-                for (std::map<unsigned int, float>::const_iterator it(m_all_distances.begin());
-                     it != m_all_distances.end(); it++)
+                for (std::map<unsigned int, NeighborBond>::const_iterator it(m_nearest_bonds.begin());
+                     it != m_nearest_bonds.end(); it++)
                 {
-                    if (it->second >= m_r_min)
+                    if (it->second.distance >= m_r_min)
                     {
-                        m_current_neighbors.emplace_back(m_query_point_idx, it->first, it->second);
+                        m_current_neighbors.emplace_back(it->second);
                     }
                 }
                 std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
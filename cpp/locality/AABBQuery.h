@@ -4,6 +4,7 @@
 #ifndef AABBQUERY_H
 #define AABBQUERY_H
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "AABBTree.h"
+#include "AABBWideTree.h"
 #include "Box.h"
 #include "NeighborQuery.h"
 
@@ -21,14 +23,74 @@
  * the tree encloses all child AABBs. A leaf AABB holds multiple particles. The
  * tree is constructed in a balanced way using a heuristic to minimize AABB
  * volume. We build one tree per particle type, and use point AABBs for the
- * particles. The neighbor list is built by traversing down the tree with an
- * AABB that encloses the pairwise cutoff for the particle. Periodic boundaries
- * are treated by translating the query AABB by all possible image vectors,
- * many of which are trivially rejected for not intersecting the root node.
+ * particles. By default, the binary tree is collapsed into a wide tree (see
+ * AABBWideTree.h) whose nodes store the bounds of all their children in
+ * SIMD-friendly form. The neighbors of a single query point are found by
+ * traversing down the wide tree, or the binary tree if no wide tree is built,
+ * with a sphere of the pairwise cutoff radius. Periodic boundaries
+ * are treated by translating the query AABB by image vectors. Only images for
+ * which the translated query sphere can reach the region spanned by the points
+ * (measured in fractional coordinates along each lattice vector) are
+ * traversed, so query points far from the box faces only search one image.
+ * Since the images are enumerated from the extent of the query sphere, r_max
+ * may exceed half of the box, in which case a point is reported once for
+ * every image within r_max of the query point. Nodes whose farthest point is
+ * closer than r_min to the query point are skipped as well, so queries of
+ * thin shells only descend into the nodes that the shell crosses.
+ *
+ * Bulk ball queries (see NeighborQuery::queryBonds) share traversal work
+ * between nearby query points. Query points are sorted along a Morton curve
+ * and traversed in packets of AABB_PACKET_SIZE points: a node is entered if
+ * the query sphere of any point in the packet overlaps it, and all spheres of
+ * the packet are tested against a node at once. When a large set of points
+ * is queried against itself, the tree also serves as a tree over the query
+ * points and both are descended together (a dual-tree traversal): a subtree
+ * of query points discards a region of the tree with a single test, and each
+ * query leaf then traverses the remaining region as packets.
+ *
+ * Points can be moved, inserted and removed without rebuilding the trees.
+ * Inserted points, and moved points that leave the bounds of their leaf, are
+ * added to the leaf with free slots whose bounds grow the least. The bounds
+ * of the leaves that changed are then recomputed from the points they hold
+ * and propagated to their ancestors. The tree topology is not adapted to the
+ * new positions, so the trees are rebuilt once the number of points changed
+ * since the last build exceeds the number of points, which keeps updates at
+ * O(log N) amortized time per point.
  */
 
 namespace freud { namespace locality {
 
+//! Minimum number of points for which bulk ball queries of the points against themselves use dual-tree
+//! traversal.
+const unsigned int DUAL_TREE_MIN_QUERY_POINTS = 4096;
+//! Maximum number of query tree nodes in the subtree handled by a single dual-tree task.
+const unsigned int DUAL_TREE_TASK_NODES = 32;
+
+//! Spread the lowest 10 bits of an integer so that two zero bits separate each of them.
+inline unsigned int spreadBits(unsigned int v)
+{
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+//! Get the Morton code of the cell of a point in a grid of 1024 cells along each box vector.
+/*! \param frac The fractional coordinates of the point, which are wrapped into the box.
+ *  \param is2D Whether the box is 2D, in which case the z coordinate is ignored.
+ */
+inline unsigned int mortonCode(vec3<float> frac, bool is2D)
+{
+    frac.x -= std::floor(frac.x);
+    frac.y -= std::floor(frac.y);
+    frac.z -= std::floor(frac.z);
+    const unsigned int cell_x = std::min(static_cast<unsigned int>(frac.x * 1024.0f), 1023u);
+    const unsigned int cell_y = std::min(static_cast<unsigned int>(frac.y * 1024.0f), 1023u);
+    const unsigned int cell_z = is2D ? 0 : std::min(static_cast<unsigned int>(frac.z * 1024.0f), 1023u);
+    return spreadBits(cell_x) | (spreadBits(cell_y) << 1) | (spreadBits(cell_z) << 2);
+}
+
 class AABBQuery : public NeighborQuery
 {
 public:
@@ -36,7 +98,14 @@ public:
     AABBQuery();
 
     //! New-style constructor.
-    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+    /*! \param box The simulation box.
+     *  \param points The points to build the tree from.
+     *  \param n_points The number of points.
+     *  \param wide_tree Whether to collapse the binary tree into a wide tree
+     *         for queries of single points. Bulk packet and dual-tree queries
+     *         always traverse the binary tree.
+     */
+    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points, bool wide_tree = true);
 
     //! Destructor
     ~AABBQuery();
@@ -49,7 +118,65 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
 
-    AABBTree m_aabb_tree; //!< AABB tree of points
+    //! Implementation of bulk queries for AABBQuery (see NeighborQuery.h for documentation).
+    /*! Ball queries are traversed with packets of query points, or with a
+     *  dual-tree traversal when many points are queried against themselves.
+     *  Nearest neighbor queries are performed point by point.
+     */
+    virtual void queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                            const BondBatchFunction& cf, bool parallel = true,
+                            bool squared_distances = false) const;
+
+    //! Move the points between leaves as needed and refit the leaves (see NeighborQuery::updatePoints).
+    virtual void updatePoints(const vec3<float>* points, const unsigned int* indices, unsigned int n_indices);
+
+    //! Insert the new points into leaves with free slots (see NeighborQuery::insertPoints).
+    virtual void insertPoints(const vec3<float>* points, unsigned int n_points);
+
+    //! Remove the points from their leaves (see NeighborQuery::removePoints).
+    virtual void removePoints(const vec3<float>* points, unsigned int n_points, const unsigned int* indices,
+                              unsigned int n_indices);
+
+    //! Compute the image vectors to search for query points in a region.
+    /*! Only images for which a sphere of radius r_max around some point of the
+     *  fractional region [frac_lower, frac_upper] can intersect the fractional
+     *  extent of the points in the tree are retained. There is no limit on
+     *  r_max: when the sphere spans more than half of the box, images beyond
+     *  the nearest ones are included as needed. The zero image is always the
+     *  first entry. Throws std::invalid_argument if the region is not finite
+     *  or lies too far from the box for its images to be represented exactly.
+     *
+     *  \param frac_lower Lower bound of the fractional coordinates of the query region.
+     *  \param frac_upper Upper bound of the fractional coordinates of the query region.
+     *  \param r_max The query distance.
+     *  \param image_list Output list of translation vectors, resized as needed.
+     *  \param images Output list of the images of the points found through each translation
+     *                vector (its negated multiples of the lattice vectors), resized as needed.
+     *  \returns The number of images in image_list to search.
+     */
+    unsigned int getImageVectors(const vec3<float>& frac_lower, const vec3<float>& frac_upper, float r_max,
+                                 std::vector<vec3<float>>& image_list, std::vector<vec3<int>>& images) const;
+
+    //! Get the lower bound of the fractional coordinates of all points in the tree.
+    const vec3<float>& getFractionalLower() const
+    {
+        return m_frac_lower;
+    }
+
+    //! Get the upper bound of the fractional coordinates of all points in the tree.
+    const vec3<float>& getFractionalUpper() const
+    {
+        return m_frac_upper;
+    }
+
+    //! Whether queries of single points traverse the wide tree.
+    bool usesWideTree() const
+    {
+        return m_wide_tree;
+    }
+
+    AABBTree m_aabb_tree;          //!< AABB tree of points
+    AABBWideTree m_aabb_wide_tree; //!< Wide AABB tree collapsed from m_aabb_tree, if used
 
 protected:
     //! Validate the combination of specified arguments.
@@ -107,7 +234,50 @@ private:
     //! Driver to build AABB trees
     void buildTree(const vec3<float>* points, unsigned int N);
 
+    //! Rebuild the trees if many points changed since they were built
+    /*! \param n_changed The number of points changed by the current update.
+     *  \returns Whether the trees were rebuilt.
+     */
+    bool rebuildIfStale(unsigned int n_changed);
+
+    //! Recompute the bounds of leaves of the binary tree from their points and refit both trees
+    void refitLeaves(std::vector<unsigned int>& leaves);
+
+    //! Grow the fractional extent of the points to include a point
+    void growFractionalExtent(const vec3<float>& point);
+
+    //! Find the neighbors of a packet of query points in the subtree rooted at a node.
+    /*! \tparam is2D Whether the box is 2D, in which case the z components are skipped.
+     *  \param packet The (already translated) query spheres.
+     *  \param query_point_indices The indices of the query points in the packet.
+     *  \param lane_images The images of the points found by each query sphere of the packet.
+     *  \param packet_size The number of query points in the packet.
+     *  \param root The root node of the subtree to search.
+     *  \param r_min The minimum distance for neighbors.
+     *  \param exclude_ii Whether to exclude self-neighbors.
+     *  \param bonds The vector that found bonds are appended to, with squared distances.
+     */
+    template<bool is2D>
+    void queryPacket(const AABBSpherePacket& packet, const unsigned int* query_point_indices,
+                     const vec3<int>* lane_images, unsigned int packet_size, unsigned int root,
+                     float r_min, bool exclude_ii, std::vector<NeighborBond>& bonds) const;
+
+    //! Bulk ball query using packets of query points sorted along a Morton curve.
+    template<bool is2D>
+    void queryBondsPackets(const vec3<float>* query_points, unsigned int n_query_points,
+                           const QueryArgs& args, const BondBatchFunction& cf, bool parallel,
+                           bool squared_distances) const;
+
+    //! Bulk ball query of the points against themselves using a dual-tree traversal.
+    template<bool is2D>
+    void queryBondsDualTree(const QueryArgs& args, const BondBatchFunction& cf, bool parallel,
+                            bool squared_distances) const;
+
     std::vector<AABB> m_aabbs; //!< Flat array of AABBs of all types
+    vec3<float> m_frac_lower;  //!< Lower bound of the fractional coordinates of the points
+    vec3<float> m_frac_upper;  //!< Upper bound of the fractional coordinates of the points
+    unsigned int m_n_changed;  //!< Number of points moved, inserted or removed since the trees were built
+    bool m_wide_tree;          //!< Whether the wide tree is built and used for queries of single points
 };
 
 //! Parent class of AABB iterators that knows how to traverse general AABB tree structures.
@@ -125,12 +295,13 @@ public:
     //! Empty Destructor
     virtual ~AABBIterator() {}
 
-    //! Computes the image vectors to query for
-    void updateImageVectors(float r_max, bool _check_r_max = true);
+    //! Computes the image vectors to query for (see AABBQuery::getImageVectors)
+    void updateImageVectors(float r_max);
 
 protected:
     const AABBQuery* m_aabb_query;         //!< Link to the AABBQuery object
     std::vector<vec3<float>> m_image_list; //!< List of translation vectors
+    std::vector<vec3<int>> m_images;       //!< Images of the points found through each translation vector
     unsigned int m_n_images;               //!< The number of image vectors to check
 };
 
@@ -144,7 +315,7 @@ public:
                       float r_min, float scale, bool exclude_ii)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), m_count(0),
           m_num_neighbors(num_neighbors), m_search_extended(false), m_r_cur(r_guess), m_scale(scale),
-          m_all_distances(), m_query_points_below_r_min()
+          m_nearest_bonds(), m_query_points_below_r_min()
     {
         updateImageVectors(0);
     }
@@ -164,8 +335,9 @@ protected:
     float
         m_r_cur; //!< Current search ball cutoff distance in use for the current particle (expands as needed).
     float m_scale; //!< The amount to scale m_r by when the current ball is too small.
-    std::map<unsigned int, float> m_all_distances; //!< Hash map of minimum distances found for a given point,
-                                                   //!< used when searching beyond maximum safe AABB distance.
+    std::map<unsigned int, NeighborBond> m_nearest_bonds; //!< Map of the shortest bond found to each point,
+                                                          //!< used when searching beyond maximum safe AABB
+                                                          //!< distance.
     std::unordered_set<unsigned int> m_query_points_below_r_min; //!< The set of query_points that were too
                                                                  //!< close based on the r_min threshold.
 };
@@ -176,12 +348,12 @@ class AABBQueryBallIterator : public AABBIterator
 public:
     //! Constructor
     AABBQueryBallIterator(const AABBQuery* neighbor_query, const vec3<float> query_point,
-                          unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
-                          bool _check_r_max = true)
+                          unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), cur_image(0),
-          cur_node_idx(0), cur_ref_p(0)
+          cur_leaf_idx(INVALID_NODE), cur_ref_p(0)
     {
-        updateImageVectors(m_r_max, _check_r_max);
+        updateImageVectors(m_r_max);
+        m_node_stack.push_back(0);
     }
 
     //! Empty Destructor
@@ -190,11 +362,22 @@ public:
     //! Get the next element.
     virtual NeighborBond next();
 
+    //! Return squared distances from next() (see NeighborQueryPerPointIterator::useSquaredDistances).
+    virtual bool useSquaredDistances()
+    {
+        m_squared_distances = true;
+        return true;
+    }
+
 private:
-    unsigned int cur_image;    //!< The current node in the tree.
-    unsigned int cur_node_idx; //!< The current node in the tree.
+    //! Get the next element, with the dimensionality of the box fixed at compile time.
+    template<bool is2D> NeighborBond nextImpl();
+
+    unsigned int cur_image;    //!< The current image vector.
+    unsigned int cur_leaf_idx; //!< The leaf node (of the binary tree) being searched, if any.
     unsigned int
         cur_ref_p; //!< The current index into the reference particles in the current node of the tree.
+    std::vector<unsigned int> m_node_stack; //!< Tree nodes and leaves remaining to be searched.
 };
 }; }; // end namespace freud::locality
 
@@ -41,6 +41,7 @@ struct CACHE_ALIGN AABBNode
         left = right = parent = INVALID_NODE;
         num_particles = 0;
         skip = 0;
+        free_slots = 0;
     }
 
     AABB aabb;           //!< The box bounding this node's volume
@@ -52,6 +53,7 @@ struct CACHE_ALIGN AABBNode
     unsigned int particles[NODE_CAPACITY];     //!< Indices of the particles contained in the node
     unsigned int particle_tags[NODE_CAPACITY]; //!< Corresponding particle tags for particles in node
     unsigned int num_particles;                //!< Number of particles contained in the node
+    unsigned int free_slots;                   //!< Number of free particle slots in the leaves under the node
 };
 
 //! AABB Tree
@@ -65,6 +67,11 @@ struct CACHE_ALIGN AABBNode
    tree topology is left unchanged. Runs in O(log N) time. AABBs are not saved for all particles, so an update
    will only increase the volume of nodes. The tree should be rebuilt periodically instead of continually
    updated.
+    - Refit : Set the AABB of a node, e.g. one recomputed from the current positions of the particles in a
+   leaf, and recompute the AABBs of its ancestors. Runs in O(log N) time.
+    - Insert / Remove : Add a particle to a leaf node with a free slot, or remove a particle from its leaf
+   node, without changing the tree topology. Runs in O(log N) time. Insertion fails when all leaves are full,
+   and the tree should be rebuilt after many insertions and removals.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
 
     **Implementation details**
@@ -153,6 +160,18 @@ public:
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Set the AABB of a node and recompute the AABBs of its ancestors
+    inline void refit(unsigned int node, const AABB& aabb);
+
+    //! Insert a particle into a leaf node with a free slot
+    inline unsigned int insert(unsigned int idx, const AABB& aabb);
+
+    //! Remove a particle from its leaf node
+    inline unsigned int remove(unsigned int idx);
+
+    //! Change the index of a particle
+    inline void reindex(unsigned int old_idx, unsigned int new_idx);
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -194,6 +213,22 @@ public:
         return (m_nodes[node].skip);
     }
 
+    //! Get the parent of a given node
+    /*! \param node Index of the node (not the particle) to query
+     */
+    inline unsigned int getNodeParent(unsigned int node) const
+    {
+        return (m_nodes[node].parent);
+    }
+
+    //! Get the leaf node containing a given particle
+    /*! \param idx Index of the particle
+     */
+    inline unsigned int getParticleNode(unsigned int idx) const
+    {
+        return m_mapping[idx];
+    }
+
     //! Get the left child of a given node
     /*! \param node Index of the node (not the particle) to query
      */
@@ -202,6 +237,14 @@ public:
         return (m_nodes[node].left);
     }
 
+    //! Get the right child of a given node
+    /*! \param node Index of the node (not the particle) to query
+     */
+    inline unsigned int getNodeRight(unsigned int node) const
+    {
+        return (m_nodes[node].right);
+    }
+
     //! Get the number of particles in a given node
     /*! \param node Index of the node (not the particle) to query
      */
@@ -246,6 +289,19 @@ private:
 
     //! Update the skip value for a node
     inline unsigned int updateSkip(unsigned int idx);
+
+    //! Add to the number of free slots of a node and its ancestors
+    inline void addFreeSlots(unsigned int node, int delta);
+
+    //! Find the slot of a particle in its leaf node
+    inline unsigned int findParticleSlot(unsigned int node, unsigned int idx) const;
+
+    //! Sum of the side lengths of an AABB, used to measure how much an insertion enlarges a node
+    static inline float margin(const AABB& aabb)
+    {
+        const vec3<float> extent = aabb.getUpper() - aabb.getLower();
+        return extent.x + extent.y + extent.z;
+    }
 };
 
 /*! \param N Number of particles to allocate space for
@@ -334,6 +390,134 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
     }
 }
 
+/*! \param node Index of the node to update
+    \param aabb New AABB for the node
+
+    Unlike update(), refit() sets the AABB of the node even if it shrinks, and each ancestor is set to the
+   union of the AABBs of its children. The tree topology is unchanged.
+*/
+inline void AABBTree::refit(unsigned int node, const AABB& aabb)
+{
+    m_nodes[node].aabb = aabb;
+    unsigned int current_node = m_nodes[node].parent;
+    while (current_node != INVALID_NODE)
+    {
+        unsigned int left_idx = m_nodes[current_node].left;
+        unsigned int right_idx = m_nodes[current_node].right;
+
+        m_nodes[current_node].aabb = merge(m_nodes[left_idx].aabb, m_nodes[right_idx].aabb);
+        current_node = m_nodes[current_node].parent;
+    }
+}
+
+/*! \param idx Index of the new particle
+    \param aabb AABB of the new particle
+    \returns The leaf node the particle was inserted into, or INVALID_NODE if all leaves are full
+
+    The tree is descended from the root into the child with free slots whose AABB grows the least when the
+   particle is added, so that the particle joins a nearby leaf. The AABBs of the leaf and its ancestors grow
+   to include the particle. Runs in O(log N) time.
+*/
+inline unsigned int AABBTree::insert(unsigned int idx, const AABB& aabb)
+{
+    if (m_num_nodes == 0 || m_nodes[m_root].free_slots == 0)
+        return INVALID_NODE;
+
+    unsigned int node_idx = m_root;
+    while (!isNodeLeaf(node_idx))
+    {
+        unsigned int best_child = INVALID_NODE;
+        float best_growth = 0;
+        for (unsigned int child : {m_nodes[node_idx].left, m_nodes[node_idx].right})
+        {
+            if (m_nodes[child].free_slots == 0)
+                continue;
+
+            const float growth = margin(merge(m_nodes[child].aabb, aabb)) - margin(m_nodes[child].aabb);
+            if (best_child == INVALID_NODE || growth < best_growth)
+            {
+                best_child = child;
+                best_growth = growth;
+            }
+        }
+        node_idx = best_child;
+    }
+
+    AABBNode& leaf = m_nodes[node_idx];
+    leaf.particles[leaf.num_particles] = idx;
+    leaf.particle_tags[leaf.num_particles] = aabb.tag;
+    if (idx >= m_mapping.size())
+        m_mapping.resize(idx + 1, INVALID_NODE);
+    m_mapping[idx] = node_idx;
+    addFreeSlots(node_idx, -1);
+
+    // the AABB of an empty leaf is stale, so it is replaced rather than grown
+    const AABB leaf_aabb = (leaf.num_particles == 0) ? aabb : merge(leaf.aabb, aabb);
+    leaf.num_particles++;
+    refit(node_idx, leaf_aabb);
+    return node_idx;
+}
+
+/*! \param idx Index of the particle to remove
+    \returns The leaf node the particle was removed from
+
+    The AABBs of the nodes are left unchanged, so they may be larger than needed until the leaf is refit. An
+   empty leaf keeps its AABB.
+*/
+inline unsigned int AABBTree::remove(unsigned int idx)
+{
+    unsigned int node_idx = m_mapping[idx];
+    AABBNode& leaf = m_nodes[node_idx];
+    unsigned int slot = findParticleSlot(node_idx, idx);
+
+    // fill the slot with the last particle of the leaf
+    leaf.num_particles--;
+    leaf.particles[slot] = leaf.particles[leaf.num_particles];
+    leaf.particle_tags[slot] = leaf.particle_tags[leaf.num_particles];
+    m_mapping[idx] = INVALID_NODE;
+    addFreeSlots(node_idx, 1);
+    return node_idx;
+}
+
+/*! \param old_idx Current index of the particle
+    \param new_idx New index of the particle, which must not be in the tree
+
+    The particle stays in the same leaf, so no AABBs change.
+*/
+inline void AABBTree::reindex(unsigned int old_idx, unsigned int new_idx)
+{
+    unsigned int node_idx = m_mapping[old_idx];
+    unsigned int slot = findParticleSlot(node_idx, old_idx);
+    m_nodes[node_idx].particles[slot] = new_idx;
+    m_nodes[node_idx].particle_tags[slot] = new_idx;
+    m_mapping[old_idx] = INVALID_NODE;
+    m_mapping[new_idx] = node_idx;
+}
+
+/*! \param node Index of the node to start from
+    \param delta Change in the number of free slots
+*/
+inline void AABBTree::addFreeSlots(unsigned int node, int delta)
+{
+    for (unsigned int current_node = node; current_node != INVALID_NODE;
+         current_node = m_nodes[current_node].parent)
+    {
+        m_nodes[current_node].free_slots += delta;
+    }
+}
+
+/*! \param node Index of the leaf node containing the particle
+    \param idx Index of the particle
+    \returns The slot of the particle in the particles array of the node
+*/
+inline unsigned int AABBTree::findParticleSlot(unsigned int node, unsigned int idx) const
+{
+    unsigned int slot = 0;
+    while (m_nodes[node].particles[slot] != idx)
+        slot++;
+    return slot;
+}
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -410,6 +594,7 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
         m_nodes[new_node].aabb = my_aabb;
         m_nodes[new_node].parent = parent;
         m_nodes[new_node].num_particles = len;
+        m_nodes[new_node].free_slots = NODE_CAPACITY - len;
 
         for (unsigned int i = 0; i < len; i++)
         {
@@ -526,6 +711,7 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
     m_nodes[my_idx].parent = parent;
     m_nodes[my_idx].left = new_left;
     m_nodes[my_idx].right = new_right;
+    m_nodes[my_idx].free_slots = m_nodes[new_left].free_slots + m_nodes[new_right].free_slots;
 
     return my_idx;
 }
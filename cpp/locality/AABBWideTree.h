@@ -0,0 +1,367 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef AABB_WIDE_TREE_H
+#define AABB_WIDE_TREE_H
+
+#include <limits>
+#include <vector>
+
+#include "AABB.h"
+#include "AABBTree.h"
+#include "VectorMath.h"
+
+/*! \file AABBWideTree.h
+    \brief Wide AABB tree collapsed from a binary AABBTree
+*/
+
+namespace freud { namespace locality {
+
+#if defined(__AVX__)
+const unsigned int WIDE_NODE_WIDTH = 8; //!< Maximum number of children of a wide node (one AVX register)
+#else
+const unsigned int WIDE_NODE_WIDTH = 4; //!< Maximum number of children of a wide node (one SSE register)
+#endif
+
+const unsigned int WIDE_LEAF_FLAG = 0x80000000; //!< Flag marking a child reference as a leaf
+
+//! Node in an AABBWideTree
+/*! Stores the bounds of up to WIDE_NODE_WIDTH children as a structure of arrays, so that a query sphere can
+   be tested against all children of a node at once. Unused child slots have inverted bounds that never
+   overlap anything.
+ */
+struct AABBWideNode
+{
+    float lower_x[WIDE_NODE_WIDTH]; //!< Lower x bounds of the children
+    float lower_y[WIDE_NODE_WIDTH]; //!< Lower y bounds of the children
+    float lower_z[WIDE_NODE_WIDTH]; //!< Lower z bounds of the children
+    float upper_x[WIDE_NODE_WIDTH]; //!< Upper x bounds of the children
+    float upper_y[WIDE_NODE_WIDTH]; //!< Upper y bounds of the children
+    float upper_z[WIDE_NODE_WIDTH]; //!< Upper z bounds of the children
+
+    //! References to the children. A reference with WIDE_LEAF_FLAG set is the index of a leaf node in the
+    //! binary tree, otherwise it is the index of a wide node.
+    unsigned int children[WIDE_NODE_WIDTH];
+    unsigned int num_children; //!< Number of children in use
+};
+
+//! Check which children of a wide node overlap an AABBSphere
+/*! \tparam is2D Whether the node and sphere lie in the z=0 plane, in which case the z components are skipped
+    \param a AABBWideNode
+    \param b AABBSphere
+    \returns A bit mask in which bit i is set when child i of the node overlaps the sphere
+*/
+template<bool is2D> inline unsigned int overlapMask(const AABBWideNode& a, const AABBSphere& b)
+{
+    const vec3<float> position = b.getPosition();
+#if defined(__AVX__)
+    const __m256 x_v = _mm256_set1_ps(position.x);
+    const __m256 y_v = _mm256_set1_ps(position.y);
+    const __m256 dx_v = _mm256_sub_ps(
+        _mm256_min_ps(_mm256_max_ps(x_v, _mm256_loadu_ps(a.lower_x)), _mm256_loadu_ps(a.upper_x)), x_v);
+    const __m256 dy_v = _mm256_sub_ps(
+        _mm256_min_ps(_mm256_max_ps(y_v, _mm256_loadu_ps(a.lower_y)), _mm256_loadu_ps(a.upper_y)), y_v);
+    __m256 dr2_v = _mm256_add_ps(_mm256_mul_ps(dx_v, dx_v), _mm256_mul_ps(dy_v, dy_v));
+    if (!is2D)
+    {
+        const __m256 z_v = _mm256_set1_ps(position.z);
+        const __m256 dz_v = _mm256_sub_ps(
+            _mm256_min_ps(_mm256_max_ps(z_v, _mm256_loadu_ps(a.lower_z)), _mm256_loadu_ps(a.upper_z)), z_v);
+        dr2_v = _mm256_add_ps(dr2_v, _mm256_mul_ps(dz_v, dz_v));
+    }
+    return static_cast<unsigned int>(
+        _mm256_movemask_ps(_mm256_cmp_ps(dr2_v, _mm256_set1_ps(b.radius * b.radius), _CMP_LT_OQ)));
+
+#elif defined(__SSE__)
+    const __m128 x_v = _mm_set1_ps(position.x);
+    const __m128 y_v = _mm_set1_ps(position.y);
+    const __m128 dx_v
+        = _mm_sub_ps(_mm_min_ps(_mm_max_ps(x_v, _mm_loadu_ps(a.lower_x)), _mm_loadu_ps(a.upper_x)), x_v);
+    const __m128 dy_v
+        = _mm_sub_ps(_mm_min_ps(_mm_max_ps(y_v, _mm_loadu_ps(a.lower_y)), _mm_loadu_ps(a.upper_y)), y_v);
+    __m128 dr2_v = _mm_add_ps(_mm_mul_ps(dx_v, dx_v), _mm_mul_ps(dy_v, dy_v));
+    if (!is2D)
+    {
+        const __m128 z_v = _mm_set1_ps(position.z);
+        const __m128 dz_v
+            = _mm_sub_ps(_mm_min_ps(_mm_max_ps(z_v, _mm_loadu_ps(a.lower_z)), _mm_loadu_ps(a.upper_z)), z_v);
+        dr2_v = _mm_add_ps(dr2_v, _mm_mul_ps(dz_v, dz_v));
+    }
+    return static_cast<unsigned int>(
+        _mm_movemask_ps(_mm_cmplt_ps(dr2_v, _mm_set1_ps(b.radius * b.radius))));
+
+#else
+    unsigned int mask = 0;
+    const float r2 = b.radius * b.radius;
+    for (unsigned int i = 0; i < WIDE_NODE_WIDTH; ++i)
+    {
+        const float dx = std::min(std::max(position.x, a.lower_x[i]), a.upper_x[i]) - position.x;
+        const float dy = std::min(std::max(position.y, a.lower_y[i]), a.upper_y[i]) - position.y;
+        float dr2 = dx * dx + dy * dy;
+        if (!is2D)
+        {
+            const float dz = std::min(std::max(position.z, a.lower_z[i]), a.upper_z[i]) - position.z;
+            dr2 += dz * dz;
+        }
+        if (dr2 < r2)
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+
+#endif
+}
+
+//! Check which children of a wide node lie entirely within a distance of a point
+/*! \tparam is2D Whether the node and point lie in the z=0 plane, in which case the z components are skipped
+    \param a AABBWideNode
+    \param position Point
+    \param r_sq Squared distance to compare against
+    \returns A bit mask in which bit i is set when all points in child i are closer than sqrt(r_sq) to
+   position. The inverted bounds of unused child slots are infinitely far away, so they are never set.
+*/
+template<bool is2D>
+inline unsigned int insideMask(const AABBWideNode& a, const vec3<float>& position, float r_sq)
+{
+#if defined(__AVX__)
+    const __m256 x_v = _mm256_set1_ps(position.x);
+    const __m256 y_v = _mm256_set1_ps(position.y);
+    const __m256 dx_v = _mm256_max_ps(_mm256_sub_ps(x_v, _mm256_loadu_ps(a.lower_x)),
+                                      _mm256_sub_ps(_mm256_loadu_ps(a.upper_x), x_v));
+    const __m256 dy_v = _mm256_max_ps(_mm256_sub_ps(y_v, _mm256_loadu_ps(a.lower_y)),
+                                      _mm256_sub_ps(_mm256_loadu_ps(a.upper_y), y_v));
+    __m256 dr2_v = _mm256_add_ps(_mm256_mul_ps(dx_v, dx_v), _mm256_mul_ps(dy_v, dy_v));
+    if (!is2D)
+    {
+        const __m256 z_v = _mm256_set1_ps(position.z);
+        const __m256 dz_v = _mm256_max_ps(_mm256_sub_ps(z_v, _mm256_loadu_ps(a.lower_z)),
+                                          _mm256_sub_ps(_mm256_loadu_ps(a.upper_z), z_v));
+        dr2_v = _mm256_add_ps(dr2_v, _mm256_mul_ps(dz_v, dz_v));
+    }
+    const unsigned int mask = static_cast<unsigned int>(
+        _mm256_movemask_ps(_mm256_cmp_ps(dr2_v, _mm256_set1_ps(r_sq), _CMP_LT_OQ)));
+
+#elif defined(__SSE__)
+    const __m128 x_v = _mm_set1_ps(position.x);
+    const __m128 y_v = _mm_set1_ps(position.y);
+    const __m128 dx_v
+        = _mm_max_ps(_mm_sub_ps(x_v, _mm_loadu_ps(a.lower_x)), _mm_sub_ps(_mm_loadu_ps(a.upper_x), x_v));
+    const __m128 dy_v
+        = _mm_max_ps(_mm_sub_ps(y_v, _mm_loadu_ps(a.lower_y)), _mm_sub_ps(_mm_loadu_ps(a.upper_y), y_v));
+    __m128 dr2_v = _mm_add_ps(_mm_mul_ps(dx_v, dx_v), _mm_mul_ps(dy_v, dy_v));
+    if (!is2D)
+    {
+        const __m128 z_v = _mm_set1_ps(position.z);
+        const __m128 dz_v
+            = _mm_max_ps(_mm_sub_ps(z_v, _mm_loadu_ps(a.lower_z)), _mm_sub_ps(_mm_loadu_ps(a.upper_z), z_v));
+        dr2_v = _mm_add_ps(dr2_v, _mm_mul_ps(dz_v, dz_v));
+    }
+    const unsigned int mask
+        = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(dr2_v, _mm_set1_ps(r_sq))));
+
+#else
+    unsigned int mask = 0;
+    for (unsigned int i = 0; i < WIDE_NODE_WIDTH; ++i)
+    {
+        const float dx = std::max(position.x - a.lower_x[i], a.upper_x[i] - position.x);
+        const float dy = std::max(position.y - a.lower_y[i], a.upper_y[i] - position.y);
+        float dr2 = dx * dx + dy * dy;
+        if (!is2D)
+        {
+            const float dz = std::max(position.z - a.lower_z[i], a.upper_z[i] - position.z);
+            dr2 += dz * dz;
+        }
+        if (dr2 < r_sq)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+#endif
+    return mask;
+}
+
+//! Wide AABB Tree
+/*! An AABBWideTree is a bounding volume hierarchy in which each node has up to WIDE_NODE_WIDTH children,
+   obtained by collapsing the levels of a binary AABBTree. The leaves are the leaf nodes of the binary tree,
+   which continue to store the particles. Because the bounds of all children of a node are tested at once,
+   traversals of the wide tree are shallower and touch fewer nodes than traversals of the binary tree.
+
+    **Implementation details**
+
+    Each wide node is built from a binary internal node by repeatedly replacing the child with the largest
+   bounding box surface area by its own two children until the node is full or only leaves remain. This
+   keeps the children of a node similar in size. The root of the wide tree is node 0. If the binary tree
+   consists of a single leaf, the wide tree is a single node with that leaf as its only child.
+*/
+class AABBWideTree
+{
+public:
+    //! Construct an empty AABBWideTree
+    AABBWideTree() {}
+
+    //! Build the wide tree by collapsing a binary tree
+    inline void buildTree(const AABBTree& tree);
+
+    //! Copy the AABBs of a binary node and its ancestors into the wide tree after they were refit
+    inline void refit(const AABBTree& tree, unsigned int binary_node);
+
+    //! Get the number of nodes
+    inline unsigned int getNumNodes() const
+    {
+        return static_cast<unsigned int>(m_nodes.size());
+    }
+
+    //! Get a node
+    /*! \param node Index of the node to get
+     */
+    inline const AABBWideNode& getNode(unsigned int node) const
+    {
+        return m_nodes[node];
+    }
+
+private:
+    std::vector<AABBWideNode> m_nodes; //!< The nodes of the tree
+
+    //! Wide node and slot (node * WIDE_NODE_WIDTH + slot) referring to each binary node, or INVALID_NODE
+    std::vector<unsigned int> m_slots;
+
+    //! Build the wide node for a binary internal node and return its index
+    inline unsigned int buildNode(const AABBTree& tree, unsigned int binary_node);
+
+    //! Half of the surface area of an AABB, used to pick which child to expand
+    static inline float halfArea(const AABB& aabb)
+    {
+        const vec3<float> extent = aabb.getUpper() - aabb.getLower();
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+    }
+};
+
+/*! \param tree Binary tree to collapse
+
+    The binary tree must outlive any use of the wide tree, since leaves refer to its nodes.
+*/
+inline void AABBWideTree::buildTree(const AABBTree& tree)
+{
+    m_nodes.clear();
+    m_slots.assign(tree.getNumNodes(), INVALID_NODE);
+    if (tree.getNumNodes() == 0)
+    {
+        return;
+    }
+
+    // The root of the binary tree is node 0 (see AABBTree::updateSkip)
+    buildNode(tree, 0);
+}
+
+/*! \param tree Binary tree the wide tree was collapsed from
+    \param binary_node Index of the binary node whose AABB changed
+
+    The bounds stored for a child of a wide node are the AABB of the binary node it refers to, so the wide
+   tree is refit by copying the AABBs of the binary node and all of its ancestors into the slots referring to
+   them. The topology of the binary tree must not have changed since the wide tree was built.
+*/
+inline void AABBWideTree::refit(const AABBTree& tree, unsigned int binary_node)
+{
+    for (unsigned int node = binary_node; node != INVALID_NODE; node = tree.getNodeParent(node))
+    {
+        const unsigned int slot = m_slots[node];
+        if (slot == INVALID_NODE)
+        {
+            continue;
+        }
+        AABBWideNode& wide_node = m_nodes[slot / WIDE_NODE_WIDTH];
+        const unsigned int i = slot % WIDE_NODE_WIDTH;
+        const AABB& aabb = tree.getNodeAABB(node);
+        const vec3<float> lower = aabb.getLower();
+        const vec3<float> upper = aabb.getUpper();
+        wide_node.lower_x[i] = lower.x;
+        wide_node.lower_y[i] = lower.y;
+        wide_node.lower_z[i] = lower.z;
+        wide_node.upper_x[i] = upper.x;
+        wide_node.upper_y[i] = upper.y;
+        wide_node.upper_z[i] = upper.z;
+    }
+}
+
+/*! \param tree Binary tree being collapsed
+    \param binary_node Index of the binary node to create a wide node for
+    \returns The index of the new wide node
+*/
+inline unsigned int AABBWideTree::buildNode(const AABBTree& tree, unsigned int binary_node)
+{
+    // Collect the binary nodes that become children of this wide node
+    unsigned int children[WIDE_NODE_WIDTH];
+    unsigned int num_children = 0;
+    if (tree.isNodeLeaf(binary_node))
+    {
+        children[num_children++] = binary_node;
+    }
+    else
+    {
+        children[num_children++] = tree.getNodeLeft(binary_node);
+        children[num_children++] = tree.getNodeRight(binary_node);
+    }
+
+    while (num_children < WIDE_NODE_WIDTH)
+    {
+        // Expand the internal child with the largest surface area
+        unsigned int expand = WIDE_NODE_WIDTH;
+        float expand_area = -1;
+        for (unsigned int i = 0; i < num_children; ++i)
+        {
+            if (!tree.isNodeLeaf(children[i]))
+            {
+                const float area = halfArea(tree.getNodeAABB(children[i]));
+                if (area > expand_area)
+                {
+                    expand = i;
+                    expand_area = area;
+                }
+            }
+        }
+        if (expand == WIDE_NODE_WIDTH)
+        {
+            break;
+        }
+        const unsigned int expanded = children[expand];
+        children[expand] = tree.getNodeLeft(expanded);
+        children[num_children++] = tree.getNodeRight(expanded);
+    }
+
+    // note: building the children may reallocate m_nodes, so the node is only accessed by index
+    const unsigned int my_idx = static_cast<unsigned int>(m_nodes.size());
+    m_nodes.push_back(AABBWideNode());
+    for (unsigned int i = 0; i < WIDE_NODE_WIDTH; ++i)
+    {
+        // Unused slots get inverted bounds so that they never overlap
+        vec3<float> lower(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                          std::numeric_limits<float>::max());
+        vec3<float> upper(-lower);
+        unsigned int child = 0;
+        if (i < num_children)
+        {
+            const AABB& aabb = tree.getNodeAABB(children[i]);
+            lower = aabb.getLower();
+            upper = aabb.getUpper();
+            child = tree.isNodeLeaf(children[i]) ? (children[i] | WIDE_LEAF_FLAG)
+                                                 : buildNode(tree, children[i]);
+            m_slots[children[i]] = my_idx * WIDE_NODE_WIDTH + i;
+        }
+        m_nodes[my_idx].lower_x[i] = lower.x;
+        m_nodes[my_idx].lower_y[i] = lower.y;
+        m_nodes[my_idx].lower_z[i] = lower.z;
+        m_nodes[my_idx].upper_x[i] = upper.x;
+        m_nodes[my_idx].upper_y[i] = upper.y;
+        m_nodes[my_idx].upper_z[i] = upper.z;
+        m_nodes[my_idx].children[i] = child;
+    }
+    m_nodes[my_idx].num_children = num_children;
+
+    return my_idx;
+}
+
+}; }; // end namespace freud::locality
+
+#endif // AABB_WIDE_TREE_H
@@ -0,0 +1,683 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+#include "AdaptiveCell.h"
+#include "utils.h"
+
+/*! \file AdaptiveCell.cc
+    \brief Build a multilevel cell grid that adapts to the local density of points.
+*/
+
+namespace freud { namespace locality {
+
+//! Marks coarse cells that do not contain any points.
+const unsigned int EMPTY_CELL = 0xffffffff;
+
+//! Padding (in fractional coordinates) that keeps rounding from discarding neighbors.
+const float FRACTIONAL_PADDING = float(1e-5);
+
+//! Distance between a coordinate and an interval along one lattice direction, in fractional coordinates.
+inline float fractionalGap(float q, float lower, float upper, bool periodic)
+{
+    float gap = std::max(float(0), std::max(lower - q, q - upper));
+    if (periodic)
+    {
+        // Both coordinates are wrapped into [0, 1], so only the neighboring images can be closer
+        gap = std::min(gap, std::max(float(0), lower + float(1) - q));
+        gap = std::min(gap, std::max(float(0), q - upper + float(1)));
+    }
+    return std::max(float(0), gap - FRACTIONAL_PADDING);
+}
+
+AdaptiveCell::AdaptiveCell()
+    : NeighborQuery(), m_cell_width(0), m_max_points_per_cell(0), m_celldim(0, 0, 0), m_num_levels(0),
+      m_orthogonal(true)
+{}
+
+AdaptiveCell::AdaptiveCell(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                           float cell_width, unsigned int max_points_per_cell)
+    : NeighborQuery(box, points, n_points), m_cell_width(cell_width),
+      m_max_points_per_cell(max_points_per_cell), m_celldim(1, 1, 1), m_num_levels(1),
+      m_plane_distance(box.getNearestPlaneDistance()),
+      m_orthogonal(box.getTiltFactorXY() == 0 && box.getTiltFactorXZ() == 0 && box.getTiltFactorYZ() == 0)
+{
+    if (max_points_per_cell == 0)
+    {
+        throw std::invalid_argument("AdaptiveCell requires max_points_per_cell to be positive.");
+    }
+    if (cell_width < 0)
+    {
+        throw std::invalid_argument("AdaptiveCell requires cell_width to be non-negative.");
+    }
+
+    // If no cell width is provided, size the coarse cells so that they hold
+    // max_points_per_cell points at the mean density. Only cells in regions
+    // denser than the mean are then subdivided.
+    if (cell_width == 0)
+    {
+        const float num_cells
+            = std::max(float(n_points) / float(m_max_points_per_cell), static_cast<float>(1));
+        m_cell_width = box.is2D() ? std::sqrt(box.getVolume() / num_cells)
+                                  : std::cbrt(box.getVolume() / num_cells);
+    }
+
+    // At least one cell is needed along each direction
+    m_celldim.x = std::max(static_cast<unsigned int>(m_plane_distance.x / m_cell_width), 1u);
+    m_celldim.y = std::max(static_cast<unsigned int>(m_plane_distance.y / m_cell_width), 1u);
+    if (!box.is2D())
+    {
+        m_celldim.z = std::max(static_cast<unsigned int>(m_plane_distance.z / m_cell_width), 1u);
+    }
+
+    buildCells();
+}
+
+vec3<float> AdaptiveCell::getWrappedFractional(const vec3<float>& p) const
+{
+    vec3<float> frac = m_box.makeFractional(p);
+    const vec3<bool> periodic = m_box.getPeriodic();
+    if (periodic.x)
+    {
+        frac.x = util::modulusPositive(frac.x, 1.0f);
+    }
+    if (periodic.y)
+    {
+        frac.y = util::modulusPositive(frac.y, 1.0f);
+    }
+    if (periodic.z && !m_box.is2D())
+    {
+        frac.z = util::modulusPositive(frac.z, 1.0f);
+    }
+    return frac;
+}
+
+vec3<int> AdaptiveCell::getCellCoord(const vec3<float>& frac) const
+{
+    // Points outside the box along aperiodic directions are placed in the outermost cells
+    auto coord = [](float f, unsigned int dim) {
+        const int c = static_cast<int>(std::floor(f * float(dim)));
+        return std::min(std::max(c, 0), static_cast<int>(dim) - 1);
+    };
+    return vec3<int>(coord(frac.x, m_celldim.x), coord(frac.y, m_celldim.y), coord(frac.z, m_celldim.z));
+}
+
+void AdaptiveCell::buildCells()
+{
+    const unsigned int n_cells = m_celldim.x * m_celldim.y * m_celldim.z;
+
+    // Compute the fractional coordinates and the coarse cell of each point
+    std::vector<vec3<float>> frac(m_n_points);
+    std::vector<unsigned int> cell(m_n_points);
+    util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            frac[i] = getWrappedFractional(m_points[i]);
+            const vec3<int> c = getCellCoord(frac[i]);
+            cell[i] = (c.z * m_celldim.y + c.y) * m_celldim.x + c.x;
+        }
+    });
+
+    // Counting sort of the points by coarse cell
+    std::vector<unsigned int> cell_start(n_cells + 1, 0);
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        ++cell_start[cell[i] + 1];
+    }
+    for (unsigned int c = 0; c < n_cells; ++c)
+    {
+        cell_start[c + 1] += cell_start[c];
+    }
+    m_point_order.resize(m_n_points);
+    m_sorted_points.resize(m_n_points);
+    m_sorted_frac.resize(m_n_points);
+    std::vector<unsigned int> cell_fill(cell_start.begin(), cell_start.end() - 1);
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        const unsigned int k = cell_fill[cell[i]]++;
+        m_point_order[k] = i;
+        m_sorted_points[k] = m_points[i];
+        m_sorted_frac[k] = frac[i];
+    }
+
+    // Create a root node for each non-empty coarse cell, then refine the over-full ones
+    m_cell_nodes.assign(n_cells, EMPTY_CELL);
+    m_nodes.clear();
+    m_num_levels = 1;
+    for (unsigned int c = 0; c < n_cells; ++c)
+    {
+        if (cell_start[c + 1] > cell_start[c])
+        {
+            m_cell_nodes[c] = static_cast<unsigned int>(m_nodes.size());
+            m_nodes.push_back(makeNode(cell_start[c], cell_start[c + 1] - cell_start[c]));
+        }
+    }
+
+    const vec3<float> width(float(1) / float(m_celldim.x), float(1) / float(m_celldim.y),
+                            float(1) / float(m_celldim.z));
+    for (unsigned int c = 0; c < n_cells; ++c)
+    {
+        if (m_cell_nodes[c] != EMPTY_CELL)
+        {
+            const vec3<float> lower(float(c % m_celldim.x) * width.x,
+                                    float((c / m_celldim.x) % m_celldim.y) * width.y,
+                                    float(c / (m_celldim.x * m_celldim.y)) * width.z);
+            subdivide(m_cell_nodes[c], lower, lower + width, 1);
+        }
+    }
+}
+
+AdaptiveCellNode AdaptiveCell::makeNode(unsigned int first_point, unsigned int num_points) const
+{
+    AdaptiveCellNode node;
+    node.lower = node.upper = m_sorted_frac[first_point];
+    for (unsigned int k = first_point + 1; k < first_point + num_points; ++k)
+    {
+        const vec3<float>& f = m_sorted_frac[k];
+        node.lower = vec3<float>(std::min(node.lower.x, f.x), std::min(node.lower.y, f.y),
+                                 std::min(node.lower.z, f.z));
+        node.upper = vec3<float>(std::max(node.upper.x, f.x), std::max(node.upper.y, f.y),
+                                 std::max(node.upper.z, f.z));
+    }
+    node.first_point = first_point;
+    node.num_points = num_points;
+    node.first_child = 0;
+    node.num_children = 0;
+    return node;
+}
+
+void AdaptiveCell::subdivide(unsigned int node, vec3<float> cell_lower, vec3<float> cell_upper,
+                             unsigned int level)
+{
+    const unsigned int first_point = m_nodes[node].first_point;
+    const unsigned int num_points = m_nodes[node].num_points;
+    if (num_points <= m_max_points_per_cell || level >= ADAPTIVE_CELL_MAX_LEVELS)
+    {
+        return;
+    }
+    m_num_levels = std::max(m_num_levels, level + 1);
+
+    // Sort the points of the node by subcell, keeping their order within each subcell
+    const bool is2D = m_box.is2D();
+    const unsigned int num_subcells = is2D ? 4 : 8;
+    const vec3<float> center = float(0.5) * (cell_lower + cell_upper);
+    auto subcell = [&](const vec3<float>& f) {
+        return static_cast<unsigned int>(f.x >= center.x) | (static_cast<unsigned int>(f.y >= center.y) << 1)
+            | (static_cast<unsigned int>(!is2D && f.z >= center.z) << 2);
+    };
+    unsigned int subcell_start[9] = {0};
+    for (unsigned int k = first_point; k < first_point + num_points; ++k)
+    {
+        ++subcell_start[subcell(m_sorted_frac[k]) + 1];
+    }
+    for (unsigned int s = 0; s < num_subcells; ++s)
+    {
+        subcell_start[s + 1] += subcell_start[s];
+    }
+    std::vector<unsigned int> order(num_points);
+    std::vector<vec3<float>> positions(num_points);
+    std::vector<vec3<float>> frac(num_points);
+    unsigned int subcell_fill[8];
+    std::copy(subcell_start, subcell_start + 8, subcell_fill);
+    for (unsigned int k = first_point; k < first_point + num_points; ++k)
+    {
+        const unsigned int dest = subcell_fill[subcell(m_sorted_frac[k])]++;
+        order[dest] = m_point_order[k];
+        positions[dest] = m_sorted_points[k];
+        frac[dest] = m_sorted_frac[k];
+    }
+    std::copy(order.begin(), order.end(), m_point_order.begin() + first_point);
+    std::copy(positions.begin(), positions.end(), m_sorted_points.begin() + first_point);
+    std::copy(frac.begin(), frac.end(), m_sorted_frac.begin() + first_point);
+
+    // Create the children for the non-empty subcells. The nodes are only
+    // accessed by index because adding nodes may reallocate m_nodes.
+    const unsigned int first_child = static_cast<unsigned int>(m_nodes.size());
+    unsigned int subcells[8];
+    unsigned int num_children = 0;
+    for (unsigned int s = 0; s < num_subcells; ++s)
+    {
+        const unsigned int count = subcell_start[s + 1] - subcell_start[s];
+        if (count == 0)
+        {
+            continue;
+        }
+        m_nodes.push_back(makeNode(first_point + subcell_start[s], count));
+        subcells[num_children++] = s;
+    }
+    m_nodes[node].first_child = first_child;
+    m_nodes[node].num_children = num_children;
+
+    for (unsigned int i = 0; i < num_children; ++i)
+    {
+        const unsigned int s = subcells[i];
+        const vec3<float> lower((s & 1) ? center.x : cell_lower.x, (s & 2) ? center.y : cell_lower.y,
+                                (s & 4) ? center.z : cell_lower.z);
+        const vec3<float> upper((s & 1) ? cell_upper.x : center.x, (s & 2) ? cell_upper.y : center.y,
+                                (s & 4) ? cell_upper.z : center.z);
+        subdivide(first_child + i, lower, upper, level + 1);
+    }
+}
+
+inline float AdaptiveCell::lowerBoundDistanceSquared(const vec3<float>& frac,
+                                                     const AdaptiveCellNode& node) const
+{
+    // A displacement that changes the fractional coordinate along a lattice
+    // direction by g is at least g times the distance between the
+    // corresponding box planes long. In orthogonal boxes the contributions
+    // of the directions are independent and can be summed.
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const float dx = fractionalGap(frac.x, node.lower.x, node.upper.x, periodic.x) * m_plane_distance.x;
+    const float dy = fractionalGap(frac.y, node.lower.y, node.upper.y, periodic.y) * m_plane_distance.y;
+    float dz = 0;
+    if (!m_box.is2D())
+    {
+        dz = fractionalGap(frac.z, node.lower.z, node.upper.z, periodic.z) * m_plane_distance.z;
+    }
+    if (m_orthogonal)
+    {
+        return dx * dx + dy * dy + dz * dz;
+    }
+    return std::max(dx * dx, std::max(dy * dy, dz * dz));
+}
+
+void AdaptiveCell::validateQueryArgs(QueryArgs& args) const
+{
+    NeighborQuery::validateQueryArgs(args);
+
+    // Ball queries rely on the minimum image convention
+    if (args.mode == QueryArgs::ball)
+    {
+        const vec3<bool> periodic = m_box.getPeriodic();
+        if ((periodic.x && m_plane_distance.x <= args.r_max * 2.0)
+            || (periodic.y && m_plane_distance.y <= args.r_max * 2.0)
+            || (!m_box.is2D() && periodic.z && m_plane_distance.z <= args.r_max * 2.0))
+        {
+            throw std::runtime_error("The AdaptiveCell r_max is too large for this box.");
+        }
+    }
+}
+
+std::shared_ptr<NeighborQueryPerPointIterator>
+AdaptiveCell::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const
+{
+    this->validateQueryArgs(args);
+    if (args.mode == QueryArgs::ball)
+    {
+        return std::make_shared<AdaptiveCellQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
+                                                               args.r_min, args.exclude_ii);
+    }
+    else if (args.mode == QueryArgs::nearest)
+    {
+        return std::make_shared<AdaptiveCellQueryIterator>(this, query_point, query_point_idx,
+                                                           args.num_neighbors, args.r_max, args.r_min,
+                                                           args.exclude_ii);
+    }
+    else
+    {
+        throw std::runtime_error("Invalid query mode provided to query function in AdaptiveCell.");
+    }
+}
+
+void AdaptiveCell::queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                              const BondBatchFunction& cf, bool parallel, bool squared_distances) const
+{
+    this->validateQueryArgs(args);
+    util::forLoopWrapper(
+        0, n_query_points,
+        [&](size_t begin, size_t end) {
+            std::vector<NeighborBond> bonds;
+            for (size_t i = begin; i != end; ++i)
+            {
+                bonds.clear();
+                if (args.mode == QueryArgs::ball)
+                {
+                    findBallNeighbors(query_points[i], i, args.r_max, args.r_min, args.exclude_ii, bonds);
+                    if (!squared_distances)
+                    {
+                        sqrtBondDistances(bonds);
+                    }
+                }
+                else
+                {
+                    findNearestNeighbors(query_points[i], i, args.num_neighbors, args.r_max, args.r_min,
+                                         args.exclude_ii, bonds);
+                    if (squared_distances)
+                    {
+                        for (NeighborBond& bond : bonds)
+                        {
+                            bond.distance *= bond.distance;
+                        }
+                    }
+                }
+                cf(bonds);
+            }
+        },
+        parallel);
+}
+
+void AdaptiveCell::findBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                                     float r_max, float r_min, bool exclude_ii,
+                                     std::vector<NeighborBond>& bonds) const
+{
+    if (m_box.is2D())
+    {
+        findBallNeighborsImpl<true>(query_point, query_point_idx, r_max, r_min, exclude_ii, bonds);
+    }
+    else
+    {
+        findBallNeighborsImpl<false>(query_point, query_point_idx, r_max, r_min, exclude_ii, bonds);
+    }
+}
+
+void AdaptiveCell::findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                                        unsigned int num_neighbors, float r_max, float r_min,
+                                        bool exclude_ii, std::vector<NeighborBond>& bonds) const
+{
+    if (m_box.is2D())
+    {
+        findNearestNeighborsImpl<true>(query_point, query_point_idx, num_neighbors, r_max, r_min,
+                                       exclude_ii, bonds);
+    }
+    else
+    {
+        findNearestNeighborsImpl<false>(query_point, query_point_idx, num_neighbors, r_max, r_min,
+                                        exclude_ii, bonds);
+    }
+}
+
+template<bool is2D>
+void AdaptiveCell::findBallNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx,
+                                         float r_max, float r_min, bool exclude_ii,
+                                         std::vector<NeighborBond>& bonds) const
+{
+    const float r_max_sq = r_max * r_max;
+    const float r_min_sq = r_min * r_min;
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> frac = getWrappedFractional(query_point);
+    const vec3<int> cell = getCellCoord(frac);
+
+    // The stencil of coarse cells along each lattice direction covers the
+    // number of cells spanned by r_max. Along periodic directions in which
+    // the stencil wraps around the box, each cell is visited once.
+    int range_lower[3], range_upper[3];
+    const int cell_coord[3] = {cell.x, cell.y, cell.z};
+    const int celldim[3]
+        = {static_cast<int>(m_celldim.x), static_cast<int>(m_celldim.y), static_cast<int>(m_celldim.z)};
+    const float plane_distance[3] = {m_plane_distance.x, m_plane_distance.y, m_plane_distance.z};
+    const bool is_periodic[3] = {periodic.x, periodic.y, periodic.z};
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+        if (dim == 2 && is2D)
+        {
+            range_lower[dim] = range_upper[dim] = 0;
+            continue;
+        }
+        const int stencil = static_cast<int>(r_max * float(celldim[dim]) / plane_distance[dim]) + 1;
+        if (is_periodic[dim] && 2 * stencil + 1 >= celldim[dim])
+        {
+            range_lower[dim] = 0;
+            range_upper[dim] = celldim[dim] - 1;
+        }
+        else
+        {
+            range_lower[dim] = cell_coord[dim] - stencil;
+            range_upper[dim] = cell_coord[dim] + stencil;
+            if (!is_periodic[dim])
+            {
+                range_lower[dim] = std::max(range_lower[dim], 0);
+                range_upper[dim] = std::min(range_upper[dim], celldim[dim] - 1);
+            }
+        }
+    }
+
+    // A depth first traversal holds at most 7 pending siblings per level
+    unsigned int node_stack[8 * ADAPTIVE_CELL_MAX_LEVELS];
+    for (int k = range_lower[2]; k <= range_upper[2]; ++k)
+    {
+        const int wrapped_k = (k + celldim[2]) % celldim[2];
+        for (int j = range_lower[1]; j <= range_upper[1]; ++j)
+        {
+            const int wrapped_j = (j + celldim[1]) % celldim[1];
+            for (int i = range_lower[0]; i <= range_upper[0]; ++i)
+            {
+                const int wrapped_i = (i + celldim[0]) % celldim[0];
+                const unsigned int root
+                    = m_cell_nodes[(wrapped_k * celldim[1] + wrapped_j) * celldim[0] + wrapped_i];
+                if (root == EMPTY_CELL)
+                {
+                    continue;
+                }
+
+                unsigned int stack_size = 0;
+                node_stack[stack_size++] = root;
+                while (stack_size > 0)
+                {
+                    const AdaptiveCellNode& node = m_nodes[node_stack[--stack_size]];
+                    if (!(lowerBoundDistanceSquared(frac, node) < r_max_sq))
+                    {
+                        continue;
+                    }
+                    if (node.num_children > 0)
+                    {
+                        for (unsigned int c = 0; c < node.num_children; ++c)
+                        {
+                            node_stack[stack_size++] = node.first_child + c;
+                        }
+                        continue;
+                    }
+
+                    for (unsigned int p = node.first_point; p < node.first_point + node.num_points; ++p)
+                    {
+                        const unsigned int point_idx = m_point_order[p];
+                        if (exclude_ii && point_idx == query_point_idx)
+                        {
+                            continue;
+                        }
+                        vec3<int> image;
+                        const vec3<float> r_ij = m_box.wrap<is2D>(m_sorted_points[p] - query_point, image);
+                        const float r_sq = is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij);
+                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                        {
+                            bonds.emplace_back(query_point_idx, point_idx, r_sq, image);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<bool is2D>
+void AdaptiveCell::findNearestNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx,
+                                            unsigned int num_neighbors, float r_max, float r_min,
+                                            bool exclude_ii, std::vector<NeighborBond>& bonds) const
+{
+    const float r_max_sq = r_max * r_max;
+    const float r_min_sq = r_min * r_min;
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> frac = getWrappedFractional(query_point);
+    const vec3<int> cell = getCellCoord(frac);
+
+    // Offsets of the coarse cells from the cell of the query point. Along
+    // periodic directions the offsets are restricted to one period so that
+    // every cell is reached once.
+    int offset_lower[3], offset_upper[3];
+    const int cell_coord[3] = {cell.x, cell.y, cell.z};
+    const int celldim[3]
+        = {static_cast<int>(m_celldim.x), static_cast<int>(m_celldim.y), static_cast<int>(m_celldim.z)};
+    const bool is_periodic[3] = {periodic.x, periodic.y, periodic.z};
+    int max_shell = 0;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+        if (is_periodic[dim])
+        {
+            offset_lower[dim] = -((celldim[dim] - 1) / 2);
+            offset_upper[dim] = celldim[dim] / 2;
+        }
+        else
+        {
+            offset_lower[dim] = -cell_coord[dim];
+            offset_upper[dim] = celldim[dim] - 1 - cell_coord[dim];
+        }
+        if (dim == 2 && is2D)
+        {
+            offset_lower[dim] = offset_upper[dim] = 0;
+        }
+        max_shell = std::max(max_shell, std::max(-offset_lower[dim], offset_upper[dim]));
+    }
+
+    // Any point in a cell of shell s (the cells whose largest offset is s)
+    // is at least s - 1 cell widths away from the query point.
+    float shell_width
+        = std::min(m_plane_distance.x / float(m_celldim.x), m_plane_distance.y / float(m_celldim.y));
+    if (!is2D)
+    {
+        shell_width = std::min(shell_width, m_plane_distance.z / float(m_celldim.z));
+    }
+
+    // The best candidates so far, with the farthest on top
+    typedef std::pair<float, unsigned int> Candidate;
+    std::priority_queue<Candidate> best;
+    // The nodes to search, with the closest on top
+    typedef std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> NodeQueue;
+    NodeQueue nodes;
+
+    auto push_node = [&](unsigned int node_idx) {
+        const float bound = lowerBoundDistanceSquared(frac, m_nodes[node_idx]);
+        if (bound < r_max_sq && (best.size() < num_neighbors || bound <= best.top().first))
+        {
+            nodes.emplace(bound, node_idx);
+        }
+    };
+    auto push_cell = [&](int i, int j, int k) {
+        const int wrapped_i = ((cell.x + i) % celldim[0] + celldim[0]) % celldim[0];
+        const int wrapped_j = ((cell.y + j) % celldim[1] + celldim[1]) % celldim[1];
+        const int wrapped_k = ((cell.z + k) % celldim[2] + celldim[2]) % celldim[2];
+        const unsigned int root
+            = m_cell_nodes[(wrapped_k * celldim[1] + wrapped_j) * celldim[0] + wrapped_i];
+        if (root != EMPTY_CELL)
+        {
+            push_node(root);
+        }
+    };
+
+    for (int shell = 0; shell <= max_shell; ++shell)
+    {
+        // Add the cells of this shell
+        for (int j = std::max(offset_lower[1], -shell); j <= std::min(offset_upper[1], shell); ++j)
+        {
+            for (int i = std::max(offset_lower[0], -shell); i <= std::min(offset_upper[0], shell); ++i)
+            {
+                if (std::max(std::abs(i), std::abs(j)) == shell)
+                {
+                    for (int k = std::max(offset_lower[2], -shell); k <= std::min(offset_upper[2], shell);
+                         ++k)
+                    {
+                        push_cell(i, j, k);
+                    }
+                }
+                else
+                {
+                    if (offset_lower[2] <= -shell)
+                    {
+                        push_cell(i, j, -shell);
+                    }
+                    if (shell != 0 && offset_upper[2] >= shell)
+                    {
+                        push_cell(i, j, shell);
+                    }
+                }
+            }
+        }
+
+        // Search the nodes that are closer than any cell of the next shell
+        const float next_shell_bound = std::max(float(shell) - float(1e-3), float(0)) * shell_width;
+        const float next_shell_bound_sq = (shell < max_shell) ? next_shell_bound * next_shell_bound
+                                                              : std::numeric_limits<float>::infinity();
+        while (!nodes.empty() && nodes.top().first < next_shell_bound_sq)
+        {
+            const Candidate top = nodes.top();
+            nodes.pop();
+            if (best.size() == num_neighbors && top.first > best.top().first)
+            {
+                // All remaining nodes are farther than the current candidates
+                nodes = NodeQueue();
+                break;
+            }
+
+            const AdaptiveCellNode& node = m_nodes[top.second];
+            if (node.num_children > 0)
+            {
+                for (unsigned int c = 0; c < node.num_children; ++c)
+                {
+                    push_node(node.first_child + c);
+                }
+                continue;
+            }
+
+            for (unsigned int p = node.first_point; p < node.first_point + node.num_points; ++p)
+            {
+                const unsigned int point_idx = m_point_order[p];
+                if (exclude_ii && point_idx == query_point_idx)
+                {
+                    continue;
+                }
+                const vec3<float> r_ij = m_box.wrap<is2D>(m_sorted_points[p] - query_point);
+                const float r_sq = is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij);
+                if (r_sq >= r_max_sq || r_sq < r_min_sq)
+                {
+                    continue;
+                }
+                const Candidate candidate(r_sq, point_idx);
+                if (best.size() < num_neighbors)
+                {
+                    best.push(candidate);
+                }
+                else if (candidate < best.top())
+                {
+                    best.pop();
+                    best.push(candidate);
+                }
+            }
+        }
+
+        // Stop once the next shell cannot contain closer points
+        if ((best.size() == num_neighbors && best.top().first <= next_shell_bound_sq)
+            || next_shell_bound_sq >= r_max_sq)
+        {
+            break;
+        }
+    }
+
+    // Return the neighbors in order of increasing distance. The images are
+    // only found for the returned neighbors.
+    const size_t first_bond = bonds.size();
+    bonds.resize(first_bond + best.size());
+    for (size_t b = bonds.size(); b > first_bond; --b)
+    {
+        const unsigned int point_idx = best.top().second;
+        vec3<int> image;
+        m_box.wrap<is2D>(m_points[point_idx] - query_point, image);
+        bonds[b - 1] = NeighborBond(query_point_idx, point_idx, std::sqrt(best.top().first), image);
+        best.pop();
+    }
+}
+
+NeighborBond AdaptiveCellIterator::next()
+{
+    if (m_count < m_current_neighbors.size())
+    {
+        return m_current_neighbors[m_count++];
+    }
+    m_finished = true;
+    return NeighborQueryIterator::ITERATOR_TERMINATOR;
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,259 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef ADAPTIVE_CELL_H
+#define ADAPTIVE_CELL_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborQuery.h"
+
+/*! \file AdaptiveCell.h
+    \brief Build a multilevel cell grid that adapts to the local density of points.
+*/
+
+namespace freud { namespace locality {
+
+//! Maximum number of times a cell of the coarse grid is subdivided.
+/*! This bounds the depth of the hierarchy when many points (nearly) coincide.
+ */
+const unsigned int ADAPTIVE_CELL_MAX_LEVELS = 10;
+
+//! Node of the hierarchy of cells built by AdaptiveCell.
+/*! The points of a node are stored contiguously in the sorted point arrays
+ *  of AdaptiveCell, and the children of a node are stored contiguously in
+ *  its node array. The bounds are the extent of the fractional coordinates
+ *  of the points in the node, which is at most the region of the cell.
+ */
+struct AdaptiveCellNode
+{
+    vec3<float> lower;         //!< Lower bound of the fractional coordinates of the points
+    vec3<float> upper;         //!< Upper bound of the fractional coordinates of the points
+    unsigned int first_point;  //!< Index of the first point in the sorted point arrays
+    unsigned int num_points;   //!< Number of points in the node
+    unsigned int first_child;  //!< Index of the first child node
+    unsigned int num_children; //!< Number of (non-empty) children, 0 for leaves
+};
+
+//! Multilevel cell grid for finding neighbors in systems with strongly varying density.
+/*! A LinkCell uses a single cell width across the box, so in systems with
+ *  coexisting dense and dilute regions (e.g. liquid droplets in a vapor or
+ *  sedimented suspensions) the cells in dense regions contain many points
+ *  while most other cells are empty. AdaptiveCell instead bins the points
+ *  into a coarse grid and recursively splits every cell that holds more than
+ *  max_points_per_cell points into 4 (2D) or 8 (3D) equal subcells, so the
+ *  resolution of the grid follows the local density. Empty cells of the
+ *  coarse grid do not store any nodes.
+ *
+ *  Queries first visit the stencil of coarse cells that can contain points
+ *  within r_max of the query point, which is chosen per lattice direction
+ *  from the number of cells spanned by r_max. Within each coarse cell, the
+ *  subcells at every level are only entered when the distance between the
+ *  query point and the bounds of their points can be smaller than the
+ *  query distance. This distance is bounded from below using the nearest
+ *  plane distances of the box, so arbitrary triclinic boxes are supported.
+ *  Nearest neighbor queries visit coarse cells in shells of increasing
+ *  distance and traverse the subcells in order of their distance bound.
+ */
+class AdaptiveCell : public NeighborQuery
+{
+public:
+    //! Null Constructor
+    AdaptiveCell();
+
+    //! Constructor
+    /*! \param box Simulation box.
+     *  \param points The points to bin.
+     *  \param n_points The number of points.
+     *  \param cell_width The width of the cells of the coarse grid. If 0, a
+     *         width is estimated from the mean density of the points.
+     *  \param max_points_per_cell Cells holding more points are subdivided.
+     */
+    AdaptiveCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0,
+                 unsigned int max_points_per_cell = 16);
+
+    //! Get the width of the cells of the coarse grid
+    float getCellWidth() const
+    {
+        return m_cell_width;
+    }
+
+    //! Get the dimensions of the coarse grid
+    vec3<unsigned int> getCellDimensions() const
+    {
+        return m_celldim;
+    }
+
+    //! Get the number of points above which cells are subdivided
+    unsigned int getMaxPointsPerCell() const
+    {
+        return m_max_points_per_cell;
+    }
+
+    //! Get the number of nodes in the hierarchy
+    unsigned int getNumNodes() const
+    {
+        return static_cast<unsigned int>(m_nodes.size());
+    }
+
+    //! Get the number of levels in the hierarchy, including the coarse grid
+    unsigned int getNumLevels() const
+    {
+        return m_num_levels;
+    }
+
+    //! Implementation of per-particle query for AdaptiveCell (see NeighborQuery.h for documentation).
+    /*! \param query_point The point to find neighbors for.
+     *  \param n_query_points The number of query points.
+     *  \param qargs The query arguments that should be used to find neighbors.
+     */
+    virtual std::shared_ptr<NeighborQueryPerPointIterator>
+    querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
+
+    //! Bulk query that finds the neighbors of each query point without creating per-point iterators.
+    virtual void queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                            const BondBatchFunction& cf, bool parallel = true,
+                            bool squared_distances = false) const;
+
+    //! Find all neighbors of a point within a ball.
+    /*! The bonds are appended to bonds in no particular order, with the
+     *  squared distances in their distance.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param exclude_ii Whether to exclude neighbors with the same index as the query point.
+     *  \param bonds The vector that found bonds are appended to.
+     */
+    void findBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx, float r_max,
+                           float r_min, bool exclude_ii, std::vector<NeighborBond>& bonds) const;
+
+    //! Find the nearest neighbors of a point.
+    /*! The bonds are appended to bonds in order of increasing distance.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param num_neighbors The number of neighbors to find.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param exclude_ii Whether to exclude neighbors with the same index as the query point.
+     *  \param bonds The vector that found bonds are appended to.
+     */
+    void findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                              unsigned int num_neighbors, float r_max, float r_min, bool exclude_ii,
+                              std::vector<NeighborBond>& bonds) const;
+
+protected:
+    //! Validate the query arguments, rejecting ball queries that violate the minimum image convention
+    virtual void validateQueryArgs(QueryArgs& args) const;
+
+private:
+    //! Bin the points into the coarse grid and build the hierarchy
+    void buildCells();
+
+    //! Create a leaf node for a range of the sorted points
+    AdaptiveCellNode makeNode(unsigned int first_point, unsigned int num_points) const;
+
+    //! Subdivide a node until its children hold at most m_max_points_per_cell points
+    void subdivide(unsigned int node, vec3<float> cell_lower, vec3<float> cell_upper, unsigned int level);
+
+    //! Compute the fractional coordinates of a point, wrapped into the box along periodic directions
+    vec3<float> getWrappedFractional(const vec3<float>& p) const;
+
+    //! Compute the coarse cell coordinates of a point from its wrapped fractional coordinates
+    vec3<int> getCellCoord(const vec3<float>& frac) const;
+
+    //! Lower bound of the squared distance between a point and the points of a node
+    inline float lowerBoundDistanceSquared(const vec3<float>& frac, const AdaptiveCellNode& node) const;
+
+    template<bool is2D>
+    void findBallNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx, float r_max,
+                               float r_min, bool exclude_ii, std::vector<NeighborBond>& bonds) const;
+
+    template<bool is2D>
+    void findNearestNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx,
+                                  unsigned int num_neighbors, float r_max, float r_min, bool exclude_ii,
+                                  std::vector<NeighborBond>& bonds) const;
+
+    float m_cell_width;                 //!< Width of the cells of the coarse grid
+    unsigned int m_max_points_per_cell; //!< Cells holding more points are subdivided
+    vec3<unsigned int> m_celldim;       //!< Dimensions of the coarse grid
+    unsigned int m_num_levels;          //!< Number of levels in the hierarchy
+    vec3<float> m_plane_distance;       //!< Nearest plane distances of the box
+    bool m_orthogonal;                  //!< Whether the box has no tilt factors
+
+    std::vector<unsigned int> m_cell_nodes;   //!< Root node of each coarse cell, or -1 for empty cells
+    std::vector<AdaptiveCellNode> m_nodes;    //!< Nodes of the hierarchy
+    std::vector<unsigned int> m_point_order;  //!< Point indices sorted by node
+    std::vector<vec3<float>> m_sorted_points; //!< Point positions sorted by node
+    std::vector<vec3<float>> m_sorted_frac;   //!< Wrapped fractional coordinates sorted by node
+};
+
+//! Parent class of AdaptiveCell iterators.
+/*! The neighbors of the query point are found by the constructors of the
+ *  subclasses and returned one by one.
+ */
+class AdaptiveCellIterator : public NeighborQueryPerPointIterator
+{
+public:
+    //! Constructor
+    AdaptiveCellIterator(const AdaptiveCell* neighbor_query, const vec3<float> query_point,
+                         unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
+        : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
+                                        exclude_ii),
+          m_count(0)
+    {}
+
+    //! Empty Destructor
+    virtual ~AdaptiveCellIterator() {}
+
+    //! Get the next element.
+    virtual NeighborBond next();
+
+protected:
+    unsigned int m_count;                          //!< Number of neighbors returned for the current point.
+    std::vector<NeighborBond> m_current_neighbors; //!< The neighbors of the current point.
+};
+
+//! Iterator that gets neighbors in a ball of size r_max from an AdaptiveCell.
+class AdaptiveCellQueryBallIterator : public AdaptiveCellIterator
+{
+public:
+    //! Constructor
+    AdaptiveCellQueryBallIterator(const AdaptiveCell* neighbor_query, const vec3<float> query_point,
+                                  unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
+        : AdaptiveCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
+    {
+        neighbor_query->findBallNeighbors(query_point, query_point_idx, r_max, r_min, exclude_ii,
+                                          m_current_neighbors);
+        sqrtBondDistances(m_current_neighbors);
+    }
+
+    //! Empty Destructor
+    virtual ~AdaptiveCellQueryBallIterator() {}
+};
+
+//! Iterator that gets a specified number of nearest neighbors from an AdaptiveCell.
+class AdaptiveCellQueryIterator : public AdaptiveCellIterator
+{
+public:
+    //! Constructor
+    AdaptiveCellQueryIterator(const AdaptiveCell* neighbor_query, const vec3<float> query_point,
+                              unsigned int query_point_idx, unsigned int num_neighbors, float r_max,
+                              float r_min, bool exclude_ii)
+        : AdaptiveCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
+    {
+        neighbor_query->findNearestNeighbors(query_point, query_point_idx, num_neighbors, r_max, r_min,
+                                             exclude_ii, m_current_neighbors);
+    }
+
+    //! Empty Destructor
+    virtual ~AdaptiveCellQueryIterator() {}
+};
+
+}; }; // end namespace freud::locality
+
+#endif // ADAPTIVE_CELL_H
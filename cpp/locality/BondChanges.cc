@@ -0,0 +1,325 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+
+#include "BondChanges.h"
+#include "NeighborListOperations.h"
+#include "utils.h"
+
+/*! \file BondChanges.cc
+    \brief Find the bonds that change between neighbor lists and track bond lifetimes.
+*/
+
+namespace freud { namespace locality {
+
+//! Copy the flagged bonds of a neighbor list, keeping their order.
+/*! The flagged bonds of query point i are written starting at dest_offsets[i].
+ */
+void copyFlaggedBonds(const NeighborList* src, const std::vector<unsigned int>& src_offsets,
+                      const std::vector<char>& flags, const std::vector<unsigned int>& dest_offsets,
+                      NeighborList* dest)
+{
+    const unsigned int num_query_points = static_cast<unsigned int>(src_offsets.size()) - 1;
+    dest->setNumBonds(dest_offsets[num_query_points], src->getNumQueryPoints(), src->getNumPoints());
+    const unsigned int* src_neighbors = src->getNeighbors().get();
+    const float* src_distances = src->getDistances().get();
+    const float* src_weights = src->getWeights().get();
+    unsigned int* dest_neighbors = dest->getNeighbors().get();
+    float* dest_distances = dest->getDistances().get();
+    float* dest_weights = dest->getWeights().get();
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned int dest_bond = dest_offsets[i];
+            for (unsigned int bond = src_offsets[i]; bond < src_offsets[i + 1]; ++bond)
+            {
+                if (flags[bond])
+                {
+                    dest_neighbors[2 * dest_bond] = src_neighbors[2 * bond];
+                    dest_neighbors[2 * dest_bond + 1] = src_neighbors[2 * bond + 1];
+                    dest_distances[dest_bond] = src_distances[bond];
+                    dest_weights[dest_bond] = src_weights[bond];
+                    ++dest_bond;
+                }
+            }
+        }
+    });
+}
+
+void BondChanges::compute(const NeighborList* old_nlist, const NeighborList* new_nlist)
+{
+    if (old_nlist->getNumQueryPoints() != new_nlist->getNumQueryPoints()
+        || old_nlist->getNumPoints() != new_nlist->getNumPoints())
+    {
+        throw std::invalid_argument("The neighbor lists must be built on the same query points and points.");
+    }
+    const unsigned int num_query_points = new_nlist->getNumQueryPoints();
+
+    std::vector<unsigned int> old_offsets;
+    std::vector<unsigned int> new_offsets;
+    computeBondOffsets(old_nlist, old_offsets);
+    computeBondOffsets(new_nlist, new_offsets);
+
+    // Flag the changed bonds and count them for each query point. The counts
+    // are shifted by one so that their prefix sums are the output offsets.
+    std::vector<char> is_broken(old_nlist->getNumBonds(), 0);
+    std::vector<char> is_formed(new_nlist->getNumBonds(), 0);
+    std::vector<unsigned int> broken_offsets(num_query_points + 1, 0);
+    std::vector<unsigned int> formed_offsets(num_query_points + 1, 0);
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        std::vector<std::pair<unsigned int, unsigned int>> old_bonds;
+        std::vector<std::pair<unsigned int, unsigned int>> new_bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortBondsByPoint(old_nlist, old_offsets[i], old_offsets[i + 1], old_bonds);
+            sortBondsByPoint(new_nlist, new_offsets[i], new_offsets[i + 1], new_bonds);
+            mergeSortedBonds(
+                old_bonds.size(), [&](size_t k) { return old_bonds[k].first; }, new_bonds.size(),
+                [&](size_t k) { return new_bonds[k].first; }, [](size_t, size_t) {},
+                [&](size_t k) {
+                    is_broken[old_bonds[k].second] = 1;
+                    ++broken_offsets[i + 1];
+                },
+                [&](size_t k) {
+                    is_formed[new_bonds[k].second] = 1;
+                    ++formed_offsets[i + 1];
+                });
+        }
+    });
+    std::partial_sum(broken_offsets.begin(), broken_offsets.end(), broken_offsets.begin());
+    std::partial_sum(formed_offsets.begin(), formed_offsets.end(), formed_offsets.begin());
+
+    copyFlaggedBonds(old_nlist, old_offsets, is_broken, broken_offsets, m_broken.get());
+    copyFlaggedBonds(new_nlist, new_offsets, is_formed, formed_offsets, m_formed.get());
+}
+
+//! Copy bonds into a neighbor list on num_points query points and points.
+void copyBonds(const std::vector<NeighborBond>& bonds, unsigned int num_points, NeighborList* nlist)
+{
+    nlist->setNumBonds(static_cast<unsigned int>(bonds.size()), num_points, num_points);
+    unsigned int* neighbors = nlist->getNeighbors().get();
+    float* distances = nlist->getDistances().get();
+    float* weights = nlist->getWeights().get();
+    for (size_t bond = 0; bond < bonds.size(); ++bond)
+    {
+        neighbors[2 * bond] = bonds[bond].query_point_idx;
+        neighbors[2 * bond + 1] = bonds[bond].point_idx;
+        distances[bond] = bonds[bond].distance;
+        weights[bond] = bonds[bond].weight;
+    }
+}
+
+void MovedPointBondChanges::prepare(const NeighborQuery* nq, const unsigned int* indices,
+                                    unsigned int n_indices, QueryArgs qargs)
+{
+    if (qargs.mode == QueryArgs::nearest || qargs.num_neighbors != QueryArgs::DEFAULT_NUM_NEIGHBORS)
+    {
+        throw std::invalid_argument("The bond changes of moved points can only be found for ball queries.");
+    }
+    m_indices.assign(indices, indices + n_indices);
+    std::sort(m_indices.begin(), m_indices.end());
+    if (std::adjacent_find(m_indices.begin(), m_indices.end()) != m_indices.end())
+    {
+        throw std::invalid_argument("The indices of the moved points must be distinct.");
+    }
+    if (!m_indices.empty() && m_indices.back() >= nq->getNPoints())
+    {
+        throw std::invalid_argument("Point indices must be less than the number of points.");
+    }
+    m_qargs = qargs;
+    m_num_points = nq->getNPoints();
+    findBonds(nq, m_old_bonds);
+    m_prepared = true;
+}
+
+void MovedPointBondChanges::compute(const NeighborQuery* nq)
+{
+    if (!m_prepared)
+    {
+        throw std::runtime_error("The bonds of the moved points must be found before they move.");
+    }
+    if (nq->getNPoints() != m_num_points)
+    {
+        throw std::invalid_argument(
+            "The number of points changed since the bonds of the moved points were found.");
+    }
+    std::vector<NeighborBond> new_bonds;
+    findBonds(nq, new_bonds);
+
+    // Both lists are sorted by query point and point index, and bonds with
+    // the same indices are matched one to one.
+    auto less_indices = [](const NeighborBond& a, const NeighborBond& b) {
+        return (a.query_point_idx != b.query_point_idx) ? (a.query_point_idx < b.query_point_idx)
+                                                        : (a.point_idx < b.point_idx);
+    };
+    std::vector<NeighborBond> formed;
+    std::vector<NeighborBond> broken;
+    size_t k_old = 0;
+    size_t k_new = 0;
+    while (k_old < m_old_bonds.size() && k_new < new_bonds.size())
+    {
+        if (less_indices(m_old_bonds[k_old], new_bonds[k_new]))
+        {
+            broken.push_back(m_old_bonds[k_old++]);
+        }
+        else if (less_indices(new_bonds[k_new], m_old_bonds[k_old]))
+        {
+            formed.push_back(new_bonds[k_new++]);
+        }
+        else
+        {
+            ++k_old;
+            ++k_new;
+        }
+    }
+    broken.insert(broken.end(), m_old_bonds.begin() + k_old, m_old_bonds.end());
+    formed.insert(formed.end(), new_bonds.begin() + k_new, new_bonds.end());
+
+    copyBonds(formed, m_num_points, m_formed.get());
+    copyBonds(broken, m_num_points, m_broken.get());
+    m_old_bonds.clear();
+    m_prepared = false;
+}
+
+void MovedPointBondChanges::findBonds(const NeighborQuery* nq, std::vector<NeighborBond>& bonds) const
+{
+    const unsigned int n_indices = static_cast<unsigned int>(m_indices.size());
+    std::vector<vec3<float>> query_points(n_indices);
+    for (unsigned int k = 0; k < n_indices; ++k)
+    {
+        query_points[k] = (*nq)[m_indices[k]];
+    }
+
+    // The query point indices of the bonds are positions in m_indices, so
+    // self-neighbors are excluded here rather than by the query.
+    QueryArgs qargs(m_qargs);
+    qargs.exclude_ii = false;
+    tbb::enumerable_thread_specific<std::vector<NeighborBond>> local_bonds;
+    if (n_indices != 0)
+    {
+        nq->queryBonds(query_points.data(), n_indices, qargs, [&](const std::vector<NeighborBond>& batch) {
+            std::vector<NeighborBond>& found = local_bonds.local();
+            for (const NeighborBond& nb : batch)
+            {
+                const unsigned int i = m_indices[nb.query_point_idx];
+                const unsigned int j = nb.point_idx;
+                if (m_qargs.exclude_ii && i == j)
+                {
+                    continue;
+                }
+                found.emplace_back(i, j, nb.distance);
+                // Bonds from other moved points are found by their own queries.
+                if (!std::binary_search(m_indices.begin(), m_indices.end(), j))
+                {
+                    found.emplace_back(j, i, nb.distance);
+                }
+            }
+        });
+    }
+
+    bonds.clear();
+    for (const std::vector<NeighborBond>& found : local_bonds)
+    {
+        bonds.insert(bonds.end(), found.begin(), found.end());
+    }
+    std::sort(bonds.begin(), bonds.end(), [](const NeighborBond& a, const NeighborBond& b) {
+        if (a.query_point_idx != b.query_point_idx)
+        {
+            return a.query_point_idx < b.query_point_idx;
+        }
+        if (a.point_idx != b.point_idx)
+        {
+            return a.point_idx < b.point_idx;
+        }
+        return a.distance < b.distance;
+    });
+}
+
+BondLifetime::BondLifetime() : m_num_frames(0), m_num_query_points(0), m_num_points(0) {}
+
+void BondLifetime::reset()
+{
+    m_num_frames = 0;
+    m_num_query_points = 0;
+    m_num_points = 0;
+    m_offsets.clear();
+    m_point_indices.clear();
+    m_first_frames.clear();
+    m_histogram = util::ManagedArray<unsigned int>();
+}
+
+void BondLifetime::compute(const NeighborList* nlist)
+{
+    const unsigned int frame = m_num_frames;
+    if (frame != 0
+        && (nlist->getNumQueryPoints() != m_num_query_points || nlist->getNumPoints() != m_num_points))
+    {
+        throw std::invalid_argument(
+            "The neighbor list must be built on the same query points and points as the previous frames.");
+    }
+    const unsigned int num_query_points = nlist->getNumQueryPoints();
+
+    std::vector<unsigned int> offsets;
+    computeBondOffsets(nlist, offsets);
+
+    // Every bond of the new frame is either matched with a tracked bond or
+    // newly formed, so the tracked bonds of the new frame have the same
+    // offsets as the neighbor list. Lifetimes are at most the frame index.
+    std::vector<unsigned int> point_indices(nlist->getNumBonds());
+    std::vector<unsigned int> first_frames(nlist->getNumBonds());
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> local_histograms(
+        std::vector<unsigned int>(frame + 1, 0));
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        std::vector<unsigned int>& histogram = local_histograms.local();
+        std::vector<std::pair<unsigned int, unsigned int>> bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortBondsByPoint(nlist, offsets[i], offsets[i + 1], bonds);
+            const unsigned int tracked_begin = (frame != 0) ? m_offsets[i] : 0;
+            const unsigned int tracked_end = (frame != 0) ? m_offsets[i + 1] : 0;
+            unsigned int out = offsets[i];
+            mergeSortedBonds(
+                tracked_end - tracked_begin, [&](size_t k) { return m_point_indices[tracked_begin + k]; },
+                bonds.size(), [&](size_t k) { return bonds[k].first; },
+                [&](size_t k_old, size_t k_new) {
+                    point_indices[out] = bonds[k_new].first;
+                    first_frames[out] = m_first_frames[tracked_begin + k_old];
+                    ++out;
+                },
+                [&](size_t k) { ++histogram[frame - m_first_frames[tracked_begin + k]]; },
+                [&](size_t k) {
+                    point_indices[out] = bonds[k].first;
+                    first_frames[out] = frame;
+                    ++out;
+                });
+        }
+    });
+
+    // Allocate a new histogram so that arrays previously handed out are not modified.
+    util::ManagedArray<unsigned int> histogram(frame + 1);
+    for (size_t lifetime = 0; lifetime < m_histogram.size(); ++lifetime)
+    {
+        histogram[lifetime] = m_histogram[lifetime];
+    }
+    for (const auto& local_histogram : local_histograms)
+    {
+        for (size_t lifetime = 0; lifetime < local_histogram.size(); ++lifetime)
+        {
+            histogram[lifetime] += local_histogram[lifetime];
+        }
+    }
+    m_histogram = histogram;
+
+    m_offsets.swap(offsets);
+    m_point_indices.swap(point_indices);
+    m_first_frames.swap(first_frames);
+    m_num_query_points = num_query_points;
+    m_num_points = nlist->getNumPoints();
+    ++m_num_frames;
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,180 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOND_CHANGES_H
+#define BOND_CHANGES_H
+
+#include <memory>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file BondChanges.h
+    \brief Find the bonds that change between neighbor lists and track bond lifetimes.
+*/
+
+namespace freud { namespace locality {
+
+//! Find the bonds that are formed and broken between two neighbor lists.
+/*! Both neighbor lists must be built on the same query points and points
+ *  and be sorted by query point index, which is the case for all neighbor
+ *  lists created by freud. The bonds of each query point are compared with
+ *  a merge join over the point indices, which runs in parallel over query
+ *  points and in linear time if the bonds of each query point are sorted by
+ *  point index (segments that are not sorted are sorted first).
+ *
+ *  Bonds are identified by their pair of indices only. Pairs that appear
+ *  several times in a neighbor list (e.g. bonds to multiple periodic images
+ *  in small boxes) are matched one to one, so a pair that appears twice in
+ *  the new list and once in the old list is reported as formed once.
+ */
+class BondChanges
+{
+public:
+    //! Constructor
+    BondChanges()
+        : m_formed(std::make_shared<NeighborList>()), m_broken(std::make_shared<NeighborList>())
+    {}
+
+    //! Find the bonds that differ between old_nlist and new_nlist
+    void compute(const NeighborList* old_nlist, const NeighborList* new_nlist);
+
+    //! Get the bonds of new_nlist that are not in old_nlist, with the distances and weights of new_nlist
+    std::shared_ptr<NeighborList> getFormedBonds() const
+    {
+        return m_formed;
+    }
+
+    //! Get the bonds of old_nlist that are not in new_nlist, with the distances and weights of old_nlist
+    std::shared_ptr<NeighborList> getBrokenBonds() const
+    {
+        return m_broken;
+    }
+
+private:
+    std::shared_ptr<NeighborList> m_formed; //!< Bonds formed between the neighbor lists
+    std::shared_ptr<NeighborList> m_broken; //!< Bonds broken between the neighbor lists
+};
+
+//! Find the bonds that are formed and broken when some of the points of a NeighborQuery move.
+/*! Instead of comparing the neighbor lists of all points, only the moved
+ *  points are queried, once before they move (prepare()) and once after the
+ *  NeighborQuery was updated (compute()), so the cost scales with the number
+ *  of moved points and their neighbors rather than with the number of
+ *  points. Since the bonds of ball queries are symmetric, the bonds of the
+ *  moved points found from their own queries also give the bonds in which
+ *  they are the neighbor, and the reported bonds include both directions.
+ *  Only ball queries are supported.
+ *
+ *  The neighbor lists of formed and broken bonds are sorted by query point
+ *  and point index and are built on all points of the NeighborQuery, so they
+ *  are the bonds that BondChanges would report between ball query neighbor
+ *  lists of all points before and after the move.
+ */
+class MovedPointBondChanges
+{
+public:
+    //! Constructor
+    MovedPointBondChanges()
+        : m_num_points(0), m_prepared(false), m_formed(std::make_shared<NeighborList>()),
+          m_broken(std::make_shared<NeighborList>())
+    {}
+
+    //! Find the bonds of the points that are about to move
+    /*! \param nq The NeighborQuery holding the points before the move.
+     *  \param indices The indices of the points that will move, which must be distinct.
+     *  \param n_indices The number of points that will move.
+     *  \param qargs The query arguments of the bonds, which must describe a ball query.
+     */
+    void prepare(const NeighborQuery* nq, const unsigned int* indices, unsigned int n_indices,
+                 QueryArgs qargs);
+
+    //! Find the bonds of the moved points that were formed and broken since prepare was called
+    /*! \param nq The NeighborQuery after it was updated with the moved points.
+     */
+    void compute(const NeighborQuery* nq);
+
+    //! Get the bonds formed by the move, with their distances after the move
+    std::shared_ptr<NeighborList> getFormedBonds() const
+    {
+        return m_formed;
+    }
+
+    //! Get the bonds broken by the move, with their distances before the move
+    std::shared_ptr<NeighborList> getBrokenBonds() const
+    {
+        return m_broken;
+    }
+
+private:
+    //! Find the bonds of the moved points in both directions, sorted by query point and point index
+    void findBonds(const NeighborQuery* nq, std::vector<NeighborBond>& bonds) const;
+
+    std::vector<unsigned int> m_indices;    //!< Sorted indices of the moved points
+    QueryArgs m_qargs;                      //!< Query arguments of the bonds
+    unsigned int m_num_points;              //!< Number of points of the NeighborQuery
+    bool m_prepared;                        //!< Whether prepare was called since the last compute
+    std::vector<NeighborBond> m_old_bonds;  //!< Bonds of the moved points before the move
+    std::shared_ptr<NeighborList> m_formed; //!< Bonds formed by the move
+    std::shared_ptr<NeighborList> m_broken; //!< Bonds broken by the move
+};
+
+//! Track the lifetimes of bonds over a sequence of neighbor lists.
+/*! Each call to compute() adds a frame. A bond that is present in frames
+ *  f, ..., g - 1 and absent in frame g has a lifetime of g - f frames, which
+ *  is added to a histogram of lifetimes when the bond breaks. Bonds that
+ *  are still present in the last frame have not completed their lifetime
+ *  and are not included in the histogram.
+ *
+ *  Only the bonds of the last frame are stored (sorted by query point and
+ *  point index, with the frame they were formed in), so the memory used
+ *  scales with the number of bonds and not with the number of frames.
+ *  Bonds are matched between frames as in BondChanges.
+ */
+class BondLifetime
+{
+public:
+    //! Constructor
+    BondLifetime();
+
+    //! Add the bonds of a frame
+    void compute(const NeighborList* nlist);
+
+    //! Forget all tracked bonds and reset the histogram of lifetimes
+    void reset();
+
+    //! Get the number of frames added since the last reset
+    unsigned int getNumFrames() const
+    {
+        return m_num_frames;
+    }
+
+    //! Get the number of bonds present in the last frame
+    unsigned int getNumBonds() const
+    {
+        return static_cast<unsigned int>(m_point_indices.size());
+    }
+
+    //! Get the histogram of bond lifetimes, indexed by the lifetime in frames
+    const util::ManagedArray<unsigned int>& getLifetimeHistogram() const
+    {
+        return m_histogram;
+    }
+
+private:
+    unsigned int m_num_frames;       //!< Number of frames added since the last reset
+    unsigned int m_num_query_points; //!< Number of query points of the tracked neighbor lists
+    unsigned int m_num_points;       //!< Number of points of the tracked neighbor lists
+
+    std::vector<unsigned int> m_offsets;       //!< First tracked bond of each query point
+    std::vector<unsigned int> m_point_indices; //!< Point index of each tracked bond
+    std::vector<unsigned int> m_first_frames;  //!< Frame in which each tracked bond was formed
+
+    util::ManagedArray<unsigned int> m_histogram; //!< Histogram of completed bond lifetimes
+};
+
+}; }; // end namespace freud::locality
+
+#endif // BOND_CHANGES_H
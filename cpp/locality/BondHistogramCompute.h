@@ -99,14 +99,16 @@ public:
            appropriately with given qargs.
         \param qargs Query arguments
         \param cf An object with operator(NeighborBond) as input.
+        \param squared_distances Whether cf receives squared distances (see locality::loopOverNeighbors).
     */
     template<typename Func>
     void accumulateGeneral(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                            unsigned int n_query_points, const locality::NeighborList* nlist,
-                           locality::QueryArgs qargs, Func cf)
+                           locality::QueryArgs qargs, Func cf, bool squared_distances = false)
     {
         m_box = neighbor_query->getBox();
-        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
+        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf, true,
+                                    squared_distances);
         m_frame_counter++;
         m_n_points = neighbor_query->getNPoints();
         m_n_query_points = n_query_points;
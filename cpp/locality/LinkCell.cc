@@ -202,10 +202,14 @@ void IteratorCellShell::reset(unsigned int range)
  ********************/
 
 // Default constructor
-LinkCell::LinkCell() : NeighborQuery(), m_n_points(0), m_cell_width(0), m_celldim(0, 0, 0) {}
+LinkCell::LinkCell()
+    : NeighborQuery(), m_list_capacity(0), m_cell_width(0), m_celldim(0, 0, 0), m_cell_radius(0),
+      m_cells_bound_points(false)
+{}
 
 LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width)
-    : NeighborQuery(box, points, n_points), m_n_points(0), m_cell_width(cell_width), m_celldim(0, 0, 0)
+    : NeighborQuery(box, points, n_points), m_list_capacity(0), m_cell_width(cell_width),
+      m_celldim(0, 0, 0), m_cell_radius(0), m_cells_bound_points(false)
 {
     // If no cell width is provided, we calculate the system density and
     // estimate the number of cells that would lead to 10 particles per cell.
@@ -241,6 +245,22 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
         throw std::runtime_error("At least one cell must be present.");
     }
 
+    // A cell is a parallelepiped spanned by the lattice vectors divided by
+    // the cell dimensions, whose farthest corner from the center is found
+    // among the half diagonals.
+    const vec3<float> cell_a = box.getLatticeVector(0) / float(m_celldim.x);
+    const vec3<float> cell_b = box.getLatticeVector(1) / float(m_celldim.y);
+    const vec3<float> cell_c
+        = box.is2D() ? vec3<float>(0, 0, 0) : box.getLatticeVector(2) / float(m_celldim.z);
+    for (float sign_b : {-1.0f, 1.0f})
+    {
+        for (float sign_c : {-1.0f, 1.0f})
+        {
+            const vec3<float> half_diagonal = float(0.5) * (cell_a + sign_b * cell_b + sign_c * cell_c);
+            m_cell_radius = std::max(m_cell_radius, std::sqrt(dot(half_diagonal, half_diagonal)));
+        }
+    }
+
     computeCellList(points, n_points);
 }
 
@@ -297,8 +317,9 @@ void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
     // determine the number of cells and allocate memory
     unsigned int Nc = getNumCells();
     m_cell_list.prepare(n_points + Nc);
-    m_n_points = n_points;
+    m_list_capacity = n_points;
     m_Nc = Nc;
+    m_point_cells.resize(n_points);
 
     // initialize memory
     for (unsigned int cell = 0; cell < Nc; cell++)
@@ -309,12 +330,162 @@ void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
     // generate the cell list
     for (int i = n_points - 1; i >= 0; i--)
     {
-        unsigned int cell = getCell(points[i]);
-        m_cell_list[i] = m_cell_list[n_points + cell];
-        m_cell_list[n_points + cell] = i;
+        linkPoint(i, getCell(points[i]));
+    }
+
+    // Along periodic directions, every point lies within its cell in some
+    // image of the box. Points outside of the box along aperiodic directions
+    // are binned into cells that do not contain them.
+    const vec3<bool> periodic = m_box.getPeriodic();
+    m_cells_bound_points = true;
+    if (!periodic.x || !periodic.y || (!m_box.is2D() && !periodic.z))
+    {
+        for (unsigned int i = 0; i < n_points && m_cells_bound_points; ++i)
+        {
+            m_cells_bound_points = isInsideGrid(points[i]);
+        }
     }
 }
 
+bool LinkCell::isInsideGrid(const vec3<float>& point) const
+{
+    const vec3<bool> periodic = m_box.getPeriodic();
+    auto outside_grid = [](bool is_periodic, float alpha, unsigned int dim) {
+        return !is_periodic && !(alpha >= 0 && std::floor(alpha * float(dim)) < float(dim));
+    };
+    const vec3<float> alpha = m_box.makeFractional(point);
+    return !(outside_grid(periodic.x, alpha.x, m_celldim.x) || outside_grid(periodic.y, alpha.y, m_celldim.y)
+             || (!m_box.is2D() && outside_grid(periodic.z, alpha.z, m_celldim.z)));
+}
+
+void LinkCell::linkPoint(unsigned int i, unsigned int cell)
+{
+    m_cell_list[i] = m_cell_list[m_list_capacity + cell];
+    m_cell_list[m_list_capacity + cell] = i;
+    m_point_cells[i] = cell;
+}
+
+void LinkCell::unlinkPoint(unsigned int i)
+{
+    // Find the link pointing to the point, starting from the head of its cell
+    unsigned int link = m_list_capacity + m_point_cells[i];
+    while (m_cell_list[link] != i)
+    {
+        link = m_cell_list[link];
+    }
+    m_cell_list[link] = m_cell_list[i];
+}
+
+void LinkCell::reserveCellList(unsigned int n_points)
+{
+    if (n_points <= m_list_capacity)
+    {
+        return;
+    }
+
+    // The heads of the cells follow the links of the points, so they move
+    // when the capacity changes. Links to points are unaffected.
+    const unsigned int capacity = std::max(n_points, 2 * m_list_capacity);
+    util::ManagedArray<unsigned int> cell_list(capacity + m_Nc);
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        cell_list[i] = m_cell_list[i];
+    }
+    for (unsigned int cell = 0; cell < m_Nc; ++cell)
+    {
+        cell_list[capacity + cell] = m_cell_list[m_list_capacity + cell];
+    }
+    m_cell_list = cell_list;
+    m_list_capacity = capacity;
+}
+
+void LinkCell::updatePoints(const vec3<float>* points, const unsigned int* indices, unsigned int n_indices)
+{
+    validatePointIndices(points, m_n_points, indices, n_indices, true);
+    m_points = points;
+    for (unsigned int k = 0; k < n_indices; ++k)
+    {
+        const unsigned int i = indices[k];
+        const unsigned int cell = getCell(points[i]);
+        if (cell != m_point_cells[i])
+        {
+            unlinkPoint(i);
+            linkPoint(i, cell);
+        }
+        // Points moved back into the grid are not tracked, so the flag is
+        // only restored when the cell list is recomputed.
+        m_cells_bound_points = m_cells_bound_points && isInsideGrid(points[i]);
+    }
+}
+
+void LinkCell::insertPoints(const vec3<float>* points, unsigned int n_points)
+{
+    validateInsertedPoints(points, n_points);
+    const unsigned int old_n_points = m_n_points;
+    reserveCellList(n_points);
+    m_point_cells.resize(n_points);
+    m_points = points;
+    m_n_points = n_points;
+    for (unsigned int i = old_n_points; i < n_points; ++i)
+    {
+        linkPoint(i, getCell(points[i]));
+        m_cells_bound_points = m_cells_bound_points && isInsideGrid(points[i]);
+    }
+}
+
+void LinkCell::removePoints(const vec3<float>* points, unsigned int n_points, const unsigned int* indices,
+                            unsigned int n_indices)
+{
+    const std::vector<unsigned int> removed = sortRemovedPointIndices(n_points, indices, n_indices);
+
+    // The last point takes the index of each removed point, keeping its cell.
+    unsigned int last = m_n_points;
+    for (const unsigned int i : removed)
+    {
+        --last;
+        unlinkPoint(i);
+        if (i != last)
+        {
+            const unsigned int cell = m_point_cells[last];
+            unlinkPoint(last);
+            linkPoint(i, cell);
+        }
+    }
+    m_point_cells.resize(n_points);
+    m_points = points;
+    m_n_points = n_points;
+}
+
+bool LinkCell::getCellDistanceBounds(const vec3<int>& cell, const vec3<float>& point, float& min_distance,
+                                     float& max_distance) const
+{
+    const vec3<bool> periodic = m_box.getPeriodic();
+    auto outside_grid = [](bool is_periodic, int coord, unsigned int dim) {
+        return !is_periodic && (coord < 0 || coord >= static_cast<int>(dim));
+    };
+    if (!m_cells_bound_points || outside_grid(periodic.x, cell.x, m_celldim.x)
+        || outside_grid(periodic.y, cell.y, m_celldim.y)
+        || (!m_box.is2D() && outside_grid(periodic.z, cell.z, m_celldim.z)))
+    {
+        return false;
+    }
+
+    const vec3<float> frac_center((float(cell.x) + float(0.5)) / float(m_celldim.x),
+                                  (float(cell.y) + float(0.5)) / float(m_celldim.y),
+                                  (float(cell.z) + float(0.5)) / float(m_celldim.z));
+    vec3<float> delta = m_box.makeAbsolute(frac_center) - point;
+    if (m_box.is2D())
+    {
+        delta.z = 0;
+    }
+    // The bounds are padded slightly so that rounding never discards a neighbor
+    const float center_distance = std::sqrt(dot(delta, delta));
+    const float padding = float(1e-5) * (center_distance + m_cell_radius);
+    min_distance = center_distance - m_cell_radius - padding;
+    max_distance = center_distance + m_cell_radius + padding;
+    return true;
+}
+
 vec3<unsigned int> LinkCell::indexToCoord(unsigned int x) const
 {
     std::vector<size_t> coord
@@ -338,16 +509,45 @@ unsigned int LinkCell::coordToIndex(int x, int y, int z) const
 vec3<unsigned int> LinkCell::getCellCoord(const vec3<float> p) const
 {
     vec3<float> alpha = m_box.makeFractional(p);
+    // Points outside of the box are binned into the cell of their image
+    // inside of the box.
+    auto wrap_cell = [](float frac, unsigned int dim) {
+        const int cell = static_cast<int>(std::floor(frac * float(dim))) % static_cast<int>(dim);
+        return static_cast<unsigned int>(cell < 0 ? cell + static_cast<int>(dim) : cell);
+    };
     vec3<unsigned int> c;
-    c.x = (unsigned int) std::floor(alpha.x * float(m_celldim.x));
-    c.x %= m_celldim.x;
-    c.y = (unsigned int) std::floor(alpha.y * float(m_celldim.y));
-    c.y %= m_celldim.y;
-    c.z = (unsigned int) std::floor(alpha.z * float(m_celldim.z));
-    c.z %= m_celldim.z;
+    c.x = wrap_cell(alpha.x, m_celldim.x);
+    c.y = wrap_cell(alpha.y, m_celldim.y);
+    c.z = wrap_cell(alpha.z, m_celldim.z);
     return c;
 }
 
+vec3<float> LinkCell::wrapToCell(const vec3<float>& p) const
+{
+    // The image is found from the same unwrapped cell coordinates as in
+    // getCellCoord, so that rounding at the box faces cannot separate the
+    // point from its cell.
+    const vec3<float> alpha = m_box.makeFractional(p);
+    const vec3<bool> periodic = m_box.getPeriodic();
+    auto cell_image = [](float frac, unsigned int dim) {
+        return std::floor(std::floor(frac * float(dim)) / float(dim));
+    };
+    vec3<float> wrapped(p);
+    if (periodic.x)
+    {
+        wrapped -= cell_image(alpha.x, m_celldim.x) * vec3<float>(m_box.getLatticeVector(0));
+    }
+    if (periodic.y)
+    {
+        wrapped -= cell_image(alpha.y, m_celldim.y) * vec3<float>(m_box.getLatticeVector(1));
+    }
+    if (!m_box.is2D() && periodic.z)
+    {
+        wrapped -= cell_image(alpha.z, m_celldim.z) * vec3<float>(m_box.getLatticeVector(2));
+    }
+    return wrapped;
+}
+
 const std::vector<unsigned int>& LinkCell::getCellNeighbors(unsigned int cell) const
 {
     // check if the list of neighbors has been already computed
@@ -471,7 +671,169 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     }
 }
 
+bool LinkCell::requiresImageSearch(float r_max) const
+{
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    return (periodic.x && plane_distance.x <= r_max * 2.0f)
+        || (periodic.y && plane_distance.y <= r_max * 2.0f)
+        || (!m_box.is2D() && periodic.z && plane_distance.z <= r_max * 2.0f);
+}
+
+void LinkCell::findImageBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                                      float r_max, float r_min, bool exclude_ii,
+                                      std::vector<NeighborBond>& bonds) const
+{
+    if (m_box.is2D())
+    {
+        findImageBallNeighborsImpl<true>(query_point, query_point_idx, r_max, r_min, exclude_ii, bonds);
+    }
+    else
+    {
+        findImageBallNeighborsImpl<false>(query_point, query_point_idx, r_max, r_min, exclude_ii, bonds);
+    }
+}
+
+template<bool is2D>
+void LinkCell::findImageBallNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx,
+                                          float r_max, float r_min, bool exclude_ii,
+                                          std::vector<NeighborBond>& bonds) const
+{
+    const float r_max_sq = r_max * r_max;
+    const float r_min_sq = r_min * r_min;
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const vec3<float> latt_a(m_box.getLatticeVector(0));
+    const vec3<float> latt_b(m_box.getLatticeVector(1));
+    const vec3<float> latt_c(is2D ? vec3<float>(0, 0, 0) : m_box.getLatticeVector(2));
+
+    // The query sphere spans r_max / d in fractional coordinates along each
+    // lattice vector, padded so that rounding never discards a neighbor.
+    // Along periodic directions, the range of cells it overlaps is not
+    // wrapped: cell coordinates outside [0, dim) refer to the cells of the
+    // corresponding image of the box. Points outside of the box along
+    // aperiodic directions may be binned into any cell, so all cells are
+    // searched along those directions.
+    const float padding = float(1e-5);
+    const vec3<float> frac_query = m_box.makeFractional<is2D>(query_point);
+    auto cell_range = [padding](bool search_images, float frac, float half_width, unsigned int dim,
+                                int& lower, int& upper) {
+        lower = 0;
+        upper = static_cast<int>(dim) - 1;
+        if (search_images)
+        {
+            lower = static_cast<int>(std::floor((frac - half_width - padding) * float(dim)));
+            upper = static_cast<int>(std::floor((frac + half_width + padding) * float(dim)));
+        }
+    };
+    int lower_x, upper_x, lower_y, upper_y, lower_z, upper_z;
+    cell_range(periodic.x, frac_query.x, r_max / plane_distance.x, m_celldim.x, lower_x, upper_x);
+    cell_range(periodic.y, frac_query.y, r_max / plane_distance.y, m_celldim.y, lower_y, upper_y);
+    cell_range(!is2D && periodic.z, frac_query.z, r_max / plane_distance.z, m_celldim.z, lower_z, upper_z);
+
+    // Image of the box holding an unwrapped cell coordinate
+    auto cell_image = [](int cell, unsigned int dim) {
+        return static_cast<int>(std::floor(float(cell) / float(dim)));
+    };
+
+    // Image of the box in which a point lies, relative to the cell it is
+    // binned in. Since the point lies within its cell up to rounding, this
+    // is the nearest integer to the offset from the center of the cell.
+    auto point_image = [](float frac, int cell, unsigned int dim) {
+        return static_cast<int>(std::floor(frac - (float(cell) + float(0.5)) / float(dim) + float(0.5)));
+    };
+
+    for (int cell_z = lower_z; cell_z <= upper_z; ++cell_z)
+    {
+        const int image_z = cell_image(cell_z, m_celldim.z);
+        const int wrapped_z = cell_z - image_z * static_cast<int>(m_celldim.z);
+        for (int cell_y = lower_y; cell_y <= upper_y; ++cell_y)
+        {
+            const int image_y = cell_image(cell_y, m_celldim.y);
+            const int wrapped_y = cell_y - image_y * static_cast<int>(m_celldim.y);
+            for (int cell_x = lower_x; cell_x <= upper_x; ++cell_x)
+            {
+                // Cells lying entirely outside of the shell between r_min
+                // and r_max cannot contain any neighbors
+                float min_distance, max_distance;
+                if (getCellDistanceBounds(vec3<int>(cell_x, cell_y, cell_z), query_point, min_distance,
+                                          max_distance)
+                    && (min_distance >= r_max || max_distance < r_min))
+                {
+                    continue;
+                }
+
+                const int image_x = cell_image(cell_x, m_celldim.x);
+                const int wrapped_x = cell_x - image_x * static_cast<int>(m_celldim.x);
+
+                iteratorcell cell_iter = itercell(coordToIndex(wrapped_x, wrapped_y, wrapped_z));
+                for (unsigned int j = cell_iter.next(); !cell_iter.atEnd(); j = cell_iter.next())
+                {
+                    if (exclude_ii && query_point_idx == j)
+                    {
+                        continue;
+                    }
+
+                    // Move the point into the image of the box holding this
+                    // cell. Along aperiodic directions, points are never moved.
+                    const vec3<float> pos_j(m_points[j]);
+                    const vec3<float> frac_j = m_box.makeFractional<is2D>(pos_j);
+                    vec3<float> image(0, 0, 0);
+                    if (periodic.x)
+                    {
+                        image.x = float(image_x - point_image(frac_j.x, wrapped_x, m_celldim.x));
+                    }
+                    if (periodic.y)
+                    {
+                        image.y = float(image_y - point_image(frac_j.y, wrapped_y, m_celldim.y));
+                    }
+                    if (!is2D && periodic.z)
+                    {
+                        image.z = float(image_z - point_image(frac_j.z, wrapped_z, m_celldim.z));
+                    }
+
+                    const vec3<float> r_ij
+                        = pos_j + image.x * latt_a + image.y * latt_b + image.z * latt_c - query_point;
+                    const float r_sq(is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij));
+
+                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                    {
+                        bonds.emplace_back(query_point_idx, j, r_sq,
+                                           vec3<int>(static_cast<int>(image.x), static_cast<int>(image.y),
+                                                     static_cast<int>(image.z)));
+                    }
+                }
+            }
+        }
+    }
+}
+
 NeighborBond LinkCellQueryBallIterator::next()
+{
+    if (m_image_search)
+    {
+        if (m_count < m_current_neighbors.size())
+        {
+            NeighborBond nb = m_current_neighbors[m_count++];
+            if (!m_squared_distances)
+            {
+                nb.distance = std::sqrt(nb.distance);
+            }
+            return nb;
+        }
+        m_finished = true;
+        return NeighborQueryIterator::ITERATOR_TERMINATOR;
+    }
+
+    // Dispatch on the dimensionality once per call rather than once per candidate
+    if (m_neighbor_query->getBox().is2D())
+    {
+        return nextImpl<true>();
+    }
+    return nextImpl<false>();
+}
+
+template<bool is2D> NeighborBond LinkCellQueryBallIterator::nextImpl()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
@@ -495,12 +857,15 @@ NeighborBond LinkCellQueryBallIterator::next()
                 continue;
             }
 
-            const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-            const float r_sq(dot(r_ij, r_ij));
+            vec3<int> image;
+            const vec3<float> r_ij(
+                m_neighbor_query->getBox().wrap<is2D>((*m_linkcell)[j] - m_query_point, image));
+            const float r_sq(is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij));
 
             if (r_sq < r_max_sq && r_sq >= r_min_sq)
             {
-                return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+                return NeighborBond(m_query_point_idx, j, m_squared_distances ? r_sq : std::sqrt(r_sq),
+                                    image);
             }
         }
 
@@ -519,12 +884,27 @@ NeighborBond LinkCellQueryBallIterator::next()
                 break;
             }
 
-            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
+            const vec3<int> neighbor_cell = vec3<int>(point_cell.x, point_cell.y, point_cell.z)
+                + (*m_neigh_cell_iter);
+            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(neighbor_cell);
+
+            // Cells lying entirely beyond r_max are skipped without marking
+            // them as searched, since the cell may be reached again through
+            // a closer image when the shells wrap around the box. Cells
+            // lying entirely within r_min are marked as searched without
+            // visiting their points.
+            float min_distance, max_distance;
+            const bool bounded = m_linkcell->getCellDistanceBounds(neighbor_cell, m_cell_query_point,
+                                                                   min_distance, max_distance);
+            if (bounded && min_distance >= m_r_max)
+            {
+                continue;
+            }
+
             // Insertion to an unordered set returns a pair, the second
             // element indicates insertion success or failure (if it
             // already exists)
-            if (m_searched_cells.insert(neighbor_cell_index).second)
+            if (m_searched_cells.insert(neighbor_cell_index).second && !(bounded && max_distance < m_r_min))
             {
                 // This cell has not been searched yet, so we will iterate
                 // over its contents. Otherwise, we loop back, increment
@@ -544,13 +924,23 @@ NeighborBond LinkCellQueryBallIterator::next()
 }
 
 NeighborBond LinkCellQueryIterator::next()
+{
+    // Dispatch on the dimensionality once per call rather than once per candidate
+    if (m_neighbor_query->getBox().is2D())
+    {
+        return nextImpl<true>();
+    }
+    return nextImpl<false>();
+}
+
+template<bool is2D> NeighborBond LinkCellQueryIterator::nextImpl()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
     vec3<float> plane_distance = m_neighbor_query->getBox().getNearestPlaneDistance();
     float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
-    if (!m_neighbor_query->getBox().is2D())
+    if (!is2D)
     {
         min_plane_distance = std::min(min_plane_distance, plane_distance.z);
     }
@@ -565,7 +955,7 @@ NeighborBond LinkCellQueryIterator::next()
     if (!m_current_neighbors.size())
     {
         // Expand search cell radius until termination conditions are met.
-        while (m_neigh_cell_iter != IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
+        while (m_neigh_cell_iter != IteratorCellShell(max_range, is2D))
         {
             // Iterate over the particles in that cell. Using a local counter
             // variable is safe, because the IteratorLinkCell object is keeping
@@ -581,10 +971,12 @@ NeighborBond LinkCellQueryIterator::next()
                     {
                         continue;
                     }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-                    const float r_sq(dot(r_ij, r_ij));
+                    vec3<int> image;
+                    const vec3<float> r_ij(
+                        m_neighbor_query->getBox().wrap<is2D>((*m_linkcell)[j] - m_query_point, image));
+                    const float r_sq(is2D ? r_ij.x * r_ij.x + r_ij.y * r_ij.y : dot(r_ij, r_ij));
                     if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                        m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq));
+                        m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq), image);
                 }
             }
 
@@ -592,7 +984,7 @@ NeighborBond LinkCellQueryIterator::next()
             {
                 ++m_neigh_cell_iter;
 
-                if (m_neigh_cell_iter == IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
+                if (m_neigh_cell_iter == IteratorCellShell(max_range, is2D))
                 {
                     break;
                 }
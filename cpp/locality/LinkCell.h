@@ -76,7 +76,7 @@ public:
 
 private:
     util::ManagedArray<unsigned int> m_cell_list; //!< The cell list
-    unsigned int m_Np;                            //!< Number of particles in the cell list
+    unsigned int m_Np;                            //!< Number of point slots in the cell list
     unsigned int m_Nc;                            //!< Number of cells in the cell list
     unsigned int m_cur_idx;                       //!< Current index
     unsigned int m_cell;                          //!< Cell being considered
@@ -221,10 +221,13 @@ public:
     //! Compute cell coordinates for a given position
     vec3<unsigned int> getCellCoord(const vec3<float> p) const;
 
+    //! Move a position into the image of the box holding its cell (see getCellCoord).
+    vec3<float> wrapToCell(const vec3<float>& p) const;
+
     //! Iterate over particles in a cell
     iteratorcell itercell(unsigned int cell) const
     {
-        return iteratorcell(m_cell_list, m_n_points, getNumCells(), cell);
+        return iteratorcell(m_cell_list, m_list_capacity, getNumCells(), cell);
     }
 
     //! Get a list of neighbors to a cell
@@ -233,6 +236,23 @@ public:
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
 
+    //! Relink the moved points into their new cells (see NeighborQuery::updatePoints).
+    /*! Each moved point is unlinked from its old cell and linked into its
+     *  new cell, which takes time proportional to the number of points in
+     *  the old cell.
+     */
+    virtual void updatePoints(const vec3<float>* points, const unsigned int* indices, unsigned int n_indices);
+
+    //! Link the new points into their cells (see NeighborQuery::insertPoints).
+    /*! The cell list grows geometrically, so inserting a point takes
+     *  amortized constant time.
+     */
+    virtual void insertPoints(const vec3<float>* points, unsigned int n_points);
+
+    //! Unlink the removed points from their cells (see NeighborQuery::removePoints).
+    virtual void removePoints(const vec3<float>* points, unsigned int n_points, const unsigned int* indices,
+                              unsigned int n_indices);
+
     //! Implementation of per-particle query for LinkCell (see NeighborQuery.h for documentation).
     /*! \param query_point The point to find neighbors for.
      *  \param n_query_points The number of query points.
@@ -241,17 +261,79 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
 
+    //! Bound the distances between a point and the points binned in a cell
+    /*! This is used to skip cells lying entirely outside of the shell
+     *  between r_min and r_max of a query point without visiting their
+     *  points. The bounds are computed from the distance to the center of
+     *  the cell and the distance from its center to its farthest corner.
+     *
+     *  \param cell Cell coordinates. Along periodic directions, coordinates
+     *         outside of the grid refer to the cells of other images of the box.
+     *  \param point The point to measure distances from.
+     *  \param min_distance Output lower bound of the distances.
+     *  \param max_distance Output upper bound of the distances.
+     *  \returns false when the points of the cell cannot be bounded, in which
+     *            case the outputs are not set.
+     */
+    bool getCellDistanceBounds(const vec3<int>& cell, const vec3<float>& point, float& min_distance,
+                               float& max_distance) const;
+
+    //! Whether a ball query of radius r_max must search periodic images beyond the nearest one
+    /*! This is the case when r_max is at least half of the distance between
+     *  the planes of the box along any periodic direction, so that a point
+     *  can be within r_max of a query point through more than one image.
+     */
+    bool requiresImageSearch(float r_max) const;
+
+    //! Find all neighbors of a point within a ball, including all periodic images within r_max.
+    /*! The cells overlapped by the query sphere are enumerated without
+     *  wrapping their coordinates, so each cell is visited once for every
+     *  image of the box that the sphere reaches. A point is reported once for
+     *  every image within r_max of the query point, so this supports r_max
+     *  larger than half of the box. The bonds are appended to bonds in no
+     *  particular order.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param r_max The maximum distance of neighbors.
+     *  \param r_min The minimum distance of neighbors.
+     *  \param exclude_ii Whether to exclude neighbors with the same index as the query point.
+     *  \param bonds The vector that found bonds are appended to, with squared distances.
+     */
+    void findImageBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx, float r_max,
+                                float r_min, bool exclude_ii, std::vector<NeighborBond>& bonds) const;
+
 private:
+    template<bool is2D>
+    void findImageBallNeighborsImpl(const vec3<float>& query_point, unsigned int query_point_idx,
+                                    float r_max, float r_min, bool exclude_ii,
+                                    std::vector<NeighborBond>& bonds) const;
+
     //! Helper function to compute cell neighbors
     const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
 
-    unsigned int m_n_points;      //!< Number of particles last placed into the cell list
+    //! Whether a point lies within the grid of cells along the aperiodic directions of the box
+    bool isInsideGrid(const vec3<float>& point) const;
+
+    //! Link a point at the head of the list of a cell
+    void linkPoint(unsigned int i, unsigned int cell);
+
+    //! Unlink a point from the list of its cell
+    void unlinkPoint(unsigned int i);
+
+    //! Grow the cell list to hold at least n_points points
+    void reserveCellList(unsigned int n_points);
+
+    unsigned int m_list_capacity; //!< Number of points the cell list has room for
     unsigned int m_Nc;            //!< Number of cells last used
     float m_cell_width;           //!< Minimum necessary cell width cutoff
     vec3<unsigned int> m_celldim; //!< Cell dimensions
     unsigned int m_size;          //!< The size of cell list.
+    float m_cell_radius;          //!< Distance from the center of a cell to its farthest corner
+    bool m_cells_bound_points;    //!< Whether every point lies within the cell it is binned in
 
     util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
+    std::vector<unsigned int> m_point_cells;      //!< Cell each point is linked into
     typedef tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>> CellNeighbors;
     mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
 };
@@ -269,7 +351,8 @@ public:
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
                                         exclude_ii),
           m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->getBox().is2D()),
-          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
+          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point))),
+          m_cell_query_point(m_linkcell->wrapToCell(m_query_point))
     {}
 
     //! Empty Destructor
@@ -283,6 +366,7 @@ protected:
         m_cell_iter; //!< The cell iterator indicating which cell we're currently searching.
     std::unordered_set<unsigned int>
         m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
+    vec3<float> m_cell_query_point; //!< The query point moved into the image of the box holding its cell.
 };
 
 //! Iterator that gets specified numbers of nearest neighbors from LinkCell tree structures.
@@ -304,6 +388,9 @@ public:
     virtual NeighborBond next();
 
 protected:
+    //! Get the next element, with the dimensionality of the box fixed at compile time.
+    template<bool is2D> NeighborBond nextImpl();
+
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
     std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
@@ -316,7 +403,8 @@ public:
     //! Constructor
     LinkCellQueryBallIterator(const LinkCell* neighbor_query, const vec3<float> query_point,
                               unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
-        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
+        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
+          m_image_search(neighbor_query->requiresImageSearch(r_max)), m_count(0)
     {
         // Upon querying, if the search radius is equal to the cell width, we
         // can guarantee that we don't need to search the cell shell past the
@@ -329,6 +417,14 @@ public:
         {
             m_extra_search_width = 1;
         }
+
+        // The cell shells only find the nearest image of each point, so
+        // larger balls are searched up front and returned one by one.
+        if (m_image_search)
+        {
+            neighbor_query->findImageBallNeighbors(query_point, query_point_idx, r_max, r_min, exclude_ii,
+                                                   m_current_neighbors);
+        }
     }
 
     //! Empty Destructor
@@ -337,8 +433,21 @@ public:
     //! Get the next element.
     virtual NeighborBond next();
 
+    //! Return squared distances from next() (see NeighborQueryPerPointIterator::useSquaredDistances).
+    virtual bool useSquaredDistances()
+    {
+        m_squared_distances = true;
+        return true;
+    }
+
 protected:
+    //! Get the next element, with the dimensionality of the box fixed at compile time.
+    template<bool is2D> NeighborBond nextImpl();
+
     int m_extra_search_width; //!< The extra shell distance to search, always 0 or 1.
+    bool m_image_search;      //!< Whether the ball reaches periodic images beyond the nearest one.
+    unsigned int m_count;     //!< Number of neighbors returned when searching images.
+    std::vector<NeighborBond> m_current_neighbors; //!< Bonds found by image search, with squared distances.
 };
 }; }; // end namespace freud::locality
 
@@ -1,6 +1,8 @@
 #ifndef NEIGHBOR_BOND_H
 #define NEIGHBOR_BOND_H
 
+#include "VectorMath.h"
+
 namespace freud { namespace locality {
 
 //! Simple data structure encoding neighboring points.
@@ -8,14 +10,27 @@ namespace freud { namespace locality {
  *  than a simple std::pair, which is hard to interpret. Additionally, this
  *  class defines the less than operator according to distance, making it
  *  possible to sort.
+ *
+ *  Bonds found by a NeighborQuery also record the periodic image of the
+ *  point they join, so that the bond vector is
+ *  point + image * lattice vectors - query point. When r_max exceeds half
+ *  of the box, this distinguishes the bonds found through different images
+ *  of the same point, even if they have the same length. Bonds read from a
+ *  NeighborList do not record images and hold the zero image.
  */
 struct NeighborBond
 {
     // For now, id = query_point_idx and ref_id = point_idx (into the NeighborQuery).
-    NeighborBond() : query_point_idx(0), point_idx(0), distance(0), weight(0) {}
+    NeighborBond() : query_point_idx(0), point_idx(0), distance(0), weight(0), image(0, 0, 0) {}
 
     NeighborBond(unsigned int query_point_idx, unsigned int point_idx, float d = 0, float w = 1)
-        : query_point_idx(query_point_idx), point_idx(point_idx), distance(d), weight(w)
+        : query_point_idx(query_point_idx), point_idx(point_idx), distance(d), weight(w), image(0, 0, 0)
+    {}
+
+    //! Constructor for a bond found through a periodic image of the point.
+    NeighborBond(unsigned int query_point_idx, unsigned int point_idx, float d, const vec3<int>& image,
+                 float w = 1)
+        : query_point_idx(query_point_idx), point_idx(point_idx), distance(d), weight(w), image(image)
     {}
 
     //! Equality checks both query_point_idx and distance.
@@ -91,6 +106,7 @@ struct NeighborBond
     unsigned int point_idx;       //! The reference point index.
     float distance;               //! The distance between the points.
     float weight;                 //! The weight of this bond.
+    vec3<int> image;              //! The periodic image of the point, in multiples of the lattice vectors.
 };
 
 }; }; // end namespace freud::locality
@@ -46,13 +46,15 @@ class NeighborListPerPointIterator : public NeighborPerPointIterator
 {
 public:
     NeighborListPerPointIterator(const NeighborList* nlist, size_t point_index)
-        : NeighborPerPointIterator(point_index), m_nlist(nlist)
+        : NeighborPerPointIterator(point_index), m_nlist(nlist),
+          m_neighbors(nlist->getNeighbors().view<2>()), m_distances(nlist->getDistances().view<1>()),
+          m_weights(nlist->getWeights().view<1>())
     {
         m_current_index = m_nlist->find_first_index(point_index);
         m_finished = m_current_index == m_nlist->getNumBonds();
         if (!m_finished)
         {
-            m_returned_point_index = m_nlist->getNeighbors()(m_current_index, 0);
+            m_returned_point_index = m_neighbors(m_current_index, 0);
         }
     }
 
@@ -66,9 +68,8 @@ public:
             return ITERATOR_TERMINATOR;
         }
 
-        NeighborBond nb = NeighborBond(
-            m_nlist->getNeighbors()(m_current_index, 0), m_nlist->getNeighbors()(m_current_index, 1),
-            m_nlist->getDistances()[m_current_index], m_nlist->getWeights()[m_current_index]);
+        NeighborBond nb = NeighborBond(m_neighbors(m_current_index, 0), m_neighbors(m_current_index, 1),
+                                       m_distances[m_current_index], m_weights[m_current_index]);
         ++m_current_index;
         m_returned_point_index = nb.query_point_idx;
         return nb;
@@ -81,6 +82,9 @@ public:
 
 private:
     const NeighborList* m_nlist;
+    util::ArrayView<const unsigned int, 2> m_neighbors;
+    util::ArrayView<const float, 1> m_distances;
+    util::ArrayView<const float, 1> m_weights;
     size_t m_current_index;
     size_t m_returned_point_index;
     bool m_finished;
@@ -169,22 +173,30 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
  *  \param qargs Query arguments.
  *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
  * given qargs. \param cf An object with operator(NeighborBond) as input.
+ *  \param parallel Whether to loop in parallel.
+ *  \param squared_distances Whether the distance of the bonds passed to cf holds the squared distance.
+ *         Computes that ignore distances or only compare them to thresholds should set this, so that
+ *         queries skip the square roots.
  */
 template<typename ComputePairType>
 void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
                        unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
-                       const ComputePairType& cf, bool parallel = true)
+                       const ComputePairType& cf, bool parallel = true, bool squared_distances = false)
 {
     // check if nlist exists
     if (nlist != NULL)
     {
+        const util::ArrayView<const unsigned int, 2> neighbors = nlist->getNeighbors().view<2>();
+        const util::ArrayView<const float, 1> distances = nlist->getDistances().view<1>();
+        const util::ArrayView<const float, 1> weights = nlist->getWeights().view<1>();
         util::forLoopWrapper(
             0, nlist->getNumBonds(),
             [=](size_t begin, size_t end) {
                 for (size_t bond = begin; bond != end; ++bond)
                 {
-                    const NeighborBond nb(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
-                                          nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    const float distance = distances[bond];
+                    const NeighborBond nb(neighbors(bond, 0), neighbors(bond, 1),
+                                          squared_distances ? distance * distance : distance, weights[bond]);
                     cf(nb);
                 }
             },
@@ -195,23 +207,15 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
-        // iterate over the query object in parallel
-        util::forLoopWrapper(
-            0, n_query_points,
-            [&iter, &cf](size_t begin, size_t end) {
-                NeighborBond nb;
-                for (size_t i = begin; i != end; ++i)
+        // find the bonds of batches of query points in parallel
+        iter->queryBonds(
+            [&cf](const std::vector<NeighborBond>& bonds) {
+                for (const NeighborBond& nb : bonds)
                 {
-                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
-                    nb = it->next();
-                    while (!it->end())
-                    {
-                        cf(nb);
-                        nb = it->next();
-                    }
+                    cf(nb);
                 }
             },
-            parallel);
+            parallel, squared_distances);
     }
 }
 
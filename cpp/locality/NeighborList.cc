@@ -28,6 +28,7 @@ NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* query_poi
     : m_num_query_points(num_query_points), m_num_points(num_points), m_neighbors({num_bonds, 2}),
       m_distances(num_bonds), m_weights(num_bonds), m_segments_counts_updated(false)
 {
+    const util::ArrayView<unsigned int, 2> neighbors = m_neighbors.view<2>();
     unsigned int last_index(0);
     unsigned int index(0);
     for (unsigned int i = 0; i < num_bonds; i++)
@@ -40,8 +41,8 @@ NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* query_poi
                 "NeighborList query_point_index values must be less than num_query_points.");
         if (point_index[i] >= m_num_points)
             throw std::runtime_error("NeighborList point_index values must be less than num_points.");
-        m_neighbors(i, 0) = index;
-        m_neighbors(i, 1) = point_index[i];
+        neighbors(i, 0) = index;
+        neighbors(i, 1) = point_index[i];
         m_weights[i] = weights[i];
         m_distances[i] = distances[i];
         last_index = index;
@@ -80,9 +81,10 @@ void NeighborList::updateSegmentCounts() const
         int index(-1);
         int last_index(-1);
         unsigned int counter(0);
+        const util::ArrayView<const unsigned int, 2> neighbors = m_neighbors.view<2>();
         for (unsigned int i = 0; i < getNumBonds(); i++)
         {
-            index = m_neighbors(i, 0);
+            index = neighbors(i, 0);
             if (index != last_index)
             {
                 m_segments[index] = i;
@@ -111,13 +113,14 @@ unsigned int NeighborList::filter(const bool* filt)
     // number of good (unfiltered-out) elements so far
     unsigned int num_good(0);
     const unsigned int old_size(getNumBonds());
+    const util::ArrayView<unsigned int, 2> neighbors = m_neighbors.view<2>();
 
     for (unsigned int i(0); i < old_size; ++i)
     {
         if (filt[i])
         {
-            m_neighbors(num_good, 0) = m_neighbors(i, 0);
-            m_neighbors(num_good, 1) = m_neighbors(i, 1);
+            neighbors(num_good, 0) = neighbors(i, 0);
+            neighbors(num_good, 1) = neighbors(i, 1);
             m_weights[num_good] = m_weights[i];
             m_distances[num_good] = m_distances[i];
             ++num_good;
@@ -155,10 +158,12 @@ void NeighborList::resize(unsigned int num_bonds)
     // On shrinking resizes, keep existing data.
     if (num_bonds <= getNumBonds())
     {
+        const util::ArrayView<unsigned int, 2> old_neighbors_view = m_neighbors.view<2>();
+        const util::ArrayView<unsigned int, 2> new_neighbors_view = new_neighbors.view<2>();
         for (unsigned int i = 0; i < num_bonds; i++)
         {
-            new_neighbors(i, 0) = m_neighbors(i, 0);
-            new_neighbors(i, 1) = m_neighbors(i, 1);
+            new_neighbors_view(i, 0) = old_neighbors_view(i, 0);
+            new_neighbors_view(i, 1) = old_neighbors_view(i, 1);
             new_distances[i] = m_distances[i];
             new_weights[i] = m_weights[i];
         }
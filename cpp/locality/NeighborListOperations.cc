@@ -0,0 +1,247 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+#include "NeighborListOperations.h"
+#include "utils.h"
+
+/*! \file NeighborListOperations.cc
+    \brief Set operations on neighbor lists sorted by query point index.
+*/
+
+namespace freud { namespace locality {
+
+void computeBondOffsets(const NeighborList* nlist, std::vector<unsigned int>& offsets)
+{
+    const unsigned int num_bonds = nlist->getNumBonds();
+    const unsigned int num_query_points = nlist->getNumQueryPoints();
+    const unsigned int* neighbors = nlist->getNeighbors().get();
+
+    offsets.assign(num_query_points + 1, 0);
+    unsigned int last_query_point = 0;
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        const unsigned int query_point = neighbors[2 * bond];
+        if (query_point < last_query_point || query_point >= num_query_points)
+        {
+            throw std::invalid_argument("The neighbor list must be sorted by query point index.");
+        }
+        ++offsets[query_point + 1];
+        last_query_point = query_point;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+}
+
+void sortBondsByPoint(const NeighborList* nlist, unsigned int begin, unsigned int end,
+                      std::vector<std::pair<unsigned int, unsigned int>>& bonds)
+{
+    const unsigned int* neighbors = nlist->getNeighbors().get();
+    bonds.clear();
+    bool sorted = true;
+    for (unsigned int bond = begin; bond < end; ++bond)
+    {
+        const unsigned int point = neighbors[2 * bond + 1];
+        sorted = sorted && (bonds.empty() || bonds.back().first <= point);
+        bonds.emplace_back(point, bond);
+    }
+    if (!sorted)
+    {
+        std::sort(bonds.begin(), bonds.end());
+    }
+}
+
+//! Combine the values of a bond present in both operands of a set operation.
+inline float mergeBondValues(float first, float second, BondMerge merge)
+{
+    switch (merge)
+    {
+    case BondMerge::second:
+        return second;
+    case BondMerge::min:
+        return std::min(first, second);
+    case BondMerge::max:
+        return std::max(first, second);
+    case BondMerge::sum:
+        return first + second;
+    case BondMerge::mean:
+        return float(0.5) * (first + second);
+    default:
+        return first;
+    }
+}
+
+//! Combine the bonds of two neighbor lists.
+/*! The bonds of each query point are merge joined over their point indices
+ *  in parallel. A first pass counts the bonds of the result for each query
+ *  point, and the prefix sum of the counts gives the bonds of the result
+ *  that each query point writes in the second pass, so the result is
+ *  sorted by query point index (and by point index within each query
+ *  point) without a global sort.
+ *
+ *  \param a The first neighbor list.
+ *  \param b The second neighbor list.
+ *  \param keep_a_only Whether to keep bonds only present in a.
+ *  \param keep_b_only Whether to keep bonds only present in b.
+ *  \param keep_matched Whether to keep bonds present in both a and b.
+ *  \param distance_merge How the distances of bonds present in both are combined.
+ *  \param weight_merge How the weights of bonds present in both are combined.
+ */
+NeighborList* combineNeighborLists(const NeighborList* a, const NeighborList* b, bool keep_a_only,
+                                   bool keep_b_only, bool keep_matched, BondMerge distance_merge,
+                                   BondMerge weight_merge)
+{
+    if (a->getNumQueryPoints() != b->getNumQueryPoints() || a->getNumPoints() != b->getNumPoints())
+    {
+        throw std::invalid_argument("The neighbor lists must be built on the same query points and points.");
+    }
+    const unsigned int num_query_points = a->getNumQueryPoints();
+
+    std::vector<unsigned int> a_offsets;
+    std::vector<unsigned int> b_offsets;
+    computeBondOffsets(a, a_offsets);
+    computeBondOffsets(b, b_offsets);
+
+    // The counts are shifted by one so that their prefix sums are the offsets of the result.
+    std::vector<unsigned int> offsets(num_query_points + 1, 0);
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        std::vector<std::pair<unsigned int, unsigned int>> a_bonds;
+        std::vector<std::pair<unsigned int, unsigned int>> b_bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortBondsByPoint(a, a_offsets[i], a_offsets[i + 1], a_bonds);
+            sortBondsByPoint(b, b_offsets[i], b_offsets[i + 1], b_bonds);
+            unsigned int count = 0;
+            mergeSortedBonds(
+                a_bonds.size(), [&](size_t k) { return a_bonds[k].first; }, b_bonds.size(),
+                [&](size_t k) { return b_bonds[k].first; }, [&](size_t, size_t) { count += keep_matched; },
+                [&](size_t) { count += keep_a_only; }, [&](size_t) { count += keep_b_only; });
+            offsets[i + 1] = count;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::unique_ptr<NeighborList> result(new NeighborList());
+    result->setNumBonds(offsets[num_query_points], num_query_points, a->getNumPoints());
+    const float* a_distances = a->getDistances().get();
+    const float* a_weights = a->getWeights().get();
+    const float* b_distances = b->getDistances().get();
+    const float* b_weights = b->getWeights().get();
+    unsigned int* result_neighbors = result->getNeighbors().get();
+    float* result_distances = result->getDistances().get();
+    float* result_weights = result->getWeights().get();
+    util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        std::vector<std::pair<unsigned int, unsigned int>> a_bonds;
+        std::vector<std::pair<unsigned int, unsigned int>> b_bonds;
+        for (size_t i = begin; i < end; ++i)
+        {
+            sortBondsByPoint(a, a_offsets[i], a_offsets[i + 1], a_bonds);
+            sortBondsByPoint(b, b_offsets[i], b_offsets[i + 1], b_bonds);
+            unsigned int out = offsets[i];
+            auto write_bond = [&](unsigned int point, float distance, float weight) {
+                result_neighbors[2 * out] = static_cast<unsigned int>(i);
+                result_neighbors[2 * out + 1] = point;
+                result_distances[out] = distance;
+                result_weights[out] = weight;
+                ++out;
+            };
+            mergeSortedBonds(
+                a_bonds.size(), [&](size_t k) { return a_bonds[k].first; }, b_bonds.size(),
+                [&](size_t k) { return b_bonds[k].first; },
+                [&](size_t k_a, size_t k_b) {
+                    if (keep_matched)
+                    {
+                        const unsigned int bond_a = a_bonds[k_a].second;
+                        const unsigned int bond_b = b_bonds[k_b].second;
+                        write_bond(a_bonds[k_a].first,
+                                   mergeBondValues(a_distances[bond_a], b_distances[bond_b], distance_merge),
+                                   mergeBondValues(a_weights[bond_a], b_weights[bond_b], weight_merge));
+                    }
+                },
+                [&](size_t k) {
+                    if (keep_a_only)
+                    {
+                        const unsigned int bond = a_bonds[k].second;
+                        write_bond(a_bonds[k].first, a_distances[bond], a_weights[bond]);
+                    }
+                },
+                [&](size_t k) {
+                    if (keep_b_only)
+                    {
+                        const unsigned int bond = b_bonds[k].second;
+                        write_bond(b_bonds[k].first, b_distances[bond], b_weights[bond]);
+                    }
+                });
+        }
+    });
+    return result.release();
+}
+
+NeighborList* symmetrizeNeighborList(const NeighborList* nlist, BondMerge distance_merge,
+                                     BondMerge weight_merge)
+{
+    if (nlist->getNumQueryPoints() != nlist->getNumPoints())
+    {
+        throw std::invalid_argument(
+            "Only neighbor lists between a set of points and itself can be symmetrized.");
+    }
+
+    // Build the reversed neighbor list with a counting sort over the point
+    // indices. The bonds are sorted by query point index, so the reversed
+    // bonds of each point are sorted by their point index.
+    const unsigned int num_bonds = nlist->getNumBonds();
+    const unsigned int num_points = nlist->getNumPoints();
+    const unsigned int* neighbors = nlist->getNeighbors().get();
+    const float* distances = nlist->getDistances().get();
+    const float* weights = nlist->getWeights().get();
+
+    std::vector<unsigned int> reversed_offsets(num_points + 1, 0);
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        const unsigned int point = neighbors[2 * bond + 1];
+        if (point >= num_points)
+        {
+            throw std::invalid_argument("The neighbor list contains point indices out of range.");
+        }
+        ++reversed_offsets[point + 1];
+    }
+    std::partial_sum(reversed_offsets.begin(), reversed_offsets.end(), reversed_offsets.begin());
+
+    NeighborList reversed;
+    reversed.setNumBonds(num_bonds, num_points, nlist->getNumQueryPoints());
+    unsigned int* reversed_neighbors = reversed.getNeighbors().get();
+    float* reversed_distances = reversed.getDistances().get();
+    float* reversed_weights = reversed.getWeights().get();
+    for (unsigned int bond = 0; bond < num_bonds; ++bond)
+    {
+        const unsigned int reversed_bond = reversed_offsets[neighbors[2 * bond + 1]]++;
+        reversed_neighbors[2 * reversed_bond] = neighbors[2 * bond + 1];
+        reversed_neighbors[2 * reversed_bond + 1] = neighbors[2 * bond];
+        reversed_distances[reversed_bond] = distances[bond];
+        reversed_weights[reversed_bond] = weights[bond];
+    }
+
+    return combineNeighborLists(nlist, &reversed, true, true, true, distance_merge, weight_merge);
+}
+
+NeighborList* neighborListUnion(const NeighborList* a, const NeighborList* b, BondMerge distance_merge,
+                                BondMerge weight_merge)
+{
+    return combineNeighborLists(a, b, true, true, true, distance_merge, weight_merge);
+}
+
+NeighborList* neighborListIntersection(const NeighborList* a, const NeighborList* b,
+                                       BondMerge distance_merge, BondMerge weight_merge)
+{
+    return combineNeighborLists(a, b, false, false, true, distance_merge, weight_merge);
+}
+
+NeighborList* neighborListDifference(const NeighborList* a, const NeighborList* b)
+{
+    return combineNeighborLists(a, b, true, false, false, BondMerge::first, BondMerge::first);
+}
+
+}; }; // end namespace freud::locality
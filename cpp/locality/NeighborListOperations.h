@@ -0,0 +1,112 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef NEIGHBOR_LIST_OPERATIONS_H
+#define NEIGHBOR_LIST_OPERATIONS_H
+
+#include <utility>
+#include <vector>
+
+#include "NeighborList.h"
+
+/*! \file NeighborListOperations.h
+    \brief Set operations on neighbor lists sorted by query point index.
+*/
+
+namespace freud { namespace locality {
+
+//! How the distances or weights of a bond present in both operands of a set operation are combined.
+enum class BondMerge
+{
+    first,  //!< Use the value of the first neighbor list
+    second, //!< Use the value of the second neighbor list
+    min,    //!< Use the smaller value
+    max,    //!< Use the larger value
+    sum,    //!< Use the sum of the values
+    mean    //!< Use the mean of the values
+};
+
+//! Make a neighbor list symmetric by adding the reverse of every bond.
+/*! The neighbor list must be built on a set of points and itself. A bond
+ *  (i, j) whose reverse (j, i) is already present is merged with it.
+ *
+ *  \param nlist The neighbor list to symmetrize.
+ *  \param distance_merge How the distances of a bond and its reverse are combined.
+ *  \param weight_merge How the weights of a bond and its reverse are combined.
+ *
+ *  \return A new neighbor list, which the caller is responsible for deleting.
+ */
+NeighborList* symmetrizeNeighborList(const NeighborList* nlist, BondMerge distance_merge,
+                                     BondMerge weight_merge);
+
+//! Find the bonds present in either of two neighbor lists.
+/*! \return A new neighbor list, which the caller is responsible for deleting.
+ */
+NeighborList* neighborListUnion(const NeighborList* a, const NeighborList* b, BondMerge distance_merge,
+                                BondMerge weight_merge);
+
+//! Find the bonds present in both of two neighbor lists.
+/*! \return A new neighbor list, which the caller is responsible for deleting.
+ */
+NeighborList* neighborListIntersection(const NeighborList* a, const NeighborList* b,
+                                       BondMerge distance_merge, BondMerge weight_merge);
+
+//! Find the bonds of a neighbor list that are not present in another neighbor list.
+/*! \return A new neighbor list, which the caller is responsible for deleting.
+ */
+NeighborList* neighborListDifference(const NeighborList* a, const NeighborList* b);
+
+//! Compute the first bond of each query point of a neighbor list sorted by query point index.
+/*! The offsets have an additional last element holding the number of bonds,
+ *  so the bonds of query point i are offsets[i], ..., offsets[i + 1] - 1.
+ *  Unlike the segments of the NeighborList, this is well defined for query
+ *  points without bonds. Throws std::invalid_argument if the neighbor list
+ *  is not sorted by query point index.
+ */
+void computeBondOffsets(const NeighborList* nlist, std::vector<unsigned int>& offsets);
+
+//! Collect the (point index, bond index) pairs of a range of bonds, sorted by point index.
+void sortBondsByPoint(const NeighborList* nlist, unsigned int begin, unsigned int end,
+                      std::vector<std::pair<unsigned int, unsigned int>>& bonds);
+
+//! Merge join two sequences of point indices sorted in ascending order.
+/*! Equal point indices are matched one to one, every other element is
+ *  passed to old_only or new_only. The callbacks are called in order of
+ *  increasing point index.
+ */
+template<typename OldPoint, typename NewPoint, typename Matched, typename OldOnly, typename NewOnly>
+void mergeSortedBonds(size_t num_old, const OldPoint& old_point, size_t num_new, const NewPoint& new_point,
+                      const Matched& matched, const OldOnly& old_only, const NewOnly& new_only)
+{
+    size_t k_old = 0;
+    size_t k_new = 0;
+    while (k_old < num_old && k_new < num_new)
+    {
+        const unsigned int p_old = old_point(k_old);
+        const unsigned int p_new = new_point(k_new);
+        if (p_old < p_new)
+        {
+            old_only(k_old++);
+        }
+        else if (p_new < p_old)
+        {
+            new_only(k_new++);
+        }
+        else
+        {
+            matched(k_old++, k_new++);
+        }
+    }
+    for (; k_old < num_old; ++k_old)
+    {
+        old_only(k_old);
+    }
+    for (; k_new < num_new; ++k_new)
+    {
+        new_only(k_new);
+    }
+}
+
+}; }; // end namespace freud::locality
+
+#endif // NEIGHBOR_LIST_OPERATIONS_H
@@ -14,4 +14,37 @@ const float QueryArgs::DEFAULT_R_MIN(0);
 const float QueryArgs::DEFAULT_R_GUESS(-1.0);
 const float QueryArgs::DEFAULT_SCALE(-1.0);
 const bool QueryArgs::DEFAULT_EXCLUDE_II(false);
+
+void NeighborQuery::queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                               const BondBatchFunction& cf, bool parallel, bool squared_distances) const
+{
+    util::forLoopWrapper(
+        0, n_query_points,
+        [&](size_t begin, size_t end) {
+            std::vector<NeighborBond> bonds;
+            for (size_t i = begin; i != end; ++i)
+            {
+                std::shared_ptr<NeighborQueryPerPointIterator> it
+                    = this->querySingle(query_points[i], i, args);
+                // Iterators that cannot skip the square roots have their distances squared.
+                const bool square_distances = squared_distances && !it->useSquaredDistances();
+                bonds.clear();
+                while (!it->end())
+                {
+                    NeighborBond nb = it->next();
+                    if (nb != NeighborQueryIterator::ITERATOR_TERMINATOR)
+                    {
+                        if (square_distances)
+                        {
+                            nb.distance *= nb.distance;
+                        }
+                        bonds.push_back(nb);
+                    }
+                }
+                cf(bonds);
+            }
+        },
+        parallel);
+}
+
 }; }; // end namespace freud::locality
@@ -4,8 +4,12 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
 
@@ -69,6 +73,22 @@ struct QueryArgs
 class NeighborQueryIterator;
 class NeighborQueryPerPointIterator;
 
+//! Function receiving all bonds found for a batch of query points.
+typedef std::function<void(const std::vector<NeighborBond>&)> BondBatchFunction;
+
+//! Replace the squared distances of bonds by distances.
+/*! Ball queries find bonds from squared distances. Taking the square roots
+ *  of a batch of bonds in a separate loop keeps the long latency square root
+ *  out of the search loops and lets the compiler vectorize it.
+ */
+inline void sqrtBondDistances(std::vector<NeighborBond>& bonds)
+{
+    for (NeighborBond& bond : bonds)
+    {
+        bond.distance = std::sqrt(bond.distance);
+    }
+}
+
 //! Parent data structure for all neighbor finding algorithms.
 /*! This class defines the API for all data structures for accelerating
  *  neighbor finding. The object encapsulates a set of points and a system box
@@ -145,6 +165,79 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const = 0;
 
+    //! Find the neighbors of all query points in bulk.
+    /*! This function is the interface used by bulk consumers of a query
+     *  (NeighborList construction and loopOverNeighbors) that do not need
+     *  the bonds of any query point in a particular order. The query points
+     *  are divided into batches, and cf is called once per batch with all
+     *  bonds found for the query points of that batch. Every bond of a
+     *  given query point is passed to cf in the same call, but batches may
+     *  be processed concurrently when parallel is true. The default
+     *  implementation treats each query point as a batch and uses
+     *  querySingle; subclasses may override it to share work between nearby
+     *  query points.
+     *
+     *  Consumers that only compare distances to thresholds or ignore them
+     *  can request squared distances, which are stored in the distance of the
+     *  bonds. Ball queries then skip the square roots entirely.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param n_query_points The number of query points.
+     *  \param qargs The query arguments that should be used to find neighbors.
+     *  \param cf The function to call with the bonds of each batch.
+     *  \param parallel Whether batches may be processed in parallel.
+     *  \param squared_distances Whether the bonds hold squared distances instead of distances.
+     */
+    virtual void queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs args,
+                            const BondBatchFunction& cf, bool parallel = true,
+                            bool squared_distances = false) const;
+
+    //! Update the data structure after some of the points moved.
+    /*! The coordinates of the moved points must already have been changed
+     *  in the array of points, which may also have been reallocated. Only the
+     *  parts of the data structure holding the moved points are updated, so
+     *  subclasses supporting incremental updates do so in time proportional
+     *  to the number of moved points (up to logarithmic factors). The default
+     *  implementation throws, since not every NeighborQuery supports
+     *  incremental updates.
+     *
+     *  \param points The point coordinates, with the moved points at their new positions.
+     *  \param indices The indices of the moved points.
+     *  \param n_indices The number of moved points.
+     */
+    virtual void updatePoints(const vec3<float>* /* points */, const unsigned int* /* indices */,
+                              unsigned int /* n_indices */)
+    {
+        throw std::runtime_error("This NeighborQuery does not support incremental point updates.");
+    }
+
+    //! Update the data structure after points were appended to the array of points.
+    /*! \param points The point coordinates, with the new points at the end.
+     *  \param n_points The number of points, including the new points.
+     */
+    virtual void insertPoints(const vec3<float>* /* points */, unsigned int /* n_points */)
+    {
+        throw std::runtime_error("This NeighborQuery does not support incremental point updates.");
+    }
+
+    //! Update the data structure after points were removed from the array of points.
+    /*! Points are removed by visiting the removed indices in decreasing
+     *  order and moving the last point into the slot of each removed point,
+     *  which keeps the array contiguous and only changes the indices of
+     *  points moved from the end. The array of points must already have been
+     *  rearranged accordingly.
+     *
+     *  \param points The point coordinates after the removal.
+     *  \param n_points The number of points after the removal.
+     *  \param indices The indices of the removed points before the removal, which must be distinct.
+     *  \param n_indices The number of removed points.
+     */
+    virtual void removePoints(const vec3<float>* /* points */, unsigned int /* n_points */,
+                              const unsigned int* /* indices */, unsigned int /* n_indices */)
+    {
+        throw std::runtime_error("This NeighborQuery does not support incremental point updates.");
+    }
+
     //! Get the simulation box
     const box::Box& getBox() const
     {
@@ -176,6 +269,68 @@ public:
     }
 
 protected:
+    //! Check the indices of points to update and the points they refer to.
+    /*! \param points The point coordinates after the update.
+     *  \param n_points The number of points before the update.
+     *  \param indices The indices of the points to check.
+     *  \param n_indices The number of indices.
+     *  \param check_points Whether the points at the indices must lie in the plane of a 2D box.
+     */
+    void validatePointIndices(const vec3<float>* points, unsigned int n_points, const unsigned int* indices,
+                              unsigned int n_indices, bool check_points) const
+    {
+        for (unsigned int i = 0; i < n_indices; ++i)
+        {
+            if (indices[i] >= n_points)
+            {
+                throw std::invalid_argument("Point indices must be less than the number of points.");
+            }
+            if (check_points && m_box.is2D() && std::abs(points[indices[i]].z) > 1e-6)
+            {
+                throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+            }
+        }
+    }
+
+    //! Check the arguments of insertPoints.
+    void validateInsertedPoints(const vec3<float>* points, unsigned int n_points) const
+    {
+        if (n_points < m_n_points)
+        {
+            throw std::invalid_argument("Inserting points cannot reduce the number of points.");
+        }
+        for (unsigned int i = m_n_points; i < n_points; ++i)
+        {
+            if (m_box.is2D() && std::abs(points[i].z) > 1e-6)
+            {
+                throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+            }
+        }
+    }
+
+    //! Check the arguments of removePoints and sort the removed indices in decreasing order.
+    std::vector<unsigned int> sortRemovedPointIndices(unsigned int n_points, const unsigned int* indices,
+                                                      unsigned int n_indices) const
+    {
+        std::vector<unsigned int> removed(indices, indices + n_indices);
+        std::sort(removed.begin(), removed.end(), std::greater<unsigned int>());
+        validatePointIndices(m_points, m_n_points, removed.data(), n_indices, false);
+        if (std::adjacent_find(removed.begin(), removed.end()) != removed.end())
+        {
+            throw std::invalid_argument("The indices of the points to remove must be distinct.");
+        }
+        if (n_points + n_indices != m_n_points)
+        {
+            throw std::invalid_argument(
+                "The number of points must decrease by the number of removed points.");
+        }
+        if (n_points == 0)
+        {
+            throw std::invalid_argument("Cannot remove all points of a NeighborQuery.");
+        }
+        return removed;
+    }
+
     //! Validate the combination of specified arguments.
     /*! Before checking if the combination of parameters currently set is
      *  valid, this function first attempts to infer a mode if one is not set in
@@ -252,14 +407,14 @@ class NeighborQueryPerPointIterator : public NeighborPerPointIterator
 {
 public:
     //! Nullary constructor for Cython
-    NeighborQueryPerPointIterator() {}
+    NeighborQueryPerPointIterator() : m_squared_distances(false) {}
 
     //! Constructor
     NeighborQueryPerPointIterator(const NeighborQuery* neighbor_query, const vec3<float> query_point,
                                   unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
         : NeighborPerPointIterator(query_point_idx), m_neighbor_query(neighbor_query),
           m_query_point(query_point), m_finished(false), m_r_max(r_max), m_r_min(r_min),
-          m_exclude_ii(exclude_ii)
+          m_exclude_ii(exclude_ii), m_squared_distances(false)
     {}
 
     //! Empty Destructor
@@ -274,6 +429,17 @@ public:
     //! Get the next element.
     virtual NeighborBond next() = 0;
 
+    //! Make the bonds returned by next() hold squared distances.
+    /*! Iterators finding bonds from squared distances override this to skip
+     *  the square roots. It must be called before the first call to next().
+     *
+     *  \return Whether the iterator returns squared distances.
+     */
+    virtual bool useSquaredDistances()
+    {
+        return false;
+    }
+
     static const NeighborBond ITERATOR_TERMINATOR; //!< The object returned when iteration is complete.
 
 protected:
@@ -283,6 +449,7 @@ protected:
     float m_r_max;   //!< Cutoff distance for neighbors.
     float m_r_min;   //!< Minimum distance for neighbors.
     bool m_exclude_ii; //!< Flag to indicate whether or not to include self bonds.
+    bool m_squared_distances; //!< Whether bonds hold squared distances (see useSquaredDistances).
 };
 
 //! The iterator class for neighbor queries on NeighborQuery objects.
@@ -307,7 +474,8 @@ public:
     NeighborQueryIterator(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
                           unsigned int num_query_points, QueryArgs qargs)
         : m_neighbor_query(neighbor_query), m_query_points(query_points),
-          m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0)
+          m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0),
+          m_chunk_position(0), m_chunk_query_point(0), m_chunk_num_bonds_found(0)
     {
         m_iter = this->query(m_cur_p);
     }
@@ -327,6 +495,13 @@ public:
         return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
     }
 
+    //! Find the neighbors of all query points in bulk (see NeighborQuery::queryBonds).
+    void queryBonds(const BondBatchFunction& cf, bool parallel = true, bool squared_distances = false) const
+    {
+        m_neighbor_query->queryBonds(m_query_points, m_num_query_points, m_qargs, cf, parallel,
+                                     squared_distances);
+    }
+
     //! Get the next element.
     NeighborBond next()
     {
@@ -353,9 +528,60 @@ public:
         return ITERATOR_TERMINATOR;
     }
 
+    //! Copy the next bonds into arrays, finding the neighbors of batches of query points in parallel.
+    /*! Successive calls return all bonds of the query in order of query
+     *  point index, and the bonds of each query point are sorted by point
+     *  index as in toNeighborList. The neighbors of batches of query points
+     *  are found in parallel and buffered, where the size of the batches is
+     *  chosen from the mean number of bonds found so far so that each batch
+     *  roughly fills one chunk. This state is independent of next(), so the
+     *  two methods should not be mixed.
+     *
+     *  \param chunk_size The maximum number of bonds to copy.
+     *  \param query_point_indices Array of size chunk_size receiving the query point indices.
+     *  \param point_indices Array of size chunk_size receiving the point indices.
+     *  \param distances Array of size chunk_size receiving the distances.
+     *
+     *  \return The number of bonds copied, which is smaller than chunk_size
+     *          only once all bonds have been returned.
+     */
+    unsigned int nextChunk(unsigned int chunk_size, unsigned int* query_point_indices,
+                           unsigned int* point_indices, float* distances)
+    {
+        unsigned int num_copied = 0;
+        while (num_copied < chunk_size)
+        {
+            if (m_chunk_position == m_chunk_bonds.size())
+            {
+                if (m_chunk_query_point == m_num_query_points)
+                {
+                    break;
+                }
+                fillChunkBuffer(chunk_size - num_copied);
+                continue;
+            }
+
+            const size_t num_bonds
+                = std::min(size_t(chunk_size - num_copied), m_chunk_bonds.size() - m_chunk_position);
+            util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k)
+                {
+                    const NeighborBond& nb = m_chunk_bonds[m_chunk_position + k];
+                    query_point_indices[num_copied + k] = nb.query_point_idx;
+                    point_indices[num_copied + k] = nb.point_idx;
+                    distances[num_copied + k] = nb.distance;
+                }
+            });
+            m_chunk_position += num_bonds;
+            num_copied += num_bonds;
+        }
+        return num_copied;
+    }
+
     //! Generate a NeighborList from query.
     /*! This function exploits parallelism by finding the neighbors for
-     *  each query point in parallel and adding them to a list, which is
+     *  batches of query points in parallel (see queryBonds) and adding them
+     *  to a list, which is
      *  then sorted in parallel as well before being added to the
      *  NeighborList object. Right now this won't be backwards compatible
      *  because the kn query is not symmetric, so even if we reverse the
@@ -370,22 +596,9 @@ public:
     {
         typedef tbb::enumerable_thread_specific<std::vector<NeighborBond>> BondVector;
         BondVector bonds;
-        util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        this->queryBonds([&bonds](const std::vector<NeighborBond>& batch_bonds) {
             BondVector::reference local_bonds(bonds.local());
-            NeighborBond nb;
-            for (size_t i = begin; i < end; ++i)
-            {
-                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(i);
-                while (!it->end())
-                {
-                    nb = it->next();
-                    // If we're excluding ii bonds, we have to check before adding.
-                    if (nb != ITERATOR_TERMINATOR)
-                    {
-                        local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
-                    }
-                }
-            }
+            local_bonds.insert(local_bonds.end(), batch_bonds.begin(), batch_bonds.end());
         });
 
         tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
@@ -399,14 +612,17 @@ public:
 
         NeighborList* nl = new NeighborList();
         nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
+        const util::ArrayView<unsigned int, 2> neighbors = nl->getNeighbors().view<2>();
+        const util::ArrayView<float, 1> distances = nl->getDistances().view<1>();
+        const util::ArrayView<float, 1> weights = nl->getWeights().view<1>();
 
         util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
             for (size_t bond = begin; bond < end; ++bond)
             {
-                nl->getNeighbors()(bond, 0) = linear_bonds[bond].query_point_idx;
-                nl->getNeighbors()(bond, 1) = linear_bonds[bond].point_idx;
-                nl->getDistances()[bond] = linear_bonds[bond].distance;
-                nl->getWeights()[bond] = float(1.0);
+                neighbors(bond, 0) = linear_bonds[bond].query_point_idx;
+                neighbors(bond, 1) = linear_bonds[bond].point_idx;
+                distances[bond] = linear_bonds[bond].distance;
+                weights[bond] = float(1.0);
             }
         });
 
@@ -416,6 +632,69 @@ public:
     static const NeighborBond ITERATOR_TERMINATOR; //!< The object returned when iteration is complete.
 
 protected:
+    //! Find the bonds of the next batch of query points for nextChunk.
+    /*! \param num_bonds The number of bonds the batch should roughly contain.
+     */
+    void fillChunkBuffer(unsigned int num_bonds)
+    {
+        // Start with a small batch to estimate the number of bonds per query point.
+        const unsigned int remaining = m_num_query_points - m_chunk_query_point;
+        unsigned int batch_size = std::max(1u, num_bonds / 64);
+        if (m_chunk_query_point != 0)
+        {
+            const double bonds_per_point
+                = std::max(double(m_chunk_num_bonds_found) / m_chunk_query_point, 1e-3);
+            batch_size = static_cast<unsigned int>(std::min(std::ceil(num_bonds / bonds_per_point), 1e9));
+        }
+        batch_size = std::max(1u, std::min(batch_size, remaining));
+        const unsigned int first = m_chunk_query_point;
+
+        // Query points are processed in blocks so that the bonds of each block
+        // are collected in a single vector, which are then concatenated in order.
+        const unsigned int block_size = 256;
+        const unsigned int num_blocks = (batch_size + block_size - 1) / block_size;
+        std::vector<std::vector<NeighborBond>> block_bonds(num_blocks);
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                std::vector<NeighborBond>& bonds = block_bonds[block];
+                const unsigned int block_end = std::min(unsigned(block + 1) * block_size, batch_size);
+                for (unsigned int k = block * block_size; k < block_end; ++k)
+                {
+                    const size_t point_begin = bonds.size();
+                    std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(first + k);
+                    while (!it->end())
+                    {
+                        NeighborBond nb = it->next();
+                        if (nb != ITERATOR_TERMINATOR)
+                        {
+                            bonds.push_back(nb);
+                        }
+                    }
+                    std::sort(bonds.begin() + point_begin, bonds.end(), compareNeighborBond);
+                }
+            }
+        });
+
+        std::vector<size_t> offsets(num_blocks + 1, 0);
+        for (unsigned int block = 0; block < num_blocks; ++block)
+        {
+            offsets[block + 1] = offsets[block] + block_bonds[block].size();
+        }
+        m_chunk_bonds.resize(offsets[num_blocks]);
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                std::copy(block_bonds[block].begin(), block_bonds[block].end(),
+                          m_chunk_bonds.begin() + offsets[block]);
+            }
+        });
+
+        m_chunk_position = 0;
+        m_chunk_query_point += batch_size;
+        m_chunk_num_bonds_found += offsets[num_blocks];
+    }
+
     const NeighborQuery* m_neighbor_query;                 //!< Link to the NeighborQuery object.
     const vec3<float>* m_query_points;                     //!< Coordinates of the query points.
     unsigned int m_num_query_points;                       //!< The number of query points.
@@ -424,6 +703,11 @@ protected:
 
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next on termination).
     unsigned int m_cur_p; //!< The current particle under consideration.
+
+    std::vector<NeighborBond> m_chunk_bonds; //!< Buffered bonds of the current batch of nextChunk.
+    size_t m_chunk_position;                 //!< Next buffered bond to return from nextChunk.
+    unsigned int m_chunk_query_point;        //!< First query point not yet searched by nextChunk.
+    size_t m_chunk_num_bonds_found;          //!< Number of bonds found so far by nextChunk.
 };
 
 }; }; // end namespace freud::locality
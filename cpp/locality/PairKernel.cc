@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_sort.h>
+#include <vector>
+
+#include "NeighborComputeFunctional.h"
+#include "PairKernel.h"
+#include "ThreadStorage.h"
+
+/*! \file PairKernel.cc
+    \brief Apply compiled predicates and kernels to bonds while they are found.
+*/
+
+namespace freud { namespace locality {
+
+PairKernel::PairKernel(FreudBondPredicate predicate, FreudBondKernel kernel, unsigned int num_outputs,
+                       bool store_bonds)
+    : m_predicate(predicate), m_kernel(kernel), m_num_outputs(kernel != NULL ? num_outputs : 0),
+      m_store_bonds(store_bonds), m_num_accepted(0), m_neighbor_list(std::make_shared<NeighborList>())
+{}
+
+void PairKernel::compute(const NeighborQuery* nq, const quat<float>* orientations,
+                         const vec3<float>* query_points, const quat<float>* query_orientations,
+                         unsigned int n_query_points, const NeighborList* nlist, QueryArgs qargs,
+                         void* user_data)
+{
+    const box::Box& box = nq->getBox();
+
+    FreudPairSystem system;
+    system.points = reinterpret_cast<const float*>(nq->getPoints());
+    system.query_points = reinterpret_cast<const float*>(query_points);
+    system.orientations = reinterpret_cast<const float*>(orientations);
+    system.query_orientations = reinterpret_cast<const float*>(query_orientations);
+    system.n_points = nq->getNPoints();
+    system.n_query_points = n_query_points;
+    for (unsigned int col = 0; col < 3; ++col)
+    {
+        const vec3<float> lattice_vector = box.getLatticeVector(col);
+        system.box_matrix[col] = lattice_vector.x;
+        system.box_matrix[3 + col] = lattice_vector.y;
+        system.box_matrix[6 + col] = lattice_vector.z;
+    }
+    system.user_data = user_data;
+
+    const vec3<float> latt_a(box.getLatticeVector(0));
+    const vec3<float> latt_b(box.getLatticeVector(1));
+    const vec3<float> latt_c(box.getLatticeVector(2));
+
+    util::ThreadStorage<double> local_outputs({n_query_points, m_num_outputs});
+    tbb::enumerable_thread_specific<unsigned int> local_num_accepted(0);
+    typedef tbb::enumerable_thread_specific<std::vector<NeighborBond>> BondVector;
+    BondVector local_bonds;
+
+    loopOverNeighbors(
+        nq, query_points, n_query_points, qargs, nlist,
+        [&](const NeighborBond& nb) {
+            // Queries report the image of the point that each bond was found
+            // through, which distinguishes the bonds to several images of a
+            // point when r_max exceeds half of the box. NeighborLists do not
+            // record images, so their bonds use the minimum image.
+            const vec3<float> delta = (nlist != NULL)
+                ? bondVector(nb, nq, query_points)
+                : (*nq)[nb.point_idx] - query_points[nb.query_point_idx] + float(nb.image.x) * latt_a
+                    + float(nb.image.y) * latt_b + float(nb.image.z) * latt_c;
+            const FreudBond bond = {nb.query_point_idx, nb.point_idx, nb.distance, nb.weight,
+                                    {delta.x, delta.y, delta.z}};
+            if (m_predicate != NULL && !m_predicate(&system, &bond))
+            {
+                return;
+            }
+            ++local_num_accepted.local();
+            if (m_num_outputs != 0)
+            {
+                m_kernel(&system, &bond, local_outputs.local().get() + nb.query_point_idx * m_num_outputs);
+            }
+            if (m_store_bonds)
+            {
+                local_bonds.local().push_back(nb);
+            }
+        });
+
+    m_num_accepted = local_num_accepted.combine([](unsigned int a, unsigned int b) { return a + b; });
+
+    m_output.prepare({n_query_points, m_num_outputs});
+    local_outputs.reduceInto(m_output);
+
+    if (m_store_bonds)
+    {
+        tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(local_bonds);
+        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
+        tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
+
+        const unsigned int num_bonds = linear_bonds.size();
+        m_neighbor_list->setNumBonds(num_bonds, n_query_points, nq->getNPoints());
+        const util::ArrayView<unsigned int, 2> neighbors = m_neighbor_list->getNeighbors().view<2>();
+        const util::ArrayView<float, 1> distances = m_neighbor_list->getDistances().view<1>();
+        const util::ArrayView<float, 1> weights = m_neighbor_list->getWeights().view<1>();
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                neighbors(bond, 0) = linear_bonds[bond].query_point_idx;
+                neighbors(bond, 1) = linear_bonds[bond].point_idx;
+                distances[bond] = linear_bonds[bond].distance;
+                weights[bond] = linear_bonds[bond].weight;
+            }
+        });
+    }
+    else
+    {
+        m_neighbor_list->setNumBonds(0, n_query_points, nq->getNPoints());
+    }
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,135 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef PAIR_KERNEL_H
+#define PAIR_KERNEL_H
+
+#include <memory>
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file PairKernel.h
+    \brief Apply compiled predicates and kernels to bonds while they are found.
+*/
+
+extern "C" {
+
+//! Data of a single bond passed to compiled predicates and kernels.
+/*! This struct and FreudPairSystem are part of a C ABI, so their layout
+ *  must not change.
+ */
+struct FreudBond
+{
+    unsigned int query_point_idx; //!< Index of the query point
+    unsigned int point_idx;       //!< Index of the point
+    float distance;               //!< Distance between the points
+    float weight;                 //!< Weight of the bond
+    float delta[3];               //!< Vector from the query point to the image of the point of the bond
+};
+
+//! Data of the system passed to compiled predicates and kernels.
+/*! Positions are stored as (N, 3) arrays and orientations as (N, 4)
+ *  arrays of quaternions in (w, x, y, z) order. The orientation pointers
+ *  are NULL if no orientations were provided.
+ */
+struct FreudPairSystem
+{
+    const float* points;             //!< Positions of the points
+    const float* query_points;       //!< Positions of the query points
+    const float* orientations;       //!< Orientations of the points, or NULL
+    const float* query_orientations; //!< Orientations of the query points, or NULL
+    unsigned int n_points;           //!< Number of points
+    unsigned int n_query_points;     //!< Number of query points
+    float box_matrix[9];             //!< Box matrix (lattice vectors as columns), in row-major order
+    void* user_data;                 //!< Pointer passed through from the caller
+};
+
+//! Predicate deciding whether a bond is accepted, returning nonzero to accept it.
+typedef int (*FreudBondPredicate)(const FreudPairSystem* system, const FreudBond* bond);
+
+//! Kernel that adds the contribution of a bond to the outputs of its query point.
+typedef void (*FreudBondKernel)(const FreudPairSystem* system, const FreudBond* bond, double* output);
+}
+
+namespace freud { namespace locality {
+
+//! Apply compiled predicates and kernels to bonds during neighbor finding.
+/*! Custom pair criteria (e.g. orientation dependent patches or angle
+ *  cutoffs of hydrogen bonds) and custom per-point reductions can be
+ *  applied while the bonds are found, without first building a complete
+ *  NeighborList. The predicate and kernel are C function pointers, so they
+ *  can be compiled code from any source, for example functions of a shared
+ *  library or just-in-time compiled functions. They are called concurrently
+ *  from multiple threads, so they must be thread safe.
+ *
+ *  For every bond found by the NeighborQuery (or stored in a provided
+ *  NeighborList), the predicate is called first if one is given. Accepted
+ *  bonds are passed to the kernel, which adds to the num_outputs values of
+ *  the query point of the bond. Each thread adds to its own copy of the
+ *  outputs, so kernels do not need atomic operations. If requested, the
+ *  accepted bonds are also stored in a NeighborList.
+ */
+class PairKernel
+{
+public:
+    //! Constructor
+    /*! \param predicate Predicate deciding whether bonds are accepted, or NULL to accept all bonds.
+     *  \param kernel Kernel applied to accepted bonds, or NULL.
+     *  \param num_outputs Number of values computed per query point by the kernel.
+     *  \param store_bonds Whether to store the accepted bonds in a NeighborList.
+     */
+    PairKernel(FreudBondPredicate predicate, FreudBondKernel kernel, unsigned int num_outputs,
+               bool store_bonds);
+
+    //! Apply the predicate and kernel to the bonds between the query points and the points
+    void compute(const NeighborQuery* nq, const quat<float>* orientations, const vec3<float>* query_points,
+                 const quat<float>* query_orientations, unsigned int n_query_points,
+                 const NeighborList* nlist, QueryArgs qargs, void* user_data);
+
+    //! Get the outputs of the kernel, an array of shape (n_query_points, num_outputs)
+    const util::ManagedArray<double>& getOutput() const
+    {
+        return m_output;
+    }
+
+    //! Get the number of bonds accepted by the predicate
+    unsigned int getNumAcceptedBonds() const
+    {
+        return m_num_accepted;
+    }
+
+    //! Get the accepted bonds (only filled if store_bonds is true)
+    std::shared_ptr<NeighborList> getNeighborList() const
+    {
+        return m_neighbor_list;
+    }
+
+    //! Get the number of values computed per query point
+    unsigned int getNumOutputs() const
+    {
+        return m_num_outputs;
+    }
+
+    //! Get whether the accepted bonds are stored
+    bool getStoreBonds() const
+    {
+        return m_store_bonds;
+    }
+
+private:
+    FreudBondPredicate m_predicate; //!< Predicate deciding whether bonds are accepted
+    FreudBondKernel m_kernel;       //!< Kernel applied to accepted bonds
+    unsigned int m_num_outputs;     //!< Number of values computed per query point
+    bool m_store_bonds;             //!< Whether the accepted bonds are stored
+
+    unsigned int m_num_accepted;                   //!< Number of accepted bonds
+    util::ManagedArray<double> m_output;           //!< Outputs of the kernel per query point
+    std::shared_ptr<NeighborList> m_neighbor_list; //!< Accepted bonds
+};
+
+}; }; // end namespace freud::locality
+
+#endif // PAIR_KERNEL_H
@@ -69,6 +69,20 @@ public:
         return aq->querySingle(query_point, query_point_idx, qargs);
     }
 
+    // forward bulk queries so that they use the batched AABBQuery traversal
+    virtual void queryBonds(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs qargs,
+                            const BondBatchFunction& cf, bool parallel = true,
+                            bool squared_distances = false) const
+    {
+        if (!aq)
+        {
+            throw std::runtime_error("The underlying AABBQuery object has not yet been initialized. Please "
+                                     "report this error.");
+        }
+
+        aq->queryBonds(query_points, n_query_points, qargs, cf, parallel, squared_distances);
+    }
+
 private:
     mutable std::unique_ptr<AABBQuery> aq; //!< The AABBQuery object that will be used to perform queries.
 };
@@ -169,14 +169,17 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
 
     m_neighbor_list->resize(num_bonds);
     m_neighbor_list->setNumBonds(num_bonds, n_points, n_points);
+    const util::ArrayView<unsigned int, 2> neighbors = m_neighbor_list->getNeighbors().view<2>();
+    const util::ArrayView<float, 1> distances = m_neighbor_list->getDistances().view<1>();
+    const util::ArrayView<float, 1> weights = m_neighbor_list->getWeights().view<1>();
 
-    util::forLoopWrapper(0, num_bonds, [=](size_t begin, size_t end) {
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
         for (size_t bond = begin; bond != end; ++bond)
         {
-            m_neighbor_list->getNeighbors()(bond, 0) = bonds[bond].query_point_idx;
-            m_neighbor_list->getNeighbors()(bond, 1) = bonds[bond].point_idx;
-            m_neighbor_list->getDistances()[bond] = bonds[bond].distance;
-            m_neighbor_list->getWeights()[bond] = bonds[bond].weight;
+            neighbors(bond, 0) = bonds[bond].query_point_idx;
+            neighbors(bond, 1) = bonds[bond].point_idx;
+            distances[bond] = bonds[bond].distance;
+            weights[bond] = bonds[bond].weight;
         }
     });
 }
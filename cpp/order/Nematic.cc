@@ -50,34 +50,35 @@ void Nematic::compute(quat<float>* orientations, unsigned int n)
     m_n = n;
     m_particle_tensor.prepare({m_n, 3, 3});
     m_nematic_tensor_local.reset();
+    const util::ArrayView<float, 3> particle_tensor = m_particle_tensor.view<3>();
 
     // calculate per-particle tensor
     util::forLoopWrapper(0, n, [=](size_t begin, size_t end) {
+        const util::ArrayView<float, 2> nematic_tensor = m_nematic_tensor_local.local().view<2>();
         for (size_t i = begin; i < end; ++i)
         {
             // get the director of the particle
             quat<float> q = orientations[i];
             vec3<float> u_i = rotate(q, m_u);
 
-            util::ManagedArray<float> Q_ab({3, 3});
-
-            Q_ab(0, 0) = 1.5f * u_i.x * u_i.x - 0.5f;
-            Q_ab(0, 1) = 1.5f * u_i.x * u_i.y;
-            Q_ab(0, 2) = 1.5f * u_i.x * u_i.z;
-            Q_ab(1, 0) = 1.5f * u_i.y * u_i.x;
-            Q_ab(1, 1) = 1.5f * u_i.y * u_i.y - 0.5f;
-            Q_ab(1, 2) = 1.5f * u_i.y * u_i.z;
-            Q_ab(2, 0) = 1.5f * u_i.z * u_i.x;
-            Q_ab(2, 1) = 1.5f * u_i.z * u_i.y;
-            Q_ab(2, 2) = 1.5f * u_i.z * u_i.z - 0.5f;
+            float Q_ab[3][3];
+            Q_ab[0][0] = 1.5f * u_i.x * u_i.x - 0.5f;
+            Q_ab[0][1] = 1.5f * u_i.x * u_i.y;
+            Q_ab[0][2] = 1.5f * u_i.x * u_i.z;
+            Q_ab[1][0] = 1.5f * u_i.y * u_i.x;
+            Q_ab[1][1] = 1.5f * u_i.y * u_i.y - 0.5f;
+            Q_ab[1][2] = 1.5f * u_i.y * u_i.z;
+            Q_ab[2][0] = 1.5f * u_i.z * u_i.x;
+            Q_ab[2][1] = 1.5f * u_i.z * u_i.y;
+            Q_ab[2][2] = 1.5f * u_i.z * u_i.z - 0.5f;
 
             // Set the values. The nematic tensor is reduced later.
             for (unsigned int j = 0; j < 3; j++)
             {
                 for (unsigned int k = 0; k < 3; k++)
                 {
-                    m_particle_tensor(i, j, k) += Q_ab(j, k);
-                    m_nematic_tensor_local.local()(j, k) += Q_ab(j, k);
+                    particle_tensor(i, j, k) += Q_ab[j][k];
+                    nematic_tensor(j, k) += Q_ab[j][k];
                 }
             }
         }
@@ -92,11 +93,11 @@ void Nematic::compute(quat<float>* orientations, unsigned int n)
         m_nematic_tensor[i] /= m_n;
 
     // the order parameter is the eigenvector belonging to the largest eigenvalue
-    util::ManagedArray<float> eval = util::ManagedArray<float>(3);
-    util::ManagedArray<float> evec = util::ManagedArray<float>({3, 3});
+    float eval[3];
+    float evec[9];
 
-    freud::util::diagonalize33SymmetricMatrix(m_nematic_tensor, eval, evec);
-    m_nematic_director = vec3<float>(evec(2, 0), evec(2, 1), evec(2, 2));
+    freud::util::diagonalize33SymmetricMatrix(m_nematic_tensor.get(), eval, evec);
+    m_nematic_director = vec3<float>(evec[6], evec[7], evec[8]);
     m_nematic_order_parameter = eval[2];
 }
 
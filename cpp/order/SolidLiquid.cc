@@ -29,13 +29,15 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Compute Steinhardt using neighbor list (also gets ql for normalization)
     m_steinhardt.compute(&m_nlist, points, qargs);
-    const auto& qlm = m_steinhardt.getQlm();
-    const auto& ql = m_steinhardt.getQl();
+    const util::ArrayView<const std::complex<float>, 2> qlm = m_steinhardt.getQlm().view<2>();
+    const util::ArrayView<const float, 1> ql = m_steinhardt.getQl().view<1>();
 
     // Compute (normalized) dot products for each bond in the neighbor list
     const float normalizationfactor = float(4 * M_PI / m_num_ms);
     const unsigned int num_bonds(m_nlist.getNumBonds());
     m_ql_ij.prepare(num_bonds);
+    const util::ArrayView<unsigned int, 2> neighbors = m_nlist.getNeighbors().view<2>();
+    const util::ArrayView<float, 1> ql_ij = m_ql_ij.view<1>();
 
     util::forLoopWrapper(
         0, num_query_points,
@@ -43,9 +45,9 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
             for (unsigned int i = begin; i != end; ++i)
             {
                 unsigned int bond(m_nlist.find_first_index(i));
-                for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+                for (; bond < num_bonds && neighbors(bond, 0) == i; ++bond)
                 {
-                    const unsigned int j(m_nlist.getNeighbors()(bond, 1));
+                    const unsigned int j(neighbors(bond, 1));
 
                     // Accumulate the dot product over m of qlmi and qlmj vectors
                     std::complex<float> bond_ql_ij = 0;
@@ -60,7 +62,7 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
                     {
                         bond_ql_ij *= normalizationfactor / (ql[i] * ql[j]);
                     }
-                    m_ql_ij[bond] = bond_ql_ij.real();
+                    ql_ij[bond] = bond_ql_ij.real();
                 }
             }
         },
@@ -86,10 +88,11 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
     // (particles with more than solid_threshold solid-like bonds)
     const unsigned int num_solid_bonds(solid_nlist.getNumBonds());
     std::unique_ptr<bool[]> neighbor_count_filter(new bool[num_solid_bonds]);
+    const util::ArrayView<unsigned int, 2> solid_neighbors = solid_nlist.getNeighbors().view<2>();
     for (unsigned int bond(0); bond < num_solid_bonds; bond++)
     {
-        const unsigned int i(solid_nlist.getNeighbors()(bond, 0));
-        const unsigned int j(solid_nlist.getNeighbors()(bond, 1));
+        const unsigned int i(solid_neighbors(bond, 0));
+        const unsigned int j(solid_neighbors(bond, 1));
         neighbor_count_filter[bond] = (m_number_of_connections[i] >= m_solid_threshold
                                        && m_number_of_connections[j] >= m_solid_threshold);
     }
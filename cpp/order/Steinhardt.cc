@@ -92,11 +92,14 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
     // For consistency, this reset is done here regardless of whether the array
     // is populated in baseCompute or computeAve.
     m_qlm_local.reset();
+    const util::ArrayView<std::complex<float>, 2> qlmi = m_qlmi.view<2>();
+    const util::ArrayView<float, 1> qli = m_qli.view<1>();
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
         [=](size_t i, std::shared_ptr<freud::locality::NeighborPerPointIterator> ppiter) {
             float total_weight(0);
             const vec3<float> ref((*points)[i]);
+            std::vector<std::complex<float>> Ylm(m_num_ms);
             for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
             {
                 const vec3<float> delta = points->getBox().wrap((*points)[nb.point_idx] - ref);
@@ -120,12 +123,11 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
                     theta = 0;
                 }
 
-                std::vector<std::complex<float>> Ylm(m_num_ms);
                 computeYlm(theta, phi, Ylm); // Fill up Ylm
 
                 for (unsigned int k = 0; k < m_num_ms; ++k)
                 {
-                    m_qlmi({static_cast<unsigned int>(i), k}) += weight * Ylm[k];
+                    qlmi(i, k) += weight * Ylm[k];
                 }
                 total_weight += weight;
             } // End loop going over neighbor bonds
@@ -133,19 +135,17 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
             // Normalize!
             for (unsigned int k = 0; k < m_num_ms; ++k)
             {
-                // Cache the index for efficiency.
-                const unsigned int index = m_qlmi.getIndex({static_cast<unsigned int>(i), k});
-                m_qlmi[index] /= total_weight;
+                qlmi(i, k) /= total_weight;
                 // Add the norm, which is the (complex) squared magnitude
-                m_qli[i] += norm(m_qlmi[index]);
+                qli[i] += norm(qlmi(i, k));
                 // This array gets populated by computeAve in the averaging case.
                 if (!m_average)
                 {
-                    m_qlm_local.local()[k] += m_qlmi[index] / float(m_Np);
+                    m_qlm_local.local()[k] += qlmi(i, k) / float(m_Np);
                 }
             }
-            m_qli[i] *= normalizationfactor;
-            m_qli[i] = std::sqrt(m_qli[i]);
+            qli[i] *= normalizationfactor;
+            qli[i] = std::sqrt(qli[i]);
         });
 }
 
@@ -159,6 +159,9 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
     }
 
     const float normalizationfactor = 4 * M_PI / m_num_ms;
+    const util::ArrayView<std::complex<float>, 2> qlmi = m_qlmi.view<2>();
+    const util::ArrayView<std::complex<float>, 2> qlmiAve = m_qlmiAve.view<2>();
+    const util::ArrayView<float, 1> qliAve = m_qliAve.view<1>();
 
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
@@ -184,10 +187,8 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
                 {
                     for (unsigned int k = 0; k < m_num_ms; ++k)
                     {
-                        // Adding all the qlm of the neighbors. We use the
-                        // vector function signature for indexing into the
-                        // arrays for speed.
-                        m_qlmiAve({static_cast<unsigned int>(i), k}) += m_qlmi({nb2.point_idx, k});
+                        // Adding all the qlm of the neighbors.
+                        qlmiAve(i, k) += qlmi(nb2.point_idx, k);
                     }
                     neighborcount++;
                 } // End loop over particle neighbor's bonds
@@ -196,17 +197,15 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
             // Normalize!
             for (unsigned int k = 0; k < m_num_ms; ++k)
             {
-                // Cache the index for efficiency.
-                const unsigned int index = m_qlmiAve.getIndex({static_cast<unsigned int>(i), k});
                 // Adding the qlm of the particle i itself
-                m_qlmiAve[index] += m_qlmi[index];
-                m_qlmiAve[index] /= neighborcount;
-                m_qlm_local.local()[k] += m_qlmiAve[index] / float(m_Np);
+                qlmiAve(i, k) += qlmi(i, k);
+                qlmiAve(i, k) /= neighborcount;
+                m_qlm_local.local()[k] += qlmiAve(i, k) / float(m_Np);
                 // Add the norm, which is the complex squared magnitude
-                m_qliAve[i] += norm(m_qlmiAve[index]);
+                qliAve[i] += norm(qlmiAve(i, k));
             }
-            m_qliAve[i] *= normalizationfactor;
-            m_qliAve[i] = std::sqrt(m_qliAve[i]);
+            qliAve[i] *= normalizationfactor;
+            qliAve[i] = std::sqrt(qliAve[i]);
         });
 }
 
@@ -247,10 +246,11 @@ void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
 {
     auto wigner3jvalues = getWigner3j(m_l);
     const float normalizationfactor = float(4 * M_PI / m_num_ms);
+    const util::ArrayView<std::complex<float>, 2> source_view = source.view<2>();
     util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
         {
-            target[i] = reduceWigner3j(&(source({static_cast<unsigned int>(i), 0})), m_l, wigner3jvalues);
+            target[i] = reduceWigner3j(&source_view(i, 0), m_l, wigner3jvalues);
             if (m_wl_normalize)
             {
                 const float normalization = std::sqrt(normalizationfactor) / normalization_source[i];
@@ -2,6 +2,9 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include "PMFTXYZ.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 /*! \file PMFTXYZ.cc
@@ -10,9 +13,128 @@
 
 namespace freud { namespace pmft {
 
+namespace {
+
+//! Number of signed permutations of the three axes, which are the symmetries of a cube.
+const unsigned int NUM_SIGNED_PERMUTATIONS = 48;
+
+//! Largest deviation of an equivalent orientation's rotation matrix from a signed permutation.
+const float SIGNED_PERMUTATION_TOLERANCE = 1e-4;
+
+//! The permutations of three axes, in the order of permutationIndex.
+const unsigned int PERMUTATIONS[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+//! A signed permutation g of the axes, which maps v to (g v)_i = (-1)^negate_i v_{perm_i}.
+struct SignedPermutation
+{
+    unsigned int perm[3];
+    bool negate[3];
+};
+
+//! Index of a permutation of three axes in PERMUTATIONS.
+inline unsigned int permutationIndex(const unsigned int (&perm)[3])
+{
+    return 2 * perm[0] + (perm[1] > perm[2] ? 1 : 0);
+}
+
+//! Index of a signed permutation, from 0 to NUM_SIGNED_PERMUTATIONS - 1.
+inline unsigned int signedPermutationIndex(const SignedPermutation& g)
+{
+    return 8 * permutationIndex(g.perm) + (g.negate[0] ? 1 : 0) + (g.negate[1] ? 2 : 0)
+        + (g.negate[2] ? 4 : 0);
+}
+
+//! The signed permutation with the given index.
+inline SignedPermutation signedPermutation(unsigned int index)
+{
+    const unsigned int* perm = PERMUTATIONS[index / 8];
+    SignedPermutation g = {{perm[0], perm[1], perm[2]},
+                           {(index & 1) != 0, (index & 2) != 0, (index & 4) != 0}};
+    return g;
+}
+
+//! The signed permutation a b, which applies b and then a.
+SignedPermutation compose(const SignedPermutation& a, const SignedPermutation& b)
+{
+    SignedPermutation g;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        g.perm[i] = b.perm[a.perm[i]];
+        g.negate[i] = a.negate[i] != b.negate[a.perm[i]];
+    }
+    return g;
+}
+
+//! The inverse of a signed permutation.
+SignedPermutation inverse(const SignedPermutation& g)
+{
+    SignedPermutation g_inverse;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        g_inverse.perm[g.perm[i]] = i;
+        g_inverse.negate[g.perm[i]] = g.negate[i];
+    }
+    return g_inverse;
+}
+
+//! The component of a vector along an axis.
+inline float component(const vec3<float>& v, unsigned int axis)
+{
+    return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+//! Find the signed permutation of the axes that a quaternion rotates by.
+/*! \param q The quaternion.
+ *  \param g Set to the signed permutation.
+ *  \return Whether the rotation is a signed permutation.
+ */
+bool rotationToSignedPermutation(const quat<float>& q, SignedPermutation& g)
+{
+    const float norm = std::sqrt(norm2(q));
+    if (!(norm > 0))
+    {
+        return false;
+    }
+    const quat<float> unit_q(q.s / norm, q.v / norm);
+    const vec3<float> columns[3] = {rotate(unit_q, vec3<float>(1, 0, 0)),
+                                    rotate(unit_q, vec3<float>(0, 1, 0)),
+                                    rotate(unit_q, vec3<float>(0, 0, 1))};
+    bool used[3] = {false, false, false};
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const float row[3] = {component(columns[0], i), component(columns[1], i), component(columns[2], i)};
+        unsigned int nonzero = 0;
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            if (std::abs(row[j]) > std::abs(row[nonzero]))
+            {
+                nonzero = j;
+            }
+        }
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            const float expected = (j == nonzero) ? 1 : 0;
+            if (!(std::abs(std::abs(row[j]) - expected) <= SIGNED_PERMUTATION_TOLERANCE))
+            {
+                return false;
+            }
+        }
+        if (used[nonzero])
+        {
+            return false;
+        }
+        used[nonzero] = true;
+        g.perm[i] = nonzero;
+        g.negate[i] = row[nonzero] < 0;
+    }
+    return true;
+}
+
+}; // end anonymous namespace
+
 PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
                  vec3<float> shiftvec)
-    : PMFT(), m_shiftvec(shiftvec)
+    : PMFT(), m_shiftvec(shiftvec), m_folded(false)
 {
     if (n_x < 1)
         throw std::invalid_argument("PMFTXYZ requires at least 1 bin in X.");
@@ -61,18 +183,177 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
 }
 
+void PMFTXYZ::reset()
+{
+    PMFT::reset();
+    m_folded = false;
+    m_symmetry_group.clear();
+    m_fold_table.clear();
+}
+
 void PMFTXYZ::reduce()
 {
     float jacobian_factor = (float) 1.0 / m_jacobian;
     PMFT::reduce([jacobian_factor](size_t i) { return jacobian_factor; });
+    if (!m_folded)
+    {
+        return;
+    }
+
+    // Unfold the histogram: the count of bin b is the sum over the group
+    // elements g of the folded count of the bin g^-1 b, which is a bin
+    // because the axes are symmetric under the group.
+    const std::vector<size_t> sizes = m_histogram.getAxisSizes();
+    const std::vector<unsigned int> folded_counts(&m_histogram[0], &m_histogram[0] + m_histogram.size());
+    const std::vector<float> folded_pcf(&m_pcf_array[0], &m_pcf_array[0] + m_pcf_array.size());
+    util::forLoopWrapper(0, m_histogram.size(), [&](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const size_t bin[3] = {idx / (sizes[1] * sizes[2]), (idx / sizes[2]) % sizes[1], idx % sizes[2]};
+            unsigned int count = 0;
+            float pcf = 0;
+            for (const unsigned int element : m_symmetry_group)
+            {
+                const SignedPermutation g = signedPermutation(element);
+                size_t source[3];
+                for (unsigned int i = 0; i < 3; ++i)
+                {
+                    source[g.perm[i]] = g.negate[i] ? sizes[i] - 1 - bin[i] : bin[i];
+                }
+                const size_t source_idx = (source[0] * sizes[1] + source[1]) * sizes[2] + source[2];
+                count += folded_counts[source_idx];
+                pcf += folded_pcf[source_idx];
+            }
+            m_histogram[idx] = count;
+            m_pcf_array[idx] = pcf;
+        }
+    });
+}
+
+void PMFTXYZ::setSymmetryGroup(const quat<float>* equiv_orientations, unsigned int num_equiv_orientations)
+{
+    std::vector<bool> in_group(NUM_SIGNED_PERMUTATIONS, false);
+    std::vector<unsigned int> group;
+    for (unsigned int k = 0; k < num_equiv_orientations; ++k)
+    {
+        SignedPermutation g;
+        if (!rotationToSignedPermutation(equiv_orientations[k], g))
+        {
+            throw std::invalid_argument("Folding PMFTXYZ by symmetry requires equivalent orientations that "
+                                        "map the coordinate axes onto each other.");
+        }
+        const unsigned int element = signedPermutationIndex(g);
+        if (in_group[element])
+        {
+            throw std::invalid_argument(
+                "Folding PMFTXYZ by symmetry requires distinct equivalent orientations.");
+        }
+        in_group[element] = true;
+        group.push_back(element);
+    }
+    for (const unsigned int a : group)
+    {
+        for (const unsigned int b : group)
+        {
+            if (!in_group[signedPermutationIndex(compose(signedPermutation(a), signedPermutation(b)))])
+            {
+                throw std::invalid_argument(
+                    "Folding PMFTXYZ by symmetry requires equivalent orientations that form a group.");
+            }
+        }
+    }
+
+    // Bins map onto bins under the group only if it permutes axes of the same size.
+    const std::vector<size_t> sizes = m_histogram.getAxisSizes();
+    const std::vector<std::pair<float, float>> bounds = m_histogram.getBounds();
+    for (const unsigned int element : group)
+    {
+        const SignedPermutation g = signedPermutation(element);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            if (sizes[g.perm[i]] != sizes[i] || bounds[g.perm[i]] != bounds[i])
+            {
+                throw std::invalid_argument("Folding PMFTXYZ by symmetry requires the same maximum distance "
+                                            "and number of bins along axes that the group permutes.");
+            }
+        }
+    }
+
+    const bool same_group = m_folded && group.size() == m_symmetry_group.size()
+        && std::is_permutation(group.begin(), group.end(), m_symmetry_group.begin());
+    if (m_frame_counter != 0 && !same_group)
+    {
+        throw std::invalid_argument(
+            "PMFTXYZ cannot accumulate bonds folded by a different symmetry group without a reset.");
+    }
+
+    // A bond v is mapped onto the fundamental domain x >= y >= z >= 0 of all
+    // signed permutations by the permutation h that sorts the magnitudes of
+    // its coordinates and makes them positive. It is folded by the element g
+    // of the group for which g h^-1 is first in the coset of h^-1, so that
+    // all folded bonds lie in the same |G| images of that domain.
+    m_fold_table.assign(NUM_SIGNED_PERMUTATIONS, 0);
+    for (unsigned int h = 0; h < NUM_SIGNED_PERMUTATIONS; ++h)
+    {
+        const SignedPermutation h_inverse = inverse(signedPermutation(h));
+        unsigned int first = NUM_SIGNED_PERMUTATIONS;
+        for (const unsigned int element : group)
+        {
+            const unsigned int coset_element
+                = signedPermutationIndex(compose(signedPermutation(element), h_inverse));
+            if (coset_element < first)
+            {
+                first = coset_element;
+                m_fold_table[h] = element;
+            }
+        }
+    }
+    m_symmetry_group = group;
+    m_folded = true;
 }
 
 void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, quat<float>* query_orientations,
                          vec3<float>* query_points, unsigned int n_query_points,
                          quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
-                         const locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+                         const locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                         bool fold_symmetry)
 {
     neighbor_query->getBox().enforce3D();
+    if (fold_symmetry)
+    {
+        setSymmetryGroup(equiv_orientations, num_equiv_orientations);
+        const unsigned int* fold_table = m_fold_table.data();
+        accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
+                          [=](const freud::locality::NeighborBond& neighbor_bond) {
+                              quat<float> ref_q(query_orientations[neighbor_bond.query_point_idx]);
+                              vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                              const vec3<float> v = rotate(conj(ref_q), delta);
+                              const float coords[3] = {v.x, v.y, v.z};
+
+                              // Sort the axes by decreasing magnitude of the coordinates.
+                              unsigned int perm[3] = {0, 1, 2};
+                              if (std::abs(coords[perm[0]]) < std::abs(coords[perm[1]]))
+                                  std::swap(perm[0], perm[1]);
+                              if (std::abs(coords[perm[1]]) < std::abs(coords[perm[2]]))
+                                  std::swap(perm[1], perm[2]);
+                              if (std::abs(coords[perm[0]]) < std::abs(coords[perm[1]]))
+                                  std::swap(perm[0], perm[1]);
+                              const unsigned int h = 8 * permutationIndex(perm)
+                                  + (coords[perm[0]] < 0 ? 1 : 0) + (coords[perm[1]] < 0 ? 2 : 0)
+                                  + (coords[perm[2]] < 0 ? 4 : 0);
+
+                              const SignedPermutation g = signedPermutation(fold_table[h]);
+                              m_local_histograms(g.negate[0] ? -coords[g.perm[0]] : coords[g.perm[0]],
+                                                 g.negate[1] ? -coords[g.perm[1]] : coords[g.perm[1]],
+                                                 g.negate[2] ? -coords[g.perm[2]] : coords[g.perm[2]]);
+                          });
+        return;
+    }
+    if (m_frame_counter != 0 && m_folded)
+    {
+        throw std::invalid_argument(
+            "PMFTXYZ cannot accumulate unfolded bonds after folded bonds without a reset.");
+    }
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [=](const freud::locality::NeighborBond& neighbor_bond) {
                           // create the reference point quaternion
@@ -4,6 +4,8 @@
 #ifndef PMFTXYZ_H
 #define PMFTXYZ_H
 
+#include <vector>
+
 #include "PMFT.h"
 
 /*! \file PMFTXYZ.h
@@ -19,21 +21,40 @@ public:
     PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
             vec3<float> shiftvec);
 
+    //! Reset the PCF array to all zeros
+    virtual void reset();
+
     /*! Compute the PCF for the passed in set of points. The function will be added to previous values
         of the pcf
+
+        If fold_symmetry is true, the equivalent orientations must be a point
+        group of rotations that map the coordinate axes onto each other, and
+        the bins must be symmetric under the group. Each bond is then folded
+        into a fundamental domain of the group by reflections and a sort of
+        its coordinates and binned once, and the histogram is unfolded by the
+        group when it is reduced. The result is the same as binning the bond
+        once for every equivalent orientation, up to bonds that lie on bin
+        edges.
     */
     void accumulate(const locality::NeighborQuery* neighbor_query, quat<float>* query_orientations,
                     vec3<float>* query_points, unsigned int n_query_points, quat<float>* equiv_orientations,
                     unsigned int num_equiv_orientations, const locality::NeighborList* nlist,
-                    freud::locality::QueryArgs qargs);
+                    freud::locality::QueryArgs qargs, bool fold_symmetry = false);
 
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     virtual void reduce();
 
+    //! Set the symmetry group that bonds are folded by, checking that it can be used for folding.
+    void setSymmetryGroup(const quat<float>* equiv_orientations, unsigned int num_equiv_orientations);
+
     float m_jacobian;
     vec3<float> m_shiftvec; //!< vector that points from [0,0,0] to the origin of the pmft
+
+    bool m_folded;                              //!< Whether the accumulated bonds are folded.
+    std::vector<unsigned int> m_symmetry_group; //!< Signed permutations of the axes that bonds are folded by.
+    std::vector<unsigned int> m_fold_table;     //!< Group element folding bonds sorted by each permutation.
 };
 
 }; }; // end namespace freud::pmft
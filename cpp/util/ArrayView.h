@@ -0,0 +1,106 @@
+#ifndef ARRAY_VIEW_H
+#define ARRAY_VIEW_H
+
+#include <cstddef>
+
+/*! \file ArrayView.h
+    \brief Defines a lightweight view for indexing into arrays in inner loops.
+*/
+
+namespace freud { namespace util {
+
+//! Non-owning view of a row-major array with a rank fixed at compile time.
+/*! The multidimensional indexing of ManagedArray is flexible but slow, since
+ *  the shape and data are stored behind shared pointers and the indices are
+ *  collected in a std::vector. An ArrayView caches the raw data pointer and
+ *  the strides of the array, so indexing with a fixed number of indices
+ *  compiles down to a few multiply-adds that the compiler can hoist out of
+ *  and vectorize within loops.
+ *
+ *  Views are obtained from ManagedArray::view and are intended to be created
+ *  right before a loop. A view does not keep the data alive and no bounds
+ *  checks are performed, so a view is invalidated when the array it was
+ *  created from is prepared with a new shape or otherwise reallocated.
+ */
+template<typename T, unsigned int Rank> class ArrayView
+{
+    static_assert(Rank > 0, "ArrayView requires a rank of at least one.");
+
+public:
+    //! Default constructor, creating an empty view.
+    ArrayView() : m_data(nullptr), m_size(0)
+    {
+        for (unsigned int dim = 0; dim < Rank; ++dim)
+        {
+            m_shape[dim] = 0;
+            m_strides[dim] = 0;
+        }
+    }
+
+    //! Constructor from a data pointer and shape.
+    /*! \param data Pointer to the first element of the row-major array.
+     *  \param shape Array of Rank sizes of the dimensions.
+     */
+    ArrayView(T* data, const size_t* shape) : m_data(data), m_size(1)
+    {
+        for (unsigned int dim = Rank; dim-- > 0;)
+        {
+            m_shape[dim] = shape[dim];
+            m_strides[dim] = m_size;
+            m_size *= shape[dim];
+        }
+    }
+
+    //! Index into the view with exactly Rank indices.
+    template<typename... Ints> inline T& operator()(Ints... indices) const
+    {
+        static_assert(sizeof...(Ints) == Rank, "The number of indices must match the rank of the view.");
+        const size_t index[Rank] = {static_cast<size_t>(indices)...};
+        size_t offset = index[Rank - 1];
+        for (unsigned int dim = 0; dim + 1 < Rank; ++dim)
+        {
+            offset += index[dim] * m_strides[dim];
+        }
+        return m_data[offset];
+    }
+
+    //! Index into the flattened view.
+    inline T& operator[](size_t index) const
+    {
+        return m_data[index];
+    }
+
+    //! Get the underlying data pointer.
+    T* data() const
+    {
+        return m_data;
+    }
+
+    //! Get the number of elements of the view.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //! Get the size of a dimension.
+    size_t shape(unsigned int dim) const
+    {
+        return m_shape[dim];
+    }
+
+    //! Get the number of elements between successive indices of a dimension.
+    size_t stride(unsigned int dim) const
+    {
+        return m_strides[dim];
+    }
+
+private:
+    T* m_data;              //!< Pointer to the first element.
+    size_t m_size;          //!< Number of elements.
+    size_t m_shape[Rank];   //!< Size of each dimension.
+    size_t m_strides[Rank]; //!< Stride of each dimension in elements.
+};
+
+}; }; // end namespace freud::util
+
+#endif
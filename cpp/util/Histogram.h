@@ -1,12 +1,17 @@
 #ifndef HISTOGRAM_H
 #define HISTOGRAM_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 #include <sstream>
+#include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <utility>
 
@@ -15,6 +20,25 @@
 
 namespace freud { namespace util {
 
+//! Reinterpret the bits of a float as an unsigned integer.
+/*! Non-negative floats are ordered like their bit patterns, which are a
+ * piecewise linear approximation of their base 2 logarithm.
+ */
+inline uint32_t floatToBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//! Reinterpret the bits of an unsigned integer as a float.
+inline float bitsToFloat(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
 //! Weight to add to a histogram.
 /*! For histograms that are not simple counts, a Weight instance may be passed
  * in to indicate what value should be added to a bin. If not provided,
@@ -168,6 +192,284 @@ protected:
     float m_inverse_bin_width; //!< Inverse of bin width
 };
 
+//! An axis with arbitrary bin edges.
+/*! Values are binned in constant time with a lookup table of the bins of a
+ * fine uniform grid over the axis. The grid is finer than the narrowest bin
+ * (up to a maximum table size), so at most one edge comparison is needed to
+ * correct the bin found in the table.
+ */
+class IrregularAxis : public Axis
+{
+public:
+    //! Constructor
+    /*! \param bin_edges The strictly increasing edges of the bins.
+     */
+    IrregularAxis(const std::vector<float>& bin_edges) : Axis()
+    {
+        m_nbins = checkBinEdges(bin_edges);
+        m_min = bin_edges.front();
+        m_max = bin_edges.back();
+        m_bin_edges = bin_edges;
+        float min_bin_width = m_max - m_min;
+        for (size_t i = 0; i < m_nbins; ++i)
+        {
+            min_bin_width = std::min(min_bin_width, m_bin_edges[i + 1] - m_bin_edges[i]);
+        }
+        const float num_cells = std::ceil((m_max - m_min) / min_bin_width);
+        const size_t table_size
+            = std::max(m_nbins, static_cast<size_t>(std::min(num_cells, float(MAX_LOOKUP_SIZE))));
+        m_inverse_cell_width = float(table_size) / (m_max - m_min);
+        m_lookup.resize(table_size);
+        size_t guess = 0;
+        for (size_t cell = 0; cell < table_size; ++cell)
+        {
+            guess = m_lookup[cell] = findBin(m_min + float(cell) / m_inverse_cell_width, guess);
+        }
+    }
+
+    virtual ~IrregularAxis() {}
+
+    //! Find the bin of a value along this axis.
+    /*! \param value The value to bin
+     *
+     * \return The index of the bin the value falls into.
+     */
+    virtual size_t bin(const float& value) const
+    {
+        if (!(value >= m_min && value < m_max))
+        {
+            return OVERFLOW_BIN;
+        }
+        const size_t cell
+            = std::min(static_cast<size_t>((value - m_min) * m_inverse_cell_width), m_lookup.size() - 1);
+        return findBin(value, m_lookup[cell]);
+    }
+
+    static const size_t MAX_LOOKUP_SIZE = 1 << 16; //!< Maximum number of cells of the lookup table.
+
+private:
+    //! Check that bin edges are strictly increasing and return the number of bins.
+    static size_t checkBinEdges(const std::vector<float>& bin_edges)
+    {
+        if (bin_edges.size() < 2)
+        {
+            throw std::invalid_argument("An axis requires at least two bin edges.");
+        }
+        for (size_t i = 0; i + 1 < bin_edges.size(); ++i)
+        {
+            if (!(bin_edges[i] < bin_edges[i + 1]) || !std::isfinite(bin_edges[i + 1] - bin_edges[i]))
+            {
+                throw std::invalid_argument(
+                    "The bin edges of an axis must be finite and strictly increasing.");
+            }
+        }
+        return bin_edges.size() - 1;
+    }
+
+    //! Find the bin of an in-range value by walking from a guess.
+    size_t findBin(float value, size_t guess) const
+    {
+        size_t bin = std::min(guess, m_nbins - 1);
+        while (bin > 0 && value < m_bin_edges[bin])
+        {
+            --bin;
+        }
+        while (bin + 1 < m_nbins && value >= m_bin_edges[bin + 1])
+        {
+            ++bin;
+        }
+        return bin;
+    }
+
+    std::vector<size_t> m_lookup; //!< Bin of the start of each cell of the uniform grid.
+    float m_inverse_cell_width;   //!< Inverse width of the cells of the uniform grid.
+};
+
+//! A logarithmically spaced axis.
+/*! The bins are uniform in the logarithm of values between min > 0 and max.
+ * The bit pattern of a positive float is a piecewise linear approximation of
+ * its base 2 logarithm, so a lookup table indexed by the high bits of values
+ * gives the bin of a value in constant time without evaluating a logarithm.
+ * The table has several cells per bin, so at most one edge comparison is
+ * needed to correct the bin found in the table.
+ */
+class LogAxis : public Axis
+{
+public:
+    //! Constructor
+    /*! \param nbins The number of bins.
+     *  \param min The lower edge of the first bin, which must be positive.
+     *  \param max The upper edge of the last bin.
+     */
+    LogAxis(size_t nbins, float min, float max) : Axis(nbins, min, max)
+    {
+        if (nbins == 0)
+        {
+            throw std::invalid_argument("A logarithmic axis requires a nonzero number of bins.");
+        }
+        if (!(min > 0) || !(min < max) || !std::isfinite(max))
+        {
+            throw std::invalid_argument("A logarithmic axis requires 0 < min < max.");
+        }
+        m_bin_edges.resize(m_nbins + 1);
+        const double log_ratio = std::log2(double(max) / double(min));
+        for (size_t i = 0; i < m_nbins; ++i)
+        {
+            // Computing each edge directly is more numerically stable than
+            // multiplying by the bin ratio repeatedly
+            m_bin_edges[i] = static_cast<float>(min * std::exp2(log_ratio * double(i) / double(m_nbins)));
+        }
+        m_bin_edges[m_nbins] = max;
+
+        m_min_bits = floatToBits(min);
+        const uint32_t range_bits = floatToBits(max) - m_min_bits;
+        m_shift = 0;
+        while ((range_bits >> m_shift) >= 8 * m_nbins)
+        {
+            ++m_shift;
+        }
+        m_lookup.resize((range_bits >> m_shift) + 1);
+        for (size_t cell = 0; cell < m_lookup.size(); ++cell)
+        {
+            // The first value of each cell is the smallest value in it.
+            const float value = bitsToFloat(m_min_bits + (static_cast<uint32_t>(cell) << m_shift));
+            m_lookup[cell] = std::upper_bound(m_bin_edges.begin(), m_bin_edges.end() - 1, value)
+                - m_bin_edges.begin() - 1;
+        }
+    }
+
+    virtual ~LogAxis() {}
+
+    //! Find the bin of a value along this axis.
+    /*! \param value The value to bin
+     *
+     * \return The index of the bin the value falls into.
+     */
+    virtual size_t bin(const float& value) const
+    {
+        if (!(value >= m_min && value < m_max))
+        {
+            return OVERFLOW_BIN;
+        }
+        size_t bin = m_lookup[(floatToBits(value) - m_min_bits) >> m_shift];
+        while (bin + 1 < m_nbins && value >= m_bin_edges[bin + 1])
+        {
+            ++bin;
+        }
+        return bin;
+    }
+
+private:
+    std::vector<size_t> m_lookup; //!< Bin of the smallest value of each cell of the lookup table.
+    uint32_t m_min_bits;          //!< Bit pattern of the lower edge of the axis.
+    unsigned int m_shift;         //!< Number of low bits of values ignored by the lookup table.
+};
+
+//! Bins values along an axis given their squares.
+/*! Distance histograms can be accumulated from squared distances without
+ * computing any square roots. The squared distance thresholds at which the
+ * bin of sqrt(r_sq) changes are found once by bisection over the floating
+ * point numbers, so bin(r_sq) is exactly axis.bin(std::sqrt(r_sq)) for any
+ * axis. Since std::sqrt(d * d) == d for floats in the normal range, squared
+ * distances computed from distances are binned exactly like the distances.
+ *
+ * Bins are found with a table of initial guesses over uniform intervals of
+ * squared distances, corrected by comparisons with the thresholds.
+ */
+class SquaredDistanceBinner
+{
+public:
+    SquaredDistanceBinner() : m_nbins(0), m_inverse_interval_width(0) {}
+
+    //! Constructor
+    /*! \param axis The axis along which the square roots of values are binned.
+     */
+    SquaredDistanceBinner(const Axis& axis) : m_nbins(axis.size()), m_thresholds(axis.size() + 2, 0)
+    {
+        // The rank of a squared distance is 0 below the axis, nbins + 1 above
+        // it and 1 + the bin of its square root in between. The threshold of a
+        // rank is the smallest squared distance of at least that rank.
+        const auto rank = [&axis](float r_sq) -> size_t {
+            const float r = std::sqrt(r_sq);
+            if (r < axis.getMin())
+            {
+                return 0;
+            }
+            if (r >= axis.getMax())
+            {
+                return axis.size() + 1;
+            }
+            return axis.bin(r) + 1;
+        };
+        for (size_t k = 1; k <= m_nbins + 1; ++k)
+        {
+            // Non-negative floats are ordered like their bit patterns.
+            uint32_t lower = 0;
+            uint32_t upper = 0x7f800000;
+            while (lower < upper)
+            {
+                const uint32_t middle = lower + (upper - lower) / 2;
+                if (rank(bitsToFloat(middle)) >= k)
+                {
+                    upper = middle;
+                }
+                else
+                {
+                    lower = middle + 1;
+                }
+            }
+            m_thresholds[k] = bitsToFloat(lower);
+        }
+
+        const size_t num_intervals = 4 * m_nbins;
+        const float range = m_thresholds[m_nbins + 1] - m_thresholds[1];
+        m_inverse_interval_width = (range > 0) ? float(num_intervals) / range : 0;
+        m_guesses.assign(num_intervals + 1, 1);
+        for (size_t interval = 1; range > 0 && interval <= num_intervals; ++interval)
+        {
+            const float r_sq = m_thresholds[1] + float(interval) / m_inverse_interval_width;
+            m_guesses[interval] = findRank(r_sq, m_guesses[interval - 1]);
+        }
+    }
+
+    //! Find the bin of the square root of a value.
+    /*! \param r_sq The squared value to bin.
+     *
+     * \return The index of the bin, or Axis::OVERFLOW_BIN.
+     */
+    size_t bin(float r_sq) const
+    {
+        if (!(r_sq >= m_thresholds[1] && r_sq < m_thresholds[m_nbins + 1]))
+        {
+            return Axis::OVERFLOW_BIN;
+        }
+        const size_t interval = std::min(
+            static_cast<size_t>((r_sq - m_thresholds[1]) * m_inverse_interval_width), m_guesses.size() - 1);
+        return findRank(r_sq, m_guesses[interval]) - 1;
+    }
+
+private:
+    //! Find the rank of an in-range squared value by walking from a guess.
+    size_t findRank(float r_sq, size_t guess) const
+    {
+        size_t k = std::max(std::min(guess, m_nbins), size_t(1));
+        while (k > 1 && r_sq < m_thresholds[k])
+        {
+            --k;
+        }
+        while (k < m_nbins && r_sq >= m_thresholds[k + 1])
+        {
+            ++k;
+        }
+        return k;
+    }
+
+    size_t m_nbins;                  //!< Number of bins of the axis.
+    std::vector<float> m_thresholds; //!< Smallest squared value of each rank.
+    std::vector<size_t> m_guesses;   //!< Smallest rank of each interval of squared values.
+    float m_inverse_interval_width;  //!< Inverse width of the intervals of squared values.
+};
+
 //! An n-dimensional histogram class.
 /*! The Histogram is designed to simplify the most common use of histograms in
  * C++ code, which is looping over a series of values and then binning them. To
@@ -4,8 +4,11 @@
 #include <cstring>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
+#include "ArrayView.h"
+
 /*! \file ManagedArray.h
     \brief Defines the standard array class to be used throughout freud.
 */
@@ -39,6 +42,8 @@ namespace freud { namespace util {
  *      2. In situations where multiple identically shaped arrays are being
  *         indexed into, the index may be computed once using the getIndex
  *         function and reused to avoid recomputing it each time.
+ *      3. Inner loops should index through an ArrayView obtained from the
+ *         view function, which caches the data pointer and strides.
  */
 template<typename T> class ManagedArray
 {
@@ -226,6 +231,24 @@ public:
         return (*this)[idx];
     }
 
+    //! Get a view of the array for fast indexing with a fixed number of indices.
+    /*! The view is invalidated if the array is reallocated, e.g. by prepare.
+     *  Throws std::invalid_argument if Rank differs from the number of
+     *  dimensions of the array.
+     */
+    template<unsigned int Rank> ArrayView<T, Rank> view()
+    {
+        checkRank(Rank);
+        return ArrayView<T, Rank>(get(), m_shape->data());
+    }
+
+    //! Get a read-only view of the array for fast indexing with a fixed number of indices.
+    template<unsigned int Rank> ArrayView<const T, Rank> view() const
+    {
+        checkRank(Rank);
+        return ArrayView<const T, Rank>(get(), m_shape->data());
+    }
+
     //! Get the multi-index corresponding to a single regular index.
     /*! This function is provided as an external utility in the event that
      * index generation is necessary without an actual array.
@@ -328,6 +351,18 @@ public:
     }
 
 private:
+    //! Check that views of the given rank can be created.
+    void checkRank(unsigned int rank) const
+    {
+        if (rank != m_shape->size())
+        {
+            std::ostringstream msg;
+            msg << "Attempted to create a view of rank " << rank << " of an array with " << m_shape->size()
+                << " dimensions." << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+    }
+
     //! The base case for building up the index.
     /*! These argument building functions are templated on two types, one that
      *  encapsulates the current object being operated on and the other being
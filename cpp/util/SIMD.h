@@ -0,0 +1,155 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+/*! \file SIMD.h
+    \brief Runtime detection of the SIMD instruction sets used by vectorized kernels.
+*/
+
+/* Kernels are compiled for several instruction sets in the same binary by
+ * marking functions with target attributes, which is supported by GCC and
+ * Clang on x86. The baseline build flags are left untouched, so a binary built
+ * for generic x86-64 runs everywhere and uses wider instructions only on CPUs
+ * supporting them. Other compilers and architectures only use the portable
+ * code paths. Defining FREUD_NO_SIMD_DISPATCH disables the dispatch entirely.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) \
+    && !defined(FREUD_NO_SIMD_DISPATCH)
+#define FREUD_SIMD_DISPATCH
+#define FREUD_TARGET_AVX2 __attribute__((target("avx2")))
+#define FREUD_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace freud { namespace util {
+
+//! Instruction sets for which vectorized kernels are compiled, ordered by vector width.
+enum class SIMDLevel
+{
+    none = 0,  //!< Portable code compiled with the baseline build flags
+    avx2 = 1,  //!< 256-bit AVX2 kernels
+    avx512 = 2 //!< 512-bit AVX-512F kernels
+};
+
+//! Get the name of a SIMD level, as used by the FREUD_SIMD environment variable.
+inline const char* getSIMDLevelName(SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDLevel::avx2:
+        return "avx2";
+    case SIMDLevel::avx512:
+        return "avx512";
+    default:
+        return "none";
+    }
+}
+
+//! Get the widest SIMD level supported by the CPU and operating system.
+/*! The CPU is only queried on the first call.
+ */
+inline SIMDLevel getSupportedSIMDLevel()
+{
+    static const SIMDLevel supported_level = []() {
+#ifdef FREUD_SIMD_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return SIMDLevel::avx512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SIMDLevel::avx2;
+        }
+#endif
+        return SIMDLevel::none;
+    }();
+    return supported_level;
+}
+
+//! Get the SIMD level that vectorized kernels use unless it is set.
+/*! This is the supported level, unless the FREUD_SIMD environment variable
+ *  names a narrower level ("none", "avx2" or "avx512"), which allows testing
+ *  all code paths on a single machine. Levels wider than the supported level
+ *  and unrecognized values are ignored.
+ */
+inline SIMDLevel getDefaultSIMDLevel()
+{
+    const SIMDLevel supported_level = getSupportedSIMDLevel();
+    const char* requested = std::getenv("FREUD_SIMD");
+    if (requested != NULL)
+    {
+        for (SIMDLevel requested_level : {SIMDLevel::none, SIMDLevel::avx2, SIMDLevel::avx512})
+        {
+            if (std::strcmp(requested, getSIMDLevelName(requested_level)) == 0)
+            {
+                return (requested_level < supported_level) ? requested_level : supported_level;
+            }
+        }
+    }
+    return supported_level;
+}
+
+//! Get the pointer to the storage of the SIMD level that vectorized kernels should use.
+/*! Each freud extension module is a separate library with its own copy of
+ *  this storage, which is initialized once, on the first call, to the
+ *  default level. Later changes go through setSIMDLevel, so compute classes
+ *  running on other threads never read the environment while it is being
+ *  modified. On import, every module points its storage pointer to the
+ *  storage of freud.parallel with shareSIMDLevelStorage, so that a single
+ *  level is used by all modules regardless of how the platform links
+ *  static variables of inline functions across libraries.
+ */
+inline std::atomic<std::atomic<SIMDLevel>*>& getSIMDLevelStoragePointer()
+{
+    static std::atomic<SIMDLevel> level(getDefaultSIMDLevel());
+    static std::atomic<std::atomic<SIMDLevel>*> storage(&level);
+    return storage;
+}
+
+//! Get the storage of the SIMD level that vectorized kernels should use.
+inline std::atomic<SIMDLevel>& getSIMDLevelStorage()
+{
+    return *getSIMDLevelStoragePointer().load(std::memory_order_acquire);
+}
+
+//! Get the address of the storage of the SIMD level, to share it with other modules.
+inline void* getSIMDLevelStorageAddress()
+{
+    return &getSIMDLevelStorage();
+}
+
+//! Use the storage of the SIMD level of another module.
+/*! \param storage Address of the storage, from getSIMDLevelStorageAddress in the other module.
+ */
+inline void shareSIMDLevelStorage(void* storage)
+{
+    getSIMDLevelStoragePointer().store(static_cast<std::atomic<SIMDLevel>*>(storage),
+                                       std::memory_order_release);
+}
+
+//! Get the SIMD level that vectorized kernels should use.
+/*! Compute classes should call this once per compute rather than in inner
+ *  loops, so that a compute uses a single level throughout.
+ */
+inline SIMDLevel getSIMDLevel()
+{
+    return getSIMDLevelStorage().load(std::memory_order_relaxed);
+}
+
+//! Set the SIMD level that vectorized kernels should use.
+/*! Levels wider than the supported level are capped to the supported level.
+ */
+inline void setSIMDLevel(SIMDLevel level)
+{
+    const SIMDLevel supported_level = getSupportedSIMDLevel();
+    getSIMDLevelStorage().store((level < supported_level) ? level : supported_level,
+                                std::memory_order_relaxed);
+}
+
+}; }; // end namespace freud::util
+
+#endif // SIMD_H
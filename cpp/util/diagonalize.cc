@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 #include "diagonalize.h"
+#include "utils.h"
 
 namespace freud { namespace util {
 
@@ -32,4 +38,213 @@ void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::Ma
     }
 }
 
+namespace {
+
+//! Compute the cross product of two vectors.
+inline void cross(const double* a, const double* b, double* result)
+{
+    result[0] = a[1] * b[2] - a[2] * b[1];
+    result[1] = a[2] * b[0] - a[0] * b[2];
+    result[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+//! Compute the quadratic form a^T M b of a symmetric matrix.
+inline double quadraticForm(const double (&M)[3][3], const double* a, const double* b)
+{
+    double result = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        result += a[i] * (M[i][0] * b[0] + M[i][1] * b[1] + M[i][2] * b[2]);
+    }
+    return result;
+}
+
+//! Store a unit vector as a row of the eigenvector matrix, with its component of largest magnitude positive.
+inline void storeEigenvector(const double* vec, float* eigen_vecs, unsigned int row)
+{
+    unsigned int largest = 0;
+    for (unsigned int i = 1; i < 3; ++i)
+    {
+        if (std::abs(vec[i]) > std::abs(vec[largest]))
+        {
+            largest = i;
+        }
+    }
+    const double sign = (vec[largest] < 0) ? -1 : 1;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        eigen_vecs[3 * row + i] = static_cast<float>(sign * vec[i]);
+    }
+}
+
+}; // end anonymous namespace
+
+bool diagonalize33SymmetricMatrix(const float* mat, float* eigen_vals, float* eigen_vecs)
+{
+    // Work with the symmetric part of the matrix shifted by the mean
+    // eigenvalue, which has the same eigenvectors and a zero trace.
+    const double shift = (double(mat[0]) + mat[4] + mat[8]) / 3;
+    double M[3][3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            M[i][j] = (double(mat[3 * i + j]) + mat[3 * j + i]) / 2;
+        }
+        M[i][i] -= shift;
+    }
+
+    const double off_diagonal = M[0][1] * M[0][1] + M[0][2] * M[0][2] + M[1][2] * M[1][2];
+    const double norm_sq = M[0][0] * M[0][0] + M[1][1] * M[1][1] + M[2][2] * M[2][2] + 2 * off_diagonal;
+    if (!std::isfinite(norm_sq) || !std::isfinite(shift))
+    {
+        for (unsigned int i = 0; i < 9; ++i)
+        {
+            eigen_vecs[i] = (i % 4 == 0) ? 1 : 0;
+        }
+        eigen_vals[0] = eigen_vals[1] = eigen_vals[2] = 0;
+        return false;
+    }
+    if (norm_sq == 0)
+    {
+        for (unsigned int i = 0; i < 9; ++i)
+        {
+            eigen_vecs[i] = (i % 4 == 0) ? 1 : 0;
+        }
+        eigen_vals[0] = eigen_vals[1] = eigen_vals[2] = static_cast<float>(shift);
+        return true;
+    }
+
+    // The eigenvalues of the traceless matrix are 2 p cos(phi + 2 pi k / 3),
+    // where cos(3 phi) = det(M / p) / 2.
+    const double p = std::sqrt(norm_sq / 6);
+    const double det = M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[1][2])
+        - M[0][1] * (M[0][1] * M[2][2] - M[1][2] * M[0][2])
+        + M[0][2] * (M[0][1] * M[1][2] - M[1][1] * M[0][2]);
+    const double half_det = std::max(-1.0, std::min(1.0, det / (2 * p * p * p)));
+    const double phi = std::acos(half_det) / 3;
+    const double largest = 2 * p * std::cos(phi);
+    const double smallest = 2 * p * std::cos(phi + 2 * M_PI / 3);
+    const double middle = -largest - smallest;
+
+    // The eigenvalue farthest from the others is computed accurately even
+    // when the other two are nearly degenerate, and its eigenvector is the
+    // largest cross product of two rows of M - lambda I.
+    const bool largest_isolated = (largest - middle) >= (middle - smallest);
+    const double isolated = largest_isolated ? largest : smallest;
+    double rows[3][3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            rows[i][j] = M[i][j];
+        }
+        rows[i][i] -= isolated;
+    }
+    double crosses[3][3];
+    cross(rows[0], rows[1], crosses[0]);
+    cross(rows[0], rows[2], crosses[1]);
+    cross(rows[1], rows[2], crosses[2]);
+    unsigned int best = 0;
+    double best_norm_sq = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const double cross_norm_sq
+            = crosses[i][0] * crosses[i][0] + crosses[i][1] * crosses[i][1] + crosses[i][2] * crosses[i][2];
+        if (cross_norm_sq > best_norm_sq)
+        {
+            best = i;
+            best_norm_sq = cross_norm_sq;
+        }
+    }
+    double v[3];
+    const double inverse_norm = 1 / std::sqrt(best_norm_sq);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        v[i] = crosses[best][i] * inverse_norm;
+    }
+
+    // Build an orthonormal basis (u, w) of the plane orthogonal to v.
+    double u[3];
+    if (std::abs(v[0]) > std::abs(v[1]))
+    {
+        const double inverse_length = 1 / std::sqrt(v[0] * v[0] + v[2] * v[2]);
+        u[0] = -v[2] * inverse_length;
+        u[1] = 0;
+        u[2] = v[0] * inverse_length;
+    }
+    else
+    {
+        const double inverse_length = 1 / std::sqrt(v[1] * v[1] + v[2] * v[2]);
+        u[0] = 0;
+        u[1] = v[2] * inverse_length;
+        u[2] = -v[1] * inverse_length;
+    }
+    double w[3];
+    cross(v, u, w);
+
+    // A Jacobi rotation by theta with tan(2 theta) = 2 b / (a - c)
+    // diagonalizes the block [[a, b], [b, c]] of M in the plane.
+    const double a = quadraticForm(M, u, u);
+    const double b = quadraticForm(M, u, w);
+    const double c = quadraticForm(M, w, w);
+    const double theta = std::atan2(2 * b, a - c) / 2;
+    const double cos_theta = std::cos(theta);
+    const double sin_theta = std::sin(theta);
+    const double radius = std::sqrt((a - c) * (a - c) / 4 + b * b);
+    double upper[3], lower[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        upper[i] = cos_theta * u[i] + sin_theta * w[i];
+        lower[i] = cos_theta * w[i] - sin_theta * u[i];
+    }
+    const double upper_value = (a + c) / 2 + radius;
+    const double lower_value = (a + c) / 2 - radius;
+
+    // The Rayleigh quotient refines the isolated eigenvalue.
+    const double isolated_value = quadraticForm(M, v, v);
+    if (largest_isolated)
+    {
+        eigen_vals[0] = static_cast<float>(shift + lower_value);
+        eigen_vals[1] = static_cast<float>(shift + upper_value);
+        eigen_vals[2] = static_cast<float>(shift + isolated_value);
+        storeEigenvector(lower, eigen_vecs, 0);
+        storeEigenvector(upper, eigen_vecs, 1);
+        storeEigenvector(v, eigen_vecs, 2);
+    }
+    else
+    {
+        eigen_vals[0] = static_cast<float>(shift + isolated_value);
+        eigen_vals[1] = static_cast<float>(shift + lower_value);
+        eigen_vals[2] = static_cast<float>(shift + upper_value);
+        storeEigenvector(v, eigen_vecs, 0);
+        storeEigenvector(lower, eigen_vecs, 1);
+        storeEigenvector(upper, eigen_vecs, 2);
+    }
+    return true;
+}
+
+void diagonalize33SymmetricMatrices(const util::ManagedArray<float>& mats,
+                                    util::ManagedArray<float>& eigen_vals,
+                                    util::ManagedArray<float>& eigen_vecs)
+{
+    const std::vector<size_t> shape = mats.shape();
+    if (shape.size() != 3 || shape[1] != 3 || shape[2] != 3)
+    {
+        throw std::invalid_argument("The matrices to diagonalize must have the shape (N, 3, 3).");
+    }
+    const size_t num_mats = shape[0];
+    eigen_vals.prepare({num_mats, 3});
+    eigen_vecs.prepare({num_mats, 3, 3});
+    const float* mats_data = mats.get();
+    float* vals_data = eigen_vals.get();
+    float* vecs_data = eigen_vecs.get();
+    util::forLoopWrapper(0, num_mats, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            diagonalize33SymmetricMatrix(mats_data + 9 * i, vals_data + 3 * i, vecs_data + 9 * i);
+        }
+    });
+}
+
 }; }; // namespace freud::util
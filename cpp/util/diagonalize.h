@@ -23,5 +23,38 @@ namespace freud { namespace util {
 void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::ManagedArray<float>& eigen_vals,
                                   util::ManagedArray<float>& eigen_vecs);
 
+//! Compute eigenvalues and eigenvectors of a symmetric 3x3 matrix in closed form.
+/*! The eigenvalues are found from the characteristic polynomial with the
+ * trigonometric solution of the cubic. The eigenvector of the eigenvalue that
+ * is farthest from the other two, which is always separated from them by at
+ * least half the spread of the eigenvalues, is the largest cross product of
+ * two rows of the shifted matrix. The other two eigenvectors diagonalize the
+ * 2x2 block of the matrix orthogonal to it with a single Jacobi rotation,
+ * which is exact even for degenerate eigenvalues. No iteration or allocation
+ * is performed, so this may be called for each of many matrices.
+ *
+ * The output conventions are those of the ManagedArray overload, and the
+ * sign of each eigenvector is chosen so that its component of largest
+ * magnitude is positive. The symmetric part of the matrix is diagonalized.
+ *
+ *  \param mat The 9 elements of the matrix in row-major order.
+ *  \param eigen_vals The 3 eigenvalues in increasing order (set to 0 if the matrix is not finite).
+ *  \param eigen_vecs The 9 elements of the matrix with eigenvectors as the rows (set to the identity if the
+ *         matrix is not finite).
+ *  \return Whether the matrix was diagonalized.
+ */
+bool diagonalize33SymmetricMatrix(const float* mat, float* eigen_vals, float* eigen_vecs);
+
+//! Compute eigenvalues and eigenvectors of many symmetric 3x3 matrices in parallel.
+/*! Each matrix is diagonalized in closed form as described above.
+ *
+ *  \param mats The (N, 3, 3) array of matrices to diagonalize.
+ *  \param eigen_vals Set to the (N, 3) array of eigenvalues of each matrix in increasing order.
+ *  \param eigen_vecs Set to the (N, 3, 3) array of eigenvectors of each matrix as the rows.
+ */
+void diagonalize33SymmetricMatrices(const util::ManagedArray<float>& mats,
+                                    util::ManagedArray<float>& eigen_vals,
+                                    util::ManagedArray<float>& eigen_vecs);
+
 }; }; // namespace freud::util
 #endif
@@ -1,6 +1,7 @@
 # Copyright (c) 2010-2020 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
 from freud.util cimport vec3, uint
 from libcpp.vector cimport vector
 cimport freud._locality
@@ -8,14 +9,17 @@ cimport freud.util
 
 cdef extern from "Cluster.h" namespace "freud::cluster":
     cdef cppclass Cluster:
-        Cluster() except +
+        Cluster(bool) except +
         void compute(const freud._locality.NeighborQuery*,
                      const freud._locality.NeighborList*,
                      freud._locality.QueryArgs,
                      const unsigned int*) except +
+        bool getDetectWrapping() const
         unsigned int getNumClusters() const
         const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
         const vector[vector[uint]] getClusterKeys() const
+        const freud.util.ManagedArray[bool] &getClusterWrapping() const
+        const freud.util.ManagedArray[unsigned int] &getClusterWrappingRank() const
 
 cdef extern from "ClusterProperties.h" namespace "freud::cluster":
     cdef cppclass ClusterProperties:
@@ -24,4 +28,18 @@ cdef extern from "ClusterProperties.h" namespace "freud::cluster":
                      const unsigned int*) except +
         const freud.util.ManagedArray[vec3[float]] &getClusterCenters() const
         const freud.util.ManagedArray[float] &getClusterGyrations() const
+        const freud.util.ManagedArray[float] &getClusterGyrationEigenvalues() const
+        const freud.util.ManagedArray[float] &getClusterGyrationEigenvectors() const
         const freud.util.ManagedArray[unsigned int] &getClusterSizes() const
+
+cdef extern from "RingStatistics.h" namespace "freud::cluster":
+    cdef cppclass RingStatistics:
+        RingStatistics(unsigned int) except +
+        void compute(const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborList*,
+                     freud._locality.QueryArgs) except +
+        unsigned int getMaxRingSize() const
+        unsigned int getNumRings() const
+        const freud.util.ManagedArray[unsigned int] &getRingCounts() const
+        const freud.util.ManagedArray[unsigned int] &getPointRingCounts() const
+        freud._locality.NeighborList * getNList()
@@ -4,6 +4,7 @@
 from freud.util cimport vec3
 from freud._locality cimport BondHistogramCompute
 from libcpp cimport bool
+from libcpp.vector cimport vector
 
 cimport freud._box
 cimport freud._locality
@@ -48,15 +49,40 @@ cdef extern from "LocalDensity.h" namespace "freud::density":
 
 cdef extern from "RDF.h" namespace "freud::density":
     cdef cppclass RDF(BondHistogramCompute):
-        RDF(float, float, float, bool) except +
+        RDF(unsigned int, float, float, bool, bool) except +
+        RDF(const vector[float] &, bool) except +
         const freud._box.Box & getBox() const
         void accumulate(const freud._locality.NeighborQuery*,
                         const vec3[float]*,
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateSubsampled(const freud._locality.NeighborQuery*,
+                                  const vec3[float]*,
+                                  unsigned int,
+                                  freud._locality.QueryArgs,
+                                  float, float, unsigned int) except +
+        void accumulateCellPairs(const freud._locality.NeighborQuery*,
+                                 const vec3[float]*,
+                                 unsigned int,
+                                 freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
+        const freud.util.ManagedArray[float] &getRelativeError() const
+        unsigned int getNumSampledQueryPoints() const
+
+cdef extern from "NumberVariance.h" namespace "freud::density":
+    cdef cppclass NumberVariance:
+        NumberVariance(vec3[unsigned int], unsigned int, unsigned int) except +
+        const freud._box.Box & getBox() const
+        void compute(const freud._locality.NeighborQuery*) except +
+        vec3[unsigned int] getWidth() const
+        unsigned int getNumSamples() const
+        unsigned int getSeed() const
+        const freud.util.ManagedArray[unsigned int] &getWindowWidths() const
+        const freud.util.ManagedArray[float] &getWindowVolumes() const
+        const freud.util.ManagedArray[float] &getMeanCounts() const
+        const freud.util.ManagedArray[float] &getVariances() const
 
 cdef extern from "SphereVoxelization.h" namespace "freud::density":
     cdef cppclass SphereVoxelization:
@@ -144,3 +144,25 @@ cdef extern from "LocalBondProjection.h" namespace "freud::environment":
         const freud.util.ManagedArray[float] &getProjections() const
         const freud.util.ManagedArray[float] &getNormedProjections() const
         freud._locality.NeighborList * getNList()
+
+cdef extern from "CommonNeighborAnalysis.h" namespace "freud::environment":
+    cdef cppclass CommonNeighborAnalysis:
+        CommonNeighborAnalysis(bool)
+        void compute(const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborList*,
+                     freud._locality.QueryArgs) except +
+        bool isAdaptive() const
+        const freud.util.ManagedArray[unsigned int] &getStructures() const
+        const freud.util.ManagedArray[unsigned int] &getStructureCounts() const
+        freud._locality.NeighborList * getNList()
+
+cdef extern from "NonaffineDisplacement.h" namespace "freud::environment":
+    cdef cppclass NonaffineDisplacement:
+        NonaffineDisplacement()
+        void compute(const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborList*,
+                     freud._locality.QueryArgs) except +
+        const freud.util.ManagedArray[float] &getD2min() const
+        const freud.util.ManagedArray[float] &getStrain() const
+        freud._locality.NeighborList * getNList()
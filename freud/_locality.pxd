@@ -2,7 +2,7 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 from libcpp cimport bool
-from freud.util cimport vec3
+from freud.util cimport vec3, quat
 from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
 from libcpp.pair cimport pair
@@ -46,6 +46,11 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         const vec3[float]* getPoints const
         const unsigned int getNPoints const
         const vec3[float] operator[](unsigned int) const
+        void updatePoints(const vec3[float]*, const unsigned int*,
+                          unsigned int) except +
+        void insertPoints(const vec3[float]*, unsigned int) except +
+        void removePoints(const vec3[float]*, unsigned int,
+                          const unsigned int*, unsigned int) except +
 
     NeighborBond ITERATOR_TERMINATOR \
         "freud::locality::NeighborQueryIterator::ITERATOR_TERMINATOR"
@@ -55,6 +60,8 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         NeighborQueryIterator(NeighborQuery*, vec3[float]*, unsigned int)
         bool end()
         NeighborBond next()
+        unsigned int nextChunk(unsigned int, unsigned int*, unsigned int*,
+                               float*) nogil except +
         NeighborList *toNeighborList(bool)
 
 cdef extern from "RawPoints.h" namespace "freud::locality":
@@ -101,12 +108,27 @@ cdef extern from "LinkCell.h" namespace "freud::locality":
                  float) except +
         float getCellWidth() const
 
+cdef extern from "AdaptiveCell.h" namespace "freud::locality":
+    cdef cppclass AdaptiveCell(NeighborQuery):
+        AdaptiveCell() except +
+        AdaptiveCell(const freud._box.Box &,
+                     const vec3[float]*,
+                     unsigned int,
+                     float,
+                     unsigned int) except +
+        float getCellWidth() const
+        vec3[unsigned int] getCellDimensions() const
+        unsigned int getMaxPointsPerCell() const
+        unsigned int getNumLevels() const
+
 cdef extern from "AABBQuery.h" namespace "freud::locality":
     cdef cppclass AABBQuery(NeighborQuery):
         AABBQuery() except +
         AABBQuery(const freud._box.Box,
                   const vec3[float]*,
-                  unsigned int) except +
+                  unsigned int,
+                  bool) except +
+        bool usesWideTree() const
 
 cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
     cdef cppclass BondHistogramCompute:
@@ -139,3 +161,70 @@ cdef extern from "Voronoi.h" namespace "freud::locality":
         vector[vector[vec3[double]]] getPolytopes() const
         const freud.util.ManagedArray[double] &getVolumes() const
         shared_ptr[NeighborList] getNeighborList() const
+
+cdef extern from "NeighborListOperations.h" namespace "freud::locality":
+    ctypedef enum BondMerge "freud::locality::BondMerge":
+        BOND_MERGE_FIRST "freud::locality::BondMerge::first"
+        BOND_MERGE_SECOND "freud::locality::BondMerge::second"
+        BOND_MERGE_MIN "freud::locality::BondMerge::min"
+        BOND_MERGE_MAX "freud::locality::BondMerge::max"
+        BOND_MERGE_SUM "freud::locality::BondMerge::sum"
+        BOND_MERGE_MEAN "freud::locality::BondMerge::mean"
+
+    NeighborList* symmetrizeNeighborList(
+        const NeighborList*, BondMerge, BondMerge) nogil except +
+    NeighborList* neighborListUnion(
+        const NeighborList*, const NeighborList*, BondMerge,
+        BondMerge) nogil except +
+    NeighborList* neighborListIntersection(
+        const NeighborList*, const NeighborList*, BondMerge,
+        BondMerge) nogil except +
+    NeighborList* neighborListDifference(
+        const NeighborList*, const NeighborList*) nogil except +
+
+cdef extern from "BondChanges.h" namespace "freud::locality":
+    cdef cppclass BondChanges:
+        BondChanges()
+        void compute(const NeighborList*, const NeighborList*) nogil except +
+        shared_ptr[NeighborList] getFormedBonds() const
+        shared_ptr[NeighborList] getBrokenBonds() const
+
+    cdef cppclass BondLifetime:
+        BondLifetime()
+        void compute(const NeighborList*) nogil except +
+        void reset()
+        unsigned int getNumFrames() const
+        unsigned int getNumBonds() const
+        const freud.util.ManagedArray[unsigned int] &getLifetimeHistogram() const
+
+    cdef cppclass MovedPointBondChanges:
+        MovedPointBondChanges()
+        void prepare(const NeighborQuery*, const unsigned int*, unsigned int,
+                     QueryArgs) except +
+        void compute(const NeighborQuery*) except +
+        shared_ptr[NeighborList] getFormedBonds() const
+        shared_ptr[NeighborList] getBrokenBonds() const
+
+cdef extern from "PairKernel.h":
+    cdef struct FreudBond:
+        pass
+
+    cdef struct FreudPairSystem:
+        pass
+
+    ctypedef int (*FreudBondPredicate)(const FreudPairSystem*,
+                                       const FreudBond*) nogil
+    ctypedef void (*FreudBondKernel)(const FreudPairSystem*, const FreudBond*,
+                                     double*) nogil
+
+cdef extern from "PairKernel.h" namespace "freud::locality":
+    cdef cppclass PairKernel:
+        PairKernel(FreudBondPredicate, FreudBondKernel, unsigned int, bool)
+        void compute(const NeighborQuery*, const quat[float]*,
+                     const vec3[float]*, const quat[float]*, unsigned int,
+                     const NeighborList*, QueryArgs, void*) nogil except +
+        const freud.util.ManagedArray[double] &getOutput() const
+        unsigned int getNumAcceptedBonds() const
+        shared_ptr[NeighborList] getNeighborList() const
+        unsigned int getNumOutputs() const
+        bool getStoreBonds() const
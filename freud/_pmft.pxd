@@ -1,6 +1,7 @@
 # Copyright (c) 2010-2020 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
 from freud.util cimport vec3, quat
 from freud._locality cimport BondHistogramCompute
 
@@ -60,4 +61,5 @@ cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
                         quat[float]*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs,
+                        bool) except +
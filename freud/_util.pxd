@@ -31,3 +31,15 @@ cdef extern from "ManagedArray.h" namespace "freud::util":
 
 cdef extern from "numpy/arrayobject.h":
     cdef int PyArray_SetBaseObject(numpy.ndarray arr, obj)
+
+cdef extern from "SIMD.h" namespace "freud::util":
+    ctypedef enum SIMDLevel "freud::util::SIMDLevel":
+        SIMD_NONE "freud::util::SIMDLevel::none"
+        SIMD_AVX2 "freud::util::SIMDLevel::avx2"
+        SIMD_AVX512 "freud::util::SIMDLevel::avx512"
+    const char* getSIMDLevelName(SIMDLevel)
+    SIMDLevel getSupportedSIMDLevel()
+    SIMDLevel getSIMDLevel()
+    void setSIMDLevel(SIMDLevel)
+    void* getSIMDLevelStorageAddress()
+    void shareSIMDLevelStorage(void*)
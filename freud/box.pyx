@@ -13,10 +13,11 @@ import logging
 
 import freud.util
 
-from freud.util cimport vec3
+from freud.util cimport vec3, _share_simd_level
 from cpython.object cimport Py_EQ, Py_NE
 
 cimport freud._box
+cimport freud._util
 cimport numpy as np
 
 logger = logging.getLogger(__name__)
@@ -25,6 +26,9 @@ logger = logging.getLogger(__name__)
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 cdef class Box:
     R"""The freud Box class for simulation boxes.
 
@@ -809,3 +813,14 @@ cdef BoxFromCPP(const freud._box.Box & cppbox):
                   cppbox.getPeriodicY(),
                   cppbox.getPeriodicZ()]
     return b
+
+
+def _get_simd_level():
+    R"""Get the SIMD instruction set used by the vectorized kernels of this
+    module, which is the one set with :func:`freud.parallel.set_simd_level`.
+
+    Returns:
+        str: One of :code:`'none'`, :code:`'avx2'` or :code:`'avx512'`.
+    """
+    return freud._util.getSIMDLevelName(
+        freud._util.getSIMDLevel()).decode()
@@ -12,7 +12,7 @@ import freud.locality
 import freud.util
 
 from cython.operator cimport dereference
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _PairCompute
 
 cimport freud._cluster
@@ -24,6 +24,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 cdef class Cluster(_PairCompute):
     """Finds clusters using a network of neighbors.
 
@@ -46,14 +49,37 @@ cdef class Cluster(_PairCompute):
     attribute :code:`cluster_keys`, as a list of lists. If keys are not
     provided, every point is assigned a key corresponding to its index, and
     :code:`cluster_keys` contains the point ids present in each cluster.
+
+    Clusters that wrap through the periodic boundaries of the box, such as
+    percolating networks, are detected in the same pass without replicating
+    the system. The periodic image of each point relative to the rest of its
+    cluster is tracked while clustering, and a loop of bonds that returns to
+    a point in a different image shows that the cluster extends infinitely
+    along the difference of the images. The attributes
+    :code:`cluster_wrapping` and :code:`cluster_wrapping_rank` hold the box
+    vectors each cluster wraps along and the number of independent lattice
+    vectors spanned by its loops (1 for an infinite strand, 2 for an infinite
+    sheet and 3 for a network spanning all three dimensions). The image of
+    each bond is the one that the neighbor query found it through, so bonds
+    to several images of the same point are distinguished when
+    :code:`r_max` exceeds half of the box. A
+    :class:`freud.locality.NeighborList` does not record the images of its
+    bonds, so each of its bonds joins the minimum image of its point.
+    Tracking images requires merging the bonds serially, so wrapping is only
+    detected when requested; otherwise the bonds are merged concurrently.
+
+    Args:
+        detect_wrapping (bool, optional):
+            Whether to find the clusters that wrap through the periodic
+            boundaries (Default value = :code:`False`).
     """
 
     cdef freud._cluster.Cluster * thisptr
 
-    def __cinit__(self):
-        self.thisptr = new freud._cluster.Cluster()
+    def __cinit__(self, detect_wrapping=False):
+        self.thisptr = new freud._cluster.Cluster(detect_wrapping)
 
-    def __init__(self):
+    def __init__(self, detect_wrapping=False):
         pass
 
     def __dealloc__(self):
@@ -99,6 +125,12 @@ cdef class Cluster(_PairCompute):
             l_keys_ptr)
         return self
 
+    @property
+    def detect_wrapping(self):
+        """bool: Whether clusters that wrap through the periodic boundaries
+        are found."""
+        return self.thisptr.getDetectWrapping()
+
     @_Compute._computed_property
     def num_clusters(self):
         """int: The number of clusters."""
@@ -119,8 +151,35 @@ cdef class Cluster(_PairCompute):
         cluster_keys = self.thisptr.getClusterKeys()
         return cluster_keys
 
+    @_Compute._computed_property
+    def cluster_wrapping(self):
+        """(:math:`N_{clusters}`, 3) :class:`numpy.ndarray`: Whether each
+        cluster wraps through the periodic boundaries along each box
+        vector. Only available when :code:`detect_wrapping` is
+        :code:`True`."""
+        if not self.detect_wrapping:
+            raise ValueError(
+                "Cluster wrapping is only found when detect_wrapping is True.")
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterWrapping(),
+            freud.util.arr_type_t.BOOL)
+
+    @_Compute._computed_property
+    def cluster_wrapping_rank(self):
+        """(:math:`N_{clusters}`) :class:`numpy.ndarray`: The number of
+        independent lattice vectors along which each cluster wraps through
+        the periodic boundaries, which is 0 for finite clusters. Only
+        available when :code:`detect_wrapping` is :code:`True`."""
+        if not self.detect_wrapping:
+            raise ValueError(
+                "Cluster wrapping is only found when detect_wrapping is True.")
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterWrappingRank(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
     def __repr__(self):
-        return "freud.cluster.{cls}()".format(cls=type(self).__name__)
+        return "freud.cluster.{cls}(detect_wrapping={detect_wrapping})".format(
+            cls=type(self).__name__, detect_wrapping=self.detect_wrapping)
 
     def plot(self, ax=None):
         """Plot cluster distribution.
@@ -162,7 +221,9 @@ cdef class ClusterProperties(_Compute):
     The center of mass for each cluster (properly handling periodic boundary
     conditions) can be accessed with :code:`centers` attribute.  The :math:`3
     \times 3` symmetric gyration tensors :math:`G` can be accessed with
-    :code:`gyrations` attribute.
+    :code:`gyrations` attribute, and their principal moments and axes with the
+    :code:`gyration_eigenvalues` and :code:`gyration_eigenvectors`
+    attributes.
     """
 
     cdef freud._cluster.ClusterProperties * thisptr
@@ -234,6 +295,26 @@ cdef class ClusterProperties(_Compute):
         gyration of each cluster."""
         return np.sqrt(np.trace(self.gyrations, axis1=-2, axis2=-1))
 
+    @_Compute._computed_property
+    def gyration_eigenvalues(self):
+        """(:math:`N_{clusters}`, 3) :class:`numpy.ndarray`: The eigenvalues
+        of the gyration tensors of the clusters (the squared principal radii
+        of gyration), in increasing order."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterGyrationEigenvalues(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def gyration_eigenvectors(self):
+        """(:math:`N_{clusters}`, 3, 3) :class:`numpy.ndarray`: The
+        eigenvectors of the gyration tensors of the clusters (the principal
+        axes), stored as rows in the order of :code:`gyration_eigenvalues`.
+        The sign of each eigenvector is chosen so that its component of
+        largest magnitude is positive."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterGyrationEigenvectors(),
+            freud.util.arr_type_t.FLOAT)
+
     @_Compute._computed_property
     def sizes(self):
         """(:math:`N_{clusters}`) :class:`numpy.ndarray`: The cluster sizes."""
@@ -242,4 +323,101 @@ cdef class ClusterProperties(_Compute):
             freud.util.arr_type_t.UNSIGNED_INT)
 
     def __repr__(self):
-        return "freud.cluster.{cls}()".format(cls=type(self).__name__)
+        return "freud.cluster.{cls}(detect_wrapping={detect_wrapping})".format(
+            cls=type(self).__name__, detect_wrapping=self.detect_wrapping)
+
+
+cdef class RingStatistics(_PairCompute):
+    R"""Counts the shortest-path rings of a network of neighbors.
+
+    The network is formed by the neighbor bonds, regardless of their
+    direction. A ring is a closed path on the network that visits no point
+    twice, and it is a shortest-path ring :cite:`Franzblau1991` if the shortest
+    path on the network between any two of its points runs along the ring.
+    For example, every ring of a honeycomb network is a hexagon, while the
+    paths around pairs of adjacent hexagons are not rings.
+
+    Rings are found in parallel by bounded breadth-first searches from every
+    point, and each ring is counted once.
+
+    Args:
+        max_ring_size (unsigned int, optional):
+            The largest number of points of the rings to count
+            (Default value = 12).
+    """
+    cdef freud._cluster.RingStatistics * thisptr
+
+    def __cinit__(self, unsigned int max_ring_size=12):
+        self.thisptr = new freud._cluster.RingStatistics(max_ring_size)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, neighbors=None):
+        R"""Count the rings of the network of neighbors.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+        """
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, neighbors=neighbors)
+
+        self.thisptr.compute(
+            nq.get_ptr(),
+            nlist.get_ptr(),
+            dereference(qargs.thisptr))
+        return self
+
+    @property
+    def max_ring_size(self):
+        """unsigned int: The largest number of points of the rings
+        counted."""
+        return self.thisptr.getMaxRingSize()
+
+    @_Compute._computed_property
+    def num_rings(self):
+        """int: The total number of rings."""
+        return self.thisptr.getNumRings()
+
+    @_Compute._computed_property
+    def ring_counts(self):
+        """(:math:`max\\_ring\\_size + 1`) :class:`numpy.ndarray`: The number
+        of rings of each size, indexed by the number of points of the
+        ring."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRingCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def point_ring_counts(self):
+        """(:math:`N_{points}`, :math:`max\\_ring\\_size + 1`)
+        :class:`numpy.ndarray`: The number of rings of each size that each
+        point belongs to, indexed by the number of points of the ring."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getPointRingCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`freud.locality.NeighborList`: The neighbor list from the
+        last compute."""
+        return freud.locality._nlist_from_cnlist(self.thisptr.getNList())
+
+    def __repr__(self):
+        return "freud.cluster.{cls}(max_ring_size={max_ring_size})".format(
+            cls=type(self).__name__, max_ring_size=self.max_ring_size)
@@ -12,9 +12,10 @@ import warnings
 import numpy as np
 
 from cython.operator cimport dereference
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _PairCompute, _SpatialHistogram1D
 from freud.util cimport vec3
+from libcpp.vector cimport vector
 
 from collections.abc import Sequence
 
@@ -28,6 +29,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 ctypedef unsigned int uint
 
 cdef class CorrelationFunction(_SpatialHistogram1D):
@@ -409,6 +413,145 @@ cdef class SphereVoxelization(_Compute):
             return None
 
 
+cdef class NumberVariance(_Compute):
+    R"""Computes the variance of the number of points in windows of many
+    sizes.
+
+    The points are counted on a periodic grid, and a summed-area table of the
+    grid is built once, from which the number of points in any window of
+    whole grid cells is found in constant time. Window :math:`k` spans
+    :math:`k` grid cells along each dimension of the box (only :math:`x` and
+    :math:`y` in 2D), for :math:`k` from 1 to one less than the smallest
+    width of the grid, and windows wrap around the periodic boundaries. The
+    variance :math:`\sigma^2` of the number of points in a window as a
+    function of the window volume characterizes density fluctuations, e.g.
+    hyperuniformity.
+
+    For each window size, windows are placed at every grid cell, or at
+    :code:`num_samples` random grid cells. Sampling about
+    :math:`N_{cells} / k_{max}` windows of each size evaluates the whole
+    curve in about one pass over the grid.
+
+    Args:
+        width (int or Sequence[int]):
+            The number of bins to make the grid in each dimension (identical
+            in all dimensions if a single integer value is provided).
+        num_samples (unsigned int, optional):
+            The number of windows of each size to place at random grid
+            cells. If :code:`None`, windows are placed at every grid cell
+            (Default value = :code:`None`).
+        seed (unsigned int, optional):
+            The seed of the random window positions (Default value = 0).
+    """
+    cdef freud._density.NumberVariance * thisptr
+
+    def __cinit__(self, width, num_samples=None, unsigned int seed=0):
+        cdef vec3[uint] width_vector
+        if isinstance(width, int):
+            width_vector = vec3[uint](width, width, width)
+        elif isinstance(width, Sequence) and len(width) == 2:
+            width_vector = vec3[uint](width[0], width[1], 1)
+        elif isinstance(width, Sequence) and len(width) == 3:
+            width_vector = vec3[uint](width[0], width[1], width[2])
+        else:
+            raise ValueError("The width must be either a number of bins or a "
+                             "sequence indicating the widths in each spatial "
+                             "dimension (length 2 in 2D, length 3 in 3D).")
+        if num_samples is not None and num_samples <= 0:
+            raise ValueError("num_samples must be positive.")
+
+        self.thisptr = new freud._density.NumberVariance(
+            width_vector, 0 if num_samples is None else num_samples, seed)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @_Compute._computed_property
+    def box(self):
+        """:class:`freud.box.Box`: Box used in the calculation."""
+        return freud.box.BoxFromCPP(self.thisptr.getBox())
+
+    def compute(self, system):
+        R"""Calculates the variance of the number of points in windows of
+        all sizes.
+
+        Example::
+
+            >>> box, points = freud.data.make_random_system(10, 10000, seed=0)
+            >>> nv = freud.density.NumberVariance(20)
+            >>> nv.compute((box, points))
+            freud.density.NumberVariance((20, 20, 20), None, 0)
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+        """
+        cdef freud.locality.NeighborQuery nq = \
+            freud.locality.NeighborQuery.from_system(system)
+        self.thisptr.compute(nq.get_ptr())
+        return self
+
+    @_Compute._computed_property
+    def window_widths(self):
+        """(:math:`k_{max}`) :class:`numpy.ndarray`: The number of grid
+        cells spanned by the windows of each size along each dimension."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getWindowWidths(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def window_volumes(self):
+        """(:math:`k_{max}`) :class:`numpy.ndarray`: The volume (area in 2D)
+        of the windows of each size."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getWindowVolumes(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def mean_counts(self):
+        """(:math:`k_{max}`) :class:`numpy.ndarray`: The mean number of
+        points in the windows of each size."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getMeanCounts(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def variances(self):
+        """(:math:`k_{max}`) :class:`numpy.ndarray`: The variance of the
+        number of points in the windows of each size."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getVariances(),
+            freud.util.arr_type_t.FLOAT)
+
+    @property
+    def width(self):
+        """tuple[int]: The number of bins in the grid in each dimension
+        (identical in all dimensions if a single integer value is provided)."""
+        cdef vec3[uint] width = self.thisptr.getWidth()
+        return (width.x, width.y, width.z)
+
+    @property
+    def num_samples(self):
+        """unsigned int: The number of windows of each size placed at random
+        grid cells, or :code:`None` if windows are placed at every grid
+        cell."""
+        cdef unsigned int num_samples = self.thisptr.getNumSamples()
+        return None if num_samples == 0 else num_samples
+
+    @property
+    def seed(self):
+        """unsigned int: The seed of the random window positions."""
+        return self.thisptr.getSeed()
+
+    def __repr__(self):
+        return ("freud.density.{cls}({width}, {num_samples}, {seed})").format(
+            cls=type(self).__name__,
+            width=self.width,
+            num_samples=self.num_samples,
+            seed=self.seed)
+
+
 cdef class LocalDensity(_PairCompute):
     R"""Computes the local density around a particle.
 
@@ -561,10 +704,13 @@ cdef class RDF(_SpatialHistogram1D):
         The points must be passed in as :code:`[x, y, 0]`.
 
     Args:
-        bins (unsigned int):
-            The number of bins in the RDF.
-        r_max (float):
+        bins (unsigned int or sequence of float):
+            The number of bins in the RDF, or the strictly increasing edges of
+            the bins (for example, to use finer bins at short distances).
+        r_max (float, optional):
             Maximum interparticle distance to include in the calculation.
+            Required when :code:`bins` is a number of bins, and must not be
+            given with bin edges (Default value = :code:`None`).
         r_min (float, optional):
             Minimum interparticle distance to include in the calculation
             (Default value = :code:`0`).
@@ -580,15 +726,37 @@ cdef class RDF(_SpatialHistogram1D):
             arguments are provided to :meth:`~.compute`, specifically if
             :code:`exclude_ii` is set to :code:`False`. This normalization is
             not meaningful in such cases and will simply convolute the data.
+        log_bins (bool, optional):
+            Space the bins logarithmically between :code:`r_min` and
+            :code:`r_max`, which requires a positive :code:`r_min`
+            (Default value = :code:`False`).
 
     """
     cdef freud._density.RDF * thisptr
+    cdef bint _log_bins
+    cdef bint _custom_bins
 
-    def __cinit__(self, unsigned int bins, float r_max, float r_min=0,
-                  normalize=False):
+    def __cinit__(self, bins, r_max=None, float r_min=0, normalize=False,
+                  log_bins=False):
+        cdef vector[float] bin_edges
         if type(self) == RDF:
-            self.thisptr = self.histptr = new freud._density.RDF(
-                bins, r_max, r_min, normalize)
+            self._log_bins = log_bins
+            self._custom_bins = np.ndim(bins) != 0
+            if self._custom_bins:
+                if r_max is not None or r_min != 0 or log_bins:
+                    raise ValueError(
+                        "r_max, r_min and log_bins cannot be used with bin "
+                        "edges.")
+                bin_edges = np.asarray(bins, dtype=np.float32).tolist()
+                self.thisptr = self.histptr = new freud._density.RDF(
+                    bin_edges, normalize)
+                r_max = bin_edges.back()
+            else:
+                if r_max is None:
+                    raise ValueError(
+                        "r_max is required when bins is a number of bins.")
+                self.thisptr = self.histptr = new freud._density.RDF(
+                    bins, r_max, r_min, normalize, log_bins)
 
             # r_max is left as an attribute rather than a property for now
             # since that change needs to happen at the _SpatialHistogram level
@@ -600,9 +768,30 @@ cdef class RDF(_SpatialHistogram1D):
             del self.thisptr
 
     def compute(self, system, query_points=None, neighbors=None,
-                reset=True):
+                reset=True, sample_fraction=None, target_error=None, seed=0,
+                count_cell_pairs=False):
         R"""Calculates the RDF and adds to the current RDF histogram.
 
+        For quick estimates in large systems, the RDF can be computed from a
+        subset of the query points by passing :code:`sample_fraction` or
+        :code:`target_error`. The query points are then processed in a
+        random order that samples the box evenly at every prefix (the first
+        :math:`m` of :math:`N` query points hold about one point from each
+        region of :math:`N / m` nearby query points), and the RDF is
+        normalized by the number of query points processed. With
+        :code:`target_error`, query points are added in batches of growing
+        size until the relative error of every nonempty bin (see
+        :attr:`relative_error`) is below the target.
+
+        For large :code:`r_max`, :code:`count_cell_pairs` counts the pairs
+        of points without finding neighbors. The points and query points are
+        sorted into trees of bounding spheres, and pairs of nodes whose
+        distances all fall in one bin are counted at once, while the other
+        pairs are binned individually. The bin counts are the same as those
+        of the default ball query. This is fastest when the bins are wide
+        compared to the spacing of the points, and is slower than finding
+        neighbors when :code:`r_max` spans only a few neighbor shells.
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -621,6 +810,24 @@ cdef class RDF(_SpatialHistogram1D):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            sample_fraction (float, optional):
+                Fraction of the query points to process, or the maximum
+                fraction when :code:`target_error` is given. Subsampling
+                requires neighbors to be found with query arguments rather
+                than a :class:`NeighborList <freud.locality.NeighborList>`
+                (Default value = :code:`None`, processing all query points
+                unless :code:`target_error` is given).
+            target_error (float, optional):
+                Relative error of the bins at which to stop processing query
+                points (Default value = :code:`None`).
+            seed (int, optional):
+                Seed of the random order of the query points when subsampling
+                (Default value = :code:`0`).
+            count_cell_pairs (bool, optional):
+                Whether to count pairs of cells of points rather than finding
+                neighbors, which requires ball query arguments covering the
+                bins and cannot be combined with subsampling (Default value =
+                :code:`False`).
         """  # noqa E501
         if reset:
             self._reset()
@@ -634,11 +841,41 @@ cdef class RDF(_SpatialHistogram1D):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
 
-        self.thisptr.accumulate(
+        if count_cell_pairs:
+            if nlist.get_ptr() != NULL:
+                raise ValueError(
+                    "Pairs of cells can only be counted with query "
+                    "arguments, not with a NeighborList.")
+            if sample_fraction is not None or target_error is not None:
+                raise ValueError(
+                    "Pairs of cells cannot be counted for a subset of the "
+                    "query points.")
+            self.thisptr.accumulateCellPairs(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, dereference(qargs.thisptr))
+            return self
+
+        if sample_fraction is None and target_error is None:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
+            return self
+
+        if nlist.get_ptr() != NULL:
+            raise ValueError(
+                "The RDF can only be computed from a subset of the query "
+                "points with query arguments, not with a NeighborList.")
+        if target_error is not None and target_error <= 0:
+            raise ValueError("target_error must be positive.")
+        self.thisptr.accumulateSubsampled(
             nq.get_ptr(),
             <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+            num_query_points, dereference(qargs.thisptr),
+            1 if sample_fraction is None else sample_fraction,
+            0 if target_error is None else target_error, seed)
         return self
 
     @_Compute._computed_property
@@ -660,12 +897,35 @@ cdef class RDF(_SpatialHistogram1D):
             &self.thisptr.getNr(),
             freud.util.arr_type_t.FLOAT)
 
+    @_Compute._computed_property
+    def relative_error(self):
+        """(:math:`N_{bins}`,) :class:`numpy.ndarray`: The relative standard
+        error of each bin of the RDF due to processing only a subset of the
+        query points in the last call to :meth:`~.compute`. It is estimated
+        from the spread of the bin counts between groups of the processed
+        query points, is zero when all query points were processed, and is
+        infinite for bins without bonds when query points were skipped."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRelativeError(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def num_sampled_query_points(self):
+        """unsigned int: The number of query points processed in the last
+        call to :meth:`~.compute`."""
+        return self.thisptr.getNumSampledQueryPoints()
+
     def __repr__(self):
+        if self._custom_bins:
+            return "freud.density.{cls}(bins={bins})".format(
+                cls=type(self).__name__, bins=self.bin_edges.tolist())
         return ("freud.density.{cls}(bins={bins}, r_max={r_max}, "
-                "r_min={r_min})").format(cls=type(self).__name__,
-                                         bins=len(self.bin_centers),
-                                         r_max=self.bounds[1],
-                                         r_min=self.bounds[0])
+                "r_min={r_min}{log_bins})").format(
+                    cls=type(self).__name__,
+                    bins=len(self.bin_centers),
+                    r_max=self.bounds[1],
+                    r_min=self.bounds[0],
+                    log_bins=", log_bins=True" if self._log_bins else "")
 
     def plot(self, ax=None):
         """Plot radial distribution function.
@@ -19,11 +19,14 @@ import scipy.ndimage
 import rowan
 
 from libcpp cimport bool as cbool
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 cimport freud.util
 cimport numpy as np
 
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 logger = logging.getLogger(__name__)
 
 
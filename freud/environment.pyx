@@ -13,7 +13,7 @@ import warnings
 import freud.locality
 from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _PairCompute, _SpatialHistogram
 from freud.util cimport vec3, quat
 from libcpp.map cimport map
@@ -29,6 +29,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 
 cdef class BondOrder(_SpatialHistogram):
     R"""Compute the bond orientational order diagram for the system of
@@ -1115,3 +1118,225 @@ cdef class LocalBondProjection(_PairCompute):
 
     def __repr__(self):
         return ("freud.environment.{cls}()").format(cls=type(self).__name__)
+
+
+cdef class CommonNeighborAnalysis(_PairCompute):
+    R"""Identifies fcc, hcp, bcc and icosahedral environments with common
+    neighbor analysis (CNA).
+
+    Each bond between a particle and one of its neighbors is characterized by
+    the number of neighbors common to both particles, the number of bonds
+    between these common neighbors, and the number of bonds in the largest
+    connected cluster of these bonds. A particle is assigned a structure when
+    the signatures of all its bonds match those of the structure: 12 bonds
+    with signature (4, 2, 1) for fcc, 6 bonds with signature (4, 2, 1) and 6
+    with signature (4, 2, 2) for hcp, 8 bonds with signature (6, 6, 6) and 6
+    with signature (4, 4, 4) for bcc, and 12 bonds with signature (5, 5, 5)
+    for icosahedral environments. Particles with any other environment are
+    identified as :attr:`OTHER`.
+
+    In the adaptive variant of CNA :cite:`Stukowski2012`, each particle uses
+    a cutoff computed from the distances of its 12 nearest neighbors (for
+    fcc, hcp and icosahedral environments) or its 14 nearest neighbors (for
+    bcc environments). The neighbors must then include at least the 14
+    nearest neighbors of each particle, which is the default.
+
+    In conventional CNA, the neighbors of each particle and the bonds between
+    neighbors are all given by the neighbors, which must be found with a
+    cutoff between the first and second neighbor shells (for fcc, hcp and
+    icosahedral environments) or between the second and third neighbor shells
+    (for bcc environments).
+
+    Args:
+        adaptive (bool, optional):
+            Whether to use adaptive cutoffs (Default value =
+            :code:`True`).
+    """
+    cdef freud._environment.CommonNeighborAnalysis * thisptr
+
+    OTHER = 0
+    FCC = 1
+    HCP = 2
+    BCC = 3
+    ICO = 4
+    structure_names = ('other', 'fcc', 'hcp', 'bcc', 'ico')
+
+    def __cinit__(self, adaptive=True):
+        self.thisptr = new freud._environment.CommonNeighborAnalysis(adaptive)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, neighbors=None):
+        R"""Identifies the structure of the environment of each particle.
+
+        Example::
+
+            >>> box, points = freud.data.UnitCell.fcc().generate_system(5)
+            >>> cna = freud.environment.CommonNeighborAnalysis()
+            >>> cna.compute((box, points))
+            freud.environment.CommonNeighborAnalysis(adaptive=True)
+            >>> print(cna.structure_counts)
+            [  0 500   0   0   0]
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+        """  # noqa: E501
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, neighbors=neighbors)
+        self.thisptr.compute(nq.get_ptr(), nlist.get_ptr(),
+                             dereference(qargs.thisptr))
+        return self
+
+    @property
+    def default_query_args(self):
+        """The default query arguments are
+        :code:`{'mode': 'nearest', 'num_neighbors': 14}` for adaptive CNA.
+        Conventional CNA has no default query arguments."""
+        if not self.adaptive:
+            raise NotImplementedError(
+                NO_DEFAULT_QUERY_ARGS_MESSAGE.format(type(self).__name__))
+        return dict(mode="nearest", num_neighbors=14)
+
+    @property
+    def adaptive(self):
+        """bool: Whether adaptive cutoffs are used."""
+        return self.thisptr.isAdaptive()
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`freud.locality.NeighborList`: The neighbor list from the
+        last compute."""
+        return freud.locality._nlist_from_cnlist(self.thisptr.getNList())
+
+    @_Compute._computed_property
+    def structures(self):
+        """:math:`\\left(N_{points}\\right)` :class:`numpy.ndarray`: The
+        structure identified for each particle, one of :attr:`OTHER`,
+        :attr:`FCC`, :attr:`HCP`, :attr:`BCC` and :attr:`ICO`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getStructures(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def structure_counts(self):
+        """:math:`\\left(5\\right)` :class:`numpy.ndarray`: The number of
+        particles identified as each structure, indexed like
+        :attr:`structure_names`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getStructureCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def __repr__(self):
+        return "freud.environment.{cls}(adaptive={adaptive})".format(
+            cls=type(self).__name__, adaptive=self.adaptive)
+
+
+cdef class NonaffineDisplacement(_PairCompute):
+    R"""Computes the nonaffine displacement :math:`D^2_{min}` of the
+    neighbors of each particle between two frames :cite:`Falk1998`.
+
+    The bonds :math:`\vec{d}^0_j` from a particle to its neighbors :math:`j`
+    in a reference frame are mapped to the bonds :math:`\vec{d}_j` between
+    the same particles in a current frame by the affine transformation
+    :math:`\mathbf{J}` that minimizes
+
+    .. math::
+
+        D^2 = \sum_j \left| \vec{d}_j - \mathbf{J} \vec{d}^0_j \right|^2,
+
+    which is :math:`\mathbf{J} = \mathbf{X} \mathbf{Y}^{-1}` with
+    :math:`\mathbf{X} = \sum_j \vec{d}_j \otimes \vec{d}^0_j` and
+    :math:`\mathbf{Y} = \sum_j \vec{d}^0_j \otimes \vec{d}^0_j`. The minimum
+    :math:`D^2_{min}` measures the nonaffine displacement of the neighbors,
+    and :math:`\mathbf{J} - \mathbf{I}` is the local strain.
+
+    Neighbors are found in the reference frame, and bonds are wrapped into the
+    box of their frame. In 2D systems only the :math:`xy` components of
+    :math:`\mathbf{J}` are fit. Particles whose reference bonds do not span
+    the space have :code:`nan` :math:`D^2_{min}` and strain.
+    """
+    cdef freud._environment.NonaffineDisplacement * thisptr
+
+    def __cinit__(self):
+        self.thisptr = new freud._environment.NonaffineDisplacement()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, reference_system, system, neighbors=None):
+        R"""Computes the nonaffine displacement of the neighbors of each
+        particle.
+
+        Args:
+            reference_system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`, with the
+                particles in the reference frame.
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`, with the
+                same particles in the current frame.
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs in the reference frame to use in the
+                calculation, or a dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+        """  # noqa: E501
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(reference_system, neighbors=neighbors)
+        cdef freud.locality.NeighborQuery current_nq = \
+            freud.locality.NeighborQuery.from_system(system)
+
+        self.thisptr.compute(nq.get_ptr(), current_nq.get_ptr(),
+                             nlist.get_ptr(), dereference(qargs.thisptr))
+        return self
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`freud.locality.NeighborList`: The neighbor list in the
+        reference frame from the last compute."""
+        return freud.locality._nlist_from_cnlist(self.thisptr.getNList())
+
+    @_Compute._computed_property
+    def d2min(self):
+        """:math:`\\left(N_{points}\\right)` :class:`numpy.ndarray`: The
+        nonaffine displacement :math:`D^2_{min}` of each particle."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getD2min(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def strain(self):
+        """:math:`\\left(N_{points}, 3, 3\\right)` :class:`numpy.ndarray`:
+        The local strain :math:`\\mathbf{J} - \\mathbf{I}` of each
+        particle."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getStrain(),
+            freud.util.arr_type_t.FLOAT)
+
+    def __repr__(self):
+        return "freud.environment.{cls}()".format(cls=type(self).__name__)
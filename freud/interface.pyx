@@ -8,7 +8,7 @@ between sets of points.
 
 import numpy as np
 
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _PairCompute
 import freud.locality
 
@@ -19,6 +19,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 cdef class Interface(_PairCompute):
     R"""Measures the interface between two sets of points."""
     cdef const unsigned int[::1] _point_ids
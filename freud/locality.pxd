@@ -7,6 +7,9 @@ cimport freud._locality
 cimport freud.box
 
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist)
+cdef NeighborList _managed_nlist_from_cnlist(
+    freud._locality.NeighborList *c_nlist)
+cdef freud._locality.BondMerge _bond_merge(mode) except *
 
 cdef class NeighborQueryResult:
     cdef NeighborQuery nq
@@ -35,6 +38,7 @@ cdef class NeighborQueryResult:
 cdef class NeighborQuery:
     cdef freud._locality.NeighborQuery * nqptr
     cdef const float[:, ::1] points
+    cdef object _point_buffer
     cdef freud._locality.NeighborQuery * get_ptr(self)
 
 cdef class NeighborList:
@@ -47,6 +51,9 @@ cdef class NeighborList:
 cdef class LinkCell(NeighborQuery):
     cdef freud._locality.LinkCell * thisptr
 
+cdef class AdaptiveCell(NeighborQuery):
+    cdef freud._locality.AdaptiveCell * thisptr
+
 cdef class AABBQuery(NeighborQuery):
     cdef freud._locality.AABBQuery * thisptr
 
@@ -73,3 +80,18 @@ cdef class Voronoi(_Compute):
     cdef freud._locality.Voronoi * thisptr
     cdef NeighborList _nlist
     cdef freud.box.Box _box
+
+cdef class BondChanges(_Compute):
+    cdef freud._locality.BondChanges * thisptr
+    cdef NeighborList _formed
+    cdef NeighborList _broken
+
+cdef class BondLifetime(_Compute):
+    cdef freud._locality.BondLifetime * thisptr
+
+cdef class PairKernel(_PairCompute):
+    cdef freud._locality.PairKernel * thisptr
+    cdef object _predicate
+    cdef object _kernel
+    cdef object _user_data
+    cdef list _libraries
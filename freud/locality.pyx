@@ -5,13 +5,16 @@ R"""
 The :mod:`freud.locality` module contains data structures to efficiently
 locate points based on their proximity to other points.
 """
+import ctypes
 import freud.util
 import inspect
+import numbers
 import numpy as np
 from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
 from libcpp cimport bool as cbool
-from freud.util cimport vec3, _Compute
+from freud.util cimport vec3, quat, _Compute, _share_simd_level
+from libc.stdint cimport uintptr_t
 from cython.operator cimport dereference
 from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
@@ -25,6 +28,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 cdef class _QueryArgs:
     R"""Container for query arguments.
 
@@ -198,6 +204,62 @@ cdef class NeighborQueryResult:
 
         raise StopIteration
 
+    def iter_chunks(self, unsigned int chunk_size=65536):
+        R"""Iterate over the query result in blocks of bonds.
+
+        Iterating over the bonds one at a time is dominated by the Python
+        overhead per bond. This generator instead yields the bonds in blocks
+        of NumPy arrays, which are filled in C++ without holding the GIL, and
+        finds the neighbors of batches of query points in parallel. The bonds
+        are yielded in the same order as in the :class:`~NeighborList` from
+        :meth:`~.toNeighborList`, so concatenating all blocks gives its
+        :code:`query_point_indices`, :code:`point_indices` and
+        :code:`distances`.
+
+        Args:
+            chunk_size (unsigned int):
+                Maximum number of bonds per block (Default value = 65536).
+
+        Yields:
+            tuple(:class:`numpy.ndarray`, :class:`numpy.ndarray`, :class:`numpy.ndarray`):
+                The query point indices, point indices and distances of the
+                next block of bonds. Only the last block is shorter than
+                :code:`chunk_size`.
+        """  # noqa: E501
+        if chunk_size == 0:
+            raise ValueError("The chunk size must be positive.")
+        if self.points.shape[0] == 0:
+            return
+
+        cdef const float[:, ::1] l_points = self.points
+        cdef shared_ptr[freud._locality.NeighborQueryIterator] iterator = \
+            self.nq.nqptr.query(
+                <vec3[float]*> &l_points[0, 0],
+                self.points.shape[0],
+                dereference(self.query_args.thisptr))
+        cdef freud._locality.NeighborQueryIterator *l_iterator = \
+            iterator.get()
+
+        cdef unsigned int[::1] l_query_point_indices
+        cdef unsigned int[::1] l_point_indices
+        cdef float[::1] l_distances
+        cdef unsigned int num_bonds = chunk_size
+        while num_bonds == chunk_size:
+            query_point_indices = np.empty(chunk_size, dtype=np.uint32)
+            point_indices = np.empty(chunk_size, dtype=np.uint32)
+            distances = np.empty(chunk_size, dtype=np.float32)
+            l_query_point_indices = query_point_indices
+            l_point_indices = point_indices
+            l_distances = distances
+            with nogil:
+                num_bonds = l_iterator.nextChunk(
+                    chunk_size, &l_query_point_indices[0],
+                    &l_point_indices[0], &l_distances[0])
+            if num_bonds == 0:
+                break
+            yield (query_point_indices[:num_bonds],
+                   point_indices[:num_bonds], distances[:num_bonds])
+
     def toNeighborList(self, sort_by_distance=False):
         """Convert query result to a freud :class:`~NeighborList`.
 
@@ -220,12 +282,7 @@ cdef class NeighborQueryResult:
 
         cdef freud._locality.NeighborList *cnlist = dereference(
             iterator).toNeighborList(sort_by_distance)
-        cdef NeighborList nl = _nlist_from_cnlist(cnlist)
-        # Explicitly manage a manually created nlist so that it will be
-        # deleted when the Python object is.
-        nl._managed = True
-
-        return nl
+        return _managed_nlist_from_cnlist(cnlist)
 
 
 cdef class NeighborQuery:
@@ -398,6 +455,153 @@ cdef class NeighborQuery:
         cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
         return NeighborQueryResult.init(self, query_points, args)
 
+    def _check_point_update(self, indices=None, positions=None):
+        """Check the arguments of an incremental update before any point
+        changes, and convert them to arrays."""
+        if self._point_buffer is None:
+            raise NotImplementedError(
+                "{} does not support incremental point updates.".format(
+                    type(self).__name__))
+        if indices is not None:
+            indices = freud.util._convert_array(
+                np.atleast_1d(indices), shape=(None,), dtype=np.uint32)
+            if len(indices) > 0 and indices.max() >= self.points.shape[0]:
+                raise ValueError(
+                    "Point indices must be less than the number of points.")
+            if len(np.unique(indices)) != len(indices):
+                raise ValueError("Point indices must be distinct.")
+        if positions is not None:
+            positions = freud.util._convert_array(
+                np.atleast_2d(positions),
+                shape=(None if indices is None else len(indices), 3))
+            if self.box.is2D and np.any(np.abs(positions[:, 2]) > 1e-6):
+                raise ValueError(
+                    "A point with z != 0 was provided in a 2D box.")
+        return indices, positions
+
+    def update_points(self, indices, positions, query_args=None):
+        R"""Move some of the points without rebuilding the data structure.
+
+        Only the parts of the data structure holding the moved points are
+        updated: :class:`~.LinkCell` relinks the moved points into their new
+        cells, and :class:`~.AABBQuery` recomputes the bounds of the leaves
+        holding them and of their ancestors (see the class documentation for
+        when the trees are rebuilt). Only :class:`~.LinkCell` and
+        :class:`~.AABBQuery` support incremental updates.
+
+        If query arguments are given, the bonds formed and broken by the move
+        are found by querying only the moved points before and after the move,
+        so the cost scales with the number of moved points. Only ball queries
+        are supported, because their bonds are symmetric. Both neighbor lists
+        are built on all points as query points and points, contain the bonds
+        of the moved points in both directions, and identify bonds by their
+        pair of indices like :class:`~.BondChanges`.
+
+        Args:
+            indices ((:math:`N_{moved}`) :class:`numpy.ndarray`):
+                Distinct indices of the points to move.
+            positions ((:math:`N_{moved}`, 3) :class:`numpy.ndarray`):
+                New positions of the points.
+            query_args (dict, optional):
+                Ball query arguments of the bonds whose changes to find, or
+                :code:`None` to only move the points
+                (Default value = :code:`None`).
+
+        Returns:
+            tuple of :class:`~.NeighborList`:
+                The bonds formed and broken by the move, with the distances
+                after and before the move respectively, if
+                :code:`query_args` is given. Otherwise :code:`None`.
+        """
+        indices, positions = self._check_point_update(indices, positions)
+        cdef const unsigned int[::1] l_indices = indices
+        cdef unsigned int num_indices = l_indices.shape[0]
+        cdef const unsigned int * indices_ptr = NULL
+        if num_indices > 0:
+            indices_ptr = &l_indices[0]
+
+        cdef freud._locality.MovedPointBondChanges changes
+        cdef _QueryArgs qargs
+        if query_args is not None:
+            qargs = _QueryArgs.from_dict(query_args)
+            changes.prepare(self.nqptr, indices_ptr, num_indices,
+                            dereference(qargs.thisptr))
+
+        self._point_buffer[indices] = positions
+        cdef const float[:, ::1] l_points = self.points
+        self.nqptr.updatePoints(<vec3[float]*> &l_points[0, 0], indices_ptr,
+                                num_indices)
+        if query_args is None:
+            return None
+
+        changes.compute(self.nqptr)
+        cdef NeighborList formed = NeighborList()
+        cdef NeighborList broken = NeighborList()
+        formed.thisptr.copy(dereference(changes.getFormedBonds().get()))
+        broken.thisptr.copy(dereference(changes.getBrokenBonds().get()))
+        return formed, broken
+
+    def insert_points(self, positions):
+        R"""Add points without rebuilding the data structure.
+
+        The new points are appended, so they get the indices following the
+        existing points. Only :class:`~.LinkCell` and :class:`~.AABBQuery`
+        support incremental updates.
+
+        Args:
+            positions ((:math:`N_{new}`, 3) :class:`numpy.ndarray`):
+                Positions of the new points.
+        """
+        _, positions = self._check_point_update(positions=positions)
+        cdef unsigned int num_points = self.points.shape[0]
+        cdef unsigned int new_num_points = num_points + positions.shape[0]
+
+        # The points are stored in a buffer that grows geometrically, so that
+        # inserting a point takes amortized constant time.
+        if new_num_points > self._point_buffer.shape[0]:
+            buffer = np.empty(
+                (max(new_num_points, 2 * self._point_buffer.shape[0]), 3),
+                dtype=np.float32)
+            buffer[:num_points] = self._point_buffer[:num_points]
+            self._point_buffer = buffer
+        self._point_buffer[num_points:new_num_points] = positions
+        self.points = self._point_buffer[:new_num_points]
+
+        cdef const float[:, ::1] l_points = self.points
+        self.nqptr.insertPoints(<vec3[float]*> &l_points[0, 0],
+                                new_num_points)
+
+    def remove_points(self, indices):
+        R"""Remove points without rebuilding the data structure.
+
+        The removed indices are visited in decreasing order and the last point
+        is moved into the slot of each removed point, so the indices of the
+        points that are not removed only change for points moved from the
+        end. Only :class:`~.LinkCell` and :class:`~.AABBQuery` support
+        incremental updates.
+
+        Args:
+            indices ((:math:`N_{removed}`) :class:`numpy.ndarray`):
+                Distinct indices of the points to remove.
+        """
+        indices, _ = self._check_point_update(indices)
+        cdef const unsigned int[::1] l_indices = indices
+        cdef unsigned int num_indices = l_indices.shape[0]
+        cdef unsigned int num_points = self.points.shape[0]
+        if num_indices == 0:
+            return
+        if num_indices >= num_points:
+            raise ValueError("Cannot remove all points.")
+
+        for i in np.sort(indices)[::-1]:
+            num_points -= 1
+            self._point_buffer[i] = self._point_buffer[num_points]
+        self.points = self._point_buffer[:num_points]
+
+        cdef const float[:, ::1] l_points = self.points
+        self.nqptr.removePoints(<vec3[float]*> &l_points[0, 0], num_points,
+                                &l_indices[0], num_indices)
+
     cdef freud._locality.NeighborQuery * get_ptr(self):
         R"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.nqptr
@@ -682,6 +886,151 @@ cdef class NeighborList:
         self.thisptr.filter_r(r_max, r_min)
         return self
 
+    def symmetrize(self, distance_merge='first', weight_merge='first'):
+        R"""Create a symmetric neighbor list containing every bond of this
+        neighbor list and its reverse.
+
+        The neighbor list must be built on a set of points and itself, e.g.
+        from a nearest neighbor query, whose bonds are generally not
+        symmetric. A bond :math:`\left(i, j\right)` whose reverse
+        :math:`\left(j, i\right)` is also present is merged with it.
+
+        Args:
+            distance_merge (str, optional):
+                How the distances of a bond and its reverse are combined, one
+                of :code:`'first'` (the bond), :code:`'second'` (the reverse),
+                :code:`'min'`, :code:`'max'`, :code:`'sum'` or :code:`'mean'`
+                (Default value = :code:`'first'`).
+            weight_merge (str, optional):
+                How the weights of a bond and its reverse are combined, with
+                the same options as :code:`distance_merge` (Default value =
+                :code:`'first'`).
+
+        Returns:
+            :class:`freud.locality.NeighborList`: A new neighbor list.
+        """
+        cdef freud._locality.BondMerge c_distance_merge = _bond_merge(
+            distance_merge)
+        cdef freud._locality.BondMerge c_weight_merge = _bond_merge(
+            weight_merge)
+        return _managed_nlist_from_cnlist(
+            freud._locality.symmetrizeNeighborList(
+                self.thisptr, c_distance_merge, c_weight_merge))
+
+    def union(self, NeighborList other, distance_merge='first',
+              weight_merge='first'):
+        R"""Create a neighbor list with the bonds present in this or another
+        neighbor list.
+
+        Both neighbor lists must be built on the same query points and
+        points. The bonds of each query point are combined with a parallel
+        merge, and the result is sorted by query point and point index. Pairs
+        that appear several times are matched one to one, so a pair that
+        appears twice in one neighbor list and once in the other appears
+        twice in the result.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The other neighbor list.
+            distance_merge (str, optional):
+                How the distances of bonds present in both neighbor lists are
+                combined, one of :code:`'first'` (this neighbor list),
+                :code:`'second'` (the other neighbor list), :code:`'min'`,
+                :code:`'max'`, :code:`'sum'` or :code:`'mean'` (Default value
+                = :code:`'first'`).
+            weight_merge (str, optional):
+                How the weights of bonds present in both neighbor lists are
+                combined, with the same options as :code:`distance_merge`
+                (Default value = :code:`'first'`).
+
+        Returns:
+            :class:`freud.locality.NeighborList`: A new neighbor list.
+        """
+        cdef freud._locality.BondMerge c_distance_merge = _bond_merge(
+            distance_merge)
+        cdef freud._locality.BondMerge c_weight_merge = _bond_merge(
+            weight_merge)
+        return _managed_nlist_from_cnlist(
+            freud._locality.neighborListUnion(
+                self.thisptr, other.thisptr, c_distance_merge,
+                c_weight_merge))
+
+    def intersection(self, NeighborList other, distance_merge='first',
+                     weight_merge='first'):
+        R"""Create a neighbor list with the bonds present in both this and
+        another neighbor list.
+
+        See :meth:`union` for the requirements on the neighbor lists and the
+        arguments.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The other neighbor list.
+            distance_merge (str, optional):
+                How the distances of the bonds are combined (Default value =
+                :code:`'first'`).
+            weight_merge (str, optional):
+                How the weights of the bonds are combined (Default value =
+                :code:`'first'`).
+
+        Returns:
+            :class:`freud.locality.NeighborList`: A new neighbor list.
+        """
+        cdef freud._locality.BondMerge c_distance_merge = _bond_merge(
+            distance_merge)
+        cdef freud._locality.BondMerge c_weight_merge = _bond_merge(
+            weight_merge)
+        return _managed_nlist_from_cnlist(
+            freud._locality.neighborListIntersection(
+                self.thisptr, other.thisptr, c_distance_merge,
+                c_weight_merge))
+
+    def difference(self, NeighborList other):
+        R"""Create a neighbor list with the bonds of this neighbor list that
+        are not present in another neighbor list.
+
+        See :meth:`union` for the requirements on the neighbor lists.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The other neighbor list.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: A new neighbor list.
+        """
+        return _managed_nlist_from_cnlist(
+            freud._locality.neighborListDifference(
+                self.thisptr, other.thisptr))
+
+
+cdef freud._locality.BondMerge _bond_merge(mode) except *:
+    """Convert the name of a way to merge bond values to the C++ enum."""
+    if mode == 'first':
+        return freud._locality.BOND_MERGE_FIRST
+    elif mode == 'second':
+        return freud._locality.BOND_MERGE_SECOND
+    elif mode == 'min':
+        return freud._locality.BOND_MERGE_MIN
+    elif mode == 'max':
+        return freud._locality.BOND_MERGE_MAX
+    elif mode == 'sum':
+        return freud._locality.BOND_MERGE_SUM
+    elif mode == 'mean':
+        return freud._locality.BOND_MERGE_MEAN
+    raise ValueError(
+        "Bond values must be merged with one of 'first', 'second', 'min', "
+        "'max', 'sum' or 'mean', not {}.".format(repr(mode)))
+
+
+cdef NeighborList _managed_nlist_from_cnlist(
+        freud._locality.NeighborList *c_nlist):
+    """Create a Python NeighborList object that takes ownership of a newly
+    created C++ NeighborList object."""
+    cdef NeighborList nl = _nlist_from_cnlist(c_nlist)
+    # Explicitly manage a manually created nlist so that it will be deleted
+    # when the Python object is.
+    nl._managed = True
+    return nl
 
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     """Create a Python NeighborList object that points to an existing C++
@@ -805,26 +1154,39 @@ cdef class AABBQuery(NeighborQuery):
             Simulation box.
         points ((:math:`N`, 3) :class:`numpy.ndarray`):
             The points to use to build the tree.
+        wide_tree (bool, optional):
+            Whether to collapse the binary tree into a 4-wide (8-wide when
+            compiled with AVX) tree whose child bounds are tested at once
+            when neighbors are found point by point. Ball queries of many
+            query points always traverse the binary tree, so disabling the
+            wide tree saves its build and update time when only those are
+            used (Default value = True).
     """
 
-    def __cinit__(self, box, points):
+    def __cinit__(self, box, points, wide_tree=True):
         cdef const float[:, ::1] l_points
         cdef freud.box.Box b
         if type(self) is AABBQuery:
             # Assume valid set of arguments is passed
             b = freud.util._convert_box(box)
-            self.points = freud.util._convert_array(
+            self._point_buffer = freud.util._convert_array(
                 points, shape=(None, 3)).copy()
+            self.points = self._point_buffer
             l_points = self.points
             self.thisptr = self.nqptr = new freud._locality.AABBQuery(
                 dereference(b.thisptr),
                 <vec3[float]*> &l_points[0, 0],
-                self.points.shape[0])
+                self.points.shape[0], wide_tree)
 
     def __dealloc__(self):
         if type(self) is AABBQuery:
             del self.thisptr
 
+    @property
+    def wide_tree(self):
+        """bool: Whether single points are queried with the wide tree."""
+        return self.thisptr.usesWideTree()
+
 
 cdef class LinkCell(NeighborQuery):
     R"""Supports efficiently finding all points in a set within a certain
@@ -846,8 +1208,9 @@ cdef class LinkCell(NeighborQuery):
     def __cinit__(self, box, points, cell_width=0):
         cdef freud.box.Box b = freud.util._convert_box(box)
         cdef const float[:, ::1] l_points
-        self.points = freud.util._convert_array(
+        self._point_buffer = freud.util._convert_array(
             points, shape=(None, 3)).copy()
+        self.points = self._point_buffer
         l_points = self.points
         self.thisptr = self.nqptr = new freud._locality.LinkCell(
             dereference(b.thisptr),
@@ -863,6 +1226,69 @@ cdef class LinkCell(NeighborQuery):
         return self.thisptr.getCellWidth()
 
 
+cdef class AdaptiveCell(NeighborQuery):
+    R"""Use a multilevel cell grid that adapts to the local density of the
+    points to find neighbors.
+
+    The points are binned into a coarse grid of cells, and every cell holding
+    more than :code:`max_points_per_cell` points is recursively split into 4
+    (2D) or 8 (3D) equal subcells. Unlike :class:`~.LinkCell`, whose single
+    cell width can only suit one density, this structure stays efficient in
+    systems with strongly varying density, such as coexisting liquid and vapor
+    phases or sedimented suspensions.
+
+    Args:
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points ((:math:`N`, 3) :class:`numpy.ndarray`):
+            The points to bin into the cells.
+        cell_width (float, optional):
+            Width of the cells of the coarse grid. If not provided, a width
+            is estimated such that a cell holds :code:`max_points_per_cell`
+            points at the mean density of the points (Default value = 0).
+        max_points_per_cell (int, optional):
+            Cells holding more points than this are subdivided
+            (Default value = 16).
+    """
+
+    def __cinit__(self, box, points, cell_width=0, max_points_per_cell=16):
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        cdef const float[:, ::1] l_points
+        self.points = freud.util._convert_array(
+            points, shape=(None, 3)).copy()
+        l_points = self.points
+        self.thisptr = self.nqptr = new freud._locality.AdaptiveCell(
+            dereference(b.thisptr),
+            <vec3[float]*> &l_points[0, 0],
+            self.points.shape[0], cell_width, max_points_per_cell)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def cell_width(self):
+        """float: Width of the cells of the coarse grid."""
+        return self.thisptr.getCellWidth()
+
+    @property
+    def cell_dimensions(self):
+        """tuple[int]: The number of cells of the coarse grid along each
+        lattice vector."""
+        cdef vec3[unsigned int] dims = self.thisptr.getCellDimensions()
+        return (dims.x, dims.y, dims.z)
+
+    @property
+    def max_points_per_cell(self):
+        """int: Number of points above which cells are subdivided."""
+        return self.thisptr.getMaxPointsPerCell()
+
+    @property
+    def num_levels(self):
+        """int: Number of levels of the cell hierarchy, including the coarse
+        grid."""
+        return self.thisptr.getNumLevels()
+
+
 cdef class _PairCompute(_Compute):
     R"""Parent class for all compute classes in freud that depend on finding
     nearest neighbors.
@@ -1241,3 +1667,401 @@ cdef class Voronoi(_Compute):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class BondChanges(_Compute):
+    R"""Finds the bonds that are formed and broken between two neighbor lists.
+
+    Both neighbor lists must be built on the same query points and points,
+    for example the neighbor lists of two frames of a trajectory. The bonds of
+    each query point are compared in parallel using a merge join over the
+    point indices, which is linear in the number of bonds for neighbor lists
+    generated by freud (the bonds of each query point are sorted by point
+    index). Bonds are identified by their pair of indices only, so a bond
+    whose distance changes between the neighbor lists is not reported.
+
+    Pairs of points that appear several times in a neighbor list (e.g. bonds
+    to multiple periodic images in small boxes) are matched one to one.
+    """
+
+    def __cinit__(self):
+        self.thisptr = new freud._locality.BondChanges()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, NeighborList old_nlist, NeighborList new_nlist):
+        R"""Find the bonds that differ between two neighbor lists.
+
+        Args:
+            old_nlist (:class:`~.locality.NeighborList`):
+                Neighbor list before the change.
+            new_nlist (:class:`~.locality.NeighborList`):
+                Neighbor list after the change.
+        """
+        self.thisptr.compute(old_nlist.get_ptr(), new_nlist.get_ptr())
+        return self
+
+    @_Compute._computed_property
+    def formed(self):
+        R""":class:`~.locality.NeighborList`: The bonds of the new neighbor
+        list that are not in the old neighbor list, with the distances and
+        weights of the new neighbor list."""
+        self._formed = _nlist_from_cnlist(
+            self.thisptr.getFormedBonds().get())
+        return self._formed
+
+    @_Compute._computed_property
+    def broken(self):
+        R""":class:`~.locality.NeighborList`: The bonds of the old neighbor
+        list that are not in the new neighbor list, with the distances and
+        weights of the old neighbor list."""
+        self._broken = _nlist_from_cnlist(
+            self.thisptr.getBrokenBonds().get())
+        return self._broken
+
+    def __repr__(self):
+        return "freud.locality.{cls}()".format(
+            cls=type(self).__name__)
+
+    def __str__(self):
+        return repr(self)
+
+
+cdef class BondLifetime(_Compute):
+    R"""Tracks the lifetimes of bonds over a sequence of neighbor lists.
+
+    Each call to :meth:`compute` adds a frame. A bond that is present in
+    frames :math:`f, \ldots, g - 1` and absent in frame :math:`g` has a
+    lifetime of :math:`g - f` frames, which is added to a histogram of
+    lifetimes when the bond breaks. Bonds are matched between frames as in
+    :class:`~.BondChanges`. Bonds that are present in the last frame have not
+    completed their lifetime and are not part of the histogram.
+
+    Only the bonds of the last frame are stored, so the memory used does not
+    grow with the number of frames.
+    """
+
+    def __cinit__(self):
+        self.thisptr = new freud._locality.BondLifetime()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, NeighborList nlist, reset=False):
+        R"""Add the bonds of a frame.
+
+        Args:
+            nlist (:class:`~.locality.NeighborList`):
+                Neighbor list of the frame. All frames must be built on the
+                same query points and points.
+            reset (bool):
+                Whether to forget the tracked bonds and the histogram of
+                lifetimes before adding the frame. Unlike most computes, the
+                default is to accumulate, since lifetimes span several calls
+                (Default value = :code:`False`).
+        """
+        if reset:
+            self._reset()
+        self.thisptr.compute(nlist.get_ptr())
+        return self
+
+    def _reset(self):
+        self.thisptr.reset()
+
+    @_Compute._computed_property
+    def num_frames(self):
+        """unsigned int: The number of frames added since the last reset."""
+        return self.thisptr.getNumFrames()
+
+    @_Compute._computed_property
+    def num_bonds(self):
+        """unsigned int: The number of bonds present in the last frame."""
+        return self.thisptr.getNumBonds()
+
+    @_Compute._computed_property
+    def lifetime_histogram(self):
+        """:math:`\\left(N_{frames}, \\right)` :class:`numpy.ndarray`: The
+        number of broken bonds with each lifetime, indexed by the lifetime in
+        frames."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLifetimeHistogram(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def survival(self):
+        """:math:`\\left(N_{frames}, \\right)` :class:`numpy.ndarray`: The
+        fraction of broken bonds whose lifetime is at least the index in
+        frames. This is zero if no bonds have broken."""
+        histogram = np.asarray(self.lifetime_histogram, dtype=np.float64)
+        total = np.sum(histogram)
+        if total == 0:
+            return np.zeros_like(histogram)
+        return np.cumsum(histogram[::-1])[::-1] / total
+
+    def __repr__(self):
+        return "freud.locality.{cls}()".format(
+            cls=type(self).__name__)
+
+    def __str__(self):
+        return repr(self)
+
+
+def _function_address(func, libraries):
+    """Get the address of a compiled C function.
+
+    Args:
+        func:
+            :code:`None`, an integer address, an object with an
+            :code:`address` attribute (e.g. a Numba :code:`cfunc`), a
+            :mod:`ctypes` function pointer, or a tuple
+            :code:`(library_path, symbol_name)` of a function in a shared
+            library.
+        libraries (list):
+            Loaded shared libraries are appended to this list, so that they
+            stay loaded while the function is used.
+
+    Returns:
+        int: The address of the function, 0 for :code:`None`.
+    """
+    if func is None:
+        return 0
+    if isinstance(func, tuple):
+        library_path, symbol_name = func
+        library = ctypes.CDLL(library_path)
+        libraries.append(library)
+        func = getattr(library, symbol_name)
+    if isinstance(func, numbers.Integral):
+        return int(func)
+    if hasattr(func, 'address'):
+        return int(func.address)
+    if isinstance(func, ctypes._CFuncPtr):
+        return ctypes.cast(func, ctypes.c_void_p).value
+    raise TypeError('Compiled functions must be given as an address, an '
+                    'object with an address attribute, a ctypes function '
+                    'pointer, or a (library_path, symbol_name) tuple.')
+
+
+def _data_address(data):
+    """Get the address of the data passed to compiled functions.
+
+    Args:
+        data:
+            :code:`None`, an integer address, a :class:`numpy.ndarray` or a
+            :mod:`ctypes` object.
+
+    Returns:
+        int: The address of the data, 0 for :code:`None`.
+    """
+    if data is None:
+        return 0
+    if isinstance(data, numbers.Integral):
+        return int(data)
+    if isinstance(data, np.ndarray):
+        return data.ctypes.data
+    return ctypes.addressof(data)
+
+
+cdef class PairKernel(_PairCompute):
+    R"""Applies compiled predicates and kernels to bonds while they are found.
+
+    Custom pair criteria, like orientation dependent patches or the angle
+    cutoffs of hydrogen bonds, and custom per-point reductions can be applied
+    during the neighbor search instead of filtering a complete
+    :class:`~.locality.NeighborList` in NumPy. The predicate and kernel are
+    compiled C functions, which may be given as a Numba :code:`cfunc`, a
+    :mod:`ctypes` function pointer, a :code:`(library_path, symbol_name)`
+    tuple of a function in a shared library, or an integer address. They are
+    called from multiple threads concurrently and must be thread safe.
+
+    The functions have the C signatures
+
+    .. code-block:: c
+
+        int predicate(const FreudPairSystem* system, const FreudBond* bond);
+        void kernel(const FreudPairSystem* system, const FreudBond* bond,
+                    double* output);
+
+    with the structs
+
+    .. code-block:: c
+
+        struct FreudBond {
+            unsigned int query_point_idx;
+            unsigned int point_idx;
+            float distance;
+            float weight;
+            float delta[3];  // point image - query_point
+        };
+
+        struct FreudPairSystem {
+            const float* points;              // (N_points, 3)
+            const float* query_points;        // (N_query_points, 3)
+            const float* orientations;        // (N_points, 4) or NULL
+            const float* query_orientations;  // (N_query_points, 4) or NULL
+            unsigned int n_points;
+            unsigned int n_query_points;
+            float box_matrix[9];              // row-major box matrix
+            void* user_data;
+        };
+
+    The :code:`delta` of a bond points from the query point to the periodic
+    image of the point that the bond was found through. This is the minimum
+    image unless :code:`r_max` exceeds half of the box, in which case a ball
+    query returns one bond per image, each with the vector of its own image.
+    A :class:`freud.locality.NeighborList` does not record the images of its
+    bonds, so the bonds of a neighbor list use the minimum image.
+
+    The predicate returns nonzero to accept a bond. The kernel is called for
+    each accepted bond and adds its contribution to the :code:`num_outputs`
+    values pointed to by :code:`output`, which belong to the query point of
+    the bond. The outputs of all threads are summed into :attr:`output`.
+
+    Args:
+        predicate (optional):
+            Compiled predicate, or :code:`None` to accept all bonds
+            (Default value = :code:`None`).
+        kernel (optional):
+            Compiled kernel applied to accepted bonds, or :code:`None`
+            (Default value = :code:`None`).
+        num_outputs (unsigned int, optional):
+            Number of values computed per query point by the kernel
+            (Default value = 0).
+        store_bonds (bool, optional):
+            Whether to store the accepted bonds in :attr:`nlist`. If
+            :code:`None`, the bonds are stored if no kernel is given
+            (Default value = :code:`None`).
+    """  # noqa: E501
+
+    def __cinit__(self, predicate=None, kernel=None, num_outputs=0,
+                  store_bonds=None):
+        if kernel is None and num_outputs != 0:
+            raise ValueError('num_outputs requires a kernel.')
+        if store_bonds is None:
+            store_bonds = kernel is None
+        self._libraries = []
+        self._predicate = predicate
+        self._kernel = kernel
+        cdef uintptr_t predicate_address = _function_address(
+            predicate, self._libraries)
+        cdef uintptr_t kernel_address = _function_address(
+            kernel, self._libraries)
+        self.thisptr = new freud._locality.PairKernel(
+            <freud._locality.FreudBondPredicate> predicate_address,
+            <freud._locality.FreudBondKernel> kernel_address,
+            num_outputs, store_bonds)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, orientations=None, query_points=None,
+                query_orientations=None, neighbors=None, user_data=None):
+        R"""Applies the predicate and kernel to the bonds of the system.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            orientations ((:math:`N_{points}`, 4) :class:`numpy.ndarray`, optional):
+                Orientations of the points passed to the compiled functions
+                (Default value = :code:`None`).
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to find bonds. Uses the system's points if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations ((:math:`N_{query\_points}`, 4) :class:`numpy.ndarray`, optional):
+                Orientations of the query points. Uses :code:`orientations` if
+                :code:`None` and :code:`query_points` is :code:`None`
+                (Default value = :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            user_data (optional):
+                Data passed to the compiled functions as
+                :code:`system->user_data`, given as a :class:`numpy.ndarray`,
+                a :mod:`ctypes` object or an integer address
+                (Default value = :code:`None`).
+        """  # noqa: E501
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+            const float[:, ::1] l_orientations
+            const float[:, ::1] l_query_orientations
+            const quat[float]* orientations_ptr = NULL
+            const quat[float]* query_orientations_ptr = NULL
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        if query_orientations is None and query_points is None:
+            query_orientations = orientations
+        if orientations is not None:
+            orientations = freud.util._convert_array(
+                orientations, shape=(nq.points.shape[0], 4))
+            l_orientations = orientations
+            orientations_ptr = <quat[float]*> &l_orientations[0, 0]
+        if query_orientations is not None:
+            query_orientations = freud.util._convert_array(
+                query_orientations, shape=(num_query_points, 4))
+            l_query_orientations = query_orientations
+            query_orientations_ptr = \
+                <quat[float]*> &l_query_orientations[0, 0]
+
+        # Keep the data alive while the compiled functions may access it.
+        self._user_data = user_data
+        cdef uintptr_t user_data_address = _data_address(user_data)
+
+        cdef freud._locality.NeighborQuery* nq_ptr = nq.get_ptr()
+        cdef freud._locality.NeighborList* nlist_ptr = nlist.get_ptr()
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+
+        # The GIL is released so that compiled functions that call back into
+        # Python (e.g. ctypes callbacks) can acquire it from worker threads.
+        with nogil:
+            self.thisptr.compute(
+                nq_ptr, orientations_ptr, <vec3[float]*> &l_query_points[0, 0],
+                query_orientations_ptr, num_query_points, nlist_ptr, c_qargs,
+                <void*> user_data_address)
+        return self
+
+    @_Compute._computed_property
+    def output(self):
+        """:math:`\\left(N_{query\\_points}, N_{outputs}\\right)`
+        :class:`numpy.ndarray`: The sums of the kernel outputs of the
+        accepted bonds of each query point."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getOutput(),
+            freud.util.arr_type_t.DOUBLE)
+
+    @_Compute._computed_property
+    def num_accepted_bonds(self):
+        """unsigned int: The number of bonds accepted by the predicate."""
+        return self.thisptr.getNumAcceptedBonds()
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`freud.locality.NeighborList`: The bonds accepted by the
+        predicate, sorted by query point index. Only available if
+        :code:`store_bonds` is :code:`True`."""
+        if not self.thisptr.getStoreBonds():
+            raise AttributeError(
+                'The accepted bonds are only stored if store_bonds is True.')
+        return _nlist_from_cnlist(self.thisptr.getNeighborList().get())
+
+    def __repr__(self):
+        return ("freud.locality.{cls}(predicate={predicate}, "
+                "kernel={kernel}, num_outputs={num_outputs}, "
+                "store_bonds={store_bonds})").format(
+                    cls=type(self).__name__,
+                    predicate=repr(self._predicate),
+                    kernel=repr(self._kernel),
+                    num_outputs=self.thisptr.getNumOutputs(),
+                    store_bonds=self.thisptr.getStoreBonds())
+
+    def __str__(self):
+        return repr(self)
@@ -10,11 +10,14 @@ import numpy as np
 import freud.parallel
 import logging
 
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 cimport freud.box
 cimport numpy as np
 
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 logger = logging.getLogger(__name__)
 
 # Use fastest available fft library
@@ -15,7 +15,7 @@ import time
 import freud.locality
 import logging
 
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _PairCompute
 from freud.util cimport vec3, quat
 from cython.operator cimport dereference
@@ -31,6 +31,9 @@ logger = logging.getLogger(__name__)
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 cdef class Cubatic(_Compute):
     R"""Compute the cubatic order parameter :cite:`Haji_Akbari_2015` for a system of
     particles using simulated annealing instead of Newton-Raphson root finding.
@@ -5,12 +5,26 @@ R"""
 The :class:`freud.parallel` module controls the parallelization behavior of
 freud, determining how many threads the TBB-enabled parts of freud will use.
 freud uses all available threads for parallelization unless directed otherwise.
+
+The module also controls the instruction sets used by the vectorized kernels
+of freud. By default, the widest instruction set supported by the CPU is used.
 """
 
+from cpython.pycapsule cimport PyCapsule_New
+
 cimport freud._parallel
+cimport freud._util
 
 _num_threads = 0
 
+_SIMD_LEVELS = ('none', 'avx2', 'avx512')
+
+# The other extension modules are separate libraries, so they use the storage
+# of the SIMD level of this module, shared through this capsule on import.
+_simd_level_storage = PyCapsule_New(
+    freud._util.getSIMDLevelStorageAddress(),
+    "freud.parallel._simd_level_storage", NULL)
+
 
 def get_num_threads():
     R"""Get the number of threads for parallel computation.
@@ -60,3 +74,72 @@ class NumThreads:
 
     def __exit__(self, *args):
         set_num_threads(self.restore_N)
+
+
+def get_simd_level():
+    R"""Get the SIMD instruction set used by vectorized kernels.
+
+    Returns:
+        str: One of :code:`'none'`, :code:`'avx2'` or :code:`'avx512'`.
+    """
+    return freud._util.getSIMDLevelName(
+        freud._util.getSIMDLevel()).decode()
+
+
+def get_supported_simd_level():
+    R"""Get the widest SIMD instruction set supported by the CPU.
+
+    Returns:
+        str: One of :code:`'none'`, :code:`'avx2'` or :code:`'avx512'`.
+    """
+    return freud._util.getSIMDLevelName(
+        freud._util.getSupportedSIMDLevel()).decode()
+
+
+def set_simd_level(level=None):
+    R"""Set the SIMD instruction set used by vectorized kernels.
+
+    All instruction sets give the same results up to floating point rounding,
+    so this is mostly useful for testing and benchmarking. Levels wider than
+    the one supported by the CPU are capped to the supported level. The
+    initial level may be set with the :code:`FREUD_SIMD` environment variable
+    before freud is loaded.
+
+    Args:
+        level (str, optional):
+            One of :code:`'none'`, :code:`'avx2'` or :code:`'avx512'`. If
+            :code:`None`, use the widest instruction set supported by the CPU
+            (Default value = :code:`None`).
+    """
+    if level is None:
+        level = get_supported_simd_level()
+    if level not in _SIMD_LEVELS:
+        raise ValueError("The SIMD level must be one of {}.".format(
+            ', '.join(_SIMD_LEVELS)))
+    cdef freud._util.SIMDLevel c_level = freud._util.SIMD_NONE
+    if level == 'avx2':
+        c_level = freud._util.SIMD_AVX2
+    elif level == 'avx512':
+        c_level = freud._util.SIMD_AVX512
+    freud._util.setSIMDLevel(c_level)
+
+
+class SIMDLevel:
+    R"""Context manager for managing the SIMD instruction set to use.
+
+    Args:
+        level (str, optional): SIMD level to use in this context, see
+            :func:`set_simd_level`. If :code:`None`, use the widest instruction
+            set supported by the CPU (Default value = :code:`None`).
+    """
+
+    def __init__(self, level=None):
+        self.restore_level = get_simd_level()
+        self.level = level
+
+    def __enter__(self):
+        set_simd_level(self.level)
+        return self
+
+    def __exit__(self, *args):
+        set_simd_level(self.restore_level)
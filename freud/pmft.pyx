@@ -42,7 +42,7 @@ import numpy as np
 import freud.locality
 import rowan
 
-from freud.util cimport _Compute
+from freud.util cimport _Compute, _share_simd_level
 from freud.locality cimport _SpatialHistogram
 from freud.util cimport vec3, quat
 from cython.operator cimport dereference
@@ -57,6 +57,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 
 def _quat_to_z_angle(orientations, num_points):
     """If orientations are quaternions, convert them to angles.
@@ -530,7 +533,8 @@ cdef class PMFTXYZ(_PMFT):
             del self.pmftxyzptr
 
     def compute(self, system, query_orientations, query_points=None,
-                equiv_orientations=None, neighbors=None, reset=True):
+                equiv_orientations=None, neighbors=None, reset=True,
+                fold_symmetry=False):
         R"""Calculates the PMFT.
 
         .. note::
@@ -540,6 +544,18 @@ cdef class PMFTXYZ(_PMFT):
             ``query_points`` (which are equal to the system points if no
             ``query_points`` are explicitly provided.
 
+        .. note::
+            Binning every bond once for each of the ``equiv_orientations``
+            multiplies the cost of the calculation by their number. If the
+            ``equiv_orientations`` form a point group of rotations that map
+            the coordinate axes onto each other, such as the 24 rotations of a
+            cube, setting ``fold_symmetry=True`` instead folds each bond into
+            a fundamental domain of the group and bins it once, and the
+            histogram is unfolded by the group when the results are read. The
+            results are the same up to bonds that lie on bin edges. The
+            maximum distance and number of bins must be the same along axes
+            that the group permutes.
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -569,6 +585,10 @@ cdef class PMFTXYZ(_PMFT):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            fold_symmetry (bool):
+                Whether to fold bonds by the point group formed by the
+                ``equiv_orientations`` instead of binning them once for each
+                equivalent orientation (Default value: False).
         """  # noqa: E501
         if reset:
             self._reset()
@@ -606,7 +626,7 @@ cdef class PMFTXYZ(_PMFT):
             num_query_points,
             <quat[float]*> &l_equiv_orientations[0, 0],
             num_equiv_orientations, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+            dereference(qargs.thisptr), fold_symmetry)
         return self
 
     def __repr__(self):
@@ -7,10 +7,12 @@ import numpy as np
 
 from freud._util cimport vec3, quat, ManagedArray, PyArray_SetBaseObject
 from cpython cimport Py_INCREF
+from cpython.pycapsule cimport PyCapsule_GetPointer
 from libcpp.complex cimport complex
 from cython.operator cimport dereference
 from libcpp cimport bool
 
+cimport freud._util
 cimport numpy as np
 
 ctypedef unsigned int uint
@@ -92,5 +94,14 @@ cdef inline make_managed_numpy_array(
         _ManagedArrayContainer.init(array, arr_type, element_size))
 
 
+cdef inline _share_simd_level():
+    """Make the vectorized kernels of the calling module use the SIMD level
+    stored by :mod:`freud.parallel`, since each module is a separate library
+    with its own copy of the level."""
+    from freud.parallel import _simd_level_storage
+    freud._util.shareSIMDLevelStorage(PyCapsule_GetPointer(
+        _simd_level_storage, "freud.parallel._simd_level_storage"))
+
+
 cdef class _Compute:
     cdef public bool _called_compute
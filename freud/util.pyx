@@ -12,6 +12,9 @@ cimport numpy as np
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The vectorized kernels of this module use the SIMD level of freud.parallel.
+_share_simd_level()
+
 
 cdef class _ManagedArrayContainer:
     """Class responsible for synchronizing ownership between two ManagedArray
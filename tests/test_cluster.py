@@ -100,6 +100,48 @@ class TestCluster(unittest.TestCase):
         npt.assert_allclose(
             props.radii_of_gyration, [0, rg_2], rtol=1e-5, atol=1e-5)
 
+    def test_cluster_props_gyration_eigen(self):
+        """Test the eigen-decomposition of the gyration tensors"""
+        box, positions = freud.data.make_random_system(10, 200, seed=0)
+        cluster_idx = np.arange(len(positions)) % 7
+        props = freud.cluster.ClusterProperties()
+        props.compute((box, positions), cluster_idx)
+
+        eigenvalues = props.gyration_eigenvalues
+        eigenvectors = props.gyration_eigenvectors
+        self.assertEqual(eigenvalues.shape, (7, 3))
+        self.assertEqual(eigenvectors.shape, (7, 3, 3))
+        for gyration, vals, vecs in zip(
+                props.gyrations, eigenvalues, eigenvectors):
+            expected_vals, expected_vecs = np.linalg.eigh(gyration)
+            npt.assert_allclose(vals, expected_vals, rtol=1e-4, atol=1e-4)
+            # Eigenvectors are rows, unique up to sign.
+            npt.assert_allclose(
+                np.abs(np.sum(vecs * expected_vecs.T, axis=-1)), 1,
+                atol=1e-4)
+            npt.assert_allclose(
+                vecs.T @ np.diag(vals) @ vecs, gyration, atol=1e-4)
+            largest = np.argmax(np.abs(vecs), axis=-1)
+            self.assertTrue(np.all(vecs[np.arange(3), largest] > 0))
+
+    def test_cluster_props_gyration_eigen_degenerate(self):
+        """Test principal axes of clusters with repeated moments"""
+        box = freud.box.Box.cube(L=10)
+        positions = np.array([[1, 0, 0], [-1, 0, 0],
+                              [0, 1, 0], [0, -1, 0],
+                              [0, 0, 1], [0, 0, -1],
+                              [2, 2, 2], [2, 2, 4]], dtype=np.float32)
+        cluster_idx = [0, 0, 0, 0, 0, 0, 1, 1]
+        props = freud.cluster.ClusterProperties()
+        props.compute((box, positions), cluster_idx)
+
+        npt.assert_allclose(
+            props.gyration_eigenvalues, [[1 / 3] * 3, [0, 0, 1]], atol=1e-6)
+        npt.assert_allclose(
+            props.gyration_eigenvectors[0], np.eye(3), atol=1e-6)
+        npt.assert_allclose(
+            props.gyration_eigenvectors[1, 2], [0, 0, 1], atol=1e-6)
+
     def test_cluster_com_periodic(self):
         "Tests center of mass for symmetric, box-spanning clusters."
         box = freud.Box.cube(3)
@@ -148,9 +190,83 @@ class TestCluster(unittest.TestCase):
 
         self.assertTrue(np.all(ckeys == check_values))
 
+    def test_cluster_wrapping(self):
+        box = freud.box.Box.cube(10)
+        offsets = np.arange(10) - 4.5
+        # A straight strand, a diagonal strand, a sheet, and a finite strand.
+        systems = [
+            (np.array([[x, -4, -4] for x in offsets]), [True, False, False],
+             1),
+            (np.array([[x, x, 0] for x in offsets]), [True, True, False], 1),
+            (np.array([[x, y, 2] for x in offsets for y in offsets]),
+             [True, True, False], 2),
+            (np.array([[x, 4, 4] for x in offsets[:-1]]),
+             [False, False, False], 0)]
+        for points, wrapping, rank in systems:
+            clust = freud.cluster.Cluster(detect_wrapping=True)
+            clust.compute((box, points), neighbors={'r_max': 1.5})
+            self.assertEqual(clust.num_clusters, 1)
+            npt.assert_array_equal(clust.cluster_wrapping, [wrapping])
+            npt.assert_array_equal(clust.cluster_wrapping_rank, [rank])
+
+        # All of the systems together are clustered separately.
+        points = np.concatenate([points for points, _, _ in systems])
+        clust = freud.cluster.Cluster(detect_wrapping=True)
+        clust.compute((box, points), neighbors={'r_max': 1.5})
+        self.assertEqual(clust.num_clusters, 4)
+        npt.assert_array_equal(clust.cluster_wrapping_rank, [2, 1, 1, 0])
+
+        # Detecting wrapping does not change the clusters.
+        plain_clust = freud.cluster.Cluster()
+        plain_clust.compute((box, points), neighbors={'r_max': 1.5})
+        npt.assert_array_equal(plain_clust.cluster_idx, clust.cluster_idx)
+        with self.assertRaises(ValueError):
+            plain_clust.cluster_wrapping
+        with self.assertRaises(ValueError):
+            plain_clust.cluster_wrapping_rank
+
+        # The simple cubic lattice spans all three dimensions.
+        box, points = freud.data.UnitCell.sc().generate_system(5)
+        clust = freud.cluster.Cluster(detect_wrapping=True)
+        clust.compute((box, points), neighbors={'r_max': 1.1})
+        npt.assert_array_equal(clust.cluster_wrapping, [[True, True, True]])
+        npt.assert_array_equal(clust.cluster_wrapping_rank, [3])
+
+    def test_cluster_wrapping_large_r_max(self):
+        # With r_max larger than half of the box, the two points are bonded
+        # through two images, so the pair wraps around the box along x.
+        box = freud.box.Box.cube(3)
+        points = np.array([[0, 0, 0], [1.4, 0, 0]])
+        query_args = dict(mode='ball', r_max=1.7, exclude_ii=True)
+        clust = freud.cluster.Cluster(detect_wrapping=True)
+        clust.compute((box, points), neighbors=query_args)
+        self.assertEqual(clust.num_clusters, 1)
+        npt.assert_array_equal(clust.cluster_wrapping, [[True, False, False]])
+        npt.assert_array_equal(clust.cluster_wrapping_rank, [1])
+
+    def test_cluster_wrapping_equidistant_images(self):
+        # Each point of a simple cubic lattice with two points along each box
+        # vector is bonded to two images of each neighbor at the same
+        # distance, and a partner at half of the box is bonded to two images
+        # at the same distance as well.
+        box, points = freud.data.UnitCell.sc().generate_system(2)
+        systems = [(box, points, 1.1, [True, True, True], 3),
+                   (freud.box.Box.cube(3), np.array([[0, 0, 0], [1.5, 0, 0]]),
+                    1.6, [True, False, False], 1)]
+        for box, points, r_max, wrapping, rank in systems:
+            for nq in [freud.locality.AABBQuery(box, points),
+                       freud.locality.LinkCell(box, points, 0.5)]:
+                clust = freud.cluster.Cluster(detect_wrapping=True)
+                clust.compute(nq, neighbors=dict(r_max=r_max, exclude_ii=True))
+                self.assertEqual(clust.num_clusters, 1)
+                npt.assert_array_equal(clust.cluster_wrapping, [wrapping])
+                npt.assert_array_equal(clust.cluster_wrapping_rank, [rank])
+
     def test_repr(self):
         clust = freud.cluster.Cluster()
         self.assertEqual(str(clust), str(eval(repr(clust))))
+        clust = freud.cluster.Cluster(detect_wrapping=True)
+        self.assertEqual(str(clust), str(eval(repr(clust))))
         props = freud.cluster.ClusterProperties()
         self.assertEqual(str(props), str(eval(repr(props))))
 
@@ -172,11 +288,11 @@ class TestCluster(unittest.TestCase):
 
 class TestClusterManagedArray(TestManagedArray, unittest.TestCase):
     def build_object(self):
-        self.obj = freud.cluster.Cluster()
+        self.obj = freud.cluster.Cluster(detect_wrapping=True)
 
     @property
     def computed_properties(self):
-        return ['cluster_idx']
+        return ['cluster_idx', 'cluster_wrapping', 'cluster_wrapping_rank']
 
     def compute(self):
         box = freud.box.Box.cube(10)
@@ -186,5 +302,91 @@ class TestClusterManagedArray(TestManagedArray, unittest.TestCase):
         self.obj.compute((box, points), neighbors={'r_max': 2})
 
 
+class TestRingStatistics(unittest.TestCase):
+    def test_constructor(self):
+        self.assertEqual(freud.cluster.RingStatistics().max_ring_size, 12)
+        self.assertEqual(freud.cluster.RingStatistics(6).max_ring_size, 6)
+        with self.assertRaises(ValueError):
+            freud.cluster.RingStatistics(2)
+
+    def test_square(self):
+        box, points = freud.data.UnitCell.square().generate_system(10)
+        rings = freud.cluster.RingStatistics(8)
+
+        # Test protected attribute access
+        with self.assertRaises(AttributeError):
+            rings.ring_counts
+        with self.assertRaises(AttributeError):
+            rings.point_ring_counts
+
+        rings.compute((box, points), neighbors={'r_max': 1.1})
+
+        # Every square is a ring, and paths around several squares are not.
+        expected_counts = np.zeros(9)
+        expected_counts[4] = len(points)
+        npt.assert_equal(rings.ring_counts, expected_counts)
+        self.assertEqual(rings.num_rings, len(points))
+        npt.assert_equal(rings.point_ring_counts.shape, (len(points), 9))
+        npt.assert_equal(rings.point_ring_counts[:, 4], 4)
+        self.assertEqual(np.sum(rings.point_ring_counts), 4*len(points))
+
+    def test_honeycomb(self):
+        num_cells = 8
+        cell_points = np.array([[0, 0, 0], [np.sqrt(3)/2, 0.5, 0],
+                                [np.sqrt(3)/2, 1.5, 0], [0, 2, 0]])
+        box = freud.box.Box.square(num_cells*np.sqrt(3))
+        box.Ly = num_cells*3
+        offsets = np.array([[i*np.sqrt(3), j*3, 0]
+                            for i in range(num_cells)
+                            for j in range(num_cells)])
+        points = box.wrap(
+            (offsets[:, np.newaxis, :] + cell_points).reshape(-1, 3))
+
+        rings = freud.cluster.RingStatistics()
+        rings.compute((box, points), neighbors={'r_max': 1.1})
+        expected_counts = np.zeros(13)
+        expected_counts[6] = len(points)//2
+        npt.assert_equal(rings.ring_counts, expected_counts)
+        npt.assert_equal(rings.point_ring_counts[:, 6], 3)
+
+        # The neighbor list may contain each bond in one direction only.
+        nlist = rings.nlist.copy().filter(
+            rings.nlist.query_point_indices < rings.nlist.point_indices)
+        rings.compute((box, points), neighbors=nlist)
+        npt.assert_equal(rings.ring_counts, expected_counts)
+
+    def test_shortcut(self):
+        # A square with one diagonal has two triangles, and the square itself
+        # is not a ring because the diagonal is a shortcut.
+        box = freud.box.Box.square(10)
+        points = np.array([[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0]])
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, [0, 0, 0, 1, 2], [1, 2, 3, 2, 3], np.ones(5))
+        rings = freud.cluster.RingStatistics(6)
+        rings.compute((box, points), neighbors=nlist)
+        npt.assert_equal(rings.ring_counts, [0, 0, 0, 2, 0, 0, 0])
+        npt.assert_equal(rings.point_ring_counts[:, 3], [2, 1, 2, 1])
+
+    def test_repr(self):
+        rings = freud.cluster.RingStatistics(10)
+        self.assertEqual(str(rings), str(eval(repr(rings))))
+
+
+class TestRingStatisticsManagedArray(TestManagedArray, unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.cluster.RingStatistics()
+
+    @property
+    def computed_properties(self):
+        return ['ring_counts', 'point_ring_counts']
+
+    def compute(self):
+        box = freud.box.Box.cube(10)
+        num_points = 100
+        points = np.random.rand(
+            num_points, 3)*box.L - box.L/2
+        self.obj.compute((box, points), neighbors={'num_neighbors': 4})
+
+
 if __name__ == '__main__':
     unittest.main()
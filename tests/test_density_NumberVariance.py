@@ -0,0 +1,116 @@
+import itertools
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+from test_managedarray import TestManagedArray
+
+
+def brute_force_variances(box, points, width):
+    """Count the points in windows at every grid cell by summing shifted
+    copies of the grid."""
+    fractions = box.make_fractional(points)
+    cells = np.floor(fractions * width).astype(int) % width
+    grid = np.zeros(width, dtype=int)
+    np.add.at(grid, tuple(cells.T), 1)
+    dims = 2 if box.is2D else 3
+    means, variances = [], []
+    for k in range(1, min(width[:dims])):
+        counts = np.zeros(width, dtype=int)
+        for shift in itertools.product(range(k), repeat=dims):
+            counts += np.roll(grid, [-s for s in shift],
+                              axis=tuple(range(dims)))
+        means.append(np.mean(counts))
+        variances.append(np.var(counts))
+    return np.array(means), np.array(variances)
+
+
+class TestNumberVariance(unittest.TestCase):
+    def test_random_points(self):
+        for is2D in (False, True):
+            box = freud.box.Box(10, 8, 0 if is2D else 6, xy=0.1, is2D=is2D)
+            random_box, points = freud.data.make_random_system(
+                10, 2000, is2D=is2D, seed=0)
+            points = box.make_absolute(random_box.make_fractional(points))
+            width = (10, 7) if is2D else (10, 7, 5)
+            nv = freud.density.NumberVariance(width)
+
+            # Test access
+            with self.assertRaises(AttributeError):
+                nv.variances
+            with self.assertRaises(AttributeError):
+                nv.mean_counts
+
+            nv.compute((box, points))
+            grid_width = width + (1, ) if is2D else width
+            means, variances = brute_force_variances(
+                box, points, np.array(grid_width))
+            npt.assert_equal(nv.window_widths, np.arange(1, len(means) + 1))
+            npt.assert_allclose(
+                nv.window_volumes,
+                box.volume/np.prod(grid_width)*nv.window_widths**(
+                    2 if is2D else 3), rtol=1e-5)
+            npt.assert_allclose(nv.mean_counts, means, rtol=1e-5)
+            npt.assert_allclose(nv.variances, variances, rtol=1e-4)
+
+    def test_poisson(self):
+        # The number of uniformly random points in a window is binomially
+        # distributed, and the windows sampled at random cells agree with
+        # windows placed at every cell.
+        box, points = freud.data.make_random_system(10, 100000, seed=1)
+        nv = freud.density.NumberVariance(32).compute((box, points))
+        fractions = nv.window_volumes/box.volume
+        npt.assert_allclose(nv.mean_counts, 100000*fractions, rtol=1e-5)
+        npt.assert_allclose(
+            nv.variances[:4], 100000*fractions[:4]*(1 - fractions[:4]),
+            rtol=0.15)
+
+        sampled = freud.density.NumberVariance(32, num_samples=4096, seed=2)
+        sampled.compute((box, points))
+        npt.assert_allclose(sampled.mean_counts[:4], nv.mean_counts[:4],
+                            rtol=0.05)
+        npt.assert_allclose(sampled.variances[:4], nv.variances[:4],
+                            rtol=0.15)
+
+    def test_width_unchanged_by_compute(self):
+        nv = freud.density.NumberVariance(8)
+        box, points = freud.data.make_random_system(10, 100, is2D=True,
+                                                    seed=0)
+        nv.compute((box, points))
+        self.assertEqual(nv.width, (8, 8, 8))
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        nv.compute((box, points))
+        self.assertEqual(len(nv.variances), 7)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.density.NumberVariance(0)
+        with self.assertRaises(ValueError):
+            freud.density.NumberVariance(10, num_samples=0)
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        with self.assertRaises(ValueError):
+            freud.density.NumberVariance((10, 10, 1)).compute((box, points))
+
+    def test_repr(self):
+        nv = freud.density.NumberVariance((10, 12, 8), 100, 3)
+        self.assertEqual(str(nv), str(eval(repr(nv))))
+        nv = freud.density.NumberVariance(10)
+        self.assertEqual(str(nv), str(eval(repr(nv))))
+
+
+class TestNumberVarianceManagedArray(TestManagedArray, unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.density.NumberVariance(8)
+
+    @property
+    def computed_properties(self):
+        return ['window_widths', 'window_volumes', 'mean_counts',
+                'variances']
+
+    def compute(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        self.obj.compute((box, points))
+
+
+if __name__ == '__main__':
+    unittest.main()
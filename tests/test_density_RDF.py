@@ -1,3 +1,4 @@
+import itertools
 import numpy as np
 import numpy.testing as npt
 import freud
@@ -98,10 +99,193 @@ class TestRDF(unittest.TestCase):
                 npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts),
                                     rtol=tolerance)
 
+    def test_query_matches_neighbor_list(self):
+        # Bonds found by queries are binned from squared distances, which
+        # must give exactly the same bins as the distances of neighbor lists.
+        for r_min in [0, 0.5]:
+            box, points = freud.data.make_random_system(10, 1000, seed=0)
+            query_args = dict(r_max=3, r_min=r_min, exclude_ii=True)
+            nlist = freud.locality.AABBQuery(box, points).query(
+                points, query_args).toNeighborList()
+            rdf_query = freud.density.RDF(bins=150, r_max=3, r_min=r_min)
+            rdf_query.compute((box, points), neighbors=query_args)
+            rdf_nlist = freud.density.RDF(bins=150, r_max=3, r_min=r_min)
+            rdf_nlist.compute((box, points), neighbors=nlist)
+            npt.assert_array_equal(rdf_query.bin_counts, rdf_nlist.bin_counts)
+
+    def test_count_cell_pairs(self):
+        # Counting pairs of cells must give exactly the bins of the bonds
+        # found by queries, including pairs found through several images and
+        # points outside of the box.
+        boxes = [freud.box.Box.cube(10), freud.box.Box.square(10),
+                 freud.box.Box(9, 10, 11, 0.3, -0.2, 0.1)]
+        for box, spread in itertools.product(boxes, [0.5, 1.5]):
+            points = np.random.default_rng(0).uniform(
+                -spread, spread, (2000, 3)) @ box.to_matrix().T
+            if box.is2D:
+                points[:, 2] = 0
+            query_points = points[:500] + 0.3
+            if box.is2D:
+                query_points[:, 2] = 0
+            if spread < 1:
+                points = box.wrap(points)
+                query_points = box.wrap(query_points)
+            for bins, r_max, r_min in [(100, 4.9, 0), (3, 4.5, 1), (4, 6, 0)]:
+                rdf_query = freud.density.RDF(bins, r_max, r_min)
+                rdf_cells = freud.density.RDF(bins, r_max, r_min)
+                for qp in [None, query_points]:
+                    rdf_query.compute((box, points), qp)
+                    rdf_cells.compute((box, points), qp,
+                                      count_cell_pairs=True)
+                    npt.assert_array_equal(
+                        rdf_cells.bin_counts, rdf_query.bin_counts)
+                    npt.assert_allclose(rdf_cells.rdf, rdf_query.rdf)
+
+    def test_count_cell_pairs_dense(self):
+        # Wide bins in a dense system are mostly counted in bulk.
+        box, points = freud.data.make_random_system(4, 8000, seed=1)
+        bin_edges = [0, 0.5, 1.5, 1.8]
+        rdf_query = freud.density.RDF(bins=bin_edges)
+        rdf_query.compute((box, points))
+        rdf_cells = freud.density.RDF(bins=bin_edges)
+        rdf_cells.compute((box, points), count_cell_pairs=True)
+        npt.assert_array_equal(rdf_cells.bin_counts, rdf_query.bin_counts)
+
+    def test_count_cell_pairs_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(bins=10, r_max=3)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, dict(r_max=3, exclude_ii=True)).toNeighborList()
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=nlist, count_cell_pairs=True)
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), sample_fraction=0.5,
+                        count_cell_pairs=True)
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=dict(r_max=2),
+                        count_cell_pairs=True)
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=dict(num_neighbors=4),
+                        count_cell_pairs=True)
+
+    def test_custom_bins(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        bin_edges = np.array([0, 0.1, 0.15, 0.5, 1, 1.05, 2, 3],
+                             dtype=np.float32)
+        query_args = dict(r_max=3, exclude_ii=True)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, query_args).toNeighborList()
+        expected_counts, _ = np.histogram(nlist.distances, bins=bin_edges)
+        for neighbors in [query_args, nlist]:
+            rdf = freud.density.RDF(bins=bin_edges)
+            rdf.compute((box, points), neighbors=neighbors)
+            npt.assert_array_equal(rdf.bin_edges, bin_edges)
+            npt.assert_array_equal(rdf.bin_counts, expected_counts)
+            npt.assert_allclose(rdf.bin_centers,
+                                (bin_edges[1:] + bin_edges[:-1])/2)
+        self.assertEqual(rdf.bounds, (0, 3))
+        self.assertEqual(len(rdf.rdf), len(bin_edges) - 1)
+
+    def test_log_bins(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        r_min, r_max, bins = 0.05, 3, 40
+        rdf = freud.density.RDF(bins, r_max, r_min, log_bins=True)
+        npt.assert_allclose(
+            rdf.bin_edges, np.geomspace(r_min, r_max, bins + 1), rtol=1e-5)
+        query_args = dict(r_max=r_max, r_min=r_min, exclude_ii=True)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, query_args).toNeighborList()
+        expected_counts, _ = np.histogram(nlist.distances, bins=rdf.bin_edges)
+        rdf.compute((box, points), neighbors=query_args)
+        npt.assert_array_equal(rdf.bin_counts, expected_counts)
+
+        # The RDF of an ideal gas is one regardless of the bin widths.
+        box, points = freud.data.make_random_system(20, 20000, seed=1)
+        rdf = freud.density.RDF(10, 4, 1, log_bins=True)
+        rdf.compute((box, points))
+        npt.assert_allclose(rdf.rdf, 1, atol=0.05)
+
+    def test_invalid_bins(self):
+        with self.assertRaises(ValueError):
+            freud.density.RDF(10)
+        with self.assertRaises(ValueError):
+            freud.density.RDF([0, 1, 2], r_max=2)
+        with self.assertRaises(ValueError):
+            freud.density.RDF([0, 1, 2], log_bins=True)
+        with self.assertRaises(ValueError):
+            freud.density.RDF([0, 1, 1])
+        with self.assertRaises(ValueError):
+            freud.density.RDF([1])
+        with self.assertRaises(ValueError):
+            freud.density.RDF([-1, 1, 2])
+        with self.assertRaises(ValueError):
+            freud.density.RDF(10, 2, log_bins=True)
+
+    def test_subsample(self):
+        box, points = freud.data.make_random_system(20, 20000, seed=0)
+        query_args = dict(r_max=3, exclude_ii=True)
+        nq = freud.locality.AABBQuery(box, points)
+        rdf = freud.density.RDF(bins=30, r_max=3)
+        rdf.compute(nq, neighbors=query_args)
+        npt.assert_array_equal(rdf.relative_error, 0)
+        self.assertEqual(rdf.num_sampled_query_points, len(points))
+
+        # Processing all query points reproduces the exact RDF.
+        rdf_all = freud.density.RDF(bins=30, r_max=3)
+        rdf_all.compute(nq, neighbors=query_args, sample_fraction=1)
+        npt.assert_array_equal(rdf_all.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(rdf_all.rdf, rdf.rdf, rtol=1e-6)
+        npt.assert_array_equal(rdf_all.relative_error, 0)
+
+        rdf_sub = freud.density.RDF(bins=30, r_max=3)
+        rdf_sub.compute(nq, neighbors=query_args, sample_fraction=0.2,
+                        seed=1)
+        self.assertEqual(rdf_sub.num_sampled_query_points, 4000)
+        nonzero = rdf.rdf > 0
+        self.assertTrue(np.all(rdf_sub.relative_error[nonzero] > 0))
+        self.assertTrue(np.all(rdf_sub.relative_error[nonzero] < 0.2))
+        npt.assert_allclose(
+            rdf_sub.rdf[nonzero], rdf.rdf[nonzero],
+            atol=5*rdf.rdf[nonzero]*rdf_sub.relative_error[nonzero])
+
+        # Subsampling with the same seed is deterministic.
+        rdf_sub2 = freud.density.RDF(bins=30, r_max=3)
+        rdf_sub2.compute(nq, neighbors=query_args, sample_fraction=0.2,
+                         seed=1)
+        npt.assert_array_equal(rdf_sub2.bin_counts, rdf_sub.bin_counts)
+
+    def test_subsample_target_error(self):
+        box, points = freud.data.make_random_system(20, 20000, seed=0)
+        query_args = dict(r_max=3, r_min=1, exclude_ii=True)
+        for target_error in [0.05, 0.01]:
+            rdf = freud.density.RDF(bins=20, r_max=3, r_min=1)
+            rdf.compute((box, points), neighbors=query_args,
+                        target_error=target_error)
+            self.assertTrue(
+                rdf.num_sampled_query_points == len(points) or
+                np.all(rdf.relative_error <= target_error))
+            npt.assert_allclose(rdf.rdf, 1, atol=0.1)
+        self.assertLess(rdf.num_sampled_query_points, len(points))
+
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=query_args, target_error=0)
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=query_args,
+                        sample_fraction=0)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, query_args).toNeighborList()
+        with self.assertRaises(ValueError):
+            rdf.compute((box, points), neighbors=nlist, sample_fraction=0.5)
+
     def test_repr(self):
         rdf = freud.density.RDF(r_max=10, bins=100, r_min=0.5)
         self.assertEqual(str(rdf), str(eval(repr(rdf))))
 
+    def test_repr_custom_bins(self):
+        for rdf in [freud.density.RDF([0, 0.5, 2, 3]),
+                    freud.density.RDF(10, 3, 0.1, log_bins=True)]:
+            self.assertEqual(str(rdf), str(eval(repr(rdf))))
+
     def test_repr_png(self):
         r_max = 10.0
         bins = 10
@@ -182,7 +366,7 @@ class TestRDFManagedArray(TestManagedArray, unittest.TestCase):
 
     @property
     def computed_properties(self):
-        return ['rdf', 'n_r', 'bin_counts']
+        return ['rdf', 'n_r', 'bin_counts', 'relative_error']
 
     def compute(self):
         box = freud.box.Box.cube(10)
@@ -0,0 +1,134 @@
+import unittest
+import numpy.testing as npt
+import numpy as np
+import freud
+from test_managedarray import TestManagedArray
+
+
+def make_hcp(nx, ny, nz):
+    """Make an hcp crystal with nearest neighbor distance 1 in an
+    orthorhombic box."""
+    c = np.sqrt(8/3)
+    fractions = np.array([[0, 0, 0],
+                          [0.5, 0.5, 0],
+                          [0.5, 1/6, 0.5],
+                          [0, 2/3, 0.5]])
+    cells = np.array([[x, y, z] for x in range(nx) for y in range(ny)
+                      for z in range(nz)])
+    lengths = np.array([1, np.sqrt(3), c])
+    points = ((cells[:, np.newaxis] + fractions[np.newaxis]).reshape(-1, 3) *
+              lengths)
+    box = freud.box.Box(*(lengths*[nx, ny, nz]))
+    return box, box.wrap(points - box.L/2 + 0.01)
+
+
+def make_icosahedron():
+    """Make a central point surrounded by an icosahedron of 12 points."""
+    phi = (1 + np.sqrt(5))/2
+    vertices = []
+    for s1 in [-1, 1]:
+        for s2 in [-1, 1]:
+            vertices += [[0, s1, s2*phi], [s1, s2*phi, 0], [s2*phi, 0, s1]]
+    vertices = np.array(vertices)
+    vertices /= np.linalg.norm(vertices[0])
+    return freud.box.Box.cube(20), np.vstack([[0, 0, 0], vertices])
+
+
+class TestCommonNeighborAnalysis(unittest.TestCase):
+    def test_crystals(self):
+        cna = freud.environment.CommonNeighborAnalysis
+        systems = [
+            (freud.data.UnitCell.fcc().generate_system(6), cna.FCC, 0.85),
+            (freud.data.UnitCell.bcc().generate_system(6), cna.BCC, 1.2),
+            (make_hcp(6, 4, 4), cna.HCP, 1.2),
+        ]
+        for (box, points), structure, r_max in systems:
+            for adaptive, neighbors in [(True, None),
+                                        (False, dict(r_max=r_max))]:
+                cna = freud.environment.CommonNeighborAnalysis(adaptive)
+                cna.compute((box, points), neighbors=neighbors)
+                npt.assert_array_equal(cna.structures, structure)
+                expected_counts = np.zeros(5)
+                expected_counts[structure] = len(points)
+                npt.assert_array_equal(cna.structure_counts, expected_counts)
+
+    def test_adaptive_noise(self):
+        # Adaptive cutoffs tolerate thermal noise and strain.
+        box, points = freud.data.UnitCell.fcc().generate_system(
+            6, scale=1.5, sigma_noise=0.02, seed=0)
+        cna = freud.environment.CommonNeighborAnalysis()
+        cna.compute((box, points))
+        self.assertGreater(cna.structure_counts[cna.FCC], 0.95*len(points))
+
+        box, points = freud.data.UnitCell.bcc().generate_system(
+            6, scale=0.8, sigma_noise=0.01, seed=0)
+        cna.compute((box, points))
+        self.assertGreater(cna.structure_counts[cna.BCC], 0.95*len(points))
+
+    def test_icosahedron(self):
+        box, points = make_icosahedron()
+        for adaptive, neighbors in [(True, None), (False, dict(r_max=1.2))]:
+            cna = freud.environment.CommonNeighborAnalysis(adaptive)
+            cna.compute((box, points), neighbors=neighbors)
+            self.assertEqual(cna.structures[0], cna.ICO)
+            npt.assert_array_equal(cna.structures[1:], cna.OTHER)
+
+    def test_random(self):
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        cna = freud.environment.CommonNeighborAnalysis()
+        cna.compute((box, points))
+        npt.assert_array_equal(cna.structure_counts[1:], 0)
+
+    def test_neighbor_list(self):
+        # A neighbor list gives the same result as the query arguments.
+        box, points = make_hcp(6, 4, 4)
+        for adaptive, query_args in [
+                (True, dict(num_neighbors=14, exclude_ii=True)),
+                (False, dict(r_max=1.2, exclude_ii=True))]:
+            nlist = freud.locality.AABBQuery(box, points).query(
+                points, query_args).toNeighborList()
+            cna = freud.environment.CommonNeighborAnalysis(adaptive)
+            cna.compute((box, points), neighbors=nlist)
+            npt.assert_array_equal(cna.structures, cna.HCP)
+            npt.assert_array_equal(cna.nlist[:], nlist[:])
+
+    def test_conventional_requires_neighbors(self):
+        box, points = freud.data.UnitCell.fcc().generate_system(4)
+        cna = freud.environment.CommonNeighborAnalysis(adaptive=False)
+        with self.assertRaises(NotImplementedError):
+            cna.compute((box, points))
+
+    def test_attribute_access(self):
+        cna = freud.environment.CommonNeighborAnalysis()
+        with self.assertRaises(AttributeError):
+            cna.structures
+        box, points = freud.data.UnitCell.fcc().generate_system(4)
+        cna.compute((box, points))
+        self.assertEqual(cna.structures.shape, (len(points),))
+        self.assertEqual(cna.structure_counts.shape, (5,))
+        self.assertEqual(len(cna.structure_names), 5)
+        self.assertEqual(cna.structure_names[cna.FCC], 'fcc')
+
+    def test_repr(self):
+        for adaptive in [True, False]:
+            cna = freud.environment.CommonNeighborAnalysis(adaptive)
+            self.assertEqual(str(cna), str(eval(repr(cna))))
+
+
+class TestCommonNeighborAnalysisManagedArray(TestManagedArray,
+                                             unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.environment.CommonNeighborAnalysis()
+
+    @property
+    def computed_properties(self):
+        return ['structures', 'structure_counts']
+
+    def compute(self):
+        box, points = freud.data.UnitCell.fcc().generate_system(
+            4, sigma_noise=0.05)
+        self.obj.compute((box, points))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,125 @@
+import unittest
+import numpy.testing as npt
+import numpy as np
+import freud
+from test_managedarray import TestManagedArray
+
+
+def deform(box, points, new_box):
+    """Map points affinely from one box to another."""
+    return new_box.make_absolute(box.make_fractional(points))
+
+
+def brute_force_d2min(box, points, new_box, new_points, nlist):
+    """Fit the affine transformation of each particle's bonds with a least
+    squares solver."""
+    dim = 2 if box.is2D else 3
+    d2min = np.zeros(len(points))
+    for i in range(len(points)):
+        bonds = nlist.point_indices[nlist.query_point_indices == i]
+        d0 = box.wrap(points[bonds] - points[i])[:, :dim]
+        d = new_box.wrap(new_points[bonds] - new_points[i])[:, :dim]
+        J_T = np.linalg.lstsq(d0, d, rcond=None)[0]
+        d2min[i] = np.sum((d - d0.dot(J_T))**2)
+    return d2min
+
+
+class TestNonaffineDisplacement(unittest.TestCase):
+    def test_affine(self):
+        box, points = freud.data.make_random_system(10, 500, seed=1)
+        new_box = freud.box.Box(10.1, 9.95, 10.05, xy=0.02, xz=-0.01)
+        new_points = deform(box, points, new_box)
+
+        nd = freud.environment.NonaffineDisplacement()
+
+        # Test protected attribute access
+        with self.assertRaises(AttributeError):
+            nd.d2min
+        with self.assertRaises(AttributeError):
+            nd.strain
+
+        nd.compute((box, points), (new_box, new_points),
+                   neighbors={'r_max': 2.5, 'exclude_ii': True})
+        npt.assert_allclose(nd.d2min, 0, atol=1e-5)
+        expected_strain = new_box.to_matrix()/10 - np.eye(3)
+        npt.assert_allclose(
+            nd.strain, np.broadcast_to(expected_strain, (500, 3, 3)),
+            atol=1e-4)
+
+    def test_random_displacements(self):
+        box, points = freud.data.make_random_system(10, 500, seed=2)
+        np.random.seed(0)
+        new_points = box.wrap(points + np.random.normal(
+            scale=0.05, size=points.shape).astype(np.float32))
+
+        nd = freud.environment.NonaffineDisplacement()
+        nd.compute((box, points), (box, new_points),
+                   neighbors={'num_neighbors': 12, 'exclude_ii': True})
+        npt.assert_allclose(
+            nd.d2min,
+            brute_force_d2min(box, points, box, new_points, nd.nlist),
+            rtol=1e-3, atol=1e-6)
+
+    def test_2d(self):
+        box, points = freud.data.make_random_system(10, 200, is2D=True,
+                                                    seed=3)
+        new_box = freud.box.Box(10.2, 9.9, xy=0.05, is2D=True)
+        new_points = deform(box, points, new_box)
+        np.random.seed(0)
+        new_points[:, :2] += np.random.normal(
+            scale=0.02, size=(200, 2)).astype(np.float32)
+        new_points = new_box.wrap(new_points)
+
+        nd = freud.environment.NonaffineDisplacement()
+        nd.compute((box, points), (new_box, new_points),
+                   neighbors={'num_neighbors': 6, 'exclude_ii': True})
+        npt.assert_allclose(
+            nd.d2min,
+            brute_force_d2min(box, points, new_box, new_points, nd.nlist),
+            rtol=1e-3, atol=1e-6)
+        npt.assert_equal(nd.strain[:, 2, :], 0)
+        npt.assert_equal(nd.strain[:, :, 2], 0)
+
+    def test_degenerate(self):
+        # Particles whose bonds are collinear have no affine fit.
+        box = freud.box.Box.cube(10)
+        points = np.array([[0, 0, 0], [1, 0, 0], [2, 0, 0]])
+        nd = freud.environment.NonaffineDisplacement()
+        nd.compute((box, points), (box, points),
+                   neighbors={'r_max': 1.5, 'exclude_ii': True})
+        self.assertTrue(np.all(np.isnan(nd.d2min)))
+        self.assertTrue(np.all(np.isnan(nd.strain)))
+
+    def test_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=4)
+        nd = freud.environment.NonaffineDisplacement()
+        with self.assertRaises(ValueError):
+            nd.compute((box, points), (box, points[:-1]),
+                       neighbors={'num_neighbors': 6})
+        with self.assertRaises(ValueError):
+            nd.compute((box, points),
+                       (freud.box.Box.square(10), points * [1, 1, 0]),
+                       neighbors={'num_neighbors': 6})
+
+    def test_repr(self):
+        nd = freud.environment.NonaffineDisplacement()
+        self.assertEqual(str(nd), str(eval(repr(nd))))
+
+
+class TestNonaffineDisplacementManagedArray(TestManagedArray,
+                                            unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.environment.NonaffineDisplacement()
+
+    @property
+    def computed_properties(self):
+        return ['d2min', 'strain']
+
+    def compute(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        self.obj.compute((box, points), (box, points),
+                         neighbors={'num_neighbors': 8})
+
+
+if __name__ == '__main__':
+    unittest.main()
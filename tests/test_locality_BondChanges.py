@@ -0,0 +1,136 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+def _bond_set(nlist):
+    return set(zip(nlist.query_point_indices, nlist.point_indices))
+
+
+def _nlist_from_bonds(bonds, num_points):
+    bonds = np.array(sorted(bonds), dtype=np.uint32).reshape(-1, 2)
+    return freud.locality.NeighborList.from_arrays(
+        num_points, num_points, bonds[:, 0], bonds[:, 1],
+        np.ones(len(bonds)))
+
+
+class TestBondChanges(unittest.TestCase):
+    def test_random(self):
+        L = 10
+        N = 200
+        r_max = 1.5
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        query_args = dict(r_max=r_max, exclude_ii=True)
+        old_nlist = freud.locality.AABBQuery(box, points).query(
+            points, query_args).toNeighborList()
+        np.random.seed(1)
+        points = box.wrap(points + np.random.normal(
+            scale=0.2, size=points.shape).astype(np.float32))
+        new_nlist = freud.locality.AABBQuery(box, points).query(
+            points, query_args).toNeighborList()
+
+        bc = freud.locality.BondChanges().compute(old_nlist, new_nlist)
+        old_bonds = _bond_set(old_nlist)
+        new_bonds = _bond_set(new_nlist)
+        self.assertEqual(_bond_set(bc.formed), new_bonds - old_bonds)
+        self.assertEqual(_bond_set(bc.broken), old_bonds - new_bonds)
+        self.assertEqual(len(bc.formed), len(new_bonds - old_bonds))
+        self.assertEqual(len(bc.broken), len(old_bonds - new_bonds))
+
+        # The changed bonds keep the distances of their neighbor list
+        formed_distances = np.linalg.norm(box.wrap(
+            points[bc.formed.point_indices] -
+            points[bc.formed.query_point_indices]), axis=-1)
+        npt.assert_allclose(bc.formed.distances, formed_distances,
+                            rtol=1e-5)
+        npt.assert_array_less(bc.formed.distances, r_max)
+
+    def test_identical(self):
+        nlist = _nlist_from_bonds([(0, 1), (1, 0), (1, 2), (2, 1)], 3)
+        bc = freud.locality.BondChanges().compute(nlist, nlist)
+        self.assertEqual(len(bc.formed), 0)
+        self.assertEqual(len(bc.broken), 0)
+
+    def test_unsorted_points(self):
+        # Bonds of a query point do not need to be sorted by point index
+        old_nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, [0, 0, 0, 2], [3, 1, 2, 0], np.ones(4))
+        new_nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, [0, 0, 1], [2, 0, 3], np.ones(3))
+        bc = freud.locality.BondChanges().compute(old_nlist, new_nlist)
+        self.assertEqual(_bond_set(bc.formed), {(0, 0), (1, 3)})
+        self.assertEqual(_bond_set(bc.broken), {(0, 1), (0, 3), (2, 0)})
+
+    def test_mismatched_points(self):
+        nlist1 = _nlist_from_bonds([(0, 1)], 3)
+        nlist2 = _nlist_from_bonds([(0, 1)], 4)
+        with self.assertRaises(ValueError):
+            freud.locality.BondChanges().compute(nlist1, nlist2)
+
+    def test_repr(self):
+        bc = freud.locality.BondChanges()
+        self.assertEqual(str(bc), str(eval(repr(bc))))
+
+
+class TestBondLifetime(unittest.TestCase):
+    def test_lifetimes(self):
+        frames = [
+            [(0, 1), (1, 0), (0, 2)],
+            [(0, 1), (1, 0), (1, 2)],
+            [(0, 1), (1, 2)],
+            [(0, 2), (1, 2)],
+            [(0, 2)],
+        ]
+        bl = freud.locality.BondLifetime()
+        for bonds in frames:
+            bl.compute(_nlist_from_bonds(bonds, 3))
+        self.assertEqual(bl.num_frames, len(frames))
+        self.assertEqual(bl.num_bonds, 1)
+
+        # (0, 2) lives 1 frame, (1, 0) 2 frames, (0, 1) and (1, 2) 3 frames.
+        # The second (0, 2) bond is still present in the last frame.
+        npt.assert_equal(bl.lifetime_histogram, [0, 1, 1, 2, 0])
+        npt.assert_allclose(bl.survival, [1, 1, 0.75, 0.5, 0])
+
+        bl.compute(_nlist_from_bonds([(1, 0)], 3), reset=True)
+        self.assertEqual(bl.num_frames, 1)
+        npt.assert_equal(bl.lifetime_histogram, [0])
+
+    def test_random_walk(self):
+        # Compare with a simple tracker of the first frame of each bond
+        L = 8
+        N = 50
+        box, points = freud.data.make_random_system(L, N, seed=2)
+        np.random.seed(3)
+        first_frames = {}
+        histogram = np.zeros(10, dtype=np.uint32)
+        bl = freud.locality.BondLifetime()
+        for frame in range(len(histogram)):
+            nlist = freud.locality.AABBQuery(box, points).query(
+                points, dict(r_max=1.5, exclude_ii=True)).toNeighborList()
+            bonds = _bond_set(nlist)
+            for bond in list(first_frames):
+                if bond not in bonds:
+                    histogram[frame - first_frames.pop(bond)] += 1
+            for bond in bonds:
+                first_frames.setdefault(bond, frame)
+            bl.compute(nlist)
+            points = box.wrap(points + np.random.normal(
+                scale=0.2, size=points.shape).astype(np.float32))
+        npt.assert_equal(bl.lifetime_histogram, histogram)
+        self.assertEqual(bl.num_bonds, len(first_frames))
+
+    def test_mismatched_points(self):
+        bl = freud.locality.BondLifetime()
+        bl.compute(_nlist_from_bonds([(0, 1)], 3))
+        with self.assertRaises(ValueError):
+            bl.compute(_nlist_from_bonds([(0, 1)], 4))
+
+    def test_repr(self):
+        bl = freud.locality.BondLifetime()
+        self.assertEqual(str(bl), str(eval(repr(bl))))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -250,5 +250,86 @@ class TestNeighborList(unittest.TestCase):
         self.assertEqual(tuples, sorted_tuples)
 
 
+    def test_symmetrize(self):
+        sym = self.nlist.symmetrize()
+        bonds = set(zip(self.nlist.query_point_indices,
+                        self.nlist.point_indices))
+        sym_bonds = list(zip(sym.query_point_indices, sym.point_indices))
+        expected = bonds | set((j, i) for (i, j) in bonds)
+        self.assertEqual(sym_bonds, sorted(expected))
+
+        # The distances of reverse bonds are those of the original bonds
+        points = self.nq.points
+        distances = np.linalg.norm(self.nq.box.wrap(
+            points[sym.point_indices] - points[sym.query_point_indices]),
+            axis=-1)
+        npt.assert_allclose(sym.distances, distances, rtol=1e-5)
+
+        # Symmetrizing a symmetric neighbor list does not change it
+        sym2 = sym.symmetrize()
+        npt.assert_equal(sym2[:], sym[:])
+
+    def test_symmetrize_weights(self):
+        nlist = freud.locality.NeighborList.from_arrays(
+            3, 3, [0, 0, 1], [1, 2, 0], [1, 2, 1], [1, 2, 3])
+        sym = nlist.symmetrize(weight_merge='sum')
+        npt.assert_equal(sym[:], [[0, 1], [0, 2], [1, 0], [2, 0]])
+        npt.assert_allclose(sym.weights, [4, 2, 4, 2])
+        with self.assertRaises(ValueError):
+            nlist.symmetrize(weight_merge='median')
+
+        nlist = freud.locality.NeighborList.from_arrays(
+            2, 3, [0], [1], [1])
+        with self.assertRaises(ValueError):
+            nlist.symmetrize()
+
+    def test_set_operations(self):
+        points = self.nq.points
+        nlist_r = self.nq.query(points, dict(
+            r_max=2.5, exclude_ii=True)).toNeighborList()
+        bonds_k = set(zip(self.nlist.query_point_indices,
+                          self.nlist.point_indices))
+        bonds_r = set(zip(nlist_r.query_point_indices,
+                          nlist_r.point_indices))
+
+        union = self.nlist.union(nlist_r)
+        intersection = self.nlist.intersection(nlist_r)
+        difference = self.nlist.difference(nlist_r)
+        for nlist, expected in [(union, bonds_k | bonds_r),
+                                (intersection, bonds_k & bonds_r),
+                                (difference, bonds_k - bonds_r)]:
+            self.assertEqual(
+                list(zip(nlist.query_point_indices, nlist.point_indices)),
+                sorted(expected))
+            distances = np.linalg.norm(self.nq.box.wrap(
+                points[nlist.point_indices] -
+                points[nlist.query_point_indices]), axis=-1)
+            npt.assert_allclose(nlist.distances, distances, rtol=1e-5)
+
+    def test_set_operations_merge(self):
+        a = freud.locality.NeighborList.from_arrays(
+            3, 3, [0, 1, 1], [1, 0, 2], [1, 1, 1], [1, 2, 3])
+        b = freud.locality.NeighborList.from_arrays(
+            3, 3, [0, 1, 2], [1, 2, 2], [3, 3, 3], [5, 6, 7])
+
+        union = a.union(b, distance_merge='mean', weight_merge='max')
+        npt.assert_equal(union[:], [[0, 1], [1, 0], [1, 2], [2, 2]])
+        npt.assert_allclose(union.distances, [2, 1, 2, 3])
+        npt.assert_allclose(union.weights, [5, 2, 6, 7])
+
+        intersection = a.intersection(b, weight_merge='second')
+        npt.assert_equal(intersection[:], [[0, 1], [1, 2]])
+        npt.assert_allclose(intersection.distances, [1, 1])
+        npt.assert_allclose(intersection.weights, [5, 6])
+
+        difference = b.difference(a)
+        npt.assert_equal(difference[:], [[2, 2]])
+        npt.assert_allclose(difference.weights, [7])
+
+        c = freud.locality.NeighborList.from_arrays(
+            4, 3, [0], [1], [1])
+        with self.assertRaises(ValueError):
+            a.union(c)
+
 if __name__ == '__main__':
     unittest.main()
@@ -210,6 +210,26 @@ class NeighborQueryTest(object):
         npt.assert_equal(get_point_neighbors(result, 2), {0, 1})
         npt.assert_equal(get_point_neighbors(result, 3), {0})
 
+    def test_r_min_thin_shell(self):
+        """Check that thin shells at large radii, for which whole cells and
+        tree nodes lie within r_min, find exactly the bonds in the shell."""
+        np.random.seed(0)
+        for box in [freud.box.Box(12, 13, 14, 0.3, -0.2, 0.1),
+                    freud.box.Box(30, 32, 0, 0.4, 0, 0)]:
+            points = box.make_absolute(
+                np.random.rand(2000, 3)).astype(np.float32)
+            r_min, r_max = (2.7, 3)
+            distances = box.compute_all_distances(points, points)
+            exhaustive_ijs = set(zip(*np.where(np.logical_and(
+                distances >= r_min, distances < r_max))))
+
+            nq = self.build_query_object(box, points, 1)
+            query_args = dict(mode='ball', r_max=r_max, r_min=r_min)
+            ijs = {(x[0], x[1]) for x in nq.query(points, query_args)}
+            self.assertEqual(exhaustive_ijs, ijs)
+            nlist = nq.query(points, query_args).toNeighborList()
+            self.assertEqual(set(map(tuple, nlist[:])), exhaustive_ijs)
+
     def test_query_nearest(self):
         L = 10  # Box Dimensions
         N = 4  # number of particles
@@ -424,6 +444,133 @@ class NeighborQueryTest(object):
                     seed, i))
                 raise
 
+    def test_exhaustive_search_triclinic(self):
+        """Check that neighbors across all periodic images are found in
+        sheared boxes, where points near the faces need several images."""
+        r_max, N = (1.999, 64)
+
+        seed = 0
+        for i, box in enumerate([freud.box.Box(9, 10, 11, 0.5, -0.3, 0.2),
+                                 freud.box.Box(9, 10, 0, 0.6, 0, 0)]):
+            np.random.seed(seed + i)
+            points = box.make_absolute(
+                np.random.rand(N, 3)).astype(np.float32)
+            all_vectors = points[:, np.newaxis, :] - points[np.newaxis, :, :]
+            all_vectors = box.wrap(
+                all_vectors.reshape((-1, 3))).reshape(all_vectors.shape)
+            all_rsqs = np.sum(all_vectors**2, axis=-1)
+            (exhaustive_i, exhaustive_j) = np.where(np.logical_and(
+                all_rsqs < r_max**2, all_rsqs > 0))
+            exhaustive_ijs = set(zip(exhaustive_i, exhaustive_j))
+
+            nq = self.build_query_object(box, points, r_max)
+            result = list(nq.query(points, dict(mode='ball', r_max=r_max,
+                                                exclude_ii=True)))
+            ijs = {(x[1], x[0]) for x in result}
+            self.assertEqual(exhaustive_ijs, ijs)
+
+    def test_large_r_max(self):
+        """Check that balls larger than half of the box find every periodic
+        image of each point within r_max."""
+        N = 20
+        np.random.seed(0)
+        for box, r_max in [(freud.box.Box.square(5), 6.5),
+                           (freud.box.Box(4, 5, 6, 0.3, -0.2, 0.1), 4.5)]:
+            points = box.make_absolute(
+                np.random.rand(N, 3)).astype(np.float32)
+            if box.is2D:
+                points[:, 2] = 0
+
+            # Enumerate enough images to cover the ball along every direction
+            images = np.array(list(itertools.product(
+                range(-3, 4), range(-3, 4),
+                [0] if box.is2D else range(-3, 4))))
+            image_vectors = images.dot(box.to_matrix().T)
+            vectors = (points[np.newaxis, :, np.newaxis, :]
+                       + image_vectors[np.newaxis, np.newaxis, :, :]
+                       - points[:, np.newaxis, np.newaxis, :])
+            distances = np.linalg.norm(vectors, axis=-1)
+            # Since exclude_ii is index based, it also excludes the images
+            # of the query point itself.
+            in_ball = np.logical_and(
+                distances < r_max, ~np.eye(N, dtype=bool)[:, :, np.newaxis])
+            i, j, _ = np.where(in_ball)
+            exhaustive = sorted(zip(i, j, distances[in_ball]))
+
+            nq = self.build_query_object(box, points, 1)
+            query_args = dict(mode='ball', r_max=r_max, exclude_ii=True)
+            bonds = sorted(nq.query(points, query_args))
+            self.assertEqual(len(bonds), len(exhaustive))
+            npt.assert_array_equal(
+                [b[:2] for b in bonds], [b[:2] for b in exhaustive])
+            npt.assert_allclose([b[2] for b in bonds],
+                                [b[2] for b in exhaustive], rtol=1e-4)
+
+            nlist = nq.query(points, query_args).toNeighborList()
+            self.assertEqual(nlist.num_bonds, len(exhaustive))
+
+    def test_bulk_query_matches_iteration(self):
+        """Check that neighbor lists, which are built with batched queries,
+        contain exactly the bonds found by iterating over a query."""
+        r_max = 1.5
+        np.random.seed(0)
+        for box in [freud.box.Box(16, 17, 18, 0.3, -0.2, 0.1),
+                    freud.box.Box(70, 75, 0, 0.4, 0, 0)]:
+            points = box.make_absolute(
+                np.random.rand(5000, 3)).astype(np.float32)
+            query_points = box.make_absolute(
+                np.random.rand(300, 3)).astype(np.float32)
+            nq = self.build_query_object(box, points, r_max)
+            for qp in [points, query_points]:
+                for r_min in [0, 0.5]:
+                    query_args = dict(mode='ball', r_max=r_max, r_min=r_min,
+                                      exclude_ii=qp is points)
+                    nlist = nq.query(qp, query_args).toNeighborList()
+                    bonds = sorted(nq.query(qp, query_args))
+                    npt.assert_array_equal(
+                        nlist[:], np.array([b[:2] for b in bonds]))
+                    npt.assert_allclose(
+                        nlist.distances, [b[2] for b in bonds])
+
+    def test_iter_chunks(self):
+        """Check that the chunks of a query concatenate to the bonds of the
+        corresponding neighbor list."""
+        np.random.seed(0)
+        box = freud.box.Box.cube(12)
+        points = box.make_absolute(
+            np.random.rand(2000, 3)).astype(np.float32)
+        query_points = box.make_absolute(
+            np.random.rand(500, 3)).astype(np.float32)
+        nq = self.build_query_object(box, points, 1.5)
+        for qp, query_args in [
+                (points, dict(mode='ball', r_max=1.5, exclude_ii=True)),
+                (query_points, dict(mode='ball', r_max=1.5, r_min=0.5)),
+                (query_points, dict(mode='nearest', num_neighbors=6))]:
+            result = nq.query(qp, query_args)
+            nlist = result.toNeighborList()
+            for chunk_size in [1, 97, 4096, 10**6]:
+                chunks = list(result.iter_chunks(chunk_size))
+                for chunk in chunks[:-1]:
+                    self.assertEqual(len(chunk[0]), chunk_size)
+                self.assertLessEqual(len(chunks[-1][0]), chunk_size)
+                npt.assert_array_equal(
+                    np.concatenate([c[0] for c in chunks]),
+                    nlist.query_point_indices)
+                npt.assert_array_equal(
+                    np.concatenate([c[1] for c in chunks]),
+                    nlist.point_indices)
+                npt.assert_allclose(
+                    np.concatenate([c[2] for c in chunks]), nlist.distances)
+
+        result = nq.query(points, dict(mode='ball', r_max=0.001,
+                                       exclude_ii=True))
+        self.assertEqual(list(result.iter_chunks()), [])
+        result = nq.query(np.empty((0, 3), dtype=np.float32),
+                          dict(mode='ball', r_max=1.5))
+        self.assertEqual(list(result.iter_chunks()), [])
+        with self.assertRaises(ValueError):
+            next(result.iter_chunks(0))
+
     def test_attributes(self):
         """Ensure that mixing old and new APIs throws an error"""
         L = 10
@@ -567,21 +714,122 @@ class NeighborQueryTest(object):
         nq.plot()
 
 
-class TestNeighborQueryAABB(NeighborQueryTest, unittest.TestCase):
+class PointUpdateTest(object):
+    """Tests of incremental point updates, for the NeighborQuery classes that
+    support them."""
+
+    @staticmethod
+    def random_points(box, num_points):
+        points = box.make_absolute(np.random.rand(num_points, 3))
+        if box.is2D:
+            points[:, 2] = 0
+        return points.astype(np.float32)
+
+    @staticmethod
+    def query_pairs(nq, query_args):
+        nlist = nq.query(nq.points, query_args).toNeighborList()
+        return set((i, j) for i, j in nlist)
+
+    def check_against_rebuild(self, nq, box, points, r_max):
+        npt.assert_array_equal(nq.points, points)
+        rebuilt = self.build_query_object(box, points, r_max)
+        query_args = dict(mode='ball', r_max=r_max, exclude_ii=True)
+        self.assertEqual(self.query_pairs(nq, query_args),
+                         self.query_pairs(rebuilt, query_args))
+        query_args = dict(num_neighbors=4, exclude_ii=True)
+        self.assertEqual(
+            len(nq.query(nq.points, query_args).toNeighborList()),
+            len(rebuilt.query(points, query_args).toNeighborList()))
+
+    def test_update_points(self):
+        r_max = 1.5
+        np.random.seed(0)
+        for box in [freud.box.Box(16, 17, 18, 0.3, -0.2, 0.1),
+                    freud.box.Box.square(30)]:
+            points = self.random_points(box, 2000)
+            nq = self.build_query_object(box, points, r_max)
+            for _ in range(5):
+                indices = np.random.choice(len(points), 50, replace=False)
+                displacements = np.random.rand(50, 3) - 0.5
+                if box.is2D:
+                    displacements[:, 2] = 0
+                positions = box.wrap(points[indices] + displacements)
+                positions[:25] = self.random_points(box, 25)
+                points[indices] = positions
+                self.assertIsNone(nq.update_points(indices, positions))
+                self.check_against_rebuild(nq, box, points, r_max)
+
+    def test_insert_remove_points(self):
+        r_max = 1.5
+        np.random.seed(1)
+        for box in [freud.box.Box.cube(15), freud.box.Box.square(30)]:
+            points = self.random_points(box, 1000)
+            nq = self.build_query_object(box, points, r_max)
+            for _ in range(5):
+                new_points = self.random_points(box, 300)
+                points = np.concatenate([points, new_points])
+                nq.insert_points(new_points)
+                self.check_against_rebuild(nq, box, points, r_max)
+
+                indices = np.random.choice(len(points), 200, replace=False)
+                for i in np.sort(indices)[::-1]:
+                    points[i] = points[-1]
+                    points = points[:-1]
+                nq.remove_points(indices)
+                self.check_against_rebuild(nq, box, points, r_max)
+
+    def test_update_points_bond_changes(self):
+        r_max = 1.5
+        np.random.seed(2)
+        box = freud.box.Box.cube(12)
+        points = self.random_points(box, 1000)
+        nq = self.build_query_object(box, points, r_max)
+        query_args = dict(mode='ball', r_max=r_max, exclude_ii=True)
+        old_nlist = nq.query(points, query_args).toNeighborList()
+
+        indices = np.random.choice(len(points), 30, replace=False)
+        positions = self.random_points(box, 30)
+        points[indices] = positions
+        formed, broken = nq.update_points(indices, positions, query_args)
+        new_nlist = nq.query(points, query_args).toNeighborList()
+
+        changes = freud.locality.BondChanges().compute(old_nlist, new_nlist)
+        npt.assert_array_equal(formed[:], changes.formed[:])
+        npt.assert_array_equal(broken[:], changes.broken[:])
+        npt.assert_allclose(formed.distances, changes.formed.distances,
+                            rtol=1e-5)
+        npt.assert_allclose(broken.distances, changes.broken.distances,
+                            rtol=1e-5)
+        self.assertEqual(formed.num_points, len(points))
+        for bonds in [formed, broken]:
+            self.assertTrue(np.all(np.isin(bonds[:, 0], indices)
+                                   | np.isin(bonds[:, 1], indices)))
+
+    def test_update_points_invalid(self):
+        box = freud.box.Box.square(10)
+        points = self.random_points(box, 100)
+        nq = self.build_query_object(box, points, 1.0)
+        with self.assertRaises(ValueError):
+            nq.update_points([0, 0], [[0, 0, 0], [1, 1, 0]])
+        with self.assertRaises(ValueError):
+            nq.update_points([100], [[0, 0, 0]])
+        with self.assertRaises(ValueError):
+            nq.update_points([0], [[0, 0, 1]])
+        with self.assertRaises(ValueError):
+            nq.update_points([0], [[0, 0, 0]], dict(num_neighbors=2))
+        with self.assertRaises(ValueError):
+            nq.insert_points([[0, 0, 1]])
+        with self.assertRaises(ValueError):
+            nq.remove_points(np.arange(100))
+        npt.assert_array_equal(nq.points, points)
+
+
+class TestNeighborQueryAABB(NeighborQueryTest, PointUpdateTest,
+                          unittest.TestCase):
     @classmethod
     def build_query_object(cls, box, ref_points, r_max=None):
         return freud.locality.AABBQuery(box, ref_points)
 
-    def test_throws(self):
-        """Test that specifying too large an r_max value throws an error"""
-        L = 5
-
-        box = freud.box.Box.square(L)
-        points = [[0, 0, 0], [1, 1, 0], [1, -1, 0]]
-        aq = freud.locality.AABBQuery(box, points)
-        with self.assertRaises(RuntimeError):
-            list(aq.query(points, dict(r_max=L)))
-
     def test_chaining(self):
         N = 500
         L = 10
@@ -620,8 +868,37 @@ class TestNeighborQueryAABB(NeighborQueryTest, unittest.TestCase):
                 else:
                     original_nlist = nlist
 
+    def test_query_points_far_outside_box(self):
+        """Query points many box lengths away from the box find the same
+        neighbors as their images inside of the box."""
+        np.random.seed(0)
+        box = freud.box.Box(10, 11, 12, 0.2, 0.1, -0.3)
+        points = box.make_absolute(np.random.rand(200, 3))
+        query_points = box.make_absolute(np.random.rand(50, 3))
+        shifts = np.random.randint(-100, 100, size=query_points.shape)
+        shifted_points = query_points + shifts.dot(box.to_matrix().T)
+        aq = self.build_query_object(box, points)
+        query_args = dict(mode='ball', r_max=2)
+        nlist = aq.query(query_points, query_args).toNeighborList()
+        shifted_nlist = aq.query(shifted_points, query_args).toNeighborList()
+        npt.assert_array_equal(nlist[:], shifted_nlist[:])
+        npt.assert_allclose(nlist.distances, shifted_nlist.distances,
+                            atol=1e-3)
+
+
+class TestNeighborQueryAABBBinaryTree(TestNeighborQueryAABB):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None):
+        return freud.locality.AABBQuery(box, ref_points, wide_tree=False)
+
+    def test_wide_tree(self):
+        box, points = freud.data.make_random_system(10, 100)
+        self.assertTrue(freud.locality.AABBQuery(box, points).wide_tree)
+        self.assertFalse(self.build_query_object(box, points).wide_tree)
 
-class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
+
+class TestNeighborQueryLinkCell(NeighborQueryTest, PointUpdateTest,
+                                unittest.TestCase):
     @classmethod
     def build_query_object(cls, box, ref_points, r_max=None):
         if r_max is None:
@@ -640,6 +917,34 @@ class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
                                        exclude_ii=True)).toNeighborList()
         self.assertTrue(nlist_equal(nlist1, nlist2))
 
+    def test_query_points_outside_box(self):
+        """Check LinkCell against brute force for query points shifted
+        outside of the box."""
+        np.random.seed(0)
+        for box in [freud.box.Box(10, 11, 12, 0.2, 0.1, -0.3),
+                    freud.box.Box.square(15)]:
+            points = box.make_absolute(np.random.rand(300, 3))
+            query_points = box.make_absolute(np.random.rand(50, 3))
+            if box.is2D:
+                points[:, 2] = query_points[:, 2] = 0
+            shifts = np.random.randint(-3, 4, size=query_points.shape)
+            if box.is2D:
+                shifts[:, 2] = 0
+            shifted_points = query_points + shifts.dot(box.to_matrix().T)
+            for r_min in [0, 1]:
+                lc = self.build_query_object(box, points, 2)
+                nlist = lc.query(shifted_points, dict(
+                    mode='ball', r_max=2, r_min=r_min)).toNeighborList()
+
+                vectors = (points[np.newaxis, :, :]
+                           - query_points[:, np.newaxis, :]).reshape(-1, 3)
+                distances = np.linalg.norm(
+                    box.wrap(vectors), axis=-1).reshape(len(query_points), -1)
+                expected = np.argwhere(
+                    (distances < 2) & (distances >= r_min))
+                self.assertEqual(set(map(tuple, nlist[:])),
+                                 set(map(tuple, expected)))
+
     def test_default_cell_width(self):
         """Check that using a default cell width works."""
         N = 500
@@ -654,6 +959,64 @@ class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
         self.assertTrue(nlist_equal(nlist1, nlist2))
 
 
+class TestNeighborQueryAdaptiveCell(NeighborQueryTest, unittest.TestCase):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None):
+        return freud.locality.AdaptiveCell(box, ref_points)
+
+    def test_large_r_max(self):
+        """Unlike LinkCell and AABBQuery, AdaptiveCell only finds the nearest
+        image of each point, so it rejects balls larger than half of the
+        box."""
+        L = 5
+
+        box = freud.box.Box.square(L)
+        points = [[0, 0, 0], [1, 1, 0], [1, -1, 0]]
+        ac = freud.locality.AdaptiveCell(box, points)
+        with self.assertRaises(RuntimeError):
+            list(ac.query(points, dict(r_max=L)))
+
+    def test_inhomogeneous(self):
+        """Check that a dense droplet in a dilute vapor is subdivided and
+        gives the same neighbors as a LinkCell."""
+        np.random.seed(0)
+        L = 20
+        box = freud.box.Box(L, L, L, 0.3, 0.1, 0.2)
+        vapor = box.make_absolute(np.random.rand(100, 3))
+        droplet = box.make_absolute(
+            0.5 + 0.05*np.random.randn(1000, 3).clip(-3, 3))
+        points = np.concatenate((vapor, droplet)).astype(np.float32)
+
+        ac = freud.locality.AdaptiveCell(box, points, max_points_per_cell=8)
+        self.assertGreater(ac.num_levels, 1)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+        for query_args in [dict(r_max=1.0, exclude_ii=True),
+                           dict(num_neighbors=6, exclude_ii=True)]:
+            nlist1 = ac.query(points, query_args).toNeighborList()
+            nlist2 = lc.query(points, query_args).toNeighborList()
+            self.assertTrue(nlist_equal(nlist1, nlist2))
+
+    def test_cell_parameters(self):
+        L = 10
+        box, points = freud.data.make_random_system(L, 500)
+        ac = freud.locality.AdaptiveCell(box, points, 2.5, 4)
+        self.assertEqual(ac.cell_width, 2.5)
+        self.assertEqual(ac.cell_dimensions, (4, 4, 4))
+        self.assertEqual(ac.max_points_per_cell, 4)
+        with self.assertRaises(ValueError):
+            freud.locality.AdaptiveCell(box, points, max_points_per_cell=0)
+
+    def test_update_points_unsupported(self):
+        box, points = freud.data.make_random_system(10, 100)
+        ac = freud.locality.AdaptiveCell(box, points, 2.5)
+        with self.assertRaises(NotImplementedError):
+            ac.update_points([0], [[0, 0, 0]])
+        with self.assertRaises(NotImplementedError):
+            ac.insert_points([[0, 0, 0]])
+        with self.assertRaises(NotImplementedError):
+            ac.remove_points([0])
+
+
 class TestMultipleMethods(unittest.TestCase):
     """Check that different methods of making a NeighborList give the same
     result."""
@@ -0,0 +1,162 @@
+import ctypes
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+class FreudBond(ctypes.Structure):
+    _fields_ = [('query_point_idx', ctypes.c_uint),
+                ('point_idx', ctypes.c_uint),
+                ('distance', ctypes.c_float),
+                ('weight', ctypes.c_float),
+                ('delta', ctypes.c_float * 3)]
+
+
+class FreudPairSystem(ctypes.Structure):
+    _fields_ = [('points', ctypes.POINTER(ctypes.c_float)),
+                ('query_points', ctypes.POINTER(ctypes.c_float)),
+                ('orientations', ctypes.POINTER(ctypes.c_float)),
+                ('query_orientations', ctypes.POINTER(ctypes.c_float)),
+                ('n_points', ctypes.c_uint),
+                ('n_query_points', ctypes.c_uint),
+                ('box_matrix', ctypes.c_float * 9),
+                ('user_data', ctypes.c_void_p)]
+
+
+PREDICATE = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.POINTER(FreudPairSystem),
+                             ctypes.POINTER(FreudBond))
+KERNEL = ctypes.CFUNCTYPE(None, ctypes.POINTER(FreudPairSystem),
+                          ctypes.POINTER(FreudBond),
+                          ctypes.POINTER(ctypes.c_double))
+
+
+@PREDICATE
+def positive_x(system, bond):
+    # Accept bonds pointing along +x whose query point has an orientation
+    # with w above the threshold passed as user data.
+    threshold = ctypes.cast(system[0].user_data,
+                            ctypes.POINTER(ctypes.c_float))[0]
+    i = bond[0].query_point_idx
+    return int(bond[0].delta[0] > 0 and
+               system[0].query_orientations[4*i] > threshold)
+
+
+@KERNEL
+def count_and_sum(system, bond, output):
+    output[0] += 1
+    output[1] += bond[0].distance
+
+
+@KERNEL
+def sum_delta(system, bond, output):
+    for dim in range(3):
+        output[dim] += bond[0].delta[dim]
+
+
+class TestPairKernel(unittest.TestCase):
+    def setUp(self):
+        L = 10
+        N = 300
+        self.r_max = 2
+        self.box, self.points = freud.data.make_random_system(L, N, seed=0)
+        np.random.seed(0)
+        self.orientations = np.random.rand(N, 4).astype(np.float32)
+        self.query_args = dict(r_max=self.r_max, exclude_ii=True)
+        self.nlist = freud.locality.AABBQuery(
+            self.box, self.points).query(
+                self.points, self.query_args).toNeighborList()
+        delta = self.box.wrap(
+            self.points[self.nlist.point_indices] -
+            self.points[self.nlist.query_point_indices])
+        self.threshold = np.array([0.5], dtype=np.float32)
+        self.accepted = np.logical_and(
+            delta[:, 0] > 0,
+            self.orientations[self.nlist.query_point_indices, 0] >
+            self.threshold[0])
+
+    def test_filter(self):
+        for neighbors in [self.query_args, self.nlist]:
+            pk = freud.locality.PairKernel(positive_x)
+            pk.compute((self.box, self.points), self.orientations,
+                       neighbors=neighbors, user_data=self.threshold)
+            self.assertEqual(pk.num_accepted_bonds, np.sum(self.accepted))
+            npt.assert_equal(
+                pk.nlist[:],
+                self.nlist[:][self.accepted])
+            npt.assert_allclose(pk.nlist.distances,
+                                self.nlist.distances[self.accepted])
+
+    def test_reduction(self):
+        pk = freud.locality.PairKernel(positive_x, count_and_sum,
+                                       num_outputs=2)
+        pk.compute((self.box, self.points), self.orientations,
+                   neighbors=self.query_args, user_data=self.threshold)
+        N = len(self.points)
+        i = self.nlist.query_point_indices[self.accepted]
+        counts = np.bincount(i, minlength=N)
+        sums = np.bincount(i, self.nlist.distances[self.accepted],
+                           minlength=N)
+        npt.assert_equal(pk.output.shape, (N, 2))
+        npt.assert_equal(pk.output[:, 0], counts)
+        npt.assert_allclose(pk.output[:, 1], sums, rtol=1e-5)
+        with self.assertRaises(AttributeError):
+            pk.nlist
+
+    def test_no_predicate(self):
+        pk = freud.locality.PairKernel()
+        pk.compute((self.box, self.points), neighbors=self.query_args)
+        npt.assert_equal(pk.nlist[:], self.nlist[:])
+        self.assertEqual(pk.output.shape, (len(self.points), 0))
+
+    def test_large_r_max_delta(self):
+        """Bonds found through periodic images beyond the minimum image get
+        the vector of that image."""
+        box = freud.box.Box.cube(3)
+        points = np.array([[0, 0, 0], [1.4, 0, 0]], dtype=np.float32)
+        pk = freud.locality.PairKernel(kernel=sum_delta, num_outputs=3)
+        pk.compute((box, points), neighbors=dict(r_max=1.7, exclude_ii=True))
+        # Each point finds the other at 1.4 along one direction and at 1.6
+        # along the other direction.
+        npt.assert_allclose(pk.output, [[-0.2, 0, 0], [0.2, 0, 0]],
+                            atol=1e-5)
+
+    def test_large_r_max_delta_symmetric(self):
+        """Bonds found through images at the same distance get the vectors
+        of their own images, which cancel in symmetric configurations."""
+        systems = [
+            # A point finds itself at the origin and through the six nearest
+            # images of the box.
+            (freud.box.Box.cube(3), np.array([[0.2, -0.4, 0.7]]), 3.5,
+             False, 7),
+            # A partner at half of the box is found through two images.
+            (freud.box.Box.cube(3), np.array([[0, 0, 0], [1.5, 0, 0]]), 1.6,
+             True, 2),
+            # Each point of a simple cubic lattice with two points along each
+            # box vector finds each neighbor through two images.
+            freud.data.UnitCell.sc().generate_system(2) + (1.1, True, 6)]
+        for box, points, r_max, exclude_ii, num_bonds in systems:
+            points = np.asarray(points, dtype=np.float32)
+            for nq in [freud.locality.AABBQuery(box, points),
+                       freud.locality.LinkCell(box, points, 0.5)]:
+                pk = freud.locality.PairKernel(kernel=sum_delta,
+                                               num_outputs=3)
+                pk.compute(nq, neighbors=dict(r_max=r_max,
+                                              exclude_ii=exclude_ii))
+                self.assertEqual(pk.num_accepted_bonds,
+                                 num_bonds * len(points))
+                npt.assert_allclose(pk.output, 0, atol=1e-5)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.locality.PairKernel(num_outputs=2)
+        with self.assertRaises(TypeError):
+            freud.locality.PairKernel('not a function')
+
+    def test_repr(self):
+        pk = freud.locality.PairKernel(num_outputs=0, store_bonds=False)
+        self.assertEqual(str(pk), str(eval(repr(pk))))
+
+
+if __name__ == '__main__':
+    unittest.main()
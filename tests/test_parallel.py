@@ -1,4 +1,6 @@
 import freud
+import numpy as np
+import numpy.testing as npt
 import unittest
 
 
@@ -33,5 +35,70 @@ class TestParallel(unittest.TestCase):
         self.assertEqual(freud.parallel.get_num_threads(), 1)
 
 
+class TestSIMD(unittest.TestCase):
+    """Ensure that all SIMD levels give the same results."""
+
+    def tearDown(self):
+        freud.parallel.set_simd_level(None)
+
+    def test_set(self):
+        supported = freud.parallel.get_supported_simd_level()
+        self.assertEqual(freud.parallel.get_simd_level(), supported)
+        freud.parallel.set_simd_level('none')
+        self.assertEqual(freud.parallel.get_simd_level(), 'none')
+        with freud.parallel.SIMDLevel(supported):
+            self.assertEqual(freud.parallel.get_simd_level(), supported)
+        self.assertEqual(freud.parallel.get_simd_level(), 'none')
+        freud.parallel.set_simd_level(None)
+        self.assertEqual(freud.parallel.get_simd_level(), supported)
+        with self.assertRaises(ValueError):
+            freud.parallel.set_simd_level('sse')
+
+    def test_shared_across_modules(self):
+        # Each extension module is a separate library, so the kernels of
+        # freud.box must see the level set in freud.parallel.
+        supported = freud.parallel.get_supported_simd_level()
+        self.assertEqual(freud.box._get_simd_level(), supported)
+        for level in ['none', 'avx2', 'avx512']:
+            with freud.parallel.SIMDLevel(level):
+                self.assertEqual(freud.box._get_simd_level(),
+                                 freud.parallel.get_simd_level())
+        freud.parallel.set_simd_level('none')
+        self.assertEqual(freud.box._get_simd_level(), 'none')
+
+    def test_box(self):
+        box = freud.box.Box(10, 11, 12, 0.3, -0.2, 0.7)
+        box.periodic_y = False
+        np.random.seed(0)
+        points = np.random.uniform(-30, 30, (1001, 3)).astype(np.float32)
+        query_points = np.random.uniform(-30, 30, (1001, 3)).astype(np.float32)
+
+        def compute():
+            return (box.wrap(points), box.make_fractional(points),
+                    box.make_absolute(points),
+                    box.compute_distances(query_points, points),
+                    box.compute_all_distances(query_points[:20], points))
+
+        with freud.parallel.SIMDLevel('none'):
+            expected = compute()
+        for level in ['avx2', 'avx512']:
+            with freud.parallel.SIMDLevel(level):
+                # The scalar code may be compiled with fused multiply-adds,
+                # which round differently from the SIMD kernels.
+                for result, reference in zip(compute(), expected):
+                    npt.assert_allclose(result, reference, rtol=1e-6,
+                                        atol=1e-5)
+
+    def test_gaussian_density(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        gd = freud.density.GaussianDensity(20, 3, 1)
+        with freud.parallel.SIMDLevel('none'):
+            expected = gd.compute((box, points)).density
+        for level in ['avx2', 'avx512']:
+            with freud.parallel.SIMDLevel(level):
+                npt.assert_allclose(gd.compute((box, points)).density,
+                                    expected, rtol=1e-6)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -854,6 +854,69 @@ class TestPMFTXYZ(TestPMFT, unittest.TestCase):
             points_to_set(pmft.bin_counts),
             bins)
 
+    @staticmethod
+    def cube_rotations():
+        """The 24 rotations of a cube as quaternions."""
+        matrices = []
+        for perm in [(0, 1, 2), (0, 2, 1), (1, 0, 2), (1, 2, 0), (2, 0, 1),
+                     (2, 1, 0)]:
+            for signs in np.ndindex(2, 2, 2):
+                matrix = np.zeros((3, 3))
+                matrix[range(3), perm] = 1 - 2*np.array(signs)
+                if np.linalg.det(matrix) > 0:
+                    matrices.append(matrix)
+        return rowan.from_matrix(np.array(matrices))
+
+    def test_fold_symmetry(self):
+        """Folding bonds by a point group gives the same result as binning
+        them once for each equivalent orientation."""
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        np.random.seed(0)
+        orientations = rowan.random.rand(len(points))
+        cube = self.cube_rotations()
+        groups = [cube, cube[:1], rowan.from_axis_angle(
+            [0, 0, 1], np.array([0, 0.5, 1, 1.5])*np.pi)]
+        for equiv_orientations in groups:
+            replicated = freud.pmft.PMFTXYZ(3, 3, 3, 21)
+            replicated.compute((box, points), orientations,
+                               equiv_orientations=equiv_orientations)
+            folded = freud.pmft.PMFTXYZ(3, 3, 3, 21)
+            folded.compute((box, points), orientations,
+                           equiv_orientations=equiv_orientations,
+                           fold_symmetry=True)
+            self.assertEqual(np.sum(folded.bin_counts),
+                             np.sum(replicated.bin_counts))
+            # Only bonds that fall on bin edges may be binned differently.
+            self.assertLess(
+                np.sum(np.abs(folded.bin_counts.astype(np.int64) -
+                              replicated.bin_counts)),
+                1e-3*np.sum(replicated.bin_counts))
+            pcf_per_count = (np.max(replicated.pcf) /
+                             np.max(replicated.bin_counts))
+            npt.assert_allclose(folded.pcf, replicated.pcf,
+                                atol=2*pcf_per_count)
+
+    def test_fold_symmetry_invalid(self):
+        box, points = freud.data.make_random_system(10, 20, seed=0)
+        orientations = np.array([[1, 0, 0, 0]]*len(points))
+        cube = self.cube_rotations()
+        pmft = freud.pmft.PMFTXYZ(3, 3, 3, 21)
+        # Not a group.
+        with self.assertRaises(ValueError):
+            pmft.compute((box, points), orientations,
+                         equiv_orientations=cube[:5], fold_symmetry=True)
+        # Not a signed permutation of the axes.
+        with self.assertRaises(ValueError):
+            pmft.compute((box, points), orientations,
+                         equiv_orientations=rowan.from_axis_angle(
+                             [0, 0, 1], [0, np.pi/3]),
+                         fold_symmetry=True)
+        # The grid is not symmetric under the group.
+        pmft = freud.pmft.PMFTXYZ(3, 3, 4, 21)
+        with self.assertRaises(ValueError):
+            pmft.compute((box, points), orientations,
+                         equiv_orientations=cube, fold_symmetry=True)
+
 
 class TestPMFTR12ManagedArray(TestManagedArray, unittest.TestCase):
     def build_object(self):
@@ -44,6 +44,8 @@ def make_raw_query_nlist_test_set(box, points, query_points, mode, r_max,
     test_set.append((freud.locality.AABBQuery(box, points), query_args))
     test_set.append(
         (freud.locality.LinkCell(box, points, r_max), query_args))
+    test_set.append(
+        (freud.locality.AdaptiveCell(box, points), query_args))
 
     aq = freud.locality.AABBQuery(box, points)
     if mode == "ball":